@@ -0,0 +1,154 @@
+﻿/*****************************************************************//**
+ * @file	main.cpp
+ * @brief	ArcheCook: アセットをクックするコマンドラインツール
+ *
+ * @details	ウィンドウ・デバイスを作らずに AssetCooker を実行する。ビルド工程から呼ぶ想定。
+ *			使い方: ArcheCook [--root <dir>] [--db <path>] [--jobs <n>] [--force]
+ *			        ArcheCook --bench-scene [<entities>]（JSON とバイナリシーンの読み込み時間を比べる）
+ *			        ArcheCook --bench-animator [<animators>]（アニメーターの遷移評価の時間を変更前と比べる）
+ *			        ArcheCook --bench-assets [<files>]（アセットのキー解決の時間を変更前と比べる）
+ *			作業ディレクトリはプロジェクトのルート（Resources/ のある場所）にすること。
+ *			失敗したアセットがあれば終了コード 1 を返す。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#include "Engine/Resource/AssetCooker.h"
+#include "Engine/Scene/Serializer/SceneBenchmark.h"
+#include "Engine/Scene/Animation/AnimatorBenchmark.h"
+#include "Engine/Resource/AssetRegistryBenchmark.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+static void PrintUsage()
+{
+	std::cout << "Usage: ArcheCook [--root <dir>] [--db <path>] [--jobs <n>] [--force]" << std::endl;
+	std::cout << "       ArcheCook --bench-scene [<entities>]" << std::endl;
+	std::cout << "       ArcheCook --bench-animator [<animators>]" << std::endl;
+	std::cout << "       ArcheCook --bench-assets [<files>]" << std::endl;
+}
+
+static int RunSceneBenchmark(uint32_t entityCount)
+{
+	std::cout << "[ArcheCook] Scene benchmark: " << entityCount << " entities" << std::endl;
+
+	Arche::SceneBenchmarkResult result = Arche::SceneBenchmark::Run(entityCount);
+	if (!result.succeeded)
+	{
+		std::cerr << "[ArcheCook] Scene benchmark failed" << std::endl;
+		return 1;
+	}
+
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << "[ArcheCook] JSON   : " << result.jsonBytes / (1024.0 * 1024.0) << " MB, parse "
+		<< result.jsonParseSeconds * 1000.0 << " ms + build " << result.jsonBuildSeconds * 1000.0 << " ms"
+		<< " (single thread " << result.jsonSerialBuildSeconds * 1000.0 << " ms)" << std::endl;
+	std::cout << "[ArcheCook] Stream : parse " << result.streamParseSeconds * 1000.0 << " ms + build "
+		<< result.streamBuildSeconds * 1000.0 << " ms (no DOM)" << std::endl;
+	std::cout << "[ArcheCook] Binary : " << result.binaryBytes / (1024.0 * 1024.0) << " MB, parse "
+		<< result.binaryParseSeconds * 1000.0 << " ms + build " << result.binaryBuildSeconds * 1000.0 << " ms"
+		<< " (write " << result.binaryWriteSeconds * 1000.0 << " ms)" << std::endl;
+	std::cout << "[ArcheCook] Speedup: x" << result.GetSpeedup() << std::endl;
+	return 0;
+}
+
+static int RunAnimatorBenchmark(uint32_t animatorCount)
+{
+	Arche::AnimatorBenchmarkResult result = Arche::AnimatorBenchmark::Run(animatorCount);
+	std::cout << "[ArcheCook] Animator benchmark: " << result.animatorCount << " animators x " << result.frameCount << " frames" << std::endl;
+	if (!result.succeeded)
+	{
+		std::cerr << "[ArcheCook] Animator benchmark failed (transition counts differ)" << std::endl;
+		return 1;
+	}
+
+	std::cout << std::fixed << std::setprecision(3);
+	std::cout << "[ArcheCook] Map     : " << result.GetLegacyFrameMs() << " ms/frame" << std::endl;
+	std::cout << "[ArcheCook] Program : " << result.GetProgramFrameMs() << " ms/frame" << std::endl;
+	std::cout << "[ArcheCook] Transitions: " << result.transitionCount << std::endl;
+	std::cout << std::setprecision(2) << "[ArcheCook] Speedup: x" << result.GetSpeedup() << std::endl;
+	return 0;
+}
+
+static int RunAssetRegistryBenchmark(uint32_t fileCount)
+{
+	std::cout << "[ArcheCook] Asset registry benchmark: " << fileCount << " files" << std::endl;
+
+	Arche::AssetRegistryBenchmarkResult result = Arche::AssetRegistryBenchmark::Run(fileCount);
+	if (!result.succeeded)
+	{
+		std::cerr << "[ArcheCook] Asset registry benchmark failed (resolved paths differ)" << std::endl;
+		return 1;
+	}
+
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << "[ArcheCook] Probe   : " << result.probeSeconds * 1000.0 << " ms for " << result.keyCount << " keys ("
+		<< result.GetProbeMicroseconds() << " us/key)" << std::endl;
+	std::cout << "[ArcheCook] Registry: scan " << result.scanSeconds * 1000.0 << " ms, first resolve " << result.firstResolveSeconds * 1000.0
+		<< " ms, then " << result.resolveSeconds * 1000.0 << " ms (" << result.GetResolveMicroseconds() << " us/key)" << std::endl;
+	std::cout << "[ArcheCook] Speedup: x" << result.GetSpeedup() << std::endl;
+	return 0;
+}
+
+int main(int argc, char** argv)
+{
+	Arche::CookSettings settings;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+
+		if (arg == "--bench-scene")
+		{
+			uint32_t entityCount = 50000;
+			if (hasValue && argv[i + 1][0] != '-') entityCount = (uint32_t)std::max(1, std::atoi(argv[++i]));
+			return RunSceneBenchmark(entityCount);
+		}
+		else if (arg == "--bench-animator")
+		{
+			uint32_t animatorCount = 1000;
+			if (hasValue && argv[i + 1][0] != '-') animatorCount = (uint32_t)std::max(1, std::atoi(argv[++i]));
+			return RunAnimatorBenchmark(animatorCount);
+		}
+		else if (arg == "--bench-assets")
+		{
+			uint32_t fileCount = 20000;
+			if (hasValue && argv[i + 1][0] != '-') fileCount = (uint32_t)std::max(1, std::atoi(argv[++i]));
+			return RunAssetRegistryBenchmark(fileCount);
+		}
+		else if (arg == "--root" && hasValue) settings.sourceRoot = argv[++i];
+		else if (arg == "--db" && hasValue) settings.databasePath = argv[++i];
+		else if (arg == "--jobs" && hasValue) settings.workerCount = (size_t)std::max(0, std::atoi(argv[++i]));
+		else if (arg == "--force") settings.force = true;
+		else
+		{
+			PrintUsage();
+			return 2;
+		}
+	}
+
+	std::cout << "[ArcheCook] Cooking " << settings.sourceRoot << (settings.force ? " (force)" : "") << std::endl;
+
+	Arche::AssetCooker cooker(settings);
+	Arche::CookReport report = cooker.Run();
+
+	for (const auto& error : report.errors)
+	{
+		std::cerr << "[ArcheCook] Failed: " << error << std::endl;
+	}
+
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << "[ArcheCook] Assets   : " << report.total
+		<< " (cooked " << report.cooked << ", up-to-date " << report.upToDate << ", failed " << report.failed << ")" << std::endl;
+	std::cout << "[ArcheCook] Hit rate : " << report.GetHitRate() * 100.0 << " %" << std::endl;
+	std::cout << "[ArcheCook] Input    : " << report.cookedBytes / (1024.0 * 1024.0) << " MB -> "
+		<< report.outputBytes / (1024.0 * 1024.0) << " MB" << std::endl;
+	std::cout << "[ArcheCook] Throughput: " << report.GetThroughput() << " MB/s"
+		<< " (hash " << report.hashSeconds << " s, cook " << report.cookSeconds << " s, total " << report.totalSeconds << " s)" << std::endl;
+
+	return report.failed > 0 ? 1 : 0;
+}
@@ -27,53 +27,111 @@ namespace Arche
 		virtual void Undo() = 0;
 		// メモリ管理用: trueならUndoスタックから消えた時にdeleteされる
 		virtual bool IsMerged() const { return false; }
+
+		// 履歴が持っているデータの大きさ（バイト）。履歴の上限はこの合計で決まる
+		// 大きなデータを持つコマンドは実際の大きさを返すこと
+		virtual size_t GetMemorySize() const { return 256; }
+
+		// 直前のコマンド（this）に、続けて実行された next をまとめられるならまとめて true
+		// （next は履歴に積まれずに捨てられる）
+		virtual bool MergeWith(const ICommand& next) { (void)next; return false; }
 	};
 
 	class CommandHistory
 	{
 	public:
+		// 履歴（Undo + Redo）に使うメモリの上限
+		static constexpr size_t MAX_HISTORY_BYTES = 64 * 1024 * 1024;
+
 		static void Execute(std::shared_ptr<ICommand> cmd)
 		{
 			cmd->Execute();
-			m_undoStack.push_back(cmd);
-			m_redoStack.clear();	// 新しい操作をしたらRedoスタックはクリア
-
-			// 履歴制限
-			if (m_undoStack.size() > 50) m_undoStack.pop_front();
+			ClearStack(m_redoStack);	// 新しい操作をしたらRedoスタックはクリア
 			SceneManager::Instance().SetDirty(true);
+
+			// 同じ値への続けての変更（ドラッグ、キー操作での微調整など）は1つにまとめる
+			if (!m_undoStack.empty())
+			{
+				Entry& last = m_undoStack.back();
+				if (last.command->MergeWith(*cmd))
+				{
+					m_totalBytes -= last.bytes;
+					last.bytes = last.command->GetMemorySize();
+					m_totalBytes += last.bytes;
+					return;
+				}
+			}
+
+			Entry entry{ cmd, cmd->GetMemorySize() };
+			m_totalBytes += entry.bytes;
+			m_undoStack.push_back(std::move(entry));
+			TrimUndoStack();
 		}
 
 		static void Undo()
 		{
 			if (m_undoStack.empty()) return;
-			auto cmd = m_undoStack.back();
+			Entry entry = std::move(m_undoStack.back());
 			m_undoStack.pop_back();
-			cmd->Undo();
-			m_redoStack.push_back(cmd);
+			entry.command->Undo();
+			m_redoStack.push_back(std::move(entry));
 			Logger::Log("Undo performed.");
 		}
 
 		static void Redo()
 		{
 			if (m_redoStack.empty()) return;
-			auto cmd = m_redoStack.back();
+			Entry entry = std::move(m_redoStack.back());
 			m_redoStack.pop_back();
-			cmd->Execute();
-			m_undoStack.push_back(cmd);
+			entry.command->Execute();
+
+			// Execute で持つデータが変わることがあるので測り直す（Execute と同じく上限を超えたら古いものから捨てる）
+			m_totalBytes -= entry.bytes;
+			entry.bytes = entry.command->GetMemorySize();
+			m_totalBytes += entry.bytes;
+			m_undoStack.push_back(std::move(entry));
+			TrimUndoStack();
 			Logger::Log("Redo performed.");
 		}
 
 		// 履歴の全消去（モード切替時などに使用）
 		static void Clear()
 		{
-			m_undoStack.clear();
-			m_redoStack.clear();
+			ClearStack(m_undoStack);
+			ClearStack(m_redoStack);
 			Logger::Log("Command History Cleared.");
 		}
 
+		// 履歴が今使っているメモリ（バイト）
+		static size_t GetMemoryUsage() { return m_totalBytes; }
+
+	private:
+		struct Entry
+		{
+			std::shared_ptr<ICommand> command;
+			size_t bytes = 0;	// 積んだ時点の GetMemorySize
+		};
+
+		// 履歴制限（古いものから捨てる。今の操作は残す）
+		static void TrimUndoStack()
+		{
+			while (m_totalBytes > MAX_HISTORY_BYTES && m_undoStack.size() > 1)
+			{
+				m_totalBytes -= m_undoStack.front().bytes;
+				m_undoStack.pop_front();
+			}
+		}
+
+		static void ClearStack(std::deque<Entry>& stack)
+		{
+			for (const auto& entry : stack) m_totalBytes -= entry.bytes;
+			stack.clear();
+		}
+
 	private:
-		static inline std::deque<std::shared_ptr<ICommand>> m_undoStack;
-		static inline std::deque<std::shared_ptr<ICommand>> m_redoStack;
+		static inline std::deque<Entry> m_undoStack;
+		static inline std::deque<Entry> m_redoStack;
+		static inline size_t m_totalBytes = 0;
 	};
 
 }	// namespace Arche
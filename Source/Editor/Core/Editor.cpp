@@ -17,6 +17,7 @@
 #include "Editor/Tools/GizmoSystem.h"
 #include "Engine/Audio/AudioManager.h"
 #include "Engine/Scene/Serializer/SceneSerializer.h"
+#include "Engine/Scene/Serializer/SceneSaver.h"
 #include "Engine/Scene/Serializer/ComponentSerializer.h"
 #include "Engine/Scene/Serializer/SystemRegistry.h"
 #include "Engine/Scene/Core/SceneManager.h"
@@ -36,8 +37,18 @@
 
 namespace Arche
 {
+	namespace
+	{
+		// プレイ開始時の状態（停止時にここから戻す）
+		constexpr const char* PLAY_CACHE_PATH = "Resources/Engine/Cache/SceneCache.json";
+		// 自動保存の書き出し先（元のシーンは上書きしない）
+		constexpr const char* AUTOSAVE_DIRECTORY = "Resources/Engine/Cache/Autosave/";
+	}
+
 	void Editor::Initialize()
 	{
+		m_lastAutosaveTime = std::chrono::steady_clock::now();
+
 		// 1. パネルの生成
 		m_windows.clear();
 
@@ -88,6 +99,9 @@ namespace Arche
 
 	void Editor::Shutdown()
 	{
+		// 書き出し中の保存を待つ（ゲーム側コンポーネントのコードを使うので、DLLが残っているうちに）
+		SceneSaver::Instance().Flush();
+
 		// プレファブ編集モードらな強制終了してワールドを破棄
 		if (m_editorMode == EditorMode::Prefab)
 		{
@@ -107,6 +121,10 @@ namespace Arche
 	{
 		bool ctrl = Input::GetKey(VK_CONTROL);
 
+		// 書き終わった保存の後始末と、自動保存
+		SceneSaver::Instance().Update();
+		UpdateAutosave(world, ctx);
+
 		// Undo / Redo
 		if (ctrl && Input::GetKeyDown('Z'))
 		{
@@ -123,13 +141,7 @@ namespace Arche
 			// Editモードの時だけ保存可能
 			if (ctx.editorState == EditorState::Edit)
 			{
-				std::string path = SceneManager::Instance().GetCurrentScenePath();
-				if (path.empty()) path = "Resources/Game/Scenes/Untitled.json";
-
-				SceneSerializer::SaveScene(world, path);
-				SceneManager::Instance().SetDirty(false);
-				EditorPrefs::Instance().lastScenePath = path;
-				EditorPrefs::Instance().Save();
+				SaveCurrentScene(world);
 			}
 		}
 
@@ -138,7 +150,7 @@ namespace Arche
 		{
 			if (ctx.editorState == EditorState::Edit)
 			{
-				SceneSerializer::SaveScene(world, "Resources/Engine/Cache/SceneCache.json");
+				SceneSaver::Instance().SaveAsync(world, PLAY_CACHE_PATH, nullptr, SceneSaver::SaveKind::Internal);
 				ctx.editorState = EditorState::Play;
 			}
 			else
@@ -149,8 +161,9 @@ namespace Arche
 				world.clearSystems();
 				world.clearEntities();
 
-				// 復元
-				SceneSerializer::LoadScene(world, "Resources/Engine/Cache/SceneCache.json");
+				// 復元（プレイ開始時の保存が書き終わっていなければ待つ）
+				SceneSaver::Instance().Flush();
+				SceneSerializer::LoadScene(world, PLAY_CACHE_PATH);
 			}
 		}
 
@@ -187,12 +200,11 @@ namespace Arche
 			{
 				if (ImGui::MenuItem("Save Scene", "Ctrl + S"))
 				{
-					std::string path = SceneManager::Instance().GetCurrentScenePath();
-					if (path.empty()) path = "Resources/Game/Scenes/Untitled.json";
+					SaveCurrentScene(world);
+				}
 
-					SceneSerializer::SaveScene(world, path);
-					SceneManager::Instance().SetDirty(false);
-					EditorPrefs::Instance().lastScenePath = path;
+				if (ImGui::MenuItem("Autosave", nullptr, &EditorPrefs::Instance().autosave.enabled))
+				{
 					EditorPrefs::Instance().Save();
 				}
 
@@ -229,7 +241,7 @@ namespace Arche
 				if (ImGui::Button("Play"))
 				{
 					// 一時保存
-					SceneSerializer::SaveScene(world, "Resources/Engine/Cache/SceneCache.json");
+					SceneSaver::Instance().SaveAsync(world, PLAY_CACHE_PATH, nullptr, SceneSaver::SaveKind::Internal);
 
 					ctx.editorState = EditorState::Play;
 				}
@@ -244,8 +256,9 @@ namespace Arche
 					world.clearSystems();
 					world.clearEntities();
 
-					// 復元
-					SceneSerializer::LoadScene(world, "Resources/Engine/Cache/SceneCache.json");
+					// 復元（プレイ開始時の保存が書き終わっていなければ待つ）
+					SceneSaver::Instance().Flush();
+					SceneSerializer::LoadScene(world, PLAY_CACHE_PATH);
 
 					// 3. システムの復旧 (重要)
 					// シーンファイルにシステム情報が含まれていない場合、描画などが止まってしまうためデフォルトを追加
@@ -316,6 +329,42 @@ namespace Arche
 		ImGui::End();
 	}
 
+	void Editor::SaveCurrentScene(World& world)
+	{
+		std::string path = SceneManager::Instance().GetCurrentScenePath();
+		if (path.empty()) path = "Resources/Game/Scenes/Untitled.json";
+
+		// 書き出しはワーカーで行う（失敗したら未保存に戻す）
+		SceneSaver::Instance().SaveAsync(world, path, [](bool succeeded) {
+			if (!succeeded) SceneManager::Instance().SetDirty(true);
+			});
+		SceneManager::Instance().SetDirty(false);
+		EditorPrefs::Instance().lastScenePath = path;
+		EditorPrefs::Instance().Save();
+	}
+
+	void Editor::UpdateAutosave(World& world, Context& ctx)
+	{
+		auto now = std::chrono::steady_clock::now();
+		const auto& prefs = EditorPrefs::Instance().autosave;
+
+		// 編集中のシーンだけ（プレイ中・プレファブ編集中は間隔に数えない）
+		if (!prefs.enabled || ctx.editorState != EditorState::Edit || m_editorMode != EditorMode::Scene)
+		{
+			m_lastAutosaveTime = now;
+			return;
+		}
+		if (std::chrono::duration<float>(now - m_lastAutosaveTime).count() < prefs.intervalSeconds) return;
+		m_lastAutosaveTime = now;
+
+		// 未保存の変更が無い、または前の保存がまだ書き出し中なら見送る
+		if (!SceneManager::Instance().IsDirty() || SceneSaver::Instance().IsSaving()) return;
+
+		std::string scenePath = SceneManager::Instance().GetCurrentScenePath();
+		std::string name = scenePath.empty() ? "Untitled" : std::filesystem::path(scenePath).stem().string();
+		SceneSaver::Instance().SaveAsync(world, AUTOSAVE_DIRECTORY + name + ".json", nullptr, SceneSaver::SaveKind::Internal);
+	}
+
 	void Editor::OpenPrefab(const std::string& path)
 	{
 		// 1. プレファブモードへ移行
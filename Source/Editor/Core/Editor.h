@@ -118,6 +118,11 @@ namespace Arche
 		Editor() = default;
 		~Editor() = default;
 
+		// 今のシーンを保存する（Ctrl + S・メニュー）
+		void SaveCurrentScene(World& world);
+		// EditorPrefs の設定に従って自動保存する
+		void UpdateAutosave(World& world, Context& ctx);
+
 		// シーン遷移・終了の保留管理
 		enum class PendingAction { None, LoadScene, CloseEngine };
 		PendingAction m_pendingAction = PendingAction::None;
@@ -139,6 +144,8 @@ namespace Arche
 		std::unique_ptr<World> m_prefabWorld;			// プレファブ編集用の一時ワールド
 		std::string m_currentPrefabPath;				// 編集中のパス
 		Entity m_prefabRoot = NullEntity;
+
+		std::chrono::steady_clock::time_point m_lastAutosaveTime;	// 最後に自動保存した（または数え直した）時刻
 	};
 }	// namespace Arche
 
@@ -17,6 +17,8 @@
 #include "Editor/Core/CommandHistory.h"
 #include "Engine/Scene/Core/ECS/ECS.h"
 #include "Engine/Scene/Serializer/SceneSerializer.h"
+#include "Engine/Scene/Serializer/SceneBinary.h"
+#include "Engine/Scene/Serializer/SceneEntityLoader.h"
 
 namespace Arche
 {
@@ -49,8 +51,10 @@ namespace Arche
 				m_parentOfTarget = reg.get<Relationship>(entity).parent;
 			}
 
-			// 2. 自分と全子孫を再帰的にバックアップ
-			CollectDescendants(reg, entity);
+			// 2. 自分と全子孫（親 -> 子の順）を、バイナリシーンの形式で持っておく
+			// （型ごとのフィールドを詰めて並べるだけなので、1万エンティティでも小さく速い）
+			SceneSerializer::CollectHierarchy(reg, entity, m_entities);
+			SaveBackup(reg);
 		}
 
 		void Execute() override
@@ -63,11 +67,9 @@ namespace Arche
 				RemoveChildFromParent(reg, m_parentOfTarget, m_targetEntity);
 			}
 
-			// 2. 収集した全エンティティを削除（リストは親->子の順なので、逆順(子->親)で消すと安全だがEnTTは順序不問）
-			// IDが無効になる前に全て削除
-			for (const auto& backup : m_backups)
+			// 2. 収集した全エンティティを削除
+			for (auto e : m_entities)
 			{
-				Entity e = (Entity)backup.originalID;
 				if (reg.valid(e))
 				{
 					reg.destroy(e);
@@ -79,60 +81,24 @@ namespace Arche
 		{
 			Registry& reg = m_world.getRegistry();
 
-			// 旧ID -> 新Entity の変換マップ
-			std::map<uint32_t, Entity> idMap;
-
-			// 1. 全エンティティを復元（コンポーネントデータ含む）
-			Entity newTargetEntity = NullEntity;
-
-			for (const auto& backup : m_backups)
+			// 1. 全エンティティを復元（親子関係は削除時のIDから新しいエンティティへ付け替わる）
+			// 削除されずに残っていた親はIDがそのまま
+			SceneBinary binary;
+			std::string error;
+			EntityIdRemap remap;
+			if (!binary.Parse(m_backup.data(), m_backup.size(), error) || !binary.Instantiate(reg, remap))
 			{
-				// 生成 & デシリアライズ
-				Entity newEntity = SceneSerializer::DeserializeEntityFromJson(reg, backup.data);
-
-				// マップに登録
-				idMap[backup.originalID] = newEntity;
-
-				// ターゲット（削除の起点となったエンティティ）の新しいIDを保持
-				if (backup.originalID == (uint32_t)m_targetEntity)
-				{
-					newTargetEntity = newEntity;
-				}
+				Logger::LogError("Failed to restore deleted entities: " + error);
+				return;
 			}
+			remap.ResolveRelationships(reg);
+			m_entities = remap.GetEntities();
+			if (m_entities.empty()) return;
 
-			// ターゲットのIDを更新（次回Redoのため）
-			m_targetEntity = newTargetEntity;
-
-			// 2. 親子関係のIDリンクを修復（IDリマッピング）
-			for (auto& [oldId, newEntity] : idMap)
-			{
-				if (!reg.has<Relationship>(newEntity)) continue;
-				auto& rel = reg.get<Relationship>(newEntity);
+			// 次回Redoのため、ターゲットのIDを更新
+			m_targetEntity = m_entities[0];
 
-				// Parentの書き換え
-				if (rel.parent != NullEntity)
-				{
-					uint32_t oldParentID = (uint32_t)rel.parent;
-					// 復元されたグループ内に親がいるならIDを書き換え
-					if (idMap.count(oldParentID))
-					{
-						rel.parent = idMap[oldParentID];
-					}
-					// 親が削除対象外（生き残っている親）なら、IDはそのまま
-				}
-
-				// Childrenの書き換え
-				for (auto& child : rel.children)
-				{
-					uint32_t oldChildID = (uint32_t)child;
-					if (idMap.count(oldChildID))
-					{
-						child = idMap[oldChildID];
-					}
-				}
-			}
-
-			// 3. 元の親（削除されずに残っていた親）に、復元したターゲットを再接続
+			// 2. 元の親（削除されずに残っていた親）に、復元したターゲットを再接続
 			if (m_parentOfTarget != NullEntity && reg.valid(m_parentOfTarget))
 			{
 				if (!reg.has<Relationship>(m_parentOfTarget))
@@ -151,38 +117,33 @@ namespace Arche
 			}
 		}
 
-	private:
-		// 再帰的に子孫を集める（親 -> 子 の順でリストに追加）
-		void CollectDescendants(Registry& reg, Entity root)
+		size_t GetMemorySize() const override
 		{
-			// 自分のバックアップ
-			json data;
-			SceneSerializer::SerializeEntityToJson(reg, root, data);
-			m_backups.push_back({ (uint32_t)root, data });
-
-			// 子がいれば再帰
-			if (reg.has<Relationship>(root))
-			{
-				for (auto child : reg.get<Relationship>(root).children)
-				{
-					CollectDescendants(reg, child);
-				}
-			}
+			return sizeof(*this) + m_backup.capacity() + m_entities.capacity() * sizeof(Entity);
 		}
 
 	private:
-		struct EntityBackupData
+		void SaveBackup(Registry& reg)
 		{
-			uint32_t originalID;	// 元のID
-			json data;				// シリアライズデータ
-		};
+			SceneBinary::Contents contents;
+			contents.entities = m_entities;
+			contents.ids.reserve(m_entities.size());
+			for (Entity e : m_entities) contents.ids.push_back((uint32_t)e);
+
+			SceneBinary::Write(reg, contents, m_backup);
+			m_backup.shrink_to_fit();
+		}
 
+	private:
 		World& m_world;
 		Entity m_targetEntity; // 削除対象（ルート）
 		Entity m_parentOfTarget; // 削除対象の親ID（Undo復帰用）
 
-		// 復元用データリスト
-		std::vector<EntityBackupData> m_backups;
+		// 今のシーン上のエンティティ（親 -> 子の順。Undo のたびに新しいIDになる）
+		std::vector<Entity> m_entities;
+
+		// 復元用データ（SceneBinary。IDは削除時のエンティティ）
+		std::vector<uint8_t> m_backup;
 	};
 
 	// エンティティ生成コマンド
@@ -321,12 +282,13 @@ namespace Arche
 		RemoveComponentCommand(World& world, Entity entity, const std::string& compName)
 			: m_world(world), m_entity(entity), m_componentName(compName)
 		{
-			// 削除前に現在の状態を保存
+			// 削除前に現在の状態を、コマンド専用のレジストリへ型のまま保存
 			Registry& reg = m_world.getRegistry();
 			auto& interfaces = ComponentRegistry::Instance().GetInterfaces();
 			if (interfaces.count(m_componentName))
 			{
-				interfaces.at(m_componentName).serialize(reg, m_entity, m_backup);
+				m_backupEntity = m_backup.create();
+				interfaces.at(m_componentName).clone(reg, m_entity, m_backup, m_backupEntity);
 			}
 		}
 
@@ -344,9 +306,9 @@ namespace Arche
 		{
 			Registry& reg = m_world.getRegistry();
 			auto& interfaces = ComponentRegistry::Instance().GetInterfaces();
-			if (interfaces.count(m_componentName))
+			if (interfaces.count(m_componentName) && m_backupEntity != NullEntity)
 			{
-				interfaces.at(m_componentName).deserialize(reg, m_entity, m_backup);
+				interfaces.at(m_componentName).clone(m_backup, m_backupEntity, reg, m_entity);
 			}
 		}
 
@@ -354,45 +316,270 @@ namespace Arche
 		World& m_world;
 		Entity m_entity;
 		std::string m_componentName;
-		json m_backup;
+		Registry m_backup;
+		Entity m_backupEntity = NullEntity;
 	};
 
 	// コンポーネント値変更コマンド
 	// ------------------------------------------------------------
+	// 受け取った変更前後のJSONから、変わったところだけを持つ
+	// ・メモリにそのまま置ける型 : コンポーネントのバイト列の、変わった範囲だけ
+	// ・それ以外                 : 変わったフィールドだけ（MessagePack）
+	// 同じ値への続けての変更は1つにまとめる（MergeWith）
 	class ChangeComponentValueCommand
 		: public ICommand
 	{
 	public:
+		// この時間内に続いた同じ値への変更は1つのUndoにまとめる
+		static constexpr double MERGE_WINDOW_SECONDS = 1.0;
+
 		ChangeComponentValueCommand(World& world, Entity entity, const std::string& compName, const json& oldVal, const json& newVal)
-			: m_world(world), m_entity(entity), m_componentName(compName), m_oldState(oldVal), m_newState(newVal) {}
+			: m_world(world), m_entity(entity), m_componentName(compName), m_time(std::chrono::steady_clock::now())
+		{
+			auto& interfaces = ComponentRegistry::Instance().GetInterfaces();
+			auto it = interfaces.find(m_componentName);
+			if (it == interfaces.end()) return;
+
+			if (!BuildByteDelta(it->second, oldVal, newVal))
+			{
+				BuildFieldDelta(oldVal, newVal);
+			}
+		}
 
 		void Execute() override
 		{
-			ApplyState(m_newState);
+			ApplyState(m_newBytes);
 		}
 
 		void Undo() override
 		{
-			ApplyState(m_oldState);
+			ApplyState(m_oldBytes);
+		}
+
+		size_t GetMemorySize() const override
+		{
+			return sizeof(*this) + m_componentName.capacity() + m_ranges.capacity() * sizeof(Range)
+				+ m_fields.capacity() * sizeof(std::string) + m_oldBytes.capacity() + m_newBytes.capacity();
+		}
+
+		bool MergeWith(const ICommand& next) override
+		{
+			auto* other = dynamic_cast<const ChangeComponentValueCommand*>(&next);
+			if (!other) return false;
+			if (&other->m_world != &m_world || other->m_entity != m_entity || other->m_componentName != m_componentName) return false;
+			if (other->m_isBinary != m_isBinary || other->m_time - m_time > std::chrono::duration<double>(MERGE_WINDOW_SECONDS)) return false;
+
+			// 同じところ（同じフィールド）への変更だけまとめる。変更前の値はこちらのものを残す
+			if (m_isBinary)
+			{
+				if (other->m_imageSize != m_imageSize || !IsSameFields(*other)) return false;
+				MergeRanges(*other);
+			}
+			else
+			{
+				if (other->m_fields != m_fields) return false;
+				m_newBytes = other->m_newBytes;
+			}
+
+			m_time = other->m_time;
+			return true;
 		}
 
 	private:
-		void ApplyState(const json& state)
+		// バイト列の変わった範囲（同じフィールドの中で、この幅より近い範囲はつなげる）
+		// フィールドをまたいではつなげない。間の変わっていないバイトを持つと、Undo でそこへの他の変更まで戻してしまう
+		static constexpr uint32_t RANGE_GAP = 8;
+
+		struct Range
+		{
+			uint32_t offset;
+			uint32_t length;
+		};
+
+		bool BuildByteDelta(const ComponentRegistry::Interface& iface, const json& oldVal, const json& newVal)
+		{
+			if (!iface.snapshot || !iface.clone) return false;
+
+			// 今の値を作業用に複製し、変更前・変更後をそれぞれ書き込んでバイト列を取る
+			// （JSON に無いフィールドは今の値のまま）
+			Registry& reg = m_world.getRegistry();
+			Registry scratch;
+			Entity e = scratch.create();
+			iface.clone(reg, m_entity, scratch, e);
+
+			std::vector<uint8_t> before, after;
+			iface.deserialize(scratch, e, oldVal);
+			if (!iface.snapshot(scratch, e, before)) return false;
+			iface.deserialize(scratch, e, newVal);
+			if (!iface.snapshot(scratch, e, after)) return false;
+
+			// バイトごとの持ち主（0: どのフィールドでもない（パディング・有効フラグ）、k + 1: k 番目のフィールド）
+			const size_t size = before.size();
+			std::vector<uint16_t> owner(size, 0);
+			for (size_t k = 0; k < iface.fields.size(); ++k)
+			{
+				const auto& field = iface.fields[k];
+				for (size_t b = field.offset; b < (size_t)field.offset + field.size && b < size; ++b) owner[b] = (uint16_t)(k + 1);
+			}
+
+			std::vector<bool> touched(iface.fields.size() + 1, false);
+			size_t i = 0;
+			while (i < size)
+			{
+				if (before[i] == after[i]) { ++i; continue; }
+
+				// 同じフィールドの中だけ、近い変更をつなげる
+				size_t begin = i;
+				size_t end = i + 1;
+				if (owner[begin] != 0)
+				{
+					for (size_t j = end; j < size && owner[j] == owner[begin] && j - end < RANGE_GAP; ++j)
+					{
+						if (before[j] != after[j]) end = j + 1;
+					}
+				}
+
+				m_ranges.push_back({ (uint32_t)begin, (uint32_t)(end - begin) });
+				m_oldBytes.insert(m_oldBytes.end(), before.begin() + begin, before.begin() + end);
+				m_newBytes.insert(m_newBytes.end(), after.begin() + begin, after.begin() + end);
+				for (size_t b = begin; b < end; ++b) touched[owner[b]] = true;
+				i = end;
+			}
+
+			// 変わったフィールドの名前（まとめるかどうかの判定に使う。フィールド以外の部分は空文字）
+			for (size_t k = 0; k < touched.size(); ++k)
+			{
+				if (touched[k]) m_fields.push_back(k == 0 ? std::string() : std::string(iface.fields[k - 1].name));
+			}
+
+			m_ranges.shrink_to_fit();
+			m_imageSize = (uint32_t)size;
+			m_isBinary = true;
+			return true;
+		}
+
+		// next が変えたフィールドがすべて、こちらも変えたフィールドか
+		// （値によって変わるバイトが違うので、範囲が完全に一致するとは限らない。フィールド単位で比べる）
+		bool IsSameFields(const ChangeComponentValueCommand& next) const
+		{
+			for (const auto& name : next.m_fields)
+			{
+				if (std::find(m_fields.begin(), m_fields.end(), name) == m_fields.end()) return false;
+			}
+			return true;
+		}
+
+		// 続けて行われた next の変更を合成する
+		// 変更前 : こちらにあればこちら、無ければ next のもの（そこはこちらが触っていないので同じ値）
+		// 変更後 : next にあれば next、無ければこちらのもの
+		void MergeRanges(const ChangeComponentValueCommand& next)
+		{
+			std::vector<uint8_t> before(m_imageSize), after(m_imageSize), mask(m_imageSize, 0);
+			auto Scatter = [&](const ChangeComponentValueCommand& cmd, bool overwriteBefore)
+				{
+					size_t cursor = 0;
+					for (const auto& range : cmd.m_ranges)
+					{
+						for (uint32_t i = 0; i < range.length; ++i)
+						{
+							size_t at = (size_t)range.offset + i;
+							if (overwriteBefore || !mask[at]) before[at] = cmd.m_oldBytes[cursor + i];
+							after[at] = cmd.m_newBytes[cursor + i];
+							mask[at] = 1;
+						}
+						cursor += range.length;
+					}
+				};
+			Scatter(*this, true);
+			Scatter(next, false);
+
+			m_ranges.clear();
+			m_oldBytes.clear();
+			m_newBytes.clear();
+			for (size_t i = 0; i < m_imageSize;)
+			{
+				if (!mask[i]) { ++i; continue; }
+				size_t begin = i;
+				while (i < m_imageSize && mask[i]) ++i;
+
+				m_ranges.push_back({ (uint32_t)begin, (uint32_t)(i - begin) });
+				m_oldBytes.insert(m_oldBytes.end(), before.begin() + begin, before.begin() + i);
+				m_newBytes.insert(m_newBytes.end(), after.begin() + begin, after.begin() + i);
+			}
+		}
+
+		void BuildFieldDelta(const json& oldVal, const json& newVal)
+		{
+			json oldDelta = oldVal;
+			json newDelta = newVal;
+
+			// 両方にあるフィールドのうち、値が同じものは持たない
+			if (oldVal.contains(m_componentName) && newVal.contains(m_componentName)
+				&& oldVal[m_componentName].is_object() && newVal[m_componentName].is_object())
+			{
+				const json& oldComp = oldVal[m_componentName];
+				const json& newComp = newVal[m_componentName];
+
+				json oldFields = json::object();
+				json newFields = json::object();
+				for (auto it = newComp.begin(); it != newComp.end(); ++it)
+				{
+					auto found = oldComp.find(it.key());
+					if (found != oldComp.end() && *found == it.value()) continue;
+
+					m_fields.push_back(it.key());
+					newFields[it.key()] = it.value();
+					if (found != oldComp.end()) oldFields[it.key()] = *found;
+				}
+
+				oldDelta = json{ { m_componentName, std::move(oldFields) } };
+				newDelta = json{ { m_componentName, std::move(newFields) } };
+			}
+
+			m_oldBytes = json::to_msgpack(oldDelta);
+			m_newBytes = json::to_msgpack(newDelta);
+		}
+
+		void ApplyState(const std::vector<uint8_t>& bytes)
 		{
 			Registry& reg = m_world.getRegistry();
 			auto& interfaces = ComponentRegistry::Instance().GetInterfaces();
-			if (interfaces.count(m_componentName))
+			auto it = interfaces.find(m_componentName);
+			if (it == interfaces.end() || bytes.empty()) return;
+			const auto& iface = it->second;
+
+			if (!m_isBinary)
+			{
+				iface.deserialize(reg, m_entity, json::from_msgpack(bytes));
+				return;
+			}
+
+			// 今の値に、変わった範囲だけを書き戻す（コンポーネントが無くなっていれば何もしない）
+			std::vector<uint8_t> image;
+			if (!iface.snapshot(reg, m_entity, image)) return;
+
+			const uint8_t* src = bytes.data();
+			for (const auto& range : m_ranges)
 			{
-				interfaces.at(m_componentName).deserialize(reg, m_entity, state);
+				if ((size_t)range.offset + range.length > image.size()) return;
+				memcpy(image.data() + range.offset, src, range.length);
+				src += range.length;
 			}
+			iface.restore(reg, m_entity, image.data(), image.size());
 		}
 
 	private:
 		World& m_world;
 		Entity m_entity;
 		std::string m_componentName;
-		json m_oldState;
-		json m_newState;
+		std::chrono::steady_clock::time_point m_time;
+
+		bool m_isBinary = false;
+		uint32_t m_imageSize = 0;			// バイト列の差分のとき、コンポーネント全体の大きさ
+		std::vector<Range> m_ranges;		// バイト列の差分のとき
+		std::vector<std::string> m_fields;	// 変わったフィールド名（バイト列の差分のときはフィールド以外の部分を空文字で表す）
+		std::vector<uint8_t> m_oldBytes;	// 変更前（範囲の順に連結 / MessagePack）
+		std::vector<uint8_t> m_newBytes;	// 変更後
 	};
 
 	// コンポーネント順序変更コマンド
@@ -32,6 +32,12 @@ namespace Arche
 			float pitch = 0.0f, yaw = 0.0f;
 		} camera;
 
+		// 自動保存（編集中のシーンに未保存の変更があれば、一定間隔でキャッシュへ書き出す）
+		struct AutosaveData {
+			bool enabled = true;
+			float intervalSeconds = 120.0f;
+		} autosave;
+
 		// --- 読み込み ---
 		void Load()
 		{
@@ -54,6 +60,12 @@ namespace Arche
 				camera.pitch = c.value("pitch", 0.0f);
 				camera.yaw = c.value("yaw", 0.0f);
 			}
+
+			if (j.contains("Autosave")) {
+				auto& a = j["Autosave"];
+				autosave.enabled = a.value("Enabled", true);
+				autosave.intervalSeconds = std::max(10.0f, a.value("IntervalSeconds", 120.0f));
+			}
 		}
 
 		// --- 保存 ---
@@ -69,6 +81,9 @@ namespace Arche
 			j["Camera"]["pitch"] = camera.pitch;
 			j["Camera"]["yaw"] = camera.yaw;
 
+			j["Autosave"]["Enabled"] = autosave.enabled;
+			j["Autosave"]["IntervalSeconds"] = autosave.intervalSeconds;
+
 			std::ofstream o("EditorConfig.json");
 			o << j.dump(4);
 		}
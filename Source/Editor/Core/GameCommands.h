@@ -51,9 +51,7 @@ namespace Arche
 			// reload_script: スクリプト（DLL）のリロード要求
 			Logger::RegisterCommand("reload_script", [](auto args) {
 				Logger::Log("Requesting Hot Reload...");
-				// 現在の状態を保存
-				Application::Instance().SaveState();
-				// ループを抜けて再起動（main側でハンドリングされている前提）
+				// ループを抜けて再起動（状態の保存も main側でハンドリングされている前提）
 				Application::Instance().RequestReload();
 				});
 
@@ -17,6 +17,7 @@
 #include "Editor/Core/Editor.h"
 #include "Engine/Scene/Animation/AnimatorController.h"
 #include "Engine/Scene/Serializer/AnimatorControllerSerializer.h"
+#include "Engine/Resource/ResourceManager.h"
 
 namespace Arche
 {
@@ -111,7 +112,11 @@ namespace Arche
 				if (m_controller)
 				{
 					if (AnimatorControllerSerializer::Serialize(m_currentPath, m_controller))
+					{
 						Logger::Log("Saved: " + m_currentPath);
+						// 共有キャッシュを作り直し、再生中の Animator にも反映する
+						ResourceManager::Instance().ReloadAnimatorController(m_currentPath);
+					}
 					else
 						Logger::LogError("Failed to save: " + m_currentPath);
 				}
@@ -16,6 +16,9 @@
 #include "Engine/pch.h"
 #include "Editor/Core/Editor.h"
 #include "Editor/Core/EditorPrefs.h"
+#include "Engine/Resource/AssetArchive.h"
+#include "Engine/Resource/AssetCooker.h"
+#include "Engine/Renderer/Data/CookedMesh.h"
 
 namespace Arche
 {
@@ -65,10 +68,14 @@ namespace Arche
 			}
 			ImGui::TextDisabled("(Drag & Drop Scene file here)");
 
+			// 3. リソースのパック
+			ImGui::Checkbox("Compress Archive", &m_compressArchive);
+			if (ImGui::IsItemHovered()) ImGui::SetTooltip("Compress resources in %s (already compressed formats are stored as is)", Config::RESOURCE_ARCHIVE);
+
 			ImGui::Dummy(ImVec2(0, 20));
 			ImGui::Separator();
 
-			// 3. ビルド実行
+			// 4. ビルド実行
 			if (ImGui::Button("Build & Export", ImVec2(-1, 50)))
 			{
 				PerformBuild();
@@ -87,9 +94,23 @@ namespace Arche
 		char m_gameName[64] = "MyGame";
 		char m_startScenePath[256] = "Resources/Game/Scenes/GameScene.json";
 
+		bool m_compressArchive = true;
+
 		std::string m_statusMessage;
 		ImVec4 m_statusColor = { 1,1,1,1 };
 
+		// パックに入れず、そのままコピーするファイル（ランタイムがパスを直接開くもの）
+		static bool IsLooseResource(const std::string& ext)
+		{
+			return ext == ".hlsl" || ext == ".hlsli" || ext == ".ttf" || ext == ".otf" || ext == ".ttc";
+		}
+
+		// 配布しないもの（エディタ専用・キャッシュ・書き出し途中のファイル）
+		static bool IsExcludedResource(const std::string& path, const std::string& ext)
+		{
+			return path.rfind("Resources/Editor/", 0) == 0 || path.find("/Cache/") != std::string::npos || ext == ".tmp";
+		}
+
 		// ビルド実行処理
 		void PerformBuild()
 		{
@@ -142,11 +163,54 @@ namespace Arche
 					}
 				}
 
-				// C. リソースコピー
+				// C. リソース
+				// クック済みファイルを最新にしてから、1つのパックにまとめる
+				CookReport cookReport = AssetCooker(CookSettings()).Run();
+				if (cookReport.failed > 0) Logger::LogWarning("Cook failed for " + std::to_string(cookReport.failed) + " assets. Sources are packed instead.");
+
 				fs::path resSrc = projectRoot / "Resources";
 				fs::path resDst = buildDir / "Resources";
 				if (fs::exists(resDst)) fs::remove_all(resDst);
-				fs::copy(resSrc, resDst, fs::copy_options::recursive);
+
+				AssetArchiveWriter writer;
+				size_t looseCount = 0;
+				for (const auto& item : fs::recursive_directory_iterator(resSrc))
+				{
+					if (!item.is_regular_file()) continue;
+
+					// パック内のパスは実行時に開くパスと同じ "Resources/..." の形にする
+					fs::path relative = fs::relative(item.path(), projectRoot);
+					std::string archivePath = relative.generic_string();
+					std::string ext = item.path().extension().string();
+					std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+					if (IsExcludedResource(archivePath, ext)) continue;
+
+					if (IsLooseResource(ext))
+					{
+						fs::create_directories((buildDir / relative).parent_path());
+						fs::copy_file(item.path(), buildDir / relative, fs::copy_options::overwrite_existing);
+						looseCount++;
+						continue;
+					}
+
+					// クック済みモデルがあれば元のモデルは入れない（実行時はクック済みの方しか読まない）
+					std::string sourcePath = item.path().string();
+					if (CookedMesh::IsUpToDate(CookedMesh::GetCookedPath(sourcePath), sourcePath)) continue;
+
+					writer.AddFile(archivePath, sourcePath, m_compressArchive);
+				}
+
+				AssetArchiveWriter::Report packReport;
+				bool packed = writer.Write((buildDir / Config::RESOURCE_ARCHIVE).string(), packReport);
+				for (const auto& error : packReport.errors) Logger::LogWarning(error);
+				if (!packed) throw std::runtime_error("Failed to write " + std::string(Config::RESOURCE_ARCHIVE));
+
+				char packInfo[256];
+				snprintf(packInfo, sizeof(packInfo), "Packed %d files (%d compressed): %.2f MB -> %.2f MB, %d loose files",
+					(int)packReport.fileCount, (int)packReport.compressedCount,
+					(double)packReport.sourceBytes / (1024.0 * 1024.0), (double)packReport.archiveBytes / (1024.0 * 1024.0), (int)looseCount);
+				Logger::Log(packInfo);
 
 				// D. 設定ファイル生成
 				json config;
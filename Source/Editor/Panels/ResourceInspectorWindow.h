@@ -15,6 +15,7 @@
 // ===== インクルード =====
 #include "Editor/Core/Editor.h"
 #include "Engine/Resource/ResourceManager.h"
+#include "Engine/Scene/Animation/AnimatorController.h"
 
 namespace Arche
 {
@@ -32,6 +33,8 @@ namespace Arche
 
 			ImGui::Begin(m_windowName.c_str(), &m_isOpen);
 
+			DrawMemorySummary();
+
 			if (ImGui::BeginTabBar("ResourceTabs"))
 			{
 				// --- Texture Tab ---
@@ -55,6 +58,13 @@ namespace Arche
 					ImGui::EndTabItem();
 				}
 
+				// --- AnimatorController Tab ---
+				if (ImGui::BeginTabItem("Controllers"))
+				{
+					DrawControllerList();
+					ImGui::EndTabItem();
+				}
+
 				ImGui::EndTabBar();
 			}
 
@@ -62,9 +72,96 @@ namespace Arche
 		}
 
 	private:
+		static float ToMegabytes(uint64_t bytes) { return (float)((double)bytes / (1024.0 * 1024.0)); }
+
+		// キー → エントリ情報（サイズ・参照数）
+		static std::unordered_map<std::string, ResourceEntryInfo> GetEntryInfoMap(ResourceCategory category)
+		{
+			std::unordered_map<std::string, ResourceEntryInfo> result;
+			for (auto& info : ResourceManager::Instance().GetEntryInfos(category)) result.emplace(info.key, std::move(info));
+			return result;
+		}
+
+		static void DrawEntryMemory(const std::unordered_map<std::string, ResourceEntryInfo>& infos, const std::string& key)
+		{
+			auto it = infos.find(key);
+			if (it == infos.end()) return;
+			const ResourceEntryInfo& info = it->second;
+			// 参照数はこのウィンドウが持っているスナップショット分を除く
+			ImGui::TextDisabled("%.2f MB (CPU %.2f / GPU %.2f), %u handles, %ld refs",
+				ToMegabytes(info.memory.GetTotal()), ToMegabytes(info.memory.cpuBytes), ToMegabytes(info.memory.gpuBytes),
+				info.handleCount, std::max(info.sharedCount - 1, 0L));
+		}
+
+		// カテゴリごとの使用量と予算
+		void DrawMemorySummary()
+		{
+			if (!ImGui::CollapsingHeader("Memory Budgets", ImGuiTreeNodeFlags_DefaultOpen)) return;
+
+			auto& rm = ResourceManager::Instance();
+			if (ImGui::BeginTable("MemoryTable", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable))
+			{
+				ImGui::TableSetupColumn("Category");
+				ImGui::TableSetupColumn("Assets");
+				ImGui::TableSetupColumn("CPU (MB)");
+				ImGui::TableSetupColumn("GPU (MB)");
+				ImGui::TableSetupColumn("Usage");
+				ImGui::TableSetupColumn("Budget (MB)");
+				ImGui::TableSetupColumn("Evicted");
+				ImGui::TableHeadersRow();
+
+				for (size_t i = 0; i < (size_t)ResourceCategory::Count; ++i)
+				{
+					ResourceCategory category = (ResourceCategory)i;
+					ResourceStats stats = rm.GetStats(category);
+					uint64_t total = stats.usage.memory.GetTotal();
+
+					ImGui::TableNextRow();
+					ImGui::TableSetColumnIndex(0);
+					ImGui::Text("%s", GetResourceCategoryName(category));
+
+					ImGui::TableSetColumnIndex(1);
+					ImGui::Text("%d", (int)stats.usage.count);
+					if (ImGui::IsItemHovered()) ImGui::SetTooltip("Referenced: %d\nPinned: %d", (int)stats.usage.referenced, (int)stats.pinned);
+
+					ImGui::TableSetColumnIndex(2);
+					ImGui::Text("%.2f", ToMegabytes(stats.usage.memory.cpuBytes));
+					ImGui::TableSetColumnIndex(3);
+					ImGui::Text("%.2f", ToMegabytes(stats.usage.memory.gpuBytes));
+
+					ImGui::TableSetColumnIndex(4);
+					if (stats.budget > 0)
+					{
+						float ratio = (float)((double)total / (double)stats.budget);
+						char overlay[32];
+						snprintf(overlay, sizeof(overlay), "%.0f%%", ratio * 100.0f);
+						ImGui::ProgressBar(std::min(ratio, 1.0f), ImVec2(-1, 0), overlay);
+					}
+					else
+					{
+						ImGui::TextDisabled("Unlimited");
+					}
+
+					// 予算の変更（0で無制限）
+					ImGui::TableSetColumnIndex(5);
+					float budgetMb = ToMegabytes(stats.budget);
+					ImGui::SetNextItemWidth(-1);
+					if (ImGui::DragFloat(("##Budget" + std::to_string(i)).c_str(), &budgetMb, 4.0f, 0.0f, 16384.0f, "%.0f"))
+					{
+						rm.SetBudget(category, (uint64_t)((double)budgetMb * 1024.0 * 1024.0));
+					}
+
+					ImGui::TableSetColumnIndex(6);
+					ImGui::Text("%d (%.2f MB)", (int)stats.evictedCount, ToMegabytes(stats.evictedMemory.GetTotal()));
+				}
+				ImGui::EndTable();
+			}
+		}
+
 		void DrawTextureList()
 		{
-			auto& textures = ResourceManager::Instance().GetTextureMap();
+			auto textures = ResourceManager::Instance().GetTextureMap();
+			auto infos = GetEntryInfoMap(ResourceCategory::Texture);
 
 			// 検索フィルタ
 			static char filterBuf[64] = "";
@@ -110,6 +207,7 @@ namespace Arche
 					// 3. Info
 					ImGui::TableSetColumnIndex(2);
 					if (tex) ImGui::Text("%dx%d", tex->width, tex->height);
+					DrawEntryMemory(infos, key);
 
 					// 4. Actions
 					ImGui::TableSetColumnIndex(3);
@@ -124,7 +222,8 @@ namespace Arche
 
 		void DrawModelList()
 		{
-			auto& models = ResourceManager::Instance().GetModelMap();
+			auto models = ResourceManager::Instance().GetModelMap();
+			auto infos = GetEntryInfoMap(ResourceCategory::Model);
 
 			ImGui::BeginChild("ModelList");
 			for (auto& [key, model] : models)
@@ -134,6 +233,8 @@ namespace Arche
 				{
 					ImGui::SameLine();
 					ImGui::TextDisabled("(%d meshes)", (int)model->GetMeshes().size());
+					ImGui::SameLine();
+					DrawEntryMemory(infos, key);
 				}
 			}
 			ImGui::EndChild();
@@ -141,7 +242,8 @@ namespace Arche
 
 		void DrawSoundList()
 		{
-			auto& sounds = ResourceManager::Instance().GetSoundMap();
+			auto sounds = ResourceManager::Instance().GetSoundMap();
+			auto infos = GetEntryInfoMap(ResourceCategory::Sound);
 
 			ImGui::BeginChild("SoundList");
 			for (auto& [key, sound] : sounds)
@@ -151,6 +253,8 @@ namespace Arche
 				{
 					ImGui::SameLine();
 					ImGui::TextDisabled("(%.2f sec)", sound->duration);
+					ImGui::SameLine();
+					DrawEntryMemory(infos, key);
 
 					ImGui::SameLine();
 					if (ImGui::SmallButton(("Play##" + key).c_str()))
@@ -162,6 +266,29 @@ namespace Arche
 			}
 			ImGui::EndChild();
 		}
+
+		void DrawControllerList()
+		{
+			auto controllers = ResourceManager::Instance().GetAnimatorControllerMap();
+
+			ImGui::BeginChild("ControllerList");
+			for (auto& [key, controller] : controllers)
+			{
+				ImGui::Text("Controller: %s", key.c_str());
+				ImGui::SameLine();
+				if (controller)
+				{
+					// キャッシュ本体とこのスナップショットを除いた参照数
+					ImGui::TextDisabled("(%d states, %d params, %d users)",
+						(int)controller->states.size(), (int)controller->program.GetParameterCount(), (int)controller.use_count() - 2);
+				}
+				else
+				{
+					ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "(Load Failed)");
+				}
+			}
+			ImGui::EndChild();
+		}
 	};
 
 }	// namespace Arche
@@ -19,6 +19,7 @@
 #include "Editor/Core/Editor.h"
 #include "Engine/Core/Time/Time.h"
 #include "Engine/Scene/Serializer/SystemRegistry.h"
+#include "Engine/Scene/Animation/AnimationLod.h"
 
 namespace Arche
 {
@@ -44,6 +45,9 @@ namespace Arche
 			ImGui::SameLine();
 			ImGui::Text("| Total Logic Time: %.3f ms", totalTime);
 
+			// アニメーションLODの内訳
+			DrawAnimationLodStats();
+
 			ImGui::Separator();
 
 			// 検索バー
@@ -105,6 +109,21 @@ namespace Arche
 	private:
 		std::string m_systemToRemove;
 
+		void DrawAnimationLodStats()
+		{
+			const auto& stats = AnimationLodStats::Instance();
+			if (stats.evaluated + stats.held == 0) return;
+
+			ImGui::Text("Animation LOD:");
+			for (int i = 0; i < (int)AnimationLodLevel::Count; ++i)
+			{
+				ImGui::SameLine();
+				ImGui::Text("%s %d", AnimationLod::GetLevelName((AnimationLodLevel)i), stats.levelCounts[i]);
+			}
+			ImGui::SameLine();
+			ImGui::TextDisabled("| Evaluated %d / Held %d", stats.evaluated, stats.held);
+		}
+
 		bool IsEngineSystem(const std::string& name)
 		{
 			static const std::vector<std::string> engineSys = {
@@ -21,10 +21,40 @@
 #include "Engine/pch.h"
 #include "Engine/Audio/AudioManager.h"
 #include "Engine/Resource/ResourceManager.h"
+#include "Engine/Resource/VirtualFileSystem.h"
 #include "Engine/Core/Time/Time.h"
+#include "Engine/Core/Base/Logger.h"
 
 namespace Arche
 {
+	namespace
+	{
+		// SoundStream のブロックを XAudio2 のソースボイスへ渡す
+		class XAudio2StreamSink : public AudioStreamSink
+		{
+		public:
+			explicit XAudio2StreamSink(IXAudio2SourceVoice* voice) : m_voice(voice) {}
+
+			bool SubmitBuffer(const uint8_t* data, uint32_t size, bool endOfStream) override
+			{
+				XAUDIO2_BUFFER buffer = { 0 };
+				buffer.pAudioData = data;
+				buffer.AudioBytes = size;
+				buffer.Flags = endOfStream ? XAUDIO2_END_OF_STREAM : 0;
+				return SUCCEEDED(m_voice->SubmitSourceBuffer(&buffer));
+			}
+
+			uint32_t GetQueuedBufferCount() const override
+			{
+				XAUDIO2_VOICE_STATE state;
+				m_voice->GetState(&state, XAUDIO2_VOICE_NOSAMPLESPLAYED);
+				return state.BuffersQueued;
+			}
+
+		private:
+			IXAudio2SourceVoice* m_voice;
+		};
+	}
 
 	void AudioManager::Initialize()
 	{
@@ -76,6 +106,13 @@ namespace Arche
 			}
 		}
 
+		// BGMのストリーミング（再生し終わったブロックを読み直して渡す）
+		if (m_bgmStream)
+		{
+			m_bgmStream->Pump(*m_bgmSink);
+			if (m_bgmStream->IsFinished()) StopBGM();
+		}
+
 		// 再生が終了したSEボイスを検出し、破棄する
 		{
 			auto it = m_seVoices.begin();
@@ -97,10 +134,7 @@ namespace Arche
 
 	void AudioManager::Finalize()
 	{
-		if (m_currentBgmVoice) {
-			m_currentBgmVoice->DestroyVoice();
-			m_currentBgmVoice = nullptr;
-		}
+		StopBGM();
 		for (auto& v : m_seVoices) {
 			v.voice->DestroyVoice();
 		}
@@ -163,29 +197,38 @@ namespace Arche
 	{
 		// 既に再生中なら止める
 		StopBGM();
+		if (!m_xAudio2) return;
 
-		// データ取得 (ResourceManager経由)
-		auto sound = ResourceManager::Instance().GetSound(key);
-		if (!sound) return;
+		// 全体を読み込まないよう、ResourceManager にはパスの解決だけ頼む
+		std::string path = ResourceManager::Instance().ResolvePath(ResourceCategory::Sound, key);
+		auto stream = std::make_unique<SoundStream>();
+		if (path.empty() || !stream->Open(path, VirtualFileSystem::Instance().OpenStream(path), loop))
+		{
+			Logger::LogWarning("Failed to open BGM: " + key);
+			return;
+		}
 
-		// 仮の実装：ResourceManager連携前のためコメントアウト
+		// fmt チャンク（WAVEFORMATEX より短い PCM 用の形式もある）
+		WAVEFORMATEX wfx = { 0 };
+		const auto& format = stream->GetFormat();
+		memcpy(&wfx, format.data(), std::min(format.size(), sizeof(WAVEFORMATEX)));
 
 		// BGMサブミックスへ出力
 		XAUDIO2_SEND_DESCRIPTOR send = { 0, m_bgmSubmix };
 		XAUDIO2_VOICE_SENDS sendList = { 1, &send };
 
-		HRESULT hr = m_xAudio2->CreateSourceVoice(&m_currentBgmVoice, &sound->wfx, 0, XAUDIO2_DEFAULT_FREQ_RATIO, nullptr, &sendList);
-		if (FAILED(hr)) return;
+		HRESULT hr = m_xAudio2->CreateSourceVoice(&m_currentBgmVoice, &wfx, 0, XAUDIO2_DEFAULT_FREQ_RATIO, nullptr, &sendList);
+		if (FAILED(hr)) {
+			m_currentBgmVoice = nullptr;
+			return;
+		}
 
 		m_currentBgmVoice->SetVolume(volume);
 
-		// ループ設定
-		XAUDIO2_BUFFER buffer = sound->xBuffer;
-		if (loop) {
-			buffer.LoopCount = XAUDIO2_LOOP_INFINITE;
-		}
-
-		m_currentBgmVoice->SubmitSourceBuffer(&buffer);
+		// ループは SoundStream 側で先頭に戻って読み続ける
+		m_bgmStream = std::move(stream);
+		m_bgmSink = std::make_unique<XAudio2StreamSink>(m_currentBgmVoice);
+		m_bgmStream->Pump(*m_bgmSink);	// 読めていれば最初のブロックを渡しておく
 		m_currentBgmVoice->Start(0);
 	}
 
@@ -194,9 +237,12 @@ namespace Arche
 		if (m_currentBgmVoice) {
 			m_currentBgmVoice->Stop();
 			m_currentBgmVoice->FlushSourceBuffers();
+			// DestroyVoice はボイスがバッファを手放すまで待つので、ストリームはその後に閉じる
 			m_currentBgmVoice->DestroyVoice();
 			m_currentBgmVoice = nullptr;
 		}
+		m_bgmSink.reset();
+		m_bgmStream.reset();
 	}
 
 	void AudioManager::SetMasterVolume(float volume)
@@ -238,6 +284,10 @@ namespace Arche
 		// BGM再生状況
 		if (m_currentBgmVoice) {
 			ImGui::TextColored(ImVec4(0, 1, 0, 1), "BGM Playing");
+			if (m_bgmStream) {
+				ImGui::Text("Streaming: %s (%.1f s)", m_bgmStream->GetPath().c_str(), m_bgmStream->GetDuration());
+				ImGui::Text("Buffer: %llu KB / Underruns: %u", m_bgmStream->GetMemoryUsage() / 1024, m_bgmStream->GetUnderrunCount());
+			}
 			if (ImGui::Button("Stop BGM")) StopBGM(0.5f);
 		}
 		else {
@@ -25,6 +25,7 @@
 // ===== インクルード =====
 #include "Engine/pch.h"
 #include "Engine/Audio/Sound.h"
+#include "Engine/Audio/SoundStream.h"
 #include "Engine/Core/Base/StringId.h"
 
 namespace Arche
@@ -61,6 +62,7 @@ namespace Arche
 		void Play3DSE(std::string& key, const XMFLOAT3& emitterPos, const XMFLOAT3& listenerPos, float range, float volume);
 
 		// BGM再生 (ループ再生、BGMは同時に1つだけ)
+		// 曲全体は読み込まず SoundStream で少しずつ流す（ResourceManager のキャッシュにも載らない）
 		void PlayBGM(std::string& key, float volume = 1.0f, bool loop = true);
 		void StopBGM(float fadeOutSeconds = 0.0f);
 
@@ -86,6 +88,8 @@ namespace Arche
 
 		// 現在再生中のBGM
 		IXAudio2SourceVoice* m_currentBgmVoice = nullptr;
+		std::unique_ptr<SoundStream> m_bgmStream;
+		std::unique_ptr<AudioStreamSink> m_bgmSink;	// m_currentBgmVoice へ渡す
 
 		// 再生中のSEリスト (終わったら解放するため保持)
 		struct VoiceData {
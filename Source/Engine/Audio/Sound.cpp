@@ -1,54 +1,28 @@
 ﻿#include "Engine/pch.h"
 #include "Engine/Audio/Sound.h"
+#include "Engine/Audio/WaveFile.h"
 #include "Engine/Core/Base/Logger.h"
+#include "Engine/Resource/VirtualFileSystem.h"
 
 namespace Arche
 {
-	// WAVファイルパース用構造体
-	struct RIFF_HEADER { char chunkId[4]; unsigned int chunkSize; char format[4]; };
-	struct CHUNK_HEADER { char chunkId[4]; unsigned int chunkSize; };
-
 	bool Sound::LoadCPU(const std::string& path)
 	{
 		this->filepath = path;
-		std::ifstream file(path, std::ios::binary);
-		if (!file.is_open()) return false;
-
-		RIFF_HEADER riff;
-		file.read((char*)&riff, sizeof(RIFF_HEADER));
-
-		if (strncmp(riff.chunkId, "RIFF", 4) != 0 || strncmp(riff.format, "WAVE", 4) != 0) {
-			return false;
-		}
+		FileView file;
+		if (!VirtualFileSystem::Instance().Open(path, file)) return false;
 
-		// チャンク探索
-		while (true)
-		{
-			CHUNK_HEADER chunk;
-			file.read((char*)&chunk, sizeof(CHUNK_HEADER));
-			if (file.eof()) break;
+		MemoryStreamReader reader(file.GetData(), file.GetSize());
+		WaveFile::Chunks chunks;
+		if (!WaveFile::FindChunks(reader, chunks)) return false;
 
-			// fmt チャンク
-			if (strncmp(chunk.chunkId, "fmt ", 4) == 0)
-			{
-				file.read((char*)&wfx, sizeof(WAVEFORMATEX));
-				int skip = chunk.chunkSize - sizeof(WAVEFORMATEX);
-				if (skip > 0) file.seekg(skip, std::ios::cur);
-			}
-			// data チャンク
-			else if (strncmp(chunk.chunkId, "data", 4) == 0)
-			{
-				buffer.resize(chunk.chunkSize);
-				file.read((char*)buffer.data(), chunk.chunkSize);
+		// fmt チャンク（WAVEFORMATEX より短い PCM 用の形式もある）
+		wfx = {};
+		memcpy(&wfx, file.GetData() + chunks.formatOffset, std::min<size_t>(chunks.formatSize, sizeof(WAVEFORMATEX)));
 
-				// ここではバッファに読むだけ
-				break;
-			}
-			else
-			{
-				file.seekg(chunk.chunkSize, std::ios::cur);
-			}
-		}
+		// data チャンク（ここではバッファに読むだけ）
+		const uint8_t* body = file.GetData() + chunks.dataOffset;
+		buffer.assign(body, body + chunks.dataSize);
 		return true;
 	}
 
@@ -22,6 +22,7 @@
 
 // ===== インクルード =====
 #include "Engine/pch.h"
+#include "Engine/Resource/ResourceHandle.h"
 
 namespace Arche
 {
@@ -44,6 +45,9 @@ namespace Arche
 
 		// 2. 初期化
 		void Initialize();
+
+		// ResourceManager の予算計算用（波形はCPUメモリのまま XAudio2 に渡す）
+		ResourceMemory GetMemoryUsage() const { return { (uint64_t)buffer.capacity(), 0 }; }
 	};
 
 }	// namespace Arche
@@ -0,0 +1,205 @@
+﻿/*****************************************************************//**
+ * @file	SoundStream.cpp
+ * @brief	長いBGM向けのストリーミング再生
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+// pch.h は含めない（Tests/ からもビルドする。vcxproj でもプリコンパイル済みヘッダーを使わない）
+#include "Engine/Audio/SoundStream.h"
+#include "Engine/Audio/WaveFile.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Arche
+{
+	namespace
+	{
+		// fmt チャンク内の位置（WAVEFORMATEX と同じ並び）
+		constexpr size_t FORMAT_AVG_BYTES_PER_SEC = 8;
+		constexpr size_t FORMAT_BLOCK_ALIGN = 12;
+
+		template<typename T>
+		T ReadFormatField(const std::vector<uint8_t>& format, size_t offset)
+		{
+			T value = 0;
+			if (offset + sizeof(T) <= format.size()) std::memcpy(&value, format.data() + offset, sizeof(T));
+			return value;
+		}
+	}
+
+	bool SoundStream::Open(const std::string& path, std::unique_ptr<StreamReader> reader, bool loop)
+	{
+		Close();
+		if (!reader) return false;
+
+		WaveFile::Chunks chunks;
+		if (!WaveFile::FindChunks(*reader, chunks) || chunks.dataSize == 0) return false;
+
+		m_format.resize(chunks.formatSize);
+		if (!reader->Read(chunks.formatOffset, m_format.data(), m_format.size()))
+		{
+			m_format.clear();
+			return false;
+		}
+
+		// サンプルの途中で切れないよう、ブロックサイズは blockAlign の倍数にする
+		uint16_t blockAlign = std::max<uint16_t>(1, ReadFormatField<uint16_t>(m_format, FORMAT_BLOCK_ALIGN));
+		m_blockSize = std::max<uint32_t>(blockAlign, BLOCK_SIZE - BLOCK_SIZE % blockAlign);
+
+		m_path = path;
+		m_reader = std::move(reader);
+		m_dataOffset = chunks.dataOffset;
+		m_dataSize = chunks.dataSize;
+		m_loop = loop;
+
+		for (auto& block : m_blocks)
+		{
+			block.data.resize(m_blockSize);
+			block.size = 0;
+			block.last = false;
+		}
+		m_fillIndex = 0;
+		m_readPosition = 0;
+		m_readFailed = false;
+		m_submitIndex = 0;
+		m_filledCount = 0;
+		m_queuedCount = 0;
+		m_endRead = false;
+		m_stop = false;
+		m_endSubmitted = false;
+		m_started = false;
+		m_starved = false;
+		m_finished = false;
+		m_underrunCount = 0;
+
+		m_thread = std::thread(&SoundStream::IoThreadMain, this);
+		return true;
+	}
+
+	void SoundStream::Close()
+	{
+		if (m_thread.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_stop = true;
+			}
+			m_cv.notify_all();
+			m_thread.join();
+		}
+
+		m_reader.reset();
+		for (auto& block : m_blocks)
+		{
+			block.data.clear();
+			block.data.shrink_to_fit();
+		}
+		m_format.clear();
+		m_path.clear();
+	}
+
+	void SoundStream::Pump(AudioStreamSink& sink)
+	{
+		if (!IsOpen() || m_finished) return;
+
+		uint32_t queued = sink.GetQueuedBufferCount();
+		bool released = false;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			// 再生し終わったブロックを返す（提出順に終わる）
+			if (queued < m_queuedCount)
+			{
+				m_queuedCount = queued;
+				released = true;
+			}
+
+			// 鳴らすものが尽きた瞬間だけ数える
+			bool starved = m_started && m_queuedCount == 0 && m_filledCount == 0 && !m_endSubmitted;
+			if (starved && !m_starved) m_underrunCount++;
+			m_starved = starved;
+
+			while (m_filledCount > 0)
+			{
+				Block& block = m_blocks[m_submitIndex];
+				// 読み込みに失敗して空のまま終わったブロックは渡さない（終わりの印だけ付ける）
+				const bool empty = block.size == 0;
+				if (!empty && !sink.SubmitBuffer(block.data.data(), block.size, block.last)) break;
+
+				if (block.last) m_endSubmitted = true;
+				m_submitIndex = (m_submitIndex + 1) % BUFFER_COUNT;
+				m_filledCount--;
+				if (!empty) m_queuedCount++;
+				m_started = true;
+			}
+
+			m_finished = m_endSubmitted && m_queuedCount == 0;
+		}
+		if (released) m_cv.notify_one();
+	}
+
+	float SoundStream::GetDuration() const
+	{
+		uint32_t bytesPerSec = ReadFormatField<uint32_t>(m_format, FORMAT_AVG_BYTES_PER_SEC);
+		return bytesPerSec > 0 ? (float)m_dataSize / bytesPerSec : 0.0f;
+	}
+
+	void SoundStream::IoThreadMain()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (true)
+		{
+			m_cv.wait(lock, [this] { return m_stop || (!m_endRead && m_filledCount + m_queuedCount < BUFFER_COUNT); });
+			if (m_stop) return;
+
+			// 空いているブロックはメインスレッドが触らないので、読み込み中はロックを外す
+			Block& block = m_blocks[m_fillIndex];
+			lock.unlock();
+			FillBlock(block);
+			lock.lock();
+
+			m_fillIndex = (m_fillIndex + 1) % BUFFER_COUNT;
+			m_filledCount++;
+			if (block.last) m_endRead = true;
+		}
+	}
+
+	void SoundStream::FillBlock(Block& block)
+	{
+		// 1回に読むのはブロックの空き分だけ（ディスクからの読み出しはこのスレッドで起きる）
+		block.size = 0;
+		block.last = false;
+
+		while (block.size < m_blockSize)
+		{
+			uint64_t remaining = m_dataSize - m_readPosition;
+			uint32_t count = (uint32_t)std::min<uint64_t>(remaining, m_blockSize - block.size);
+			if (m_readFailed || !m_reader->Read(m_dataOffset + m_readPosition, block.data.data() + block.size, count))
+			{
+				// 読めなくなったら（ファイルが消された等）読めた所までで終わりにする
+				m_readFailed = true;
+				block.last = true;
+				break;
+			}
+			block.size += count;
+			m_readPosition += count;
+
+			if (m_readPosition < m_dataSize) continue;
+
+			// 末尾まで来たら、ループなら先頭から続けて詰める（つなぎ目で途切れない）
+			if (!m_loop)
+			{
+				block.last = true;
+				break;
+			}
+			m_readPosition = 0;
+		}
+	}
+
+}	// namespace Arche
@@ -0,0 +1,168 @@
+﻿/*****************************************************************//**
+ * @file	SoundStream.h
+ * @brief	長いBGM向けのストリーミング再生
+ *
+ * @details	WAV の data チャンクを一括で読まず、I/Oスレッドが StreamReader から BLOCK_SIZE ずつ
+ *			BUFFER_COUNT 個のリングバッファへ読み込む（ファイル全体をマップしない）。
+ *			メインスレッドは毎フレーム Pump を呼び、読み終わったブロックを再生先 (AudioStreamSink) へ渡し、
+ *			再生し終わったブロックをI/Oスレッドへ返す。
+ *			曲の長さに関係なく、常駐するのは BUFFER_COUNT * BLOCK_SIZE だけ。
+ *
+ *			読み込み元と再生先はどちらも XAudio2・ファイルシステムに依存しないインターフェースなので、
+ *			MemoryStreamReader と NullAudioSink を使えば音声デバイス無しでも動かせる（Tests/SoundStreamTest）。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___SOUND_STREAM_H___
+#define ___SOUND_STREAM_H___
+
+// ===== インクルード =====
+// 標準ライブラリだけで書く（pch.h を含めず、Tests/ からも使えるように）
+#include "Engine/Resource/StreamReader.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Arche
+{
+	/**
+	 * @class	AudioStreamSink
+	 * @brief	ストリームの再生先
+	 */
+	class AudioStreamSink
+	{
+	public:
+		virtual ~AudioStreamSink() = default;
+
+		// data は GetQueuedBufferCount が減るまで（再生し終わるまで）呼び出し側が保持する
+		virtual bool SubmitBuffer(const uint8_t* data, uint32_t size, bool endOfStream) = 0;
+
+		// 渡したうち、まだ再生し終わっていないバッファの数（渡した順に終わる）
+		virtual uint32_t GetQueuedBufferCount() const = 0;
+	};
+
+	/**
+	 * @class	NullAudioSink
+	 * @brief	何も鳴らさない再生先（音声デバイスの無い環境・動作確認用）
+	 */
+	class NullAudioSink : public AudioStreamSink
+	{
+	public:
+		bool SubmitBuffer(const uint8_t* /*data*/, uint32_t size, bool endOfStream) override
+		{
+			m_queue.push_back(endOfStream);
+			m_submittedBytes += size;
+			if (endOfStream) m_endSubmitted = true;
+			return true;
+		}
+
+		uint32_t GetQueuedBufferCount() const override { return (uint32_t)m_queue.size(); }
+
+		// 先頭から count 個を再生し終わったことにする
+		void Consume(uint32_t count = 1)
+		{
+			while (count-- > 0 && !m_queue.empty()) m_queue.pop_front();
+		}
+
+		uint64_t GetSubmittedBytes() const { return m_submittedBytes; }
+		bool IsEndSubmitted() const { return m_endSubmitted; }
+
+	private:
+		std::deque<bool> m_queue;
+		uint64_t m_submittedBytes = 0;
+		bool m_endSubmitted = false;
+	};
+
+	/**
+	 * @class	SoundStream
+	 * @brief	WAV ファイルのストリーミング読み込み
+	 */
+	class SoundStream
+	{
+	public:
+		static constexpr uint32_t BUFFER_COUNT = 4;
+		static constexpr uint32_t BLOCK_SIZE = 64 * 1024;	// 44.1kHz/16bit/ステレオで約0.37秒
+
+		SoundStream() = default;
+		~SoundStream() { Close(); }
+
+		SoundStream(const SoundStream&) = delete;
+		SoundStream& operator=(const SoundStream&) = delete;
+
+		// ヘッダーだけ読み、I/Oスレッドを起動する（reader はこのストリームが持ち、以降はI/Oスレッドだけが読む）
+		// @param	path	表示用（読み込みには使わない。VirtualFileSystem::OpenStream で reader を作る）
+		bool Open(const std::string& path, std::unique_ptr<StreamReader> reader, bool loop);
+		// I/Oスレッドを止める（Sink 側が再生中のバッファを手放してから呼ぶ）
+		void Close();
+
+		// メインスレッドから毎フレーム呼ぶ
+		void Pump(AudioStreamSink& sink);
+
+		bool IsOpen() const { return m_thread.joinable(); }
+		// 最後のブロックまで渡し、再生し終わった（ループ時は Close するまで false）
+		bool IsFinished() const { return m_finished; }
+
+		// fmt チャンクそのもの（WAVEFORMATEX などに写して使う）
+		const std::vector<uint8_t>& GetFormat() const { return m_format; }
+		const std::string& GetPath() const { return m_path; }
+		float GetDuration() const;
+
+		uint64_t GetMemoryUsage() const { return (uint64_t)BUFFER_COUNT * m_blockSize; }
+		// 再生先のバッファが空になった（読み込みが間に合わなかった）回数
+		uint32_t GetUnderrunCount() const { return m_underrunCount; }
+
+	private:
+		struct Block
+		{
+			std::vector<uint8_t> data;
+			uint32_t size = 0;
+			bool last = false;
+		};
+
+		void IoThreadMain();
+		void FillBlock(Block& block);
+
+	private:
+		std::string m_path;
+		std::unique_ptr<StreamReader> m_reader;
+		std::vector<uint8_t> m_format;
+		uint64_t m_dataOffset = 0;
+		uint32_t m_dataSize = 0;
+		uint32_t m_blockSize = 0;
+		bool m_loop = false;
+
+		Block m_blocks[BUFFER_COUNT];
+		uint32_t m_fillIndex = 0;		// I/Oスレッドのみ
+		uint64_t m_readPosition = 0;	// I/Oスレッドのみ（data チャンク内の位置）
+		bool m_readFailed = false;		// I/Oスレッドのみ
+		uint32_t m_submitIndex = 0;		// メインスレッドのみ
+
+		// 以下は m_mutex で守る
+		std::mutex m_mutex;
+		std::condition_variable m_cv;
+		uint32_t m_filledCount = 0;		// 読み終わって未提出
+		uint32_t m_queuedCount = 0;		// 提出済みで再生中
+		bool m_endRead = false;			// 最後のブロックを読んだ
+		bool m_stop = false;
+
+		// メインスレッドのみ
+		bool m_endSubmitted = false;
+		bool m_started = false;
+		bool m_starved = false;
+		bool m_finished = false;
+		uint32_t m_underrunCount = 0;
+
+		std::thread m_thread;
+	};
+
+}	// namespace Arche
+
+#endif // !___SOUND_STREAM_H___
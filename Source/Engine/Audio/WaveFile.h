@@ -0,0 +1,77 @@
+﻿/*****************************************************************//**
+ * @file	WaveFile.h
+ * @brief	WAV (RIFF) ファイルのチャンク探索
+ *
+ * @details	fmt / data チャンクの位置だけを調べる。波形はコピーしない。
+ *			ヘッダーは StreamReader で少しずつ読むので、ファイル全体を開いておく必要は無い。
+ *			Sound（一括読み込み）と SoundStream（ストリーミング）で共用する。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___WAVE_FILE_H___
+#define ___WAVE_FILE_H___
+
+// ===== インクルード =====
+// 標準ライブラリだけで書く（pch.h を含めず、Tests/ からも使えるように）
+#include "Engine/Resource/StreamReader.h"
+#include <cstdint>
+#include <cstring>
+
+namespace Arche
+{
+	namespace WaveFile
+	{
+		// WAVファイルパース用構造体
+		struct RiffHeader { char chunkId[4]; uint32_t chunkSize; char format[4]; };
+		struct ChunkHeader { char chunkId[4]; uint32_t chunkSize; };
+
+		struct Chunks
+		{
+			uint64_t formatOffset = 0;
+			uint32_t formatSize = 0;
+			uint64_t dataOffset = 0;
+			uint32_t dataSize = 0;
+		};
+
+		// fmt と data の両方が見つかれば true
+		inline bool FindChunks(StreamReader& reader, Chunks& out)
+		{
+			out = {};
+			RiffHeader riff;
+			if (!reader.ReadValue(0, riff) || std::strncmp(riff.chunkId, "RIFF", 4) != 0 || std::strncmp(riff.format, "WAVE", 4) != 0) return false;
+
+			const uint64_t fileSize = reader.GetSize();
+			bool hasFormat = false;
+			uint64_t offset = sizeof(RiffHeader);
+			ChunkHeader chunk;
+			while (reader.ReadValue(offset, chunk))
+			{
+				offset += sizeof(ChunkHeader);
+				if (chunk.chunkSize > fileSize - offset) break;
+
+				if (std::strncmp(chunk.chunkId, "fmt ", 4) == 0)
+				{
+					out.formatOffset = offset;
+					out.formatSize = chunk.chunkSize;
+					hasFormat = true;
+				}
+				else if (std::strncmp(chunk.chunkId, "data", 4) == 0)
+				{
+					out.dataOffset = offset;
+					out.dataSize = chunk.chunkSize;
+					return hasFormat;
+				}
+
+				// チャンクは2バイト境界に揃っている
+				offset += (uint64_t)chunk.chunkSize + (chunk.chunkSize & 1);
+			}
+			return false;
+		}
+	}
+
+}	// namespace Arche
+
+#endif // !___WAVE_FILE_H___
@@ -30,6 +30,9 @@ namespace Arche
 		// VSync
 		static const bool VSYNC_ENABLED = false;		// 垂直同期（true: 60fps固定、false: 無制限）
 
+		// リソースのパック（ビルド出力に置かれていれば Resources/ より優先して読む）
+		static const char* RESOURCE_ARCHIVE = "Resources.pak";
+
 	}	// namespace Config
 
 }	// namespace Arche
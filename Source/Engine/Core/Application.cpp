@@ -12,11 +12,14 @@
 // ===== インクルード =====
 #include "Engine/pch.h"
 #include "Engine/Core/Application.h"
+#include "Engine/Core/HotReloadState.h"
 #include "Engine/Core/Window/Input.h"
 #include "Engine/Resource/ResourceManager.h"
+#include "Engine/Resource/VirtualFileSystem.h"
 #include "Engine/Audio/AudioManager.h"
 #include "Engine/Core/Base/Logger.h"
-#include "Engine/Scene/Serializer/SceneSerializer.h"
+#include "Engine/Scene/Serializer/SceneSaver.h"
+#include "Engine/Scene/Serializer/PrefabTemplate.h"
 #include "Engine/Scene/Serializer/SystemRegistry.h"
 #include "Engine/Scene/Serializer/ComponentRegistry.h"
 
@@ -88,8 +91,10 @@ namespace Arche
 
 		// 入力
 		Input::Initialize();
-		// リソースマネージャー
-		ResourceManager::Instance().Initialize(m_device.Get());
+		// リソースのパック（リリースビルドのみ存在する。読み込みが始まる前にマウントしておく）
+		if (std::filesystem::exists(Config::RESOURCE_ARCHIVE)) VirtualFileSystem::Instance().Mount(Config::RESOURCE_ARCHIVE);
+		// リソースマネージャー（ホットリロードでデバイスを引き継いだときは、読み込み済みのアセットをそのまま使う）
+		if (!m_isDeviceInherited) ResourceManager::Instance().Initialize(m_device.Get());
 		// オーディオマネージャー
 		AudioManager::Instance().Initialize();
 		// FPS制御
@@ -227,7 +232,15 @@ namespace Arche
 		SystemRegistry::Instance().Clear();
 		ComponentRegistry::Instance().Clear();
 
-		ResourceManager::Instance().Clear();
+		// ホットリロードなら、デバイスとアセットは次のアプリへ引き継ぐ（DLLを差し替えても作り直さない）
+		if (m_reloadRequested && m_device && m_context)
+		{
+			HotReloadState::Instance().KeepDevice(m_device, m_context);
+		}
+		else
+		{
+			ResourceManager::Instance().Clear();
+		}
 
 		// レンダラーの静的リソース開放
 		SpriteRenderer::Shutdown();
@@ -264,15 +277,12 @@ namespace Arche
 
 		// シーンロードの分岐
 		std::string startScene = "Resources/Game/Scenes/GameScene.json";	// デフォルト
-		std::string tempPath = "temp_hotreload.json";
 		std::string configPath = "game_config.json";
 
-		// パターンA: ホットリロード復帰
-		if (std::filesystem::exists(tempPath))
+		// パターンA: ホットリロード復帰（メモリに取っておいたシーンから。アセットは引き継いだものを使う）
+		if (HotReloadState::Instance().HasScene())
 		{
-			SceneManager::Instance().LoadSceneAsync(tempPath, new ImmediateTransition());
-			std::filesystem::remove(tempPath);
-			Logger::Log("HotReload: State Reset (Debug).");
+			LoadState();
 		}
 		// パターンB: リリースビルド設定（Confingあり）
 		else if (std::filesystem::exists(configPath))
@@ -525,21 +535,20 @@ namespace Arche
 
 	void Application::SaveState()
 	{
-		SceneSerializer::SaveScene(SceneManager::Instance().GetWorld(), "temp_hotreload.json");
+		// 書き出し中の保存は、差し替え前のDLLのコンポーネントのコードで書き終える
+		SceneSaver::Instance().Flush();
+
+		auto& sceneManager = SceneManager::Instance();
+		HotReloadState::Instance().CaptureScene(sceneManager.GetWorld(), sceneManager.GetCurrentScenePath(), sceneManager.IsDirty());
+		// 差し替え後のDLLではゲーム側コンポーネントの並びが変わりうるので、プレファブのテンプレートを捨てる
+		PrefabCache::Instance().Clear();
 		Logger::Log("HotReload: State Saved.");
 	}
 
 	void Application::LoadState()
 	{
-		std::string tempPath = "temp_hotreload.json";
-		std::ifstream f(tempPath);
-		if (f.good())
-		{
-			f.close();
-			// 現在のシーンをクリアしてからロード
-			SceneSerializer::LoadScene(SceneManager::Instance().GetWorld(), tempPath);
-			Logger::Log("HotReload: State Loaded.");
-		}
+		// 現在のシーンをクリアしてから、取っておいたシーンを作り直す
+		HotReloadState::Instance().RestoreScene();
 	}
 
 	// ======================================================================
@@ -609,11 +618,42 @@ namespace Arche
 		creationFlags |= D3D11_CREATE_DEVICE_DEBUG;
 #endif // _DEBUG
 
-		HRESULT hr = D3D11CreateDeviceAndSwapChain(
-			nullptr, D3D_DRIVER_TYPE_HARDWARE, nullptr, creationFlags,
-			featureLevels, 1, D3D11_SDK_VERSION, &scd,
-			&m_swapChain, &m_device, &featureLevel, &m_context
-		);
+		HRESULT hr = E_FAIL;
+
+		// ホットリロード: 前のアプリのデバイスに、新しいウィンドウのスワップチェインを作る
+		if (HotReloadState::Instance().TakeDevice(m_device, m_context))
+		{
+			ComPtr<IDXGIDevice> dxgiDevice;
+			ComPtr<IDXGIAdapter> adapter;
+			ComPtr<IDXGIFactory> factory;
+			hr = m_device.As(&dxgiDevice);
+			if (SUCCEEDED(hr)) hr = dxgiDevice->GetAdapter(&adapter);
+			if (SUCCEEDED(hr)) hr = adapter->GetParent(__uuidof(IDXGIFactory), (void**)&factory);
+			if (SUCCEEDED(hr)) hr = factory->CreateSwapChain(m_device.Get(), &scd, &m_swapChain);
+
+			if (SUCCEEDED(hr))
+			{
+				// 前のアプリが設定したままのバインドを外す
+				m_context->ClearState();
+				m_isDeviceInherited = true;
+			}
+			else
+			{
+				// 作り直す（アセットは前のデバイスのものなので捨てる）
+				m_device.Reset();
+				m_context.Reset();
+				ResourceManager::Instance().Clear();
+			}
+		}
+
+		if (!m_isDeviceInherited)
+		{
+			hr = D3D11CreateDeviceAndSwapChain(
+				nullptr, D3D_DRIVER_TYPE_HARDWARE, nullptr, creationFlags,
+				featureLevels, 1, D3D11_SDK_VERSION, &scd,
+				&m_swapChain, &m_device, &featureLevel, &m_context
+			);
+		}
 
 		if (FAILED(hr)) return false;
 
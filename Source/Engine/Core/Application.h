@@ -153,6 +153,7 @@ namespace Arche
 		ComPtr<IDXGISwapChain>			m_swapChain;
 		ComPtr<ID3D11RenderTargetView>	m_renderTargetView;	// バックバッファ（Release用）
 		ComPtr<ID3D11DepthStencilView>	m_depthStencilView;	// 深度バッファ
+		bool m_isDeviceInherited = false;	// ホットリロードで前のアプリのデバイスを引き継いだか
 
 #ifdef _DEBUG
 		// エディタ用レンダーターゲット
@@ -0,0 +1,51 @@
+﻿/*****************************************************************//**
+ * @file	Hash.h
+ * @brief	バイト列の64bitハッシュ（FNV-1a）
+ *
+ * @details	クックしたファイルの整合性チェックや、ソースファイルの変更検出に使う。
+ *			暗号用途ではない。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___HASH_H___
+#define ___HASH_H___
+
+// ===== インクルード =====
+// 標準ライブラリだけで書く（pch.h を含めず、Tests/ からも使えるように）
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Arche
+{
+	namespace Hash
+	{
+		static constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+		static constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+		// 続きから計算する場合は前回の戻り値を seed に渡す
+		inline uint64_t Fnv1a64(const void* data, size_t size, uint64_t seed = FNV_OFFSET)
+		{
+			const uint8_t* bytes = static_cast<const uint8_t*>(data);
+			uint64_t hash = seed;
+			for (size_t i = 0; i < size; ++i)
+			{
+				hash ^= bytes[i];
+				hash *= FNV_PRIME;
+			}
+			return hash;
+		}
+
+		inline uint64_t Fnv1a64(const std::string& str, uint64_t seed = FNV_OFFSET)
+		{
+			return Fnv1a64(str.data(), str.size(), seed);
+		}
+
+	}	// namespace Hash
+
+}	// namespace Arche
+
+#endif // !___HASH_H___
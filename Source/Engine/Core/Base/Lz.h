@@ -0,0 +1,197 @@
+﻿/*****************************************************************//**
+ * @file	Lz.h
+ * @brief	LZ77系の高速圧縮（LZ4 ブロック形式準拠）
+ *
+ * @details	アセットアーカイブのエントリ圧縮用。展開速度優先で圧縮率は控えめ。
+ *			シーケンス = [トークン][リテラル長の延長][リテラル][オフセット(2byte LE)][一致長の延長]
+ *			トークンの上位4bitがリテラル長、下位4bitが (一致長 - 4)。15 のときは 255 単位で延長する。
+ *			最後のシーケンスはリテラルのみ（オフセット無し）。
+ *			Decompress は入力が壊れていても出力バッファの外には書かない。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___LZ_H___
+#define ___LZ_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+
+namespace Arche
+{
+	namespace Lz
+	{
+		static constexpr size_t MIN_MATCH = 4;
+		static constexpr size_t MAX_OFFSET = 65535;
+		static constexpr size_t LAST_LITERALS = 5;		// 末尾はリテラルで終える
+		static constexpr size_t MATCH_LIMIT = 12;		// 末尾からこの範囲では一致を探さない
+		static constexpr int HASH_BITS = 16;
+
+		// 最悪（全てリテラル）のときの圧縮後サイズ
+		inline size_t GetMaxCompressedSize(size_t size) { return size + size / 255 + 16; }
+
+		namespace Detail
+		{
+			inline uint32_t Read32(const uint8_t* p) { uint32_t v; memcpy(&v, p, sizeof(v)); return v; }
+			inline uint32_t HashSequence(uint32_t sequence) { return (sequence * 2654435761u) >> (32 - HASH_BITS); }
+
+			// 15 を超える長さの延長部分
+			inline bool WriteLength(uint8_t*& op, const uint8_t* end, size_t length)
+			{
+				while (length >= 255)
+				{
+					if (op >= end) return false;
+					*op++ = 255;
+					length -= 255;
+				}
+				if (op >= end) return false;
+				*op++ = (uint8_t)length;
+				return true;
+			}
+
+			inline bool ReadLength(const uint8_t*& ip, const uint8_t* end, size_t& length)
+			{
+				uint8_t b;
+				do
+				{
+					if (ip >= end) return false;
+					b = *ip++;
+					length += b;
+				} while (b == 255);
+				return true;
+			}
+
+			inline bool WriteSequence(uint8_t*& op, const uint8_t* end, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength)
+			{
+				if (op >= end) return false;
+				uint8_t* token = op++;
+				*token = (uint8_t)((literalLength >= 15 ? 15 : literalLength) << 4);
+				if (literalLength >= 15 && !WriteLength(op, end, literalLength - 15)) return false;
+
+				if ((size_t)(end - op) < literalLength) return false;
+				if (literalLength > 0) memcpy(op, literals, literalLength);
+				op += literalLength;
+
+				if (matchLength == 0) return true;	// 最後のシーケンス
+
+				if (end - op < 2) return false;
+				*op++ = (uint8_t)(offset & 0xFF);
+				*op++ = (uint8_t)(offset >> 8);
+
+				size_t code = matchLength - MIN_MATCH;
+				*token |= (uint8_t)(code >= 15 ? 15 : code);
+				if (code >= 15 && !WriteLength(op, end, code - 15)) return false;
+				return true;
+			}
+		}
+
+		/**
+		 * @brief	圧縮する
+		 * @return	圧縮後のサイズ（capacity に収まらなければ 0）
+		 */
+		inline size_t Compress(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity)
+		{
+			static constexpr uint32_t EMPTY = 0xFFFFFFFF;
+			std::vector<uint32_t> table((size_t)1 << HASH_BITS, EMPTY);
+
+			uint8_t* op = dst;
+			const uint8_t* opEnd = dst + capacity;
+			size_t anchor = 0;
+
+			if (size >= MATCH_LIMIT + 1)
+			{
+				const size_t matchStartLimit = size - MATCH_LIMIT;
+				const size_t matchEndLimit = size - LAST_LITERALS;
+
+				size_t ip = 0;
+				while (ip < matchStartLimit)
+				{
+					uint32_t sequence = Detail::Read32(src + ip);
+					uint32_t& slot = table[Detail::HashSequence(sequence)];
+					uint32_t ref = slot;
+					slot = (uint32_t)ip;
+
+					if (ref == EMPTY || ip - ref > MAX_OFFSET || Detail::Read32(src + ref) != sequence)
+					{
+						++ip;
+						continue;
+					}
+
+					size_t length = MIN_MATCH;
+					while (ip + length < matchEndLimit && src[ref + length] == src[ip + length]) ++length;
+
+					if (!Detail::WriteSequence(op, opEnd, src + anchor, ip - anchor, ip - ref, length)) return 0;
+
+					// 一致の途中も1か所だけ登録しておく（次の一致を見つけやすくする）
+					if (length > 2 && ip + length - 2 < matchStartLimit)
+					{
+						size_t p = ip + length - 2;
+						table[Detail::HashSequence(Detail::Read32(src + p))] = (uint32_t)p;
+					}
+
+					ip += length;
+					anchor = ip;
+				}
+			}
+
+			if (!Detail::WriteSequence(op, opEnd, src + anchor, size - anchor, 0, 0)) return 0;
+			return (size_t)(op - dst);
+		}
+
+		/**
+		 * @brief	展開する
+		 * @param	dstSize	展開後のサイズ（ちょうどこのサイズにならなければ失敗）
+		 */
+		inline bool Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+		{
+			const uint8_t* ip = src;
+			const uint8_t* ipEnd = src + srcSize;
+			uint8_t* op = dst;
+			uint8_t* opEnd = dst + dstSize;
+
+			while (ip < ipEnd)
+			{
+				uint8_t token = *ip++;
+
+				size_t literalLength = token >> 4;
+				if (literalLength == 15 && !Detail::ReadLength(ip, ipEnd, literalLength)) return false;
+				if ((size_t)(ipEnd - ip) < literalLength || (size_t)(opEnd - op) < literalLength) return false;
+				if (literalLength > 0) memcpy(op, ip, literalLength);
+				ip += literalLength;
+				op += literalLength;
+
+				if (ip == ipEnd) break;	// 最後のシーケンス
+
+				if (ipEnd - ip < 2) return false;
+				size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+				ip += 2;
+				if (offset == 0 || offset > (size_t)(op - dst)) return false;
+
+				size_t matchLength = token & 0x0F;
+				if (matchLength == 15 && !Detail::ReadLength(ip, ipEnd, matchLength)) return false;
+				matchLength += MIN_MATCH;
+				if ((size_t)(opEnd - op) < matchLength) return false;
+
+				// 重なりがあり得るので1バイトずつ（オフセットが十分離れていればまとめてコピー）
+				const uint8_t* match = op - offset;
+				if (offset >= matchLength)
+				{
+					memcpy(op, match, matchLength);
+					op += matchLength;
+				}
+				else
+				{
+					for (size_t i = 0; i < matchLength; ++i) *op++ = *match++;
+				}
+			}
+
+			return op == opEnd;
+		}
+
+	}	// namespace Lz
+
+}	// namespace Arche
+
+#endif // !___LZ_H___
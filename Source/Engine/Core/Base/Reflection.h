@@ -22,6 +22,8 @@
 
 // ===== インクルード =====
 #include "Engine/pch.h"
+#include "Engine/Core/Base/StringId.h"
+#include <span>
 
 namespace Arche
 {
@@ -29,12 +31,95 @@ namespace Arche
 	// リフレクションシステム内部用
 	namespace Reflection
 	{
+		// フィールドの型（BinaryFieldType はこれを使う。値を変えたら SceneBinary::VERSION を上げる）
+		enum class FieldType : uint8_t
+		{
+			Int8, Int16, Int32, Int64,
+			UInt8, UInt16, UInt32, UInt64,
+			Float, Double, Bool,
+			String, StringId,
+			Float2, Float3, Float4,
+			StringList, EntityList,
+			Unknown,	// 上以外（シリアライズの対象外）
+		};
+
+		enum class FieldFlag : uint8_t
+		{
+			None = 0,
+			Trivial = 1 << 0,		// バイト列のままコピー・比較してよい（memcpy / memcmp）
+			Container = 1 << 1,		// 可変長（std::vector。中身はヒープ）
+		};
+
+		template<typename T>
+		constexpr FieldType GetFieldType()
+		{
+			if constexpr (std::is_enum_v<T>) return GetFieldType<std::underlying_type_t<T>>();
+			else if constexpr (std::is_same_v<T, bool>) return FieldType::Bool;
+			else if constexpr (std::is_floating_point_v<T>) return sizeof(T) == 4 ? FieldType::Float : FieldType::Double;
+			else if constexpr (std::is_integral_v<T>)
+			{
+				constexpr int index = sizeof(T) == 1 ? 0 : sizeof(T) == 2 ? 1 : sizeof(T) == 4 ? 2 : 3;
+				return (FieldType)((std::is_signed_v<T> ? (int)FieldType::Int8 : (int)FieldType::UInt8) + index);
+			}
+			else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, const char*>) return FieldType::String;
+			else if constexpr (std::is_same_v<T, StringId>) return FieldType::StringId;
+			else if constexpr (std::is_same_v<T, DirectX::XMFLOAT2>) return FieldType::Float2;
+			else if constexpr (std::is_same_v<T, DirectX::XMFLOAT3>) return FieldType::Float3;
+			else if constexpr (std::is_same_v<T, DirectX::XMFLOAT4>) return FieldType::Float4;
+			else if constexpr (std::is_same_v<T, std::vector<std::string>>) return FieldType::StringList;
+			else if constexpr (std::is_same_v<T, std::vector<uint32_t>>) return FieldType::EntityList;	// Entity は uint32_t
+			else return FieldType::Unknown;
+		}
+
+		// 1フィールドぶんの情報（REFLECT_VAR からコンパイル時に作る）
+		struct FieldInfo
+		{
+			const char* name = "";
+			uint32_t nameHash = 0;		// StringId と同じハッシュ
+			uint32_t offset = 0;		// 構造体の先頭からの位置
+			uint32_t size = 0;
+			FieldType type = FieldType::Unknown;
+			uint8_t flags = 0;
+
+			constexpr bool HasFlag(FieldFlag flag) const { return (flags & (uint8_t)flag) != 0; }
+		};
+
+		// consteval なので Debug ビルドでも実行時には計算しない
+		template<typename FieldT>
+		consteval FieldInfo MakeField(const char* name, size_t offset)
+		{
+			FieldInfo field;
+			field.name = name;
+			field.nameHash = StringId::Hash(name);
+			field.offset = (uint32_t)offset;
+			field.size = (uint32_t)sizeof(FieldT);
+			field.type = GetFieldType<FieldT>();
+			if constexpr (std::is_trivially_copyable_v<FieldT>) field.flags |= (uint8_t)FieldFlag::Trivial;
+			if constexpr (requires(const FieldT& v) { v.size(); v.data(); } && !std::is_same_v<FieldT, std::string>) field.flags |= (uint8_t)FieldFlag::Container;
+			return field;
+		}
+
+		// メンバーポインタ → メンバーの型
+		template<typename MemberPtr>
+		struct MemberTraits;
+
+		template<typename Owner, typename FieldT>
+		struct MemberTraits<FieldT Owner::*>
+		{
+			using Type = FieldT;
+		};
+
+		template<typename MemberPtr>
+		using MemberType = typename MemberTraits<MemberPtr>::Type;
+
 		// 基本テンプレート
 		template<typename T>
 		struct Meta
 		{
 			static constexpr const char* Name = "Unknown";
 			template<typename Visitor>
+			static constexpr void VisitFields(Visitor&& visitor) {}
+			template<typename Visitor>
 			static void Visit(T& instance, Visitor&& visitor) {}
 		};
 
@@ -45,6 +130,101 @@ namespace Arche
 			Meta<T>::Visit(instance, std::forward<Visitor>(visitor));
 		}
 
+		// ------------------------------------------------------------
+		// フィールド表（コンパイル時に作る。インスタンスもビジターも要らない）
+		// ------------------------------------------------------------
+		template<typename T>
+		constexpr size_t GetFieldCount()
+		{
+			size_t count = 0;
+			Meta<T>::VisitFields([&](auto, const FieldInfo&) { ++count; });
+			return count;
+		}
+
+		template<typename T>
+		constexpr auto MakeFieldTable()
+		{
+			std::array<FieldInfo, GetFieldCount<T>()> table{};
+			size_t index = 0;
+			Meta<T>::VisitFields([&](auto, const FieldInfo& field) { table[index++] = field; });
+			return table;
+		}
+
+		template<typename T>
+		inline constexpr auto FieldTable = MakeFieldTable<T>();
+
+		// REFLECT_VAR の順
+		template<typename T>
+		constexpr std::span<const FieldInfo> GetFields() { return FieldTable<T>; }
+
+		// 名前のハッシュ（StringId::GetHash）から引く。無ければ nullptr
+		template<typename T>
+		constexpr const FieldInfo* FindField(uint32_t nameHash)
+		{
+			for (const auto& field : FieldTable<T>)
+			{
+				if (field.nameHash == nameHash) return &field;
+			}
+			return nullptr;
+		}
+
+		// すべてのフィールドが FieldType のどれかか（バイナリ形式で読み書きできるか）
+		template<typename T>
+		constexpr bool HasOnlyKnownFields()
+		{
+			for (const auto& field : FieldTable<T>)
+			{
+				if (field.type == FieldType::Unknown) return false;
+			}
+			return true;
+		}
+
+		// ------------------------------------------------------------
+		// 表を使った汎用処理
+		// ------------------------------------------------------------
+		// a と b で値が違うフィールド（i 番目 → 1 << i。64 番目以降は見ない）
+		// Trivial なフィールドはバイト列で比べ、それ以外は operator== で比べる
+		template<typename T>
+		uint64_t GetChangedFields(const T& a, const T& b)
+		{
+			static_assert(GetFieldCount<T>() <= 64, "too many fields for a 64bit mask");
+
+			uint64_t mask = 0;
+			size_t index = 0;
+			Meta<T>::VisitFields([&](auto member, const FieldInfo& field)
+				{
+					bool same = false;
+					if constexpr (std::is_trivially_copyable_v<MemberType<decltype(member)>>)
+					{
+						same = memcmp(reinterpret_cast<const uint8_t*>(&a) + field.offset, reinterpret_cast<const uint8_t*>(&b) + field.offset, field.size) == 0;
+					}
+					else same = a.*member == b.*member;
+
+					if (!same) mask |= 1ull << index;
+					index++;
+				});
+			return mask;
+		}
+
+		// mask のフィールドだけ src から dst へコピーする
+		template<typename T>
+		void CopyFields(const T& src, T& dst, uint64_t mask)
+		{
+			size_t index = 0;
+			Meta<T>::VisitFields([&](auto member, const FieldInfo& field)
+				{
+					if (mask & (1ull << index))
+					{
+						if constexpr (std::is_trivially_copyable_v<MemberType<decltype(member)>>)
+						{
+							memcpy(reinterpret_cast<uint8_t*>(&dst) + field.offset, reinterpret_cast<const uint8_t*>(&src) + field.offset, field.size);
+						}
+						else dst.*member = src.*member;
+					}
+					index++;
+				});
+		}
+
 	}	// namespace Reflection
 
 }	// namespace Arche
@@ -55,6 +235,8 @@ namespace Arche
 
 /**
  * @brief	構造体の外部でリフレクション情報を定義するためのマクロ
+ * @details	REFLECT_VAR はメンバーポインタとフィールド情報（位置・サイズ・型）を渡す。
+ *			Visit（値を訪問するビジター）と FieldTable（コンパイル時の表）はどちらもこれから作る。
  * @code
  * 使い方：
  *	REFLECT_STRUCT_BEGIN(Transform)
@@ -65,17 +247,22 @@ namespace Arche
 #define REFLECT_STRUCT_BEGIN(Type) \
 	namespace Reflection { \
 		template <> struct Meta<Type> { \
+			using Self = Type; \
 			static constexpr const char* Name = #Type; \
 			template <typename Visitor> \
-			static void Visit(Type& obj, Visitor&& visitor) { \
+			static constexpr void VisitFields(Visitor&& visitor) { \
 
  // 変数登録: REFLECT_VAR(position)
 #define REFLECT_VAR(Name) \
-				visitor(obj.Name, #Name); \
+				visitor(&Self::Name, ::Arche::Reflection::MakeField<decltype(Self::Name)>(#Name, offsetof(Self, Name))); \
 
 // 定義終了
 #define REFLECT_STRUCT_END() \
 			} \
+			template <typename Visitor> \
+			static void Visit(Self& obj, Visitor&& visitor) { \
+				VisitFields([&](auto member, const ::Arche::Reflection::FieldInfo& field) { visitor(obj.*member, field.name); }); \
+			} \
 		}; \
 	}
 
@@ -14,7 +14,11 @@
 #define ___STRING_ID_H___
 
 // ===== インクルード =====
-#include "Engine/pch.h"
+// 標準ライブラリだけで書く（pch.h を含めず、Tests/ からも使えるように）
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
 
 /**
  * @class	StringId
@@ -71,8 +75,7 @@ public:
 
 	}
 
-private:
-	// CRC32ハッシュ関数
+	// CRC32ハッシュ関数（リフレクションのフィールド名にも使う）
 	static constexpr ValueType Hash(const char* str)
 	{
 		ValueType hash = 0xFFFFFFFF;
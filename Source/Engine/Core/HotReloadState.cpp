@@ -0,0 +1,111 @@
+﻿/*****************************************************************//**
+ * @file	HotReloadState.cpp
+ * @brief	ゲームDLLの差し替えをまたいで持ち越す状態
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Core/HotReloadState.h"
+#include "Engine/Core/Base/Logger.h"
+#include "Engine/Scene/Core/SceneManager.h"
+#include "Engine/Scene/Serializer/SceneBinary.h"
+#include "Engine/Scene/Serializer/SceneSaver.h"
+#include "Engine/Scene/Serializer/SceneSerializer.h"
+#include "Engine/Scene/Components/Components.h"
+
+namespace Arche
+{
+	HotReloadState& HotReloadState::Instance()
+	{
+		static HotReloadState instance;
+		return instance;
+	}
+
+	// ====================================================================================
+	// シーン
+	// ====================================================================================
+	bool HotReloadState::CaptureScene(World& world, const std::string& scenePath, bool isDirty)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+
+		// 保存と同じく、Tagを持たない（内部的な）エンティティは持ち越さない
+		auto& registry = world.getRegistry();
+		SceneBinary::Contents contents;
+		contents.settings = SceneSnapshot::CaptureSettings(world);
+		registry.each([&](auto entityID)
+			{
+				Entity entity = entityID;
+				if (!registry.has<Tag>(entity)) return;
+
+				contents.entities.push_back(entity);
+				contents.ids.push_back((uint32_t)entity);
+			});
+
+		if (!SceneBinary::Write(registry, contents, m_scene))
+		{
+			m_scene.clear();
+			Logger::LogError("HotReload: Failed to capture the scene.");
+			return false;
+		}
+		m_scenePath = scenePath;
+		m_isDirty = isDirty;
+
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		Logger::Log("HotReload: Captured " + std::to_string(contents.entities.size()) + " entities (" +
+			std::to_string(m_scene.size() / 1024) + " KB, " + std::to_string(ms) + " ms)");
+		return true;
+	}
+
+	bool HotReloadState::RestoreScene()
+	{
+		if (m_scene.empty()) return false;
+
+		auto start = std::chrono::high_resolution_clock::now();
+
+		// コンポーネントのフィールドが変わっていても、名前の合うフィールドは読み替えて残す
+		SceneDocument document;
+		document.binary = std::make_shared<SceneBinary>();
+		std::string error;
+		document.valid = document.binary->Parse(m_scene.data(), m_scene.size(), error, true);
+
+		std::vector<uint8_t>().swap(m_scene);
+		if (!document.valid)
+		{
+			Logger::LogError("HotReload: Failed to restore the scene (" + error + ")");
+			return false;
+		}
+
+		SceneManager::Instance().RestoreScene(m_scenePath, document, m_isDirty);
+
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		Logger::Log("HotReload: State Restored (" + std::to_string(ms) + " ms)");
+		return true;
+	}
+
+	// ====================================================================================
+	// デバイス
+	// ====================================================================================
+	void HotReloadState::KeepDevice(ComPtr<ID3D11Device> device, ComPtr<ID3D11DeviceContext> context)
+	{
+		m_device = std::move(device);
+		m_context = std::move(context);
+	}
+
+	bool HotReloadState::TakeDevice(ComPtr<ID3D11Device>& outDevice, ComPtr<ID3D11DeviceContext>& outContext)
+	{
+		if (!m_device || !m_context) return false;
+
+		outDevice = std::move(m_device);
+		outContext = std::move(m_context);
+		m_device.Reset();
+		m_context.Reset();
+		return true;
+	}
+
+}	// namespace Arche
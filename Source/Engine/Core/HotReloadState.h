@@ -0,0 +1,64 @@
+﻿/*****************************************************************//**
+ * @file	HotReloadState.h
+ * @brief	ゲームDLLの差し替えをまたいで持ち越す状態
+ *
+ * @details	エンジン (ArcheEngine.dll) はランナーが読み込んだままなので、ここに置いたものは
+ *			Sandbox.dll を外して読み直す間も残る。
+ *
+ *			- シーン: 差し替え前に SceneBinary の形でメモリに取り、差し替え後にそのまま読み込む
+ *			  （ファイルの書き出し・JSON の読み直し・アセットの集め直しをしない）。
+ *			  コンポーネントのフィールドが変わっていれば、名前で合わせて読み替える。
+ *			- デバイス: D3D11 デバイスを使い続け、ResourceManager のアセットを捨てずに引き継ぐ。
+ *
+ *			ゲームDLLのコードを参照するもの（コンポーネントの実体・システム）は持たない。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___HOT_RELOAD_STATE_H___
+#define ___HOT_RELOAD_STATE_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Scene/Core/ECS/ECS.h"
+
+namespace Arche
+{
+	class ARCHE_API HotReloadState
+	{
+	public:
+		static HotReloadState& Instance();
+
+		// --- シーン ---
+
+		// 今のシーンを取っておく（ゲームDLLのコンポーネント登録が残っているうちに呼ぶ）
+		bool CaptureScene(World& world, const std::string& scenePath, bool isDirty);
+		// 取っておいたシーンを読み込む（差し替え後のDLLのコンポーネント登録が済んでから呼ぶ）
+		bool RestoreScene();
+		bool HasScene() const { return !m_scene.empty(); }
+
+		// --- デバイス ---
+
+		// アプリを破棄する前に、デバイスを次のアプリへ渡す
+		void KeepDevice(ComPtr<ID3D11Device> device, ComPtr<ID3D11DeviceContext> context);
+		// 渡されたデバイスを受け取る（無ければ false）
+		bool TakeDevice(ComPtr<ID3D11Device>& outDevice, ComPtr<ID3D11DeviceContext>& outContext);
+
+	private:
+		HotReloadState() = default;
+		~HotReloadState() = default;
+
+	private:
+		std::vector<uint8_t> m_scene;	// SceneBinary
+		std::string m_scenePath;
+		bool m_isDirty = false;
+
+		ComPtr<ID3D11Device> m_device;
+		ComPtr<ID3D11DeviceContext> m_context;
+	};
+
+}	// namespace Arche
+
+#endif // !___HOT_RELOAD_STATE_H___
@@ -0,0 +1,167 @@
+﻿/*****************************************************************//**
+ * @file	AnimationPose.cpp
+ * @brief	ボーン姿勢のSoAバッファと一括計算カーネル
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "AnimationPose.h"
+
+namespace Arche
+{
+	namespace
+	{
+		// 4要素単位の読み書き（vector<float> はアライン保証がないため非アライン版を使う）
+		inline XMVECTOR Load4(const std::vector<float>& v, size_t i) { return XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&v[i])); }
+		inline void Store4(std::vector<float>& v, size_t i, FXMVECTOR x) { XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&v[i]), x); }
+
+		// 4つのクォータニオンを同時に正規化（長さがほぼ0なら単位クォータニオン）
+		inline void Normalize4(XMVECTOR& x, XMVECTOR& y, XMVECTOR& z, XMVECTOR& w)
+		{
+			XMVECTOR lenSq = XMVectorMultiplyAdd(x, x, XMVectorMultiplyAdd(y, y, XMVectorMultiplyAdd(z, z, XMVectorMultiply(w, w))));
+			XMVECTOR degenerate = XMVectorLess(lenSq, XMVectorReplicate(1e-8f));
+			XMVECTOR inv = XMVectorReciprocalSqrt(XMVectorMax(lenSq, XMVectorReplicate(1e-8f)));
+
+			x = XMVectorSelect(XMVectorMultiply(x, inv), XMVectorZero(), degenerate);
+			y = XMVectorSelect(XMVectorMultiply(y, inv), XMVectorZero(), degenerate);
+			z = XMVectorSelect(XMVectorMultiply(z, inv), XMVectorZero(), degenerate);
+			w = XMVectorSelect(XMVectorMultiply(w, inv), XMVectorSplatOne(), degenerate);
+		}
+	}
+
+	void PoseBuffer::Resize(size_t boneCount)
+	{
+		count = boneCount;
+		size_t padded = (boneCount + 3) & ~size_t(3);
+
+		for (auto* v : { &tx, &ty, &tz, &qx, &qy, &qz }) v->assign(padded, 0.0f);
+		for (auto* v : { &qw, &sx, &sy, &sz }) v->assign(padded, 1.0f);
+	}
+
+	namespace PoseKernel
+	{
+		void Copy(const PoseBuffer& src, PoseBuffer& dst)
+		{
+			dst.tx = src.tx; dst.ty = src.ty; dst.tz = src.tz;
+			dst.qx = src.qx; dst.qy = src.qy; dst.qz = src.qz; dst.qw = src.qw;
+			dst.sx = src.sx; dst.sy = src.sy; dst.sz = src.sz;
+			dst.count = src.count;
+		}
+
+		void Blend(const PoseBuffer& a, const PoseBuffer& b, float t, PoseBuffer& out)
+		{
+			size_t padded = a.PaddedCount();
+			if (out.PaddedCount() != padded) out.Resize(a.count);
+
+			XMVECTOR vt = XMVectorReplicate(t);
+			XMVECTOR zero = XMVectorZero();
+
+			for (size_t i = 0; i < padded; i += 4)
+			{
+				// 平行移動・スケールは線形補間
+				Store4(out.tx, i, XMVectorLerpV(Load4(a.tx, i), Load4(b.tx, i), vt));
+				Store4(out.ty, i, XMVectorLerpV(Load4(a.ty, i), Load4(b.ty, i), vt));
+				Store4(out.tz, i, XMVectorLerpV(Load4(a.tz, i), Load4(b.tz, i), vt));
+				Store4(out.sx, i, XMVectorLerpV(Load4(a.sx, i), Load4(b.sx, i), vt));
+				Store4(out.sy, i, XMVectorLerpV(Load4(a.sy, i), Load4(b.sy, i), vt));
+				Store4(out.sz, i, XMVectorLerpV(Load4(a.sz, i), Load4(b.sz, i), vt));
+
+				// 回転は nlerp（内積が負なら b を反転して最短経路を取る）
+				XMVECTOR ax = Load4(a.qx, i), ay = Load4(a.qy, i), az = Load4(a.qz, i), aw = Load4(a.qw, i);
+				XMVECTOR bx = Load4(b.qx, i), by = Load4(b.qy, i), bz = Load4(b.qz, i), bw = Load4(b.qw, i);
+
+				XMVECTOR dot = XMVectorMultiplyAdd(ax, bx, XMVectorMultiplyAdd(ay, by, XMVectorMultiplyAdd(az, bz, XMVectorMultiply(aw, bw))));
+				XMVECTOR flip = XMVectorLess(dot, zero);
+				bx = XMVectorSelect(bx, XMVectorNegate(bx), flip);
+				by = XMVectorSelect(by, XMVectorNegate(by), flip);
+				bz = XMVectorSelect(bz, XMVectorNegate(bz), flip);
+				bw = XMVectorSelect(bw, XMVectorNegate(bw), flip);
+
+				XMVECTOR rx = XMVectorLerpV(ax, bx, vt);
+				XMVECTOR ry = XMVectorLerpV(ay, by, vt);
+				XMVECTOR rz = XMVectorLerpV(az, bz, vt);
+				XMVECTOR rw = XMVectorLerpV(aw, bw, vt);
+				Normalize4(rx, ry, rz, rw);
+
+				Store4(out.qx, i, rx);
+				Store4(out.qy, i, ry);
+				Store4(out.qz, i, rz);
+				Store4(out.qw, i, rw);
+			}
+		}
+
+		void ComposeLocalMatrices(const PoseBuffer& pose, XMMATRIX* outLocal)
+		{
+			size_t padded = pose.PaddedCount();
+			XMVECTOR one = XMVectorSplatOne();
+			XMVECTOR two = XMVectorReplicate(2.0f);
+			XMVECTOR zero = XMVectorZero();
+
+			for (size_t i = 0; i < padded; i += 4)
+			{
+				XMVECTOR x = Load4(pose.qx, i), y = Load4(pose.qy, i), z = Load4(pose.qz, i), w = Load4(pose.qw, i);
+				Normalize4(x, y, z, w);
+
+				// XMMatrixRotationQuaternion と同じ行優先の回転行列要素
+				XMVECTOR x2 = XMVectorMultiply(x, two), y2 = XMVectorMultiply(y, two), z2 = XMVectorMultiply(z, two);
+				XMVECTOR xx = XMVectorMultiply(x, x2), yy = XMVectorMultiply(y, y2), zz = XMVectorMultiply(z, z2);
+				XMVECTOR xy = XMVectorMultiply(x, y2), xz = XMVectorMultiply(x, z2), yz = XMVectorMultiply(y, z2);
+				XMVECTOR wx = XMVectorMultiply(w, x2), wy = XMVectorMultiply(w, y2), wz = XMVectorMultiply(w, z2);
+
+				XMVECTOR sx = Load4(pose.sx, i), sy = Load4(pose.sy, i), sz = Load4(pose.sz, i);
+
+				// S * R * T : 各行をスケールし、平行移動を4行目に置く
+				XMMATRIX row0(
+					XMVectorMultiply(sx, XMVectorSubtract(one, XMVectorAdd(yy, zz))),
+					XMVectorMultiply(sx, XMVectorAdd(xy, wz)),
+					XMVectorMultiply(sx, XMVectorSubtract(xz, wy)),
+					zero);
+				XMMATRIX row1(
+					XMVectorMultiply(sy, XMVectorSubtract(xy, wz)),
+					XMVectorMultiply(sy, XMVectorSubtract(one, XMVectorAdd(xx, zz))),
+					XMVectorMultiply(sy, XMVectorAdd(yz, wx)),
+					zero);
+				XMMATRIX row2(
+					XMVectorMultiply(sz, XMVectorAdd(xz, wy)),
+					XMVectorMultiply(sz, XMVectorSubtract(yz, wx)),
+					XMVectorMultiply(sz, XMVectorSubtract(one, XMVectorAdd(xx, yy))),
+					zero);
+				XMMATRIX row3(Load4(pose.tx, i), Load4(pose.ty, i), Load4(pose.tz, i), one);
+
+				// SoA -> AoS（転置すると r[k] が k番目のボーンの行になる）
+				row0 = XMMatrixTranspose(row0);
+				row1 = XMMatrixTranspose(row1);
+				row2 = XMMatrixTranspose(row2);
+				row3 = XMMatrixTranspose(row3);
+
+				size_t lanes = std::min<size_t>(4, pose.count > i ? pose.count - i : 0);
+				for (size_t k = 0; k < lanes; ++k)
+				{
+					XMMATRIX& m = outLocal[i + k];
+					m.r[0] = row0.r[k];
+					m.r[1] = row1.r[k];
+					m.r[2] = row2.r[k];
+					m.r[3] = row3.r[k];
+				}
+			}
+		}
+
+		void LocalToModel(const XMMATRIX* local, const int* parents, size_t count, const XMMATRIX& root, XMMATRIX* outModel)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				int parent = parents[i];
+				assert(parent < (int)i && "親ノードは子ノードより前に並んでいる必要があります");
+				outModel[i] = XMMatrixMultiply(local[i], parent < 0 ? root : outModel[parent]);
+			}
+		}
+
+	}	// namespace PoseKernel
+
+}	// namespace Arche
@@ -0,0 +1,71 @@
+﻿/*****************************************************************//**
+ * @file	AnimationPose.h
+ * @brief	ボーン姿勢のSoAバッファと一括計算カーネル
+ *
+ * @details	姿勢を成分ごとの配列（SoA）で保持し、4ボーン単位でSIMD処理する。
+ *			- ブレンド: 符号補正付きnlerp
+ *			- ローカル行列: 4ボーン同時のクォータニオン→行列変換
+ *			- モデル空間行列: 親インデックス順の線形パス（再帰なし）
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___ANIMATION_POSE_H___
+#define ___ANIMATION_POSE_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+
+namespace Arche
+{
+	/**
+	 * @struct	PoseBuffer
+	 * @brief	ボーン姿勢（T/R/S）を成分ごとに保持するバッファ
+	 * @note	配列長は4の倍数にパディングされ、余剰分は単位姿勢で埋まる
+	 */
+	struct PoseBuffer
+	{
+		std::vector<float> tx, ty, tz;		// 平行移動
+		std::vector<float> qx, qy, qz, qw;	// 回転（クォータニオン）
+		std::vector<float> sx, sy, sz;		// スケール
+		size_t count = 0;					// 有効なボーン数
+
+		// ボーン数を設定（全て単位姿勢で初期化）
+		void Resize(size_t boneCount);
+
+		// パディング込みの要素数
+		size_t PaddedCount() const { return tx.size(); }
+
+		void SetTranslation(size_t i, const XMFLOAT3& t) { tx[i] = t.x; ty[i] = t.y; tz[i] = t.z; }
+		void SetRotation(size_t i, const XMFLOAT4& q) { qx[i] = q.x; qy[i] = q.y; qz[i] = q.z; qw[i] = q.w; }
+		void SetScale(size_t i, const XMFLOAT3& s) { sx[i] = s.x; sy[i] = s.y; sz[i] = s.z; }
+
+		XMFLOAT3 GetTranslation(size_t i) const { return { tx[i], ty[i], tz[i] }; }
+		XMFLOAT4 GetRotation(size_t i) const { return { qx[i], qy[i], qz[i], qw[i] }; }
+		XMFLOAT3 GetScale(size_t i) const { return { sx[i], sy[i], sz[i] }; }
+	};
+
+	namespace PoseKernel
+	{
+		// src の内容を dst へコピー（サイズが違えば合わせる）
+		void Copy(const PoseBuffer& src, PoseBuffer& dst);
+
+		// 2つの姿勢をブレンド（T/S: 線形補間、R: 符号補正付きnlerp）
+		void Blend(const PoseBuffer& a, const PoseBuffer& b, float t, PoseBuffer& out);
+
+		// 姿勢からローカル行列 (S * R * T) を4ボーン単位で生成
+		// @param	outLocal	pose.count 個の行列を受け取る配列
+		void ComposeLocalMatrices(const PoseBuffer& pose, XMMATRIX* outLocal);
+
+		// ローカル行列をモデル空間へ変換（親は必ず子より前にある前提）
+		// @param	parents		各ボーンの親インデックス（ルートは -1）
+		// @param	root		ルートに掛ける行列
+		void LocalToModel(const XMMATRIX* local, const int* parents, size_t count, const XMMATRIX& root, XMMATRIX* outModel);
+
+	}	// namespace PoseKernel
+
+}	// namespace Arche
+
+#endif // !___ANIMATION_POSE_H___
@@ -0,0 +1,160 @@
+﻿/*****************************************************************//**
+ * @file	CookedMesh.h
+ * @brief	クック済みモデル (.amesh) のファイルフォーマット
+ *
+ * @details	Assimp を通さずに読めるよう、Model の中身をそのまま並べたバイナリ。
+ *			[Header][各レコード配列][頂点/インデックス/キー][文字列テーブル]
+ *			- 位置はすべてファイル先頭からのバイトオフセット（16バイト境界）
+ *			- 頂点は MeshOptimizer で最適化・圧縮済みのストリームのまま（GPUに直接渡せる）
+ *			  静的ストリーム (StaticVertex) とスキンストリーム (SkinVertex) は別配列
+ *			- payloadHash はヘッダー以降の全バイトのハッシュ（破損検出用）
+ *			読み込みはメモリマップ + オフセット→ポインタ変換のみで行う。
+ *			ハッシュの確認は全体を読むことになるので、クッカーとデバッグビルドでだけ行う（VerifyPayload）。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___COOKED_MESH_H___
+#define ___COOKED_MESH_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Core/Base/Hash.h"
+
+namespace Arche
+{
+	namespace CookedMesh
+	{
+		static constexpr uint32_t MAGIC = 0x48534D41;	// "AMSH"
+		static constexpr uint32_t VERSION = 2;
+		static constexpr uint64_t ALIGNMENT = 16;
+		static constexpr const char* EXTENSION = ".amesh";
+
+		// 文字列テーブル内の位置
+		struct StringRef
+		{
+			uint32_t offset;
+			uint32_t length;
+		};
+
+		struct Header
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint64_t payloadHash;
+			uint64_t payloadSize;		// ヘッダーを除いたサイズ
+			uint32_t vertexStride;		// sizeof(MeshBuffer::StaticVertex)（レイアウト変更の検出用）
+			uint32_t nodeCount;
+			uint32_t meshCount;
+			uint32_t materialCount;
+			uint32_t animationCount;
+			uint32_t skinStride;		// sizeof(MeshBuffer::SkinVertex)
+			uint64_t nodeOffset;
+			uint64_t meshOffset;
+			uint64_t materialOffset;
+			uint64_t animationOffset;
+			uint64_t stringOffset;
+			uint64_t stringSize;
+		};
+
+		struct NodeRecord
+		{
+			StringRef name;
+			int32_t parent;
+			uint32_t reserved;
+			float localMatrix[16];
+		};
+
+		struct BoneRecord
+		{
+			int32_t nodeIndex;
+			uint32_t reserved[3];
+			float invOffset[16];
+		};
+
+		struct MeshRecord
+		{
+			uint32_t vertexCount;
+			uint32_t indexCount;
+			uint32_t materialID;
+			uint32_t boneCount;
+			uint32_t indexSize;			// 2 or 4
+			uint32_t reserved;
+			uint64_t vertexOffset;		// StaticVertex の配列
+			uint64_t skinOffset;		// SkinVertex の配列（0ならスキン無し）
+			uint64_t indexOffset;		// uint16_t / uint32_t の配列
+			uint64_t boneOffset;
+		};
+
+		struct MaterialRecord
+		{
+			float diffuse[4];
+			float ambient[4];
+			float specular[4];
+			StringRef texturePath;		// モデルファイルからの相対パス
+		};
+
+		struct AnimationRecord
+		{
+			StringRef name;
+			float totalTime;
+			uint32_t channelCount;
+			uint64_t channelOffset;
+		};
+
+		struct ChannelRecord
+		{
+			int32_t nodeIndex;
+			uint32_t positionCount;
+			uint32_t rotationCount;
+			uint32_t scalingCount;
+			uint64_t positionOffset;	// Vec3Key の配列
+			uint64_t rotationOffset;	// QuatKey の配列
+			uint64_t scalingOffset;		// Vec3Key の配列
+		};
+
+		struct Vec3Key { float time; float value[3]; };
+		struct QuatKey { float time; float value[4]; };
+
+		// 通常の読み込みでもハッシュを確かめるか
+#ifdef _DEBUG
+		static constexpr bool VERIFY_ON_LOAD = true;
+#else
+		static constexpr bool VERIFY_ON_LOAD = false;
+#endif
+
+		// ヘッダーの後ろのバイト列が payloadHash と一致するか（data はファイル先頭）
+		inline bool VerifyPayload(const uint8_t* data, size_t size)
+		{
+			if (!data || size < sizeof(Header)) return false;
+			const Header* header = reinterpret_cast<const Header*>(data);
+			if (header->magic != MAGIC || header->payloadSize != size - sizeof(Header)) return false;
+			return Hash::Fnv1a64(data + sizeof(Header), (size_t)header->payloadSize) == header->payloadHash;
+		}
+
+		// ソースファイルに対応するクック済みファイルのパス（例: Player.fbx → Player.fbx.amesh）
+		inline std::string GetCookedPath(const std::string& sourcePath) { return sourcePath + EXTENSION; }
+
+		// クック済みファイルがあり、ソースより新しいか
+		inline bool IsUpToDate(const std::string& cookedPath, const std::string& sourcePath)
+		{
+			std::error_code ec;
+			if (!std::filesystem::is_regular_file(cookedPath, ec)) return false;
+
+			auto cookedTime = std::filesystem::last_write_time(cookedPath, ec);
+			if (ec) return false;
+
+			// ソースが無い（クック済みのみ配布）場合はそのまま使う
+			auto sourceTime = std::filesystem::last_write_time(sourcePath, ec);
+			if (ec) return true;
+
+			return cookedTime >= sourceTime;
+		}
+
+	}	// namespace CookedMesh
+
+}	// namespace Arche
+
+#endif // !___COOKED_MESH_H___
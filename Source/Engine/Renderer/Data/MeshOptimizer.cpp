@@ -0,0 +1,347 @@
+﻿/*****************************************************************//**
+ * @file	MeshOptimizer.cpp
+ * @brief	インポート時のメッシュ最適化（CPUのみ）
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+// pch.h は含めない（Tests/ からもビルドする。vcxproj でもプリコンパイル済みヘッダーを使わない）
+#include "Engine/Renderer/Data/MeshOptimizer.h"
+#include "Engine/Core/Base/Hash.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace Arche
+{
+	namespace MeshOptimizer
+	{
+		namespace
+		{
+			static constexpr uint32_t INVALID = 0xFFFFFFFF;
+
+			// Forsyth法のスコア（キャッシュ内の位置 + 残りの三角形数）
+			float VertexScore(int cachePosition, uint32_t remaining)
+			{
+				if (remaining == 0) return -1.0f;
+
+				float score = 0.0f;
+				if (cachePosition >= 0)
+				{
+					// 直前の三角形で使った3頂点は固定値（同じ頂点ばかり連続して使わないように）
+					if (cachePosition < 3) score = 0.75f;
+					else score = powf(1.0f - (float)(cachePosition - 3) / (float)(CACHE_SIZE - 3), 1.5f);
+				}
+
+				// 残りの少ない頂点を先に片付ける
+				score += 2.0f * powf((float)remaining, -0.5f);
+				return score;
+			}
+
+			uint32_t PackSnorm8(float x, float y, float z, float w)
+			{
+				auto Q = [](float v) { return (uint32_t)(uint8_t)(int8_t)lroundf(std::clamp(v, -1.0f, 1.0f) * 127.0f); };
+				return Q(x) | (Q(y) << 8) | (Q(z) << 16) | (Q(w) << 24);
+			}
+
+			uint32_t PackUnorm8(float x, float y, float z, float w)
+			{
+				auto Q = [](float v) { return (uint32_t)lroundf(std::clamp(v, 0.0f, 1.0f) * 255.0f); };
+				return Q(x) | (Q(y) << 8) | (Q(z) << 16) | (Q(w) << 24);
+			}
+
+			// IEEE754 binary16 へ変換（最近接偶数丸め。範囲外は無限大、NaN は NaN のまま）
+			uint16_t FloatToHalf(float value)
+			{
+				uint32_t bits;
+				std::memcpy(&bits, &value, sizeof(bits));
+
+				const uint32_t sign = (bits >> 16) & 0x8000u;
+				const uint32_t absBits = bits & 0x7FFFFFFFu;
+
+				if (absBits >= 0x7F800000u)
+				{
+					return (uint16_t)(sign | 0x7C00u | (absBits > 0x7F800000u ? 0x0200u : 0u));
+				}
+				if (absBits >= 0x477FF000u)
+				{
+					// 65520 以上は丸めると half の最大値を超える
+					return (uint16_t)(sign | 0x7C00u);
+				}
+				if (absBits < 0x38800000u)
+				{
+					// half の非正規化数（2^-14 未満）。仮数に暗黙の1を足してからずらす
+					if (absBits < 0x33000000u) return (uint16_t)sign;
+					const uint32_t exponent = absBits >> 23;
+					const uint32_t mantissa = (absBits & 0x007FFFFFu) | 0x00800000u;
+					const uint32_t shift = 126 - exponent;
+					uint32_t half = mantissa >> shift;
+					const uint32_t rest = mantissa & ((1u << shift) - 1);
+					const uint32_t halfway = 1u << (shift - 1);
+					if (rest > halfway || (rest == halfway && (half & 1u))) ++half;
+					return (uint16_t)(sign | half);
+				}
+
+				// 正規化数: 指数の偏りを 127 → 15 に付け替え、下位13bitを丸める
+				uint32_t half = (absBits - 0x38000000u) >> 13;
+				const uint32_t rest = absBits & 0x1FFFu;
+				if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) ++half;
+				return (uint16_t)(sign | half);
+			}
+
+			uint32_t PackHalf2(float x, float y)
+			{
+				return (uint32_t)FloatToHalf(x) | ((uint32_t)FloatToHalf(y) << 16);
+			}
+
+			// ウェイトを合計255になるよう量子化（丸め誤差は一番大きい要素に寄せる）
+			uint32_t PackWeights(const MeshFloat4& weight)
+			{
+				float w[4] = { std::max(weight.x, 0.0f), std::max(weight.y, 0.0f), std::max(weight.z, 0.0f), std::max(weight.w, 0.0f) };
+				float total = w[0] + w[1] + w[2] + w[3];
+				if (total <= 0.0f) return 0;	// シェーダー側で (1,0,0,0) 扱い
+
+				int q[4];
+				int sum = 0;
+				int largest = 0;
+				for (int i = 0; i < 4; ++i)
+				{
+					q[i] = (int)lroundf(w[i] / total * 255.0f);
+					sum += q[i];
+					if (w[i] > w[largest]) largest = i;
+				}
+				q[largest] = std::clamp(q[largest] + (255 - sum), 0, 255);
+
+				return (uint32_t)q[0] | ((uint32_t)q[1] << 8) | ((uint32_t)q[2] << 16) | ((uint32_t)q[3] << 24);
+			}
+		}
+
+		size_t WeldVertices(std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices)
+		{
+			if (vertices.empty()) return 0;
+
+			// Vertex はパディングの無い4バイト要素のみなので、バイト列で比較できる
+			static_assert(sizeof(MeshVertex) == 80, "MeshVertex layout changed");
+
+			size_t tableSize = 1;
+			while (tableSize < vertices.size() * 2) tableSize <<= 1;
+			std::vector<uint32_t> table(tableSize, INVALID);
+
+			std::vector<MeshVertex> unique;
+			unique.reserve(vertices.size());
+			std::vector<uint32_t> remap(vertices.size());
+
+			for (size_t i = 0; i < vertices.size(); ++i)
+			{
+				const MeshVertex& v = vertices[i];
+				size_t slot = (size_t)Hash::Fnv1a64(&v, sizeof(v)) & (tableSize - 1);
+
+				while (true)
+				{
+					uint32_t found = table[slot];
+					if (found == INVALID)
+					{
+						found = (uint32_t)unique.size();
+						table[slot] = found;
+						unique.push_back(v);
+						remap[i] = found;
+						break;
+					}
+					if (memcmp(&unique[found], &v, sizeof(v)) == 0)
+					{
+						remap[i] = found;
+						break;
+					}
+					slot = (slot + 1) & (tableSize - 1);
+				}
+			}
+
+			for (auto& index : indices) index = remap[index];
+
+			size_t removed = vertices.size() - unique.size();
+			vertices.swap(unique);
+			return removed;
+		}
+
+		void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount)
+		{
+			const size_t triangleCount = indices.size() / 3;
+			if (triangleCount == 0 || vertexCount == 0) return;
+
+			// 頂点 → 三角形の隣接リスト（未出力の三角形だけを [offset, offset + remaining) に詰めて持つ）
+			std::vector<uint32_t> remaining(vertexCount, 0);
+			for (uint32_t index : indices) ++remaining[index];
+
+			std::vector<uint32_t> offsets(vertexCount + 1, 0);
+			for (size_t v = 0; v < vertexCount; ++v) offsets[v + 1] = offsets[v] + remaining[v];
+
+			std::vector<uint32_t> adjacency(triangleCount * 3);
+			{
+				std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+				for (size_t t = 0; t < triangleCount; ++t)
+				{
+					for (int k = 0; k < 3; ++k) adjacency[cursor[indices[t * 3 + k]]++] = (uint32_t)t;
+				}
+			}
+
+			std::vector<int> cachePosition(vertexCount, -1);
+			std::vector<float> vertexScore(vertexCount);
+			for (size_t v = 0; v < vertexCount; ++v) vertexScore[v] = VertexScore(-1, remaining[v]);
+
+			std::vector<float> triangleScore(triangleCount);
+			std::vector<uint8_t> emitted(triangleCount, 0);
+			size_t best = 0;
+			for (size_t t = 0; t < triangleCount; ++t)
+			{
+				triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+				if (triangleScore[t] > triangleScore[best]) best = t;
+			}
+
+			std::vector<uint32_t> result;
+			result.reserve(indices.size());
+
+			uint32_t cache[CACHE_SIZE + 3];
+			int cacheCount = 0;
+			size_t scanCursor = 0;
+
+			for (size_t n = 0; n < triangleCount; ++n)
+			{
+				// キャッシュ内の頂点に繋がる三角形が無ければ、未出力の先頭から再開
+				if (best == SIZE_MAX)
+				{
+					while (emitted[scanCursor]) ++scanCursor;
+					best = scanCursor;
+				}
+
+				const uint32_t* tri = &indices[best * 3];
+				emitted[best] = 1;
+				result.insert(result.end(), tri, tri + 3);
+
+				// 隣接リストから外す
+				for (int k = 0; k < 3; ++k)
+				{
+					uint32_t v = tri[k];
+					uint32_t* begin = &adjacency[offsets[v]];
+					uint32_t* end = begin + remaining[v];
+					uint32_t* it = std::find(begin, end, (uint32_t)best);
+					if (it != end)
+					{
+						std::swap(*it, *(end - 1));
+						--remaining[v];
+					}
+				}
+
+				// 使った3頂点をキャッシュの先頭へ（LRU）
+				uint32_t newCache[CACHE_SIZE + 3];
+				int newCount = 0;
+				for (int k = 0; k < 3; ++k) newCache[newCount++] = tri[k];
+				for (int i = 0; i < cacheCount; ++i)
+				{
+					uint32_t v = cache[i];
+					if (v != tri[0] && v != tri[1] && v != tri[2]) newCache[newCount++] = v;
+				}
+
+				// スコア更新（キャッシュから押し出された頂点も含む）
+				for (int i = 0; i < newCount; ++i)
+				{
+					uint32_t v = newCache[i];
+					cachePosition[v] = (i < CACHE_SIZE) ? i : -1;
+					vertexScore[v] = VertexScore(cachePosition[v], remaining[v]);
+				}
+
+				best = SIZE_MAX;
+				float bestScore = -FLT_MAX;
+				for (int i = 0; i < newCount; ++i)
+				{
+					uint32_t v = newCache[i];
+					for (uint32_t a = 0; a < remaining[v]; ++a)
+					{
+						uint32_t t = adjacency[offsets[v] + a];
+						triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+						if (triangleScore[t] > bestScore)
+						{
+							bestScore = triangleScore[t];
+							best = t;
+						}
+					}
+				}
+
+				cacheCount = std::min(newCount, CACHE_SIZE);
+				std::copy(newCache, newCache + cacheCount, cache);
+			}
+
+			indices.swap(result);
+		}
+
+		void OptimizeVertexFetch(std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices)
+		{
+			std::vector<uint32_t> remap(vertices.size(), INVALID);
+			std::vector<MeshVertex> ordered;
+			ordered.reserve(vertices.size());
+
+			for (auto& index : indices)
+			{
+				if (remap[index] == INVALID)
+				{
+					remap[index] = (uint32_t)ordered.size();
+					ordered.push_back(vertices[index]);
+				}
+				index = remap[index];
+			}
+
+			vertices.swap(ordered);
+		}
+
+		void Pack(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices, bool skinned, PackedMesh& out)
+		{
+			out.vertices.resize(vertices.size());
+			out.skin.resize(skinned ? vertices.size() : 0);
+
+			for (size_t i = 0; i < vertices.size(); ++i)
+			{
+				const auto& src = vertices[i];
+				auto& dst = out.vertices[i];
+				dst.pos = src.pos;
+				dst.normal = PackSnorm8(src.normal.x, src.normal.y, src.normal.z, 0.0f);
+				dst.uv = PackHalf2(src.uv.x, src.uv.y);
+				dst.color = PackUnorm8(src.color.x, src.color.y, src.color.z, src.color.w);
+
+				if (skinned)
+				{
+					// ModelRenderer::MAX_BONES (200) に収まるので8bitで足りる
+					auto& skin = out.skin[i];
+					skin.weight = PackWeights(src.weight);
+					skin.index = std::min(src.index[0], 255u) | (std::min(src.index[1], 255u) << 8) |
+						(std::min(src.index[2], 255u) << 16) | (std::min(src.index[3], 255u) << 24);
+				}
+			}
+
+			out.indices16.clear();
+			out.indices32.clear();
+			if (vertices.size() <= 0xFFFF)
+			{
+				out.indices16.assign(indices.begin(), indices.end());
+			}
+			else
+			{
+				out.indices32 = indices;
+			}
+		}
+
+		void Process(std::vector<MeshVertex> vertices, std::vector<uint32_t> indices, bool skinned, PackedMesh& out)
+		{
+			WeldVertices(vertices, indices);
+			OptimizeVertexCache(indices, vertices.size());
+			OptimizeVertexFetch(vertices, indices);
+			Pack(vertices, indices, skinned, out);
+		}
+
+	}	// namespace MeshOptimizer
+
+}	// namespace Arche
@@ -0,0 +1,93 @@
+﻿/*****************************************************************//**
+ * @file	MeshOptimizer.h
+ * @brief	インポート時のメッシュ最適化（CPUのみ）
+ *
+ * @details	Assimp から得た三角形リストに対して以下を行う。
+ *			1. WeldVertices			: 全属性が一致する頂点を1つにまとめる
+ *			2. OptimizeVertexCache	: 変換後頂点キャッシュが効くよう三角形を並べ替える（Forsyth法）
+ *			3. OptimizeVertexFetch	: 頂点を初めて参照される順に並べ替える（未使用頂点は削除）
+ *			4. Pack					: 描画用の圧縮頂点（StaticVertex / SkinVertex）に変換し、
+ *									  頂点数が 65535 以下なら16bitインデックスにする
+ *			デバイスには触れないので、どのスレッドからでも呼べる。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___MESH_OPTIMIZER_H___
+#define ___MESH_OPTIMIZER_H___
+
+// ===== インクルード =====
+// 標準ライブラリだけで書く（pch.h を含めず、Tests/ からも使えるように）
+#include "Engine/Renderer/Data/MeshVertex.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Arche
+{
+	// 描画用の頂点とインデックスへの参照（PackedMesh か、マップしたクック済みファイルを指す）
+	struct PackedMeshView
+	{
+		std::span<const StaticMeshVertex> vertices;
+		std::span<const SkinMeshVertex> skin;	// スキンメッシュ以外は空
+		const void* indices = nullptr;
+		size_t indexCount = 0;
+		uint32_t indexSize = 2;
+
+		size_t GetByteSize() const { return vertices.size_bytes() + skin.size_bytes() + indexCount * indexSize; }
+	};
+
+	// 描画用に圧縮したメッシュデータ
+	struct PackedMesh
+	{
+		std::vector<StaticMeshVertex> vertices;
+		std::vector<SkinMeshVertex> skin;	// スキンメッシュ以外は空
+		std::vector<uint16_t> indices16;			// 頂点数が 65535 以下のとき
+		std::vector<uint32_t> indices32;			// それ以外
+
+		size_t GetVertexCount() const { return vertices.size(); }
+		size_t GetIndexCount() const { return indices16.empty() ? indices32.size() : indices16.size(); }
+		uint32_t GetIndexSize() const { return indices32.empty() ? 2 : 4; }
+		const void* GetIndexData() const { return indices32.empty() ? (const void*)indices16.data() : (const void*)indices32.data(); }
+		size_t GetByteSize() const
+		{
+			return vertices.size() * sizeof(StaticMeshVertex) + skin.size() * sizeof(SkinMeshVertex) +
+				indices16.size() * sizeof(uint16_t) + indices32.size() * sizeof(uint32_t);
+		}
+
+		PackedMeshView GetView() const
+		{
+			PackedMeshView view;
+			view.vertices = vertices;
+			view.skin = skin;
+			view.indices = GetIndexData();
+			view.indexCount = GetIndexCount();
+			view.indexSize = GetIndexSize();
+			return view;
+		}
+	};
+
+	namespace MeshOptimizer
+	{
+		// Forsyth法で想定するキャッシュサイズ
+		static constexpr int CACHE_SIZE = 32;
+
+		// @return	削除した頂点数
+		size_t WeldVertices(std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices);
+		void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+		void OptimizeVertexFetch(std::vector<MeshVertex>& vertices, std::vector<uint32_t>& indices);
+
+		// @param	skinned	false ならスキニング用ストリームを作らない
+		void Pack(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices, bool skinned, PackedMesh& out);
+
+		// 上記をすべて順に行う
+		void Process(std::vector<MeshVertex> vertices, std::vector<uint32_t> indices, bool skinned, PackedMesh& out);
+
+	}	// namespace MeshOptimizer
+
+}	// namespace Arche
+
+#endif // !___MESH_OPTIMIZER_H___
@@ -0,0 +1,60 @@
+﻿/*****************************************************************//**
+ * @file	MeshVertex.h
+ * @brief	メッシュの頂点レイアウト（インポート用と描画用）
+ *
+ * @details	MeshBuffer と MeshOptimizer が共有する。
+ *			メンバーの並びとサイズは DirectX::XMFLOAT2/3/4 と同じで、シェーダーの入力レイアウトもこれに合わせている。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___MESH_VERTEX_H___
+#define ___MESH_VERTEX_H___
+
+// ===== インクルード =====
+// 標準ライブラリだけで書く（pch.h を含めず、Tests/ からも使えるように）
+#include <cstdint>
+
+namespace Arche
+{
+	struct MeshFloat2 { float x, y; };
+	struct MeshFloat3 { float x, y, z; };
+	struct MeshFloat4 { float x, y, z, w; };
+
+	// インポート時の頂点（アニメーション対応）
+	struct MeshVertex
+	{
+		MeshFloat3 pos;
+		MeshFloat3 normal;
+		MeshFloat2 uv;
+		MeshFloat4 color;
+		MeshFloat4 weight;		// ボーンウェイト
+		uint32_t index[4];		// ボーンインデックス (uint4として扱う)
+	};
+
+	// 描画用の圧縮頂点（インポート時に MeshVertex から変換する。MeshOptimizer 参照）
+	// ストリーム0: 全メッシュ共通
+	struct StaticMeshVertex
+	{
+		MeshFloat3 pos;
+		uint32_t normal;		// SNORM8 x4 (xyz, w=0)
+		uint32_t uv;			// FLOAT16 x2
+		uint32_t color;			// UNORM8 x4
+	};
+
+	// ストリーム1: スキンメッシュのみ
+	struct SkinMeshVertex
+	{
+		uint32_t weight;		// UNORM8 x4（合計255）
+		uint32_t index;			// UINT8 x4
+	};
+
+	static_assert(sizeof(MeshVertex) == 80, "MeshVertex layout changed");
+	static_assert(sizeof(StaticMeshVertex) == 24, "StaticMeshVertex layout changed");
+	static_assert(sizeof(SkinMeshVertex) == 8, "SkinMeshVertex layout changed");
+
+}	// namespace Arche
+
+#endif // !___MESH_VERTEX_H___
@@ -3,6 +3,9 @@
 #include "Model.h"
 #include "Engine/Core/Application.h"
 #include "Engine/Resource/ResourceManager.h"
+#include "Engine/Resource/VirtualFileSystem.h"
+#include "Engine/Renderer/Data/CookedMesh.h"
+#include "Engine/Core/Base/Hash.h"
 
 #if defined(_DEBUG)
 #pragma comment(lib, "assimp-vc143-mtd.lib")
@@ -21,19 +24,65 @@ namespace Arche
 		);
 	}
 
+	// AiToXM と同じ並び（転置）で SkinMatrix に詰める
+	static SkinMatrix AiToSkin(const aiMatrix4x4& m) {
+		SkinMatrix out;
+		for (int r = 0; r < 4; ++r)
+			for (int c = 0; c < 4; ++c)
+				out.m[r][c] = m[c][r];
+		return out;
+	}
+
+	// パックに入っているファイルはメモリから読ませる
+	// （.obj の .mtl のような外部参照は解決できないので、パックにはクック済みの .amesh も入れておく）
+	static const aiScene* ReadSceneFile(Assimp::Importer& importer, const std::string& filename, unsigned int flags)
+	{
+		if (!VirtualFileSystem::Instance().IsArchived(filename)) return importer.ReadFile(filename, flags);
+
+		FileView file;
+		if (!VirtualFileSystem::Instance().Open(filename, file)) return nullptr;
+		std::string hint = std::filesystem::path(filename).extension().string();
+		if (!hint.empty() && hint[0] == '.') hint.erase(0, 1);
+		return importer.ReadFileFromMemory(file.GetData(), file.GetSize(), flags, hint.c_str());
+	}
+
 	Model::Model() {}
 	Model::~Model() { Reset(); }
 
+	ResourceMemory Model::GetMemoryUsage() const
+	{
+		ResourceMemory memory;
+		for (const auto& mesh : m_meshes) {
+			uint64_t bytes = mesh.GetData().GetByteSize();
+			memory.cpuBytes += bytes + mesh.bones.size() * sizeof(Bone);
+			if (mesh.pMesh) memory.gpuBytes += bytes;
+		}
+		for (const auto& anim : m_animes) {
+			for (const auto& ch : anim.channels) {
+				memory.cpuBytes += (ch.positionKeys.size() + ch.scalingKeys.size()) * sizeof(std::pair<float, XMFLOAT3>) +
+					ch.rotationKeys.size() * sizeof(std::pair<float, XMFLOAT4>);
+			}
+		}
+		// 姿勢 (SoA 10要素 × 4本) と行列バッファ
+		memory.cpuBytes += m_currentPose.PaddedCount() * sizeof(float) * 10 * 4;
+		memory.cpuBytes += (m_localMatrices.size() + m_nodeMatrices.size() + m_nodes.size()) * sizeof(XMMATRIX);
+		return memory;
+	}
+
 	void Model::Reset() {
 		for (auto& m : m_meshes) { if (m.pMesh) delete m.pMesh; }
 		m_meshes.clear();
 		m_materials.clear();
 		m_nodes.clear();
 		m_animes.clear();
-		m_currentTransforms.clear();
-		m_defaultTransforms.clear();
+		m_currentPose.Resize(0);
+		m_defaultPose.Resize(0);
+		m_parentIndices.clear();
+		m_localMatrices.clear();
+		m_nodeMatrices.clear();
 		m_playNo = ANIME_NONE;
 		m_nextPlayNo = ANIME_NONE;
+		m_cookedFile.Close();
 	}
 
 	bool Model::LoadSync(const std::string& filename, float scale, Flip flip)
@@ -44,13 +93,37 @@ namespace Arche
 	}
 
 	bool Model::LoadCPU(const std::string& filename, float scale, Flip flip)
+	{
+		// ソースより新しいクック済みファイルがあればそちらを使う
+		// （パックに入っているものはビルド時に最新にしてあるのでそのまま使う）
+		std::string cookedPath = CookedMesh::GetCookedPath(filename);
+		if (VirtualFileSystem::Instance().IsArchived(cookedPath) || CookedMesh::IsUpToDate(cookedPath, filename))
+		{
+			if (LoadCooked(cookedPath, scale, flip, CookedMesh::VERIFY_ON_LOAD)) return true;
+			Logger::LogWarning("Cooked mesh is invalid, loading source instead: " + cookedPath);
+		}
+
+		return LoadSource(filename, scale, flip);
+	}
+
+	bool Model::LoadSource(const std::string& filename, float scale, Flip flip)
+	{
+		return ImportSource(filename, scale, flip, true);
+	}
+
+	bool Model::LoadSourceForCook(const std::string& filename)
+	{
+		return ImportSource(filename, 1.0f, None, false);
+	}
+
+	bool Model::ImportSource(const std::string& filename, float scale, Flip flip, bool requestTextures)
 	{
 		Reset();
 		Assimp::Importer importer;
 		importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_PRESERVE_PIVOTS, false);
 		unsigned int flags = aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_FlipWindingOrder | aiProcess_LimitBoneWeights | aiProcess_OptimizeGraph;
 
-		const aiScene* pScene = importer.ReadFile(filename, flags);
+		const aiScene* pScene = ReadSceneFile(importer, filename, flags);
 		if (!pScene) return false;
 
 		if (scale < 0.001f || scale > 1000.0f) m_loadScale = 1.0f;
@@ -64,7 +137,7 @@ namespace Arche
 
 		MakeBoneNodes(pScene);
 		MakeMesh(pScene, scale, flip);
-		MakeMaterial(pScene, dir);
+		MakeMaterial(pScene, dir, requestTextures);
 
 		if (pScene->HasAnimations()) {
 			for (unsigned int i = 0; i < pScene->mNumAnimations; ++i)
@@ -122,11 +195,14 @@ namespace Arche
 		// メッシュバッファの作成
 		for (auto& mesh : m_meshes)
 		{
-			if (mesh.pMesh == nullptr && !mesh.vertices.empty())
+			// クック済みファイルから読んだものはマップ上のデータをそのまま渡す
+			const PackedMeshView data = mesh.GetData();
+			if (mesh.pMesh == nullptr && !data.vertices.empty())
 			{
 				MeshBuffer::Description desc = {};
-				desc.pVtx = mesh.vertices.data(); desc.vtxSize = sizeof(MeshBuffer::Vertex); desc.vtxCount = (UINT)mesh.vertices.size();
-				desc.pIdx = mesh.indices.data(); desc.idxSize = 4; desc.idxCount = (UINT)mesh.indices.size();
+				desc.pVtx = const_cast<MeshBuffer::StaticVertex*>(data.vertices.data()); desc.vtxSize = sizeof(MeshBuffer::StaticVertex); desc.vtxCount = (UINT)data.vertices.size();
+				desc.pIdx = const_cast<void*>(data.indices); desc.idxSize = data.indexSize; desc.idxCount = (UINT)data.indexCount;
+				if (!data.skin.empty()) { desc.pSkin = const_cast<MeshBuffer::SkinVertex*>(data.skin.data()); desc.skinSize = sizeof(MeshBuffer::SkinVertex); }
 				desc.topology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST; desc.isWrite = false;
 				mesh.pMesh = new MeshBuffer();
 				mesh.pMesh->Create(desc);
@@ -150,7 +226,6 @@ namespace Arche
 		std::function<int(aiNode*, int)> Rec = [&](aiNode* node, int parent) -> int {
 			Node n; n.name = node->mName.C_Str(); n.parent = parent;
 			n.localMat = AiToXM(node->mTransformation);
-			n.mat = XMMatrixIdentity();
 			m_nodes.push_back(n);
 			int idx = (int)m_nodes.size() - 1;
 			for (unsigned int i = 0; i < node->mNumChildren; ++i) {
@@ -161,23 +236,29 @@ namespace Arche
 			};
 		if (pScene->mRootNode) Rec(pScene->mRootNode, -1);
 
-		m_currentTransforms.resize(m_nodes.size());
-		m_defaultTransforms.resize(m_nodes.size());
+		// 深さ優先で登録しているため、親は必ず子より前のインデックスになる
+		BuildPoseData();
+	}
+
+	void Model::BuildPoseData() {
+		m_parentIndices.resize(m_nodes.size());
+		for (size_t i = 0; i < m_nodes.size(); ++i) m_parentIndices[i] = m_nodes[i].parent;
+		m_localMatrices.resize(m_nodes.size());
+		m_nodeMatrices.resize(m_nodes.size(), XMMatrixIdentity());
 
+		// デコンプに失敗したノードは単位姿勢のまま
+		m_defaultPose.Resize(m_nodes.size());
 		for (size_t i = 0; i < m_nodes.size(); ++i) {
 			XMVECTOR S, R, T;
 			if (XMMatrixDecompose(&S, &R, &T, m_nodes[i].localMat)) {
-				XMStoreFloat3(&m_defaultTransforms[i].scale, S);
-				XMStoreFloat4(&m_defaultTransforms[i].quaternion, R);
-				XMStoreFloat3(&m_defaultTransforms[i].translate, T);
+				XMFLOAT3 s, t; XMFLOAT4 q;
+				XMStoreFloat3(&s, S); XMStoreFloat4(&q, R); XMStoreFloat3(&t, T);
+				m_defaultPose.SetScale(i, s);
+				m_defaultPose.SetRotation(i, q);
+				m_defaultPose.SetTranslation(i, t);
 			}
-			else {
-				m_defaultTransforms[i].scale = { 1, 1, 1 };
-				m_defaultTransforms[i].quaternion = { 0, 0, 0, 1 };
-				m_defaultTransforms[i].translate = { 0, 0, 0 };
-			}
-			m_currentTransforms[i] = m_defaultTransforms[i];
 		}
+		PoseKernel::Copy(m_defaultPose, m_currentPose);
 		UpdateNodeTransforms();
 	}
 
@@ -186,9 +267,13 @@ namespace Arche
 		for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
 			const aiMesh* pAiMesh = pScene->mMeshes[i];
 			Mesh& mesh = m_meshes[i];
-			mesh.vertices.resize(pAiMesh->mNumVertices);
+
+			// 展開した頂点を一旦作り、最適化・圧縮してから保持する
+			std::vector<MeshBuffer::Vertex> vertices(pAiMesh->mNumVertices);
+			std::vector<uint32_t> indices;
+			indices.reserve((size_t)pAiMesh->mNumFaces * 3);
 			for (unsigned int v = 0; v < pAiMesh->mNumVertices; ++v) {
-				auto& vert = mesh.vertices[v];
+				auto& vert = vertices[v];
 				vert.pos = { pAiMesh->mVertices[v].x, pAiMesh->mVertices[v].y, pAiMesh->mVertices[v].z };
 				if (pAiMesh->HasNormals()) vert.normal = { pAiMesh->mNormals[v].x, pAiMesh->mNormals[v].y, pAiMesh->mNormals[v].z };
 				if (pAiMesh->HasTextureCoords(0)) vert.uv = { pAiMesh->mTextureCoords[0][v].x, pAiMesh->mTextureCoords[0][v].y };
@@ -197,16 +282,18 @@ namespace Arche
 			}
 			for (unsigned int f = 0; f < pAiMesh->mNumFaces; ++f) {
 				const aiFace& face = pAiMesh->mFaces[f];
-				if (face.mNumIndices == 3) { mesh.indices.push_back(face.mIndices[0]); mesh.indices.push_back(face.mIndices[1]); mesh.indices.push_back(face.mIndices[2]); }
+				if (face.mNumIndices == 3) { indices.push_back(face.mIndices[0]); indices.push_back(face.mIndices[1]); indices.push_back(face.mIndices[2]); }
 			}
 			mesh.materialID = pAiMesh->mMaterialIndex;
-			MakeWeight(pScene, i);
+			MakeWeight(pScene, i, vertices);
+
+			MeshOptimizer::Process(std::move(vertices), std::move(indices), !mesh.bones.empty(), mesh.packed);
 
 			// ★削除: pMeshのnewはUploadGPUで行うためここではしない
 		}
 	}
 
-	void Model::MakeMaterial(const aiScene* pScene, const std::string& directory) {
+	void Model::MakeMaterial(const aiScene* pScene, const std::string& directory, bool requestTextures) {
 		m_materials.resize(pScene->mNumMaterials);
 		for (unsigned int i = 0; i < pScene->mNumMaterials; ++i) {
 			const aiMaterial* pMat = pScene->mMaterials[i];
@@ -221,12 +308,13 @@ namespace Arche
 				mat.texturePath = directory + file;
 
 				// 自動的に非同期ロードリクエストを投げても良いが、今回はUploadGPUで解決する
-				ResourceManager::Instance().LoadTextureAsync(mat.texturePath);
+				// クック時はパスを記録するだけ（.amesh に書き出す）
+				if (requestTextures) ResourceManager::Instance().LoadTextureAsync(mat.texturePath);
 			}
 		}
 	}
 
-	void Model::MakeWeight(const aiScene* pScene, int meshIdx)
+	void Model::MakeWeight(const aiScene* pScene, int meshIdx, std::vector<MeshBuffer::Vertex>& vertices)
 	{
 		const aiMesh* pAiMesh = pScene->mMeshes[meshIdx];
 		Mesh& mesh = m_meshes[meshIdx];
@@ -234,7 +322,7 @@ namespace Arche
 		if (!pAiMesh->HasBones()) return;
 
 		struct WInfo { UINT id; float w; };
-		std::vector<std::vector<WInfo>> vWeights(mesh.vertices.size());
+		std::vector<std::vector<WInfo>> vWeights(vertices.size());
 
 		mesh.bones.clear();
 
@@ -260,7 +348,7 @@ namespace Arche
 			// 有効なボーンとして登録
 			Bone newBone;
 			newBone.index = (int)std::distance(m_nodes.begin(), it);
-			newBone.invOffset = AiToXM(pBone->mOffsetMatrix);
+			newBone.invOffset = AiToSkin(pBone->mOffsetMatrix);
 			mesh.bones.push_back(newBone);
 
 			// 現在の登録数（インデックス）を取得
@@ -273,15 +361,15 @@ namespace Arche
 				vWeights[pBone->mWeights[w].mVertexId].push_back({ currentBoneIndex, pBone->mWeights[w].mWeight });
 			}
 		}
-		for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+		for (size_t i = 0; i < vertices.size(); ++i) {
 			auto& ws = vWeights[i];
 			std::sort(ws.begin(), ws.end(), [](auto& a, auto& b) { return a.w > b.w; });
 			float total = 0.0f; for (int k = 0; k < 4 && k < ws.size(); ++k) total += ws[k].w;
 			if (total > 0) {
-				if (ws.size() > 0) { mesh.vertices[i].weight.x = ws[0].w / total; mesh.vertices[i].index[0] = ws[0].id; }
-				if (ws.size() > 1) { mesh.vertices[i].weight.y = ws[1].w / total; mesh.vertices[i].index[1] = ws[1].id; }
-				if (ws.size() > 2) { mesh.vertices[i].weight.z = ws[2].w / total; mesh.vertices[i].index[2] = ws[2].id; }
-				if (ws.size() > 3) { mesh.vertices[i].weight.w = ws[3].w / total; mesh.vertices[i].index[3] = ws[3].id; }
+				if (ws.size() > 0) { vertices[i].weight.x = ws[0].w / total; vertices[i].index[0] = ws[0].id; }
+				if (ws.size() > 1) { vertices[i].weight.y = ws[1].w / total; vertices[i].index[1] = ws[1].id; }
+				if (ws.size() > 2) { vertices[i].weight.z = ws[2].w / total; vertices[i].index[2] = ws[2].id; }
+				if (ws.size() > 3) { vertices[i].weight.w = ws[3].w / total; vertices[i].index[3] = ws[3].id; }
 			}
 		}
 	}
@@ -306,7 +394,7 @@ namespace Arche
 
 		// 3. キャッシュになければディスクから同期読み込み (カクつきの原因だが、安全策として残す)
 		Assimp::Importer importer;
-		const aiScene* pScene = importer.ReadFile(filename, 0);
+		const aiScene* pScene = ReadSceneFile(importer, filename, 0);
 		if (!pScene || !pScene->HasAnimations()) return ANIME_NONE;
 
 		// 1つ目のアニメーションを読み込む
@@ -502,8 +590,6 @@ namespace Arche
 		}
 
 		// 2. 見つからない場合、外部ファイルとしてロードを試みる
-		namespace fs = std::filesystem;
-
 		// 検索パスの候補
 		std::vector<std::string> searchPaths = {
 			animName,									// そのまま
@@ -513,7 +599,7 @@ namespace Arche
 
 		for (const auto& path : searchPaths)
 		{
-			if (fs::exists(path))
+			if (VirtualFileSystem::Instance().Exists(path) || VirtualFileSystem::Instance().Exists(CookedMesh::GetCookedPath(path)))
 			{
 				// ファイルが見つかったら追加ロード
 				AnimeNo newNo = AddAnimation(path);
@@ -529,8 +615,11 @@ namespace Arche
 		}
 	}
 
-	void Model::Step(float deltaTime)
+	void Model::Step(float deltaTime, const std::vector<uint8_t>* nodeMask)
 	{
+		// マスクがノード数と合わなければ全ノード評価
+		if (nodeMask && nodeMask->size() != m_nodes.size()) nodeMask = nullptr;
+
 		// 1. 現在のアニメーション進行
 		if (m_playNo != ANIME_NONE) {
 			Animation& anim = m_animes[m_playNo];
@@ -563,37 +652,78 @@ namespace Arche
 				m_nextPlayNo = ANIME_NONE;
 
 				// 最終姿勢を適用
-				EvaluateAnimation(m_playNo, m_animes[m_playNo].nowTime, m_currentTransforms);
+				EvaluateAnimation(m_playNo, m_animes[m_playNo].nowTime, m_currentPose, nodeMask);
 			}
 			else
 			{
 				// ブレンド計算
-				// バッファ確保
-				if (m_blendSrcTransforms.size() != m_nodes.size()) m_blendSrcTransforms.resize(m_nodes.size());
-				if (m_blendDstTransforms.size() != m_nodes.size()) m_blendDstTransforms.resize(m_nodes.size());
-
 				// 両方の姿勢を計算
-				EvaluateAnimation(m_playNo, m_animes[m_playNo].nowTime, m_blendSrcTransforms);
-				EvaluateAnimation(m_nextPlayNo, m_animes[m_nextPlayNo].nowTime, m_blendDstTransforms);
+				EvaluateAnimation(m_playNo, m_animes[m_playNo].nowTime, m_blendSrcPose, nodeMask);
+				EvaluateAnimation(m_nextPlayNo, m_animes[m_nextPlayNo].nowTime, m_blendDstPose, nodeMask);
 
-				// ブレンドして m_currentTransforms に格納
-				BlendTransforms(m_blendSrcTransforms, m_blendDstTransforms, t, m_currentTransforms);
+				// ブレンドして m_currentPose に格納
+				PoseKernel::Blend(m_blendSrcPose, m_blendDstPose, t, m_currentPose);
 			}
 		}
 		else if (m_playNo != ANIME_NONE)
 		{
 			// 通常再生
-			EvaluateAnimation(m_playNo, m_animes[m_playNo].nowTime, m_currentTransforms);
+			EvaluateAnimation(m_playNo, m_animes[m_playNo].nowTime, m_currentPose, nodeMask);
 		}
 
 		UpdateNodeTransforms();
 	}
 
-	void Model::EvaluateAnimation(AnimeNo no, float time, std::vector<TransformData>& outTransforms)
+	bool Model::BuildSubtreeMask(const std::string& rootNodeName, std::vector<uint8_t>& outMask) const
 	{
-		// デフォルト姿勢で初期化
-		if (outTransforms.size() != m_nodes.size()) outTransforms = m_defaultTransforms;
-		else std::copy(m_defaultTransforms.begin(), m_defaultTransforms.end(), outTransforms.begin());
+		outMask.clear();
+		if (rootNodeName.empty()) return false;
+		outMask.assign(m_nodes.size(), 0);
+
+		int root = -1;
+		for (size_t i = 0; i < m_nodes.size(); ++i)
+		{
+			// "mixamorig:Spine" のような接頭辞付きの名前も末尾一致で拾う
+			const std::string& name = m_nodes[i].name;
+			if (name.size() >= rootNodeName.size() &&
+				name.compare(name.size() - rootNodeName.size(), rootNodeName.size(), rootNodeName) == 0)
+			{
+				root = (int)i;
+				break;
+			}
+		}
+		if (root < 0) { outMask.clear(); return false; }
+
+		// 祖先（腰など）も含める
+		for (int n = root; n >= 0; n = m_nodes[n].parent) outMask[n] = 1;
+
+		// 子孫は親が必ず前にあるので1パスで伝播できる
+		for (size_t i = (size_t)root + 1; i < m_nodes.size(); ++i)
+		{
+			int parent = m_nodes[i].parent;
+			if (parent >= root && outMask[parent]) outMask[i] = 1;
+		}
+		return true;
+	}
+
+	void Model::EvaluateAnimation(AnimeNo no, float time, PoseBuffer& outPose, const std::vector<uint8_t>* nodeMask)
+	{
+		if (!nodeMask || outPose.count != m_defaultPose.count)
+		{
+			// デフォルト姿勢で初期化
+			PoseKernel::Copy(m_defaultPose, outPose);
+		}
+		else
+		{
+			// マスク対象のノードだけ初期化（それ以外は前回の姿勢を保持）
+			for (size_t i = 0; i < outPose.count; ++i)
+			{
+				if (!(*nodeMask)[i]) continue;
+				outPose.SetTranslation(i, m_defaultPose.GetTranslation(i));
+				outPose.SetRotation(i, m_defaultPose.GetRotation(i));
+				outPose.SetScale(i, m_defaultPose.GetScale(i));
+			}
+		}
 
 		if (no < 0 || no >= (int)m_animes.size()) return;
 
@@ -601,8 +731,9 @@ namespace Arche
 
 		for (const auto& ch : anim.channels)
 		{
-			if (ch.nodeIndex < 0 || ch.nodeIndex >= (int)outTransforms.size()) continue;
-			TransformData& trans = outTransforms[ch.nodeIndex];
+			if (ch.nodeIndex < 0 || ch.nodeIndex >= (int)outPose.count) continue;
+			size_t node = (size_t)ch.nodeIndex;
+			if (nodeMask && !(*nodeMask)[node]) continue;
 
 			// Position
 			if (!ch.positionKeys.empty()) {
@@ -622,7 +753,7 @@ namespace Arche
 				if (t < 0.0f) t += anim.totalTime;
 				t = (dt > 0.0001f) ? t / dt : 0.0f;
 				t = std::max(0.0f, std::min(t, 1.0f));
-				trans.translate = Lerp3(prevKey.second, nextKey.second, t);
+				outPose.SetTranslation(node, Lerp3(prevKey.second, nextKey.second, t));
 			}
 
 			// Rotation
@@ -642,7 +773,7 @@ namespace Arche
 				if (t < 0.0f) t += anim.totalTime;
 				t = (dt > 0.0001f) ? t / dt : 0.0f;
 				t = std::max(0.0f, std::min(t, 1.0f));
-				trans.quaternion = Slerp4(prevKey.second, nextKey.second, t);
+				outPose.SetRotation(node, Slerp4(prevKey.second, nextKey.second, t));
 			}
 
 			// Scale
@@ -657,23 +788,11 @@ namespace Arche
 				const auto& prevKey = ch.scalingKeys[prevIdx];
 				float dt = nextKey.first - prevKey.first;
 				float t = (dt > 0.0001f) ? (time - prevKey.first) / dt : 0.0f;
-				trans.scale = Lerp3(prevKey.second, nextKey.second, t);
+				outPose.SetScale(node, Lerp3(prevKey.second, nextKey.second, t));
 			}
 		}
 	}
 
-	// --- 追加: ブレンド関数 ---
-	void Model::BlendTransforms(const std::vector<TransformData>& src, const std::vector<TransformData>& dst, float t, std::vector<TransformData>& outResult)
-	{
-		size_t count = outResult.size();
-		for (size_t i = 0; i < count; ++i)
-		{
-			outResult[i].translate = Lerp3(src[i].translate, dst[i].translate, t);
-			outResult[i].scale = Lerp3(src[i].scale, dst[i].scale, t);
-			outResult[i].quaternion = Slerp4(src[i].quaternion, dst[i].quaternion, t);
-		}
-	}
-
 	// --- 追加: ゲッター ---
 	float Model::GetCurrentAnimationTime() const {
 		if (m_playNo == ANIME_NONE) return 0.0f;
@@ -716,40 +835,313 @@ namespace Arche
 
 	void Model::UpdateNodeTransforms()
 	{
-		static int frameCount = 0;
-		frameCount++;
+		if (m_nodes.empty()) return;
 
-		std::function<void(int, DirectX::XMMATRIX)> Rec = [&](int idx, DirectX::XMMATRIX parent) {
-			auto& t = m_currentTransforms[idx];
+		// 1. 姿勢 -> ローカル行列 (4ボーン単位)
+		PoseKernel::ComposeLocalMatrices(m_currentPose, m_localMatrices.data());
 
-			// クォータニオンの安全性チェック
-			DirectX::XMVECTOR Q = DirectX::XMLoadFloat4(&t.quaternion);
-			DirectX::XMVECTOR Len = DirectX::XMQuaternionLength(Q);
-			float len;
-			DirectX::XMStoreFloat(&len, Len);
-			if (len < 0.0001f) {
-				Q = DirectX::XMQuaternionIdentity(); // 単位クォータニオンにリセット
+		// 2. 親インデックス順に1回走査してモデル空間へ
+		XMMATRIX root = XMMatrixScaling(m_loadScale, m_loadScale, m_loadScale);
+		PoseKernel::LocalToModel(m_localMatrices.data(), m_parentIndices.data(), m_nodes.size(), root, m_nodeMatrices.data());
+	}
+
+	// --- クック済みファイル ---
+	namespace
+	{
+		// 16バイト境界に揃えながらバイト列を積む
+		struct CookWriter
+		{
+			std::vector<uint8_t> bytes;
+			std::string strings;
+
+			uint64_t Append(const void* data, size_t size)
+			{
+				size_t offset = (bytes.size() + CookedMesh::ALIGNMENT - 1) & ~(size_t)(CookedMesh::ALIGNMENT - 1);
+				bytes.resize(offset + size);
+				if (size > 0) memcpy(bytes.data() + offset, data, size);
+				return offset;
 			}
-			else {
-				Q = DirectX::XMQuaternionNormalize(Q); // 正規化
+
+			template<typename T>
+			uint64_t AppendArray(const std::vector<T>& values) { return Append(values.data(), values.size() * sizeof(T)); }
+
+			CookedMesh::StringRef AddString(const std::string& str)
+			{
+				CookedMesh::StringRef ref = { (uint32_t)strings.size(), (uint32_t)str.size() };
+				strings += str;
+				return ref;
 			}
+		};
+
+		void StoreMatrix(float out[16], const XMMATRIX& m)
+		{
+			XMFLOAT4X4 f; XMStoreFloat4x4(&f, m);
+			memcpy(out, &f, sizeof(f));
+		}
+
+		XMMATRIX LoadMatrix(const float in[16])
+		{
+			return XMLoadFloat4x4(reinterpret_cast<const XMFLOAT4X4*>(in));
+		}
 
-			// スケールは1.0固定 (Assimp爆発対策)
-			DirectX::XMMATRIX S = DirectX::XMMatrixScaling(t.scale.x, t.scale.y, t.scale.z);
-			DirectX::XMMATRIX R = DirectX::XMMatrixRotationQuaternion(Q); // 安全なQを使用
-			DirectX::XMMATRIX T = DirectX::XMMatrixTranslation(t.translate.x, t.translate.y, t.translate.z);
+		std::string GetDirectory(const std::string& path)
+		{
+			size_t slash = path.find_last_of("/\\");
+			return (slash != std::string::npos) ? path.substr(0, slash + 1) : "";
+		}
+	}
 
-			// ローカル行列
-			DirectX::XMMATRIX localMat = S * R * T;
+	bool Model::SaveCooked(const std::string& path) const
+	{
+		using namespace CookedMesh;
 
-			// 3. 全体行列
-			m_nodes[idx].mat = localMat * parent;
+		CookWriter writer;
+		writer.bytes.resize(sizeof(Header));
 
-			// 子ノードへ再帰
-			for (int child : m_nodes[idx].children) Rec(child, m_nodes[idx].mat);
+		// ノード
+		std::vector<NodeRecord> nodes(m_nodes.size());
+		for (size_t i = 0; i < m_nodes.size(); ++i) {
+			nodes[i] = {};
+			nodes[i].name = writer.AddString(m_nodes[i].name);
+			nodes[i].parent = m_nodes[i].parent;
+			StoreMatrix(nodes[i].localMatrix, m_nodes[i].localMat);
+		}
+
+		// メッシュ（最適化・圧縮済みのストリームをそのまま書く）
+		std::vector<MeshRecord> meshes(m_meshes.size());
+		for (size_t i = 0; i < m_meshes.size(); ++i) {
+			const Mesh& mesh = m_meshes[i];
+			std::vector<BoneRecord> bones(mesh.bones.size());
+			for (size_t b = 0; b < mesh.bones.size(); ++b) {
+				bones[b] = {};
+				bones[b].nodeIndex = mesh.bones[b].index;
+				memcpy(bones[b].invOffset, mesh.bones[b].invOffset.m, sizeof(bones[b].invOffset));
+			}
+
+			MeshRecord& rec = meshes[i];
+			rec = {};
+			const PackedMeshView data = mesh.GetData();
+			rec.vertexCount = (uint32_t)data.vertices.size();
+			rec.indexCount = (uint32_t)data.indexCount;
+			rec.materialID = mesh.materialID;
+			rec.boneCount = (uint32_t)bones.size();
+			rec.indexSize = data.indexSize;
+			rec.vertexOffset = writer.Append(data.vertices.data(), data.vertices.size_bytes());
+			rec.skinOffset = data.skin.empty() ? 0 : writer.Append(data.skin.data(), data.skin.size_bytes());
+			rec.indexOffset = writer.Append(data.indices, data.indexCount * data.indexSize);
+			rec.boneOffset = writer.AppendArray(bones);
+		}
+
+		// マテリアル（テクスチャはモデルと同じフォルダからの相対パスで持つ）
+		std::string dir = GetDirectory(path);
+		std::vector<MaterialRecord> materials(m_materials.size());
+		for (size_t i = 0; i < m_materials.size(); ++i) {
+			const Material& mat = m_materials[i];
+			MaterialRecord& rec = materials[i];
+			rec = {};
+			memcpy(rec.diffuse, &mat.diffuse, sizeof(rec.diffuse));
+			memcpy(rec.ambient, &mat.ambient, sizeof(rec.ambient));
+			memcpy(rec.specular, &mat.specular, sizeof(rec.specular));
+
+			std::string texture = mat.texturePath;
+			if (!dir.empty() && texture.compare(0, dir.size(), dir) == 0) texture = texture.substr(dir.size());
+			rec.texturePath = writer.AddString(texture);
+		}
+
+		// アニメーション
+		std::vector<AnimationRecord> animations(m_animes.size());
+		for (size_t i = 0; i < m_animes.size(); ++i) {
+			const Animation& anim = m_animes[i];
+			std::vector<ChannelRecord> channels(anim.channels.size());
+			for (size_t c = 0; c < anim.channels.size(); ++c) {
+				const auto& ch = anim.channels[c];
+				std::vector<Vec3Key> positions(ch.positionKeys.size());
+				std::vector<QuatKey> rotations(ch.rotationKeys.size());
+				std::vector<Vec3Key> scalings(ch.scalingKeys.size());
+				for (size_t k = 0; k < positions.size(); ++k) positions[k] = { ch.positionKeys[k].first, { ch.positionKeys[k].second.x, ch.positionKeys[k].second.y, ch.positionKeys[k].second.z } };
+				for (size_t k = 0; k < rotations.size(); ++k) rotations[k] = { ch.rotationKeys[k].first, { ch.rotationKeys[k].second.x, ch.rotationKeys[k].second.y, ch.rotationKeys[k].second.z, ch.rotationKeys[k].second.w } };
+				for (size_t k = 0; k < scalings.size(); ++k) scalings[k] = { ch.scalingKeys[k].first, { ch.scalingKeys[k].second.x, ch.scalingKeys[k].second.y, ch.scalingKeys[k].second.z } };
+
+				ChannelRecord& rec = channels[c];
+				rec = {};
+				rec.nodeIndex = ch.nodeIndex;
+				rec.positionCount = (uint32_t)positions.size();
+				rec.rotationCount = (uint32_t)rotations.size();
+				rec.scalingCount = (uint32_t)scalings.size();
+				rec.positionOffset = writer.AppendArray(positions);
+				rec.rotationOffset = writer.AppendArray(rotations);
+				rec.scalingOffset = writer.AppendArray(scalings);
+			}
+
+			AnimationRecord& rec = animations[i];
+			rec = {};
+			rec.name = writer.AddString(anim.name);
+			rec.totalTime = anim.totalTime;
+			rec.channelCount = (uint32_t)channels.size();
+			rec.channelOffset = writer.AppendArray(channels);
+		}
+
+		Header header = {};
+		header.magic = MAGIC;
+		header.version = VERSION;
+		header.vertexStride = sizeof(MeshBuffer::StaticVertex);
+		header.skinStride = sizeof(MeshBuffer::SkinVertex);
+		header.nodeCount = (uint32_t)nodes.size();
+		header.meshCount = (uint32_t)meshes.size();
+		header.materialCount = (uint32_t)materials.size();
+		header.animationCount = (uint32_t)animations.size();
+		header.nodeOffset = writer.AppendArray(nodes);
+		header.meshOffset = writer.AppendArray(meshes);
+		header.materialOffset = writer.AppendArray(materials);
+		header.animationOffset = writer.AppendArray(animations);
+		header.stringOffset = writer.Append(writer.strings.data(), writer.strings.size());
+		header.stringSize = writer.strings.size();
+		header.payloadSize = writer.bytes.size() - sizeof(Header);
+		header.payloadHash = Hash::Fnv1a64(writer.bytes.data() + sizeof(Header), (size_t)header.payloadSize);
+		memcpy(writer.bytes.data(), &header, sizeof(Header));
+
+		// 読み込み中のプロセスに中途半端なファイルを見せないよう、一時ファイルから置き換える
+		std::string tempPath = path + ".tmp";
+		{
+			std::ofstream ofs(tempPath, std::ios::binary | std::ios::trunc);
+			if (!ofs) return false;
+			ofs.write(reinterpret_cast<const char*>(writer.bytes.data()), (std::streamsize)writer.bytes.size());
+			if (!ofs) return false;
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(tempPath, path, ec);
+		if (ec) {
+			std::filesystem::remove(tempPath, ec);
+			return false;
+		}
+		return true;
+	}
+
+	bool Model::LoadCooked(const std::string& path, float scale, Flip flip, bool verifyHash)
+	{
+		using namespace CookedMesh;
+
+		Reset();
+
+		// 頂点とインデックスはこのファイルを直接指すので、モデルが持っておく（次の Reset で閉じる）
+		if (!VirtualFileSystem::Instance().Open(path, m_cookedFile)) return false;
+		const FileView& file = m_cookedFile;
+
+		const Header* header = file.At<Header>(0);
+		if (!header || header->magic != MAGIC || header->version != VERSION) return false;
+		if (header->vertexStride != sizeof(MeshBuffer::StaticVertex) || header->skinStride != sizeof(MeshBuffer::SkinVertex)) return false;
+		if (header->payloadSize != file.GetSize() - sizeof(Header)) return false;
+		if (verifyHash && !VerifyPayload(file.GetData(), file.GetSize())) return false;
+
+		const char* strings = file.At<char>(header->stringOffset, header->stringSize);
+		if (!strings && header->stringSize > 0) return false;
+		auto GetString = [&](const StringRef& ref, std::string& out) {
+			if ((uint64_t)ref.offset + ref.length > header->stringSize) return false;
+			out.assign(strings + ref.offset, ref.length);
+			return true;
 			};
 
-		// ルート呼び出し
-		Rec(0, DirectX::XMMatrixScaling(m_loadScale, m_loadScale, m_loadScale));
+		const NodeRecord* nodes = file.At<NodeRecord>(header->nodeOffset, header->nodeCount);
+		const MeshRecord* meshes = file.At<MeshRecord>(header->meshOffset, header->meshCount);
+		const MaterialRecord* materials = file.At<MaterialRecord>(header->materialOffset, header->materialCount);
+		const AnimationRecord* animations = file.At<AnimationRecord>(header->animationOffset, header->animationCount);
+		if (!nodes || !meshes || !materials || !animations) return false;
+
+		if (scale < 0.001f || scale > 1000.0f) m_loadScale = 1.0f;
+		else m_loadScale = scale;
+		m_loadFlip = flip;
+
+		// ノード（親は必ず子より前）
+		m_nodes.resize(header->nodeCount);
+		for (uint32_t i = 0; i < header->nodeCount; ++i) {
+			Node& node = m_nodes[i];
+			if (!GetString(nodes[i].name, node.name)) return false;
+			node.parent = nodes[i].parent;
+			if (node.parent >= (int)i) return false;
+			node.localMat = LoadMatrix(nodes[i].localMatrix);
+			if (node.parent >= 0) m_nodes[node.parent].children.push_back((int)i);
+		}
+
+		// メッシュ
+		m_meshes.resize(header->meshCount);
+		for (uint32_t i = 0; i < header->meshCount; ++i) {
+			const MeshRecord& rec = meshes[i];
+			const MeshBuffer::StaticVertex* vertices = file.At<MeshBuffer::StaticVertex>(rec.vertexOffset, rec.vertexCount);
+			const BoneRecord* bones = file.At<BoneRecord>(rec.boneOffset, rec.boneCount);
+			if (!vertices || !bones) return false;
+			if (rec.indexSize != 2 && rec.indexSize != 4) return false;
+
+			Mesh& mesh = m_meshes[i];
+			PackedMeshView& mapped = mesh.mapped;
+			mapped.vertices = { vertices, rec.vertexCount };
+			if (rec.skinOffset != 0) {
+				const MeshBuffer::SkinVertex* skin = file.At<MeshBuffer::SkinVertex>(rec.skinOffset, rec.vertexCount);
+				if (!skin) return false;
+				mapped.skin = { skin, rec.vertexCount };
+			}
+			mapped.indices = (rec.indexSize == 2) ? (const void*)file.At<uint16_t>(rec.indexOffset, rec.indexCount) : (const void*)file.At<uint32_t>(rec.indexOffset, rec.indexCount);
+			if (!mapped.indices) return false;
+			mapped.indexCount = rec.indexCount;
+			mapped.indexSize = rec.indexSize;
+			mesh.materialID = rec.materialID;
+			mesh.bones.resize(rec.boneCount);
+			for (uint32_t b = 0; b < rec.boneCount; ++b) {
+				if (bones[b].nodeIndex < 0 || bones[b].nodeIndex >= (int)header->nodeCount) return false;
+				mesh.bones[b].index = bones[b].nodeIndex;
+				memcpy(mesh.bones[b].invOffset.m, bones[b].invOffset, sizeof(bones[b].invOffset));
+			}
+		}
+
+		// マテリアル
+		std::string dir = GetDirectory(path);
+		m_materials.resize(header->materialCount);
+		for (uint32_t i = 0; i < header->materialCount; ++i) {
+			const MaterialRecord& rec = materials[i];
+			Material& mat = m_materials[i];
+			memcpy(&mat.diffuse, rec.diffuse, sizeof(rec.diffuse));
+			memcpy(&mat.ambient, rec.ambient, sizeof(rec.ambient));
+			memcpy(&mat.specular, rec.specular, sizeof(rec.specular));
+
+			std::string texture;
+			if (!GetString(rec.texturePath, texture)) return false;
+			if (!texture.empty()) {
+				mat.texturePath = std::filesystem::path(texture).is_absolute() ? texture : dir + texture;
+				ResourceManager::Instance().LoadTextureAsync(mat.texturePath);
+			}
+		}
+
+		// アニメーション
+		m_animes.resize(header->animationCount);
+		for (uint32_t i = 0; i < header->animationCount; ++i) {
+			const AnimationRecord& rec = animations[i];
+			Animation& anim = m_animes[i];
+			if (!GetString(rec.name, anim.name)) return false;
+			anim.totalTime = rec.totalTime;
+
+			const ChannelRecord* channels = file.At<ChannelRecord>(rec.channelOffset, rec.channelCount);
+			if (!channels) return false;
+			anim.channels.resize(rec.channelCount);
+			for (uint32_t c = 0; c < rec.channelCount; ++c) {
+				const ChannelRecord& chRec = channels[c];
+				const Vec3Key* positions = file.At<Vec3Key>(chRec.positionOffset, chRec.positionCount);
+				const QuatKey* rotations = file.At<QuatKey>(chRec.rotationOffset, chRec.rotationCount);
+				const Vec3Key* scalings = file.At<Vec3Key>(chRec.scalingOffset, chRec.scalingCount);
+				if (!positions || !rotations || !scalings) return false;
+				if (chRec.nodeIndex < 0 || chRec.nodeIndex >= (int)header->nodeCount) return false;
+
+				auto& ch = anim.channels[c];
+				ch.nodeIndex = chRec.nodeIndex;
+				ch.positionKeys.resize(chRec.positionCount);
+				ch.rotationKeys.resize(chRec.rotationCount);
+				ch.scalingKeys.resize(chRec.scalingCount);
+				for (uint32_t k = 0; k < chRec.positionCount; ++k) ch.positionKeys[k] = { positions[k].time, { positions[k].value[0], positions[k].value[1], positions[k].value[2] } };
+				for (uint32_t k = 0; k < chRec.rotationCount; ++k) ch.rotationKeys[k] = { rotations[k].time, { rotations[k].value[0], rotations[k].value[1], rotations[k].value[2], rotations[k].value[3] } };
+				for (uint32_t k = 0; k < chRec.scalingCount; ++k) ch.scalingKeys[k] = { scalings[k].time, { scalings[k].value[0], scalings[k].value[1], scalings[k].value[2] } };
+			}
+		}
+
+		BuildPoseData();
+		return true;
 	}
-}
\ No newline at end of file
+}
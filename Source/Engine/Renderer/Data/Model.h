@@ -23,6 +23,10 @@
 #include "Engine/pch.h"
 #include "Engine/Renderer/RHI/Texture.h"
 #include "Engine/Renderer/RHI/MeshBuffer.h"
+#include "Engine/Renderer/Data/MeshOptimizer.h"
+#include "Engine/Renderer/Data/AnimationPose.h"
+#include "Engine/Renderer/Data/SkinningKernel.h"
+#include "Engine/Resource/VirtualFileSystem.h"
 
 struct aiScene;
 struct aiNode;
@@ -37,17 +41,17 @@ namespace Arche
 
 		enum Flip { None, XFlip, ZFlip, ZFlipUseAnime };
 
-		struct Bone {
-			int index;
-			XMMATRIX invOffset;
-		};
+		using Bone = SkinBone;	// SkinningKernel.h 参照
 
 		struct Mesh {
-			std::vector<MeshBuffer::Vertex> vertices;
-			std::vector<uint32_t> indices;
+			PackedMesh packed;		// 最適化・圧縮済みの頂点とインデックス（MeshOptimizer。クック済みファイルから読んだときは空）
+			PackedMeshView mapped;	// クック済みファイルから読んだときの、マップ上の頂点とインデックス
 			unsigned int materialID;
 			std::vector<Bone> bones;
 			MeshBuffer* pMesh = nullptr;
+
+			// 描画・書き出しに使う頂点とインデックス
+			PackedMeshView GetData() const { return mapped.vertices.empty() ? packed.GetView() : mapped; }
 		};
 
 		struct Material {
@@ -62,16 +66,9 @@ namespace Arche
 			std::string name;
 			int parent;
 			std::vector<int> children;
-			XMMATRIX mat;
 			XMMATRIX localMat;
 		};
 
-		struct TransformData {
-			XMFLOAT3 translate;
-			XMFLOAT4 quaternion;
-			XMFLOAT3 scale;
-		};
-
 		struct Animation {
 			std::string name;
 			float totalTime = 0.0f;
@@ -99,13 +96,33 @@ namespace Arche
 		// 従来互換用（同期ロード）
 		bool LoadSync(const std::string& filename, float scale = 1.0f, Flip flip = None);
 
+		// クック済みファイル (.amesh) の書き出し / 読み込み（フォーマットは CookedMesh.h）
+		// LoadCPU はソースより新しいクック済みファイルがあれば自動的にそちらを読む
+		// LoadSource はクック済みファイルを見ずに Assimp で読む
+		// LoadSourceForCook はクッカー用。テクスチャはパスを記録するだけで ResourceManager には要求しない
+		// （ResourceManager を初期化していないプロセスや、クックのワーカースレッドから呼ぶため）
+		// LoadCooked はヘッダーと各配列の範囲だけを確かめ、頂点とインデックスはマップしたまま使う
+		// （verifyHash なら内容のハッシュも確かめる。全体を読むので通常の読み込みでは行わない）
+		bool LoadSource(const std::string& filename, float scale = 1.0f, Flip flip = None);
+		bool LoadSourceForCook(const std::string& filename);
+		bool SaveCooked(const std::string& path) const;
+		bool LoadCooked(const std::string& path, float scale = 1.0f, Flip flip = None, bool verifyHash = false);
+
 		void Reset();
 
 		const std::vector<Mesh>& GetMeshes() const { return m_meshes; }
 		const std::vector<Node>& GetNodes() const { return m_nodes; }
+		// モデル空間のノード行列（ノードインデックス順）
+		const std::vector<XMMATRIX>& GetNodeMatrices() const { return m_nodeMatrices; }
 		const Material* GetMaterial(size_t index) const { return &m_materials[index]; }
 
-		void Step(float deltaTime);
+		// ResourceManager の予算計算用（テクスチャは別カテゴリで数える）
+		ResourceMemory GetMemoryUsage() const;
+
+		// @param	nodeMask	評価するノードのマスク（nullptrなら全ノード、0のノードは前回の姿勢を保持）
+		void Step(float deltaTime, const std::vector<uint8_t>* nodeMask = nullptr);
+		// 指定ノード以下の部分木とその祖先を1にしたマスクを作る（見つからなければ false）
+		bool BuildSubtreeMask(const std::string& rootNodeName, std::vector<uint8_t>& outMask) const;
 		AnimeNo AddAnimation(const std::string& filename);
 		AnimeNo ImportAnimation(std::shared_ptr<Model> sourceModel, const std::string& name);
 		void Play(AnimeNo no, bool loop = true, float speed = 1.0f, float transitionDuration = 0.0f);
@@ -116,13 +133,15 @@ namespace Arche
 
 	private:
 		void MakeMesh(const aiScene* pScene, float scale, Flip flip);
-		void MakeMaterial(const aiScene* pScene, const std::string& directory);
+		bool ImportSource(const std::string& filename, float scale, Flip flip, bool requestTextures);
+		void MakeMaterial(const aiScene* pScene, const std::string& directory, bool requestTextures);
 		void MakeBoneNodes(const aiScene* pScene);
-		void MakeWeight(const aiScene* pScene, int meshIdx);
+		void MakeWeight(const aiScene* pScene, int meshIdx, std::vector<MeshBuffer::Vertex>& vertices);
+		// m_nodes から親インデックス・行列バッファ・初期姿勢を作る
+		void BuildPoseData();
 
 		void UpdateNodeTransforms();
-		void EvaluateAnimation(AnimeNo no, float time, std::vector<TransformData>& outTransforms);
-		void BlendTransforms(const std::vector<TransformData>& src, const std::vector<TransformData>& dst, float t, std::vector<TransformData>& outResult);
+		void EvaluateAnimation(AnimeNo no, float time, PoseBuffer& outPose, const std::vector<uint8_t>* nodeMask = nullptr);
 
 		XMFLOAT3 Lerp3(const XMFLOAT3& a, const XMFLOAT3& b, float t);
 		XMFLOAT4 Slerp4(const XMFLOAT4& a, const XMFLOAT4& b, float t);
@@ -138,13 +157,22 @@ namespace Arche
 		float m_transitionTime = 0.0f;
 		float m_transitionDuration = 0.0f;
 
-		std::vector<TransformData> m_currentTransforms;
-		std::vector<TransformData> m_defaultTransforms;
-		std::vector<TransformData> m_blendSrcTransforms;
-		std::vector<TransformData> m_blendDstTransforms;
+		// 姿勢 (SoA)
+		PoseBuffer m_currentPose;
+		PoseBuffer m_defaultPose;
+		PoseBuffer m_blendSrcPose;
+		PoseBuffer m_blendDstPose;
+
+		// 行列計算用（ノードインデックス順、親は必ず子より前）
+		std::vector<int> m_parentIndices;
+		std::vector<XMMATRIX> m_localMatrices;
+		std::vector<XMMATRIX> m_nodeMatrices;
 
 		float m_loadScale = 1.0f;
 		Flip m_loadFlip = None;
+
+		// LoadCooked で開いたファイル（メッシュの mapped が指しているので、モデルと同じ間だけ保持する）
+		FileView m_cookedFile;
 	};
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,77 @@
+﻿/*****************************************************************//**
+ * @file	SkinningKernel.cpp
+ * @brief	スキニング行列の計算カーネル（CPUのみ）
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+// pch.h は含めない（Tests/ からもビルドする。vcxproj でもプリコンパイル済みヘッダーを使わない）
+#include "Engine/Renderer/Data/SkinningKernel.h"
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define ARCHE_SKINNING_SSE 1
+#include <xmmintrin.h>
+#endif
+
+namespace Arche
+{
+	namespace SkinningKernel
+	{
+#ifdef ARCHE_SKINNING_SSE
+		void ComputePalette(const SkinBone* bones, size_t boneCount, const SkinMatrix* nodeMatrices, SkinMatrix* out)
+		{
+			for (size_t b = 0; b < boneCount; ++b)
+			{
+				const float (*a)[4] = bones[b].invOffset.m;
+				const float (*n)[4] = nodeMatrices[bones[b].index].m;
+
+				// XMMatrixMultiply と同じく、結果の各行 = a の行の各要素 × n の各行 の和
+				const __m128 n0 = _mm_load_ps(n[0]);
+				const __m128 n1 = _mm_load_ps(n[1]);
+				const __m128 n2 = _mm_load_ps(n[2]);
+				const __m128 n3 = _mm_load_ps(n[3]);
+
+				__m128 r[4];
+				for (int i = 0; i < 4; ++i)
+				{
+					__m128 v = _mm_mul_ps(_mm_set1_ps(a[i][0]), n0);
+					v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(a[i][1]), n1));
+					v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(a[i][2]), n2));
+					v = _mm_add_ps(v, _mm_mul_ps(_mm_set1_ps(a[i][3]), n3));
+					r[i] = v;
+				}
+
+				// シェーダーに渡す形（転置）で書き込む
+				_MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+				_mm_store_ps(out[b].m[0], r[0]);
+				_mm_store_ps(out[b].m[1], r[1]);
+				_mm_store_ps(out[b].m[2], r[2]);
+				_mm_store_ps(out[b].m[3], r[3]);
+			}
+		}
+#else
+		void ComputePalette(const SkinBone* bones, size_t boneCount, const SkinMatrix* nodeMatrices, SkinMatrix* out)
+		{
+			for (size_t b = 0; b < boneCount; ++b)
+			{
+				const float (*a)[4] = bones[b].invOffset.m;
+				const float (*n)[4] = nodeMatrices[bones[b].index].m;
+				for (int i = 0; i < 4; ++i)
+				{
+					for (int j = 0; j < 4; ++j)
+					{
+						out[b].m[j][i] = a[i][0] * n[0][j] + a[i][1] * n[1][j] + a[i][2] * n[2][j] + a[i][3] * n[3][j];
+					}
+				}
+			}
+		}
+#endif
+
+	}	// namespace SkinningKernel
+
+}	// namespace Arche
@@ -0,0 +1,45 @@
+﻿/*****************************************************************//**
+ * @file	SkinningKernel.h
+ * @brief	スキニング行列の計算カーネル（CPUのみ）
+ *
+ * @details	Model のボーンと SkinningPalette が共有する。
+ *			SkinMatrix の並びとサイズは DirectX::XMMATRIX / XMFLOAT4X4 と同じ（行優先・行ベクトル）。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___SKINNING_KERNEL_H___
+#define ___SKINNING_KERNEL_H___
+
+// ===== インクルード =====
+// 標準ライブラリだけで書く（pch.h を含めず、Tests/ からも使えるように）
+#include <cstddef>
+#include <cstdint>
+
+namespace Arche
+{
+	// 4x4 行列（XMMATRIX と同じ並び・アラインメント）
+	struct alignas(16) SkinMatrix
+	{
+		float m[4][4];
+	};
+
+	// メッシュが参照するボーン
+	struct SkinBone
+	{
+		int index;				// ノード番号
+		SkinMatrix invOffset;	// メッシュ空間 → ボーン空間
+	};
+
+	namespace SkinningKernel
+	{
+		// bones[i].invOffset * nodeMatrices[bones[i].index] を転置して out[i] へ書き込む
+		void ComputePalette(const SkinBone* bones, size_t boneCount, const SkinMatrix* nodeMatrices, SkinMatrix* out);
+
+	}	// namespace SkinningKernel
+
+}	// namespace Arche
+
+#endif // !___SKINNING_KERNEL_H___
@@ -0,0 +1,52 @@
+﻿/*****************************************************************//**
+ * @file	SkinningPalette.cpp
+ * @brief	スキニング用ボーン行列パレット（インスタンス単位）
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "SkinningPalette.h"
+
+namespace Arche
+{
+	// ノード行列は XMMATRIX のまま、カーネルには SkinMatrix として渡す
+	static_assert(sizeof(SkinMatrix) == sizeof(XMMATRIX) && alignof(SkinMatrix) == alignof(XMMATRIX), "SkinMatrix must match XMMATRIX");
+	static_assert(sizeof(SkinMatrix) == sizeof(XMFLOAT4X4), "SkinMatrix must match XMFLOAT4X4");
+
+	void SkinningPalette::Update(const Model& model)
+	{
+		const auto& meshes = model.GetMeshes();
+
+		// レイアウトはモデルが変わった時だけ作り直す
+		if (source != &model || meshOffsets.size() != meshes.size())
+		{
+			meshOffsets.resize(meshes.size());
+			uint32_t total = 0;
+			for (size_t m = 0; m < meshes.size(); ++m)
+			{
+				meshOffsets[m] = total;
+				total += (uint32_t)meshes[m].bones.size();
+			}
+			matrices.resize(total);
+			source = &model;
+		}
+
+		const auto& nodeMatrices = model.GetNodeMatrices();
+		if (nodeMatrices.empty()) return;
+		const SkinMatrix* nodes = reinterpret_cast<const SkinMatrix*>(nodeMatrices.data());
+
+		for (size_t m = 0; m < meshes.size(); ++m)
+		{
+			const auto& bones = meshes[m].bones;
+			if (bones.empty()) continue;
+			SkinningKernel::ComputePalette(bones.data(), bones.size(), nodes, matrices.data() + meshOffsets[m]);
+		}
+	}
+
+}	// namespace Arche
@@ -0,0 +1,48 @@
+﻿/*****************************************************************//**
+ * @file	SkinningPalette.h
+ * @brief	スキニング用ボーン行列パレット（インスタンス単位）
+ *
+ * @details	invOffset * ノード行列 を全メッシュ分まとめて1回だけ計算し、
+ *			シェーダーにそのまま渡せる転置済みの形で保持する。
+ *			計算そのものは SkinningKernel（pch.h に依存しない）で行い、Tests/SkinningPaletteTest から検証する。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___SKINNING_PALETTE_H___
+#define ___SKINNING_PALETTE_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Renderer/Data/Model.h"
+#include "Engine/Renderer/Data/SkinningKernel.h"
+
+namespace Arche
+{
+	/**
+	 * @struct	SkinningPalette
+	 * @brief	1インスタンス分の最終スキニング行列
+	 */
+	struct SkinningPalette
+	{
+		const Model* source = nullptr;			// 計算元のモデル
+		std::vector<SkinMatrix> matrices;		// 全メッシュ分を連結（転置済み）
+		std::vector<uint32_t> meshOffsets;		// メッシュごとの先頭位置
+
+		// 指定モデル用のパレットが計算済みか
+		bool IsValidFor(const Model* model) const { return model && source == model && meshOffsets.size() == model->GetMeshes().size(); }
+
+		// メッシュ単位のパレット先頭
+		const SkinMatrix* GetMeshPalette(size_t meshIndex) const { return matrices.data() + meshOffsets[meshIndex]; }
+
+		// 現在のモデル姿勢からパレットを再計算
+		void Update(const Model& model);
+
+		void Clear() { source = nullptr; matrices.clear(); meshOffsets.clear(); }
+	};
+
+}	// namespace Arche
+
+#endif // !___SKINNING_PALETTE_H___
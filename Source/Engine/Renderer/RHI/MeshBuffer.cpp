@@ -24,10 +24,25 @@ namespace Arche
 			if (FAILED(hr)) return hr;
 		}
 
+		// スキニング用の頂点ストリーム作成
+		if (desc.pSkin) {
+			D3D11_BUFFER_DESC bufDesc = {};
+			bufDesc.ByteWidth = desc.skinSize * desc.vtxCount;
+			bufDesc.Usage = D3D11_USAGE_DEFAULT;
+			bufDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+
+			D3D11_SUBRESOURCE_DATA subResource = {};
+			subResource.pSysMem = desc.pSkin;
+
+			hr = Application::Instance().GetDevice()->CreateBuffer(&bufDesc, &subResource, &m_pSkinBuffer);
+			if (FAILED(hr)) return hr;
+		}
+
 		m_desc = desc;
 		// ポインタメンバは保持しない（参照先が消える可能性があるため）
 		m_desc.pVtx = nullptr;
 		m_desc.pIdx = nullptr;
+		m_desc.pSkin = nullptr;
 
 		return S_OK;
 	}
@@ -41,6 +56,11 @@ namespace Arche
 
 		context->IASetPrimitiveTopology(m_desc.topology);
 		context->IASetVertexBuffers(0, 1, m_pVtxBuffer.GetAddressOf(), &stride, &offset);
+		if (m_pSkinBuffer)
+		{
+			UINT skinStride = m_desc.skinSize;
+			context->IASetVertexBuffers(1, 1, m_pSkinBuffer.GetAddressOf(), &skinStride, &offset);
+		}
 
 		if (m_desc.idxCount > 0)
 		{
@@ -4,6 +4,7 @@
 
 // ===== インクルード =====
 #include "Engine/pch.h"
+#include "Engine/Renderer/Data/MeshVertex.h"
 
 namespace Arche
 {
@@ -11,15 +12,10 @@ namespace Arche
 	class MeshBuffer
 	{
 	public:
-		// 頂点データの定義（アニメーション対応）
-		struct Vertex {
-			DirectX::XMFLOAT3 pos;
-			DirectX::XMFLOAT3 normal;
-			DirectX::XMFLOAT2 uv;
-			DirectX::XMFLOAT4 color;
-			DirectX::XMFLOAT4 weight;	// ボーンウェイト
-			uint32_t index[4];			// ボーンインデックス (uint4として扱う)
-		};
+		// 頂点データの定義（MeshVertex.h 参照）
+		using Vertex = MeshVertex;				// インポート時（アニメーション対応）
+		using StaticVertex = StaticMeshVertex;	// 描画用 ストリーム0: 全メッシュ共通
+		using SkinVertex = SkinMeshVertex;		// 描画用 ストリーム1: スキンメッシュのみ
 
 		struct Description {
 			void* pVtx;			// 頂点データへのポインタ
@@ -30,6 +26,8 @@ namespace Arche
 			UINT idxCount;		// インデックス数
 			D3D11_PRIMITIVE_TOPOLOGY topology;
 			bool isWrite;		// CPU書き込みを行うか (Dynamic)
+			void* pSkin = nullptr;	// 2本目の頂点ストリーム（スロット1、オプション）
+			UINT skinSize = 0;		// 1頂点のサイズ (sizeof(SkinVertex))
 		};
 
 	public:
@@ -45,6 +43,8 @@ namespace Arche
 		// CPUからの書き込み (Dynamicの場合のみ)
 		HRESULT Write(void* pVtx);
 
+		bool HasSkinStream() const { return m_pSkinBuffer != nullptr; }
+
 	private:
 		HRESULT CreateVertexBuffer(const void* pVtx, UINT size, UINT count, bool isWrite);
 		HRESULT CreateIndexBuffer(const void* pIdx, UINT size, UINT count);
@@ -52,6 +52,7 @@ namespace Arche
 	private:
 		ComPtr<ID3D11Buffer> m_pVtxBuffer;
 		ComPtr<ID3D11Buffer> m_pIdxBuffer;
+		ComPtr<ID3D11Buffer> m_pSkinBuffer;
 		Description m_desc;
 	};
 
@@ -20,24 +20,32 @@
 #include "Engine/pch.h"
 #include "Engine/Renderer/RHI/Texture.h"
 #include "Engine/Core/Base/Logger.h"
+#include "Engine/Resource/VirtualFileSystem.h"
 
 namespace Arche
 {
 	bool Texture::LoadCPU(const std::string& path)
 	{
 		this->filepath = path;
-		std::wstring wpath = std::filesystem::path(path).wstring();
 		std::string ext = std::filesystem::path(path).extension().string();
+		std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+		// パック・ディスクどちらからでも読めるよう、メモリ上のデータからデコードする
+		FileView file;
+		if (!VirtualFileSystem::Instance().Open(path, file))
+		{
+			Logger::LogError("Failed to open texture file: " + path);
+			return false;
+		}
 
-		// 小文字変換などの処理を入れるとより安全ですが、ここでは簡易実装
 		HRESULT hr;
 
 		if (ext == ".dds")
-			hr = DirectX::LoadFromDDSFile(wpath.c_str(), DirectX::DDS_FLAGS_NONE, nullptr, scratchImage);
+			hr = DirectX::LoadFromDDSMemory(file.GetData(), file.GetSize(), DirectX::DDS_FLAGS_NONE, nullptr, scratchImage);
 		else if (ext == ".tga")
-			hr = DirectX::LoadFromTGAFile(wpath.c_str(), nullptr, scratchImage);
+			hr = DirectX::LoadFromTGAMemory(file.GetData(), file.GetSize(), nullptr, scratchImage);
 		else
-			hr = DirectX::LoadFromWICFile(wpath.c_str(), DirectX::WIC_FLAGS_NONE, nullptr, scratchImage);
+			hr = DirectX::LoadFromWICMemory(file.GetData(), file.GetSize(), DirectX::WIC_FLAGS_NONE, nullptr, scratchImage);
 
 		if (FAILED(hr))
 		{
@@ -63,6 +71,8 @@ namespace Arche
 			srv.GetAddressOf()
 		);
 
+		if (SUCCEEDED(hr)) gpuBytes = (uint64_t)scratchImage.GetPixelsSize();
+
 		// VRAM転送完了したらCPUメモリは解放
 		scratchImage.Release();
 
@@ -14,6 +14,7 @@
 
 // ===== インクルード =====
 #include "Engine/pch.h"
+#include "Engine/Resource/ResourceHandle.h"
 
 namespace Arche
 {
@@ -27,6 +28,7 @@ namespace Arche
 
 		// DirectXリソース
 		ComPtr<ID3D11ShaderResourceView> srv;
+		uint64_t gpuBytes = 0;	// UploadGPU 時のピクセルデータサイズ（ミップ込み）
 
 		// 非同期ロード用の一時データ（CPUメモリ）
 		DirectX::ScratchImage scratchImage;
@@ -42,6 +44,9 @@ namespace Arche
 
 		// ゲッター
 		ID3D11ShaderResourceView* GetSRV() const { return srv.Get(); }
+
+		// ResourceManager の予算計算用
+		ResourceMemory GetMemoryUsage() const { return { (uint64_t)scratchImage.GetPixelsSize(), gpuBytes }; }
 	};
 
 }	// namespace Arche
@@ -35,7 +35,10 @@ namespace Arche
 	ComPtr<ID3D11SamplerState> ModelRenderer::s_samplerState = nullptr;
 	ComPtr<ID3D11RasterizerState> ModelRenderer::s_rsSolid = nullptr;
 	ComPtr<ID3D11ShaderResourceView> ModelRenderer::s_whiteTexture = nullptr;
+	ComPtr<ID3D11Buffer> ModelRenderer::s_emptySkinStream = nullptr;
 	ModelRenderer::CBData ModelRenderer::s_cbData = {};
+	SkinningPalette ModelRenderer::s_fallbackPalette;
+	size_t ModelRenderer::s_boneCountInCB = ModelRenderer::MAX_BONES;
 	ModelRenderer::SceneLightCBData ModelRenderer::s_lightData = {};
 
 	void ModelRenderer::Initialize(ID3D11Device* device, ID3D11DeviceContext* context)
@@ -90,17 +93,29 @@ namespace Arche
 		}
 		s_device->CreatePixelShader(psBlob->GetBufferPointer(), psBlob->GetBufferSize(), nullptr, &s_ps);
 
-		// 2. 入力レイアウト
+		// 2. 入力レイアウト（スロット0: StaticVertex、スロット1: SkinVertex）
+		// 圧縮フォーマットは入力アセンブラで float / uint に展開されるのでシェーダーはそのまま
 		D3D11_INPUT_ELEMENT_DESC layout[] = {
-			{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,	 0, 0,	D3D11_INPUT_PER_VERTEX_DATA, 0 },
-			{ "NORMAL",	  0, DXGI_FORMAT_R32G32B32_FLOAT,	 0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-			{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,		 0, 24, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-			{ "COLOR",	  0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 32, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-			{ "WEIGHT",	  0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 48, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-			{ "INDEX",	  0, DXGI_FORMAT_R32G32B32A32_UINT,	 0, 64, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+			{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT,	0, 0,	D3D11_INPUT_PER_VERTEX_DATA, 0 },
+			{ "NORMAL",	  0, DXGI_FORMAT_R8G8B8A8_SNORM,	0, 12,	D3D11_INPUT_PER_VERTEX_DATA, 0 },
+			{ "TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT,		0, 16,	D3D11_INPUT_PER_VERTEX_DATA, 0 },
+			{ "COLOR",	  0, DXGI_FORMAT_R8G8B8A8_UNORM,	0, 20,	D3D11_INPUT_PER_VERTEX_DATA, 0 },
+			{ "WEIGHT",	  0, DXGI_FORMAT_R8G8B8A8_UNORM,	1, 0,	D3D11_INPUT_PER_VERTEX_DATA, 0 },
+			{ "INDEX",	  0, DXGI_FORMAT_R8G8B8A8_UINT,		1, 4,	D3D11_INPUT_PER_VERTEX_DATA, 0 },
 		};
 		s_device->CreateInputLayout(layout, 6, vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), &s_inputLayout);
 
+		// スキン無しメッシュ用（ストライド0で全頂点が同じゼロ要素を読む → ウェイト0はシェーダー側で (1,0,0,0) 扱い）
+		{
+			MeshBuffer::SkinVertex zero = {};
+			D3D11_BUFFER_DESC vbd = {};
+			vbd.Usage = D3D11_USAGE_IMMUTABLE;
+			vbd.ByteWidth = sizeof(MeshBuffer::SkinVertex);
+			vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+			D3D11_SUBRESOURCE_DATA vsd = { &zero, 0, 0 };
+			s_device->CreateBuffer(&vbd, &vsd, &s_emptySkinStream);
+		}
+
 		// 3. 定数バッファ
 		D3D11_BUFFER_DESC bd = {};
 		bd.Usage = D3D11_USAGE_DEFAULT;
@@ -139,6 +154,7 @@ namespace Arche
 		s_constantBuffer.Reset(); s_samplerState.Reset(); s_rsSolid.Reset();
 		s_whiteTexture.Reset();
 		s_lightConstantBuffer.Reset();
+		s_emptySkinStream.Reset();
 	}
 
 	void ModelRenderer::Begin(const XMMATRIX& view, const XMMATRIX& projection, const XMFLOAT3& lightDir, const XMFLOAT3& lightColor)
@@ -194,7 +210,7 @@ namespace Arche
 		Draw(model, world);
 	}
 
-	void ModelRenderer::Draw(std::shared_ptr<Model> model, const DirectX::XMMATRIX& worldMatrix)
+	void ModelRenderer::Draw(std::shared_ptr<Model> model, const DirectX::XMMATRIX& worldMatrix, const SkinningPalette* palette)
 	{
 		if (!model) return;
 
@@ -203,21 +219,27 @@ namespace Arche
 
 		// メッシュごとの描画
 		const auto& meshes = model->GetMeshes();
-		const auto& nodes = model->GetNodes();
 
-		for (const auto& mesh : meshes)
+		// パレットが渡されていない（エディタ表示など）場合はここで1回だけ計算
+		if (!palette || !palette->IsValidFor(model.get()))
+		{
+			s_fallbackPalette.Update(*model);
+			palette = &s_fallbackPalette;
+		}
+
+		for (size_t meshIndex = 0; meshIndex < meshes.size(); ++meshIndex)
 		{
-			// --- ボーン行列の更新 ---
+			const auto& mesh = meshes[meshIndex];
+
+			// --- ボーン行列の更新（計算済みパレットをコピーするだけ） ---
 			if (!mesh.bones.empty()) {
 				s_cbData.hasAnimation = 1;
-				for (int i = 0; i < 200; ++i) s_cbData.boneTransforms[i] = XMMatrixIdentity();
+				size_t boneCount = std::min(mesh.bones.size(), MAX_BONES);
+				std::memcpy(s_cbData.boneTransforms, palette->GetMeshPalette(meshIndex), boneCount * sizeof(SkinMatrix));
 
-				for (size_t b = 0; b < mesh.bones.size() && b < 200; ++b)
-				{
-					const auto& bone = mesh.bones[b];
-					XMMATRIX m = bone.invOffset * nodes[bone.index].mat;
-					s_cbData.boneTransforms[b] = XMMatrixTranspose(m);
-				}
+				// 前のメッシュの方がボーンが多ければ、残った行列を単位行列に戻す（使われない番号が前の姿勢を指さないように）
+				for (size_t i = boneCount; i < s_boneCountInCB; ++i) s_cbData.boneTransforms[i] = XMMatrixIdentity();
+				s_boneCountInCB = boneCount;
 			}
 			else {
 				s_cbData.hasAnimation = 0;
@@ -241,7 +263,13 @@ namespace Arche
 			s_context->PSSetShaderResources(0, 1, &srv);
 
 			// 描画
-			if (mesh.pMesh) mesh.pMesh->Draw();
+			if (mesh.pMesh) {
+				if (!mesh.pMesh->HasSkinStream()) {
+					UINT stride = 0, offset = 0;
+					s_context->IASetVertexBuffers(1, 1, s_emptySkinStream.GetAddressOf(), &stride, &offset);
+				}
+				mesh.pMesh->Draw();
+			}
 		}
 	}
 
@@ -23,6 +23,7 @@
 // ===== インクルード =====
 #include "Engine/pch.h"
 #include "Engine/Renderer/Data/Model.h"
+#include "Engine/Renderer/Data/SkinningPalette.h"
 
 namespace Arche
 {
@@ -30,13 +31,16 @@ namespace Arche
 	class ARCHE_API ModelRenderer
 	{
 	public:
+		// シェーダーに渡せるボーン行列の最大数 (Standard.hlsl と一致させる)
+		static constexpr size_t MAX_BONES = 200;
+
 		// MainCB (b0)
 		struct CBData
 		{
 			XMMATRIX world;		 // ワールド行列
 			XMMATRIX view;		 // ビュー行列
 			XMMATRIX projection; // プロジェクション行列
-			XMMATRIX boneTransforms[200]; // ボーン行列 (最大200)
+			XMMATRIX boneTransforms[MAX_BONES]; // ボーン行列 (最大200)
 			XMFLOAT4 lightDir;	 // ライト方向
 			XMFLOAT4 lightColor; // ライト色
 			XMFLOAT4 materialColor; // マテリアル色
@@ -72,7 +76,8 @@ namespace Arche
 		static void SetSceneLights(const XMFLOAT3& ambientColor, float ambientIntensity, const std::vector<PointLightData>& lights);
 
 		static void Draw(std::shared_ptr<Model> model, const XMFLOAT3& pos, const XMFLOAT3& scale = { 1,1,1 }, const XMFLOAT3& rot = { 0,0,0 });
-		static void Draw(std::shared_ptr<Model> model, const DirectX::XMMATRIX& worldMatrix);
+		// @param	palette	アニメーション側で計算済みのパレット（nullptrならここで計算する）
+		static void Draw(std::shared_ptr<Model> model, const DirectX::XMMATRIX& worldMatrix, const SkinningPalette* palette = nullptr);
 
 	private:
 		static void CreateWhiteTexture();
@@ -92,7 +97,10 @@ namespace Arche
 		static ComPtr<ID3D11RasterizerState> s_rsSolid;
 
 		static ComPtr<ID3D11ShaderResourceView> s_whiteTexture;
+		static ComPtr<ID3D11Buffer> s_emptySkinStream;	// スキン無しメッシュのスロット1用
 		static CBData s_cbData;
+		static SkinningPalette s_fallbackPalette;
+		static size_t s_boneCountInCB;	// boneTransforms のうち、単位行列でない可能性がある先頭からの数
 		static SceneLightCBData s_lightData;
 	};
 
@@ -0,0 +1,304 @@
+﻿/*****************************************************************//**
+ * @file	AssetArchive.cpp
+ * @brief	リソースをまとめたパックファイル (.pak)
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Resource/AssetArchive.h"
+#include "Engine/Core/Base/Hash.h"
+#include "Engine/Core/Base/Lz.h"
+
+namespace Arche
+{
+	namespace
+	{
+		inline char ToLowerAscii(char c) { return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c; }
+
+		uint64_t AlignUp(uint64_t value, uint64_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+
+		bool ReadFileBytes(const std::string& path, std::vector<uint8_t>& out)
+		{
+			std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+			if (!ifs.is_open()) return false;
+			std::streamsize size = ifs.tellg();
+			if (size < 0) return false;
+			out.resize((size_t)size);
+			ifs.seekg(0);
+			return size == 0 || (bool)ifs.read((char*)out.data(), size);
+		}
+	}
+
+	// ====================================================================================
+	// 読み込み
+	// ====================================================================================
+	bool AssetArchive::Open(const std::string& path)
+	{
+		Close();
+		if (!m_file.Open(path)) return false;
+
+		const Header* header = m_file.At<Header>(0);
+		if (!header || header->magic != MAGIC || header->version != VERSION)
+		{
+			Close();
+			return false;
+		}
+
+		const Entry* entries = m_file.At<Entry>(header->tocOffset, header->entryCount);
+		const char* strings = m_file.At<char>(header->stringOffset, header->stringSize);
+		if ((!entries && header->entryCount > 0) || (!strings && header->stringSize > 0))
+		{
+			Close();
+			return false;
+		}
+
+		// 範囲外を指すエントリがあればパックごと使わない（読むたびに確認しなくて済むように）
+		for (uint32_t i = 0; i < header->entryCount; ++i)
+		{
+			const Entry& entry = entries[i];
+			if ((uint64_t)entry.pathOffset + entry.pathLength > header->stringSize ||
+				!m_file.At<uint8_t>(entry.offset, entry.storedSize) ||
+				(entry.compression == Compression::None && entry.storedSize != entry.size) ||
+				entry.compression > Compression::Lz)
+			{
+				Close();
+				return false;
+			}
+		}
+
+		m_path = path;
+		m_header = header;
+		m_entries = entries;
+		m_strings = strings;
+		return true;
+	}
+
+	void AssetArchive::Close()
+	{
+		m_file.Close();
+		m_path.clear();
+		m_header = nullptr;
+		m_entries = nullptr;
+		m_strings = nullptr;
+	}
+
+	const AssetArchive::Entry* AssetArchive::Find(const std::string& path) const
+	{
+		if (!m_header || m_header->entryCount == 0) return nullptr;
+
+		std::string normalized = NormalizePath(path);
+		const Entry* begin = m_entries;
+		const Entry* end = m_entries + m_header->entryCount;
+
+		const Entry* it = std::lower_bound(begin, end, normalized, [this](const Entry& entry, const std::string& key) {
+			return ComparePath(m_strings + entry.pathOffset, entry.pathLength, key.data(), key.size()) < 0;
+			});
+
+		if (it == end || ComparePath(m_strings + it->pathOffset, it->pathLength, normalized.data(), normalized.size()) != 0) return nullptr;
+		return it;
+	}
+
+	std::string AssetArchive::GetEntryPath(const Entry& entry) const
+	{
+		return std::string(m_strings + entry.pathOffset, entry.pathLength);
+	}
+
+	bool AssetArchive::Extract(const Entry& entry, std::vector<uint8_t>& out) const
+	{
+		out.resize((size_t)entry.size);
+		const uint8_t* stored = GetStoredData(entry);
+
+		if (entry.compression == Compression::Lz)
+		{
+			if (!Lz::Decompress(stored, (size_t)entry.storedSize, out.data(), out.size())) return false;
+		}
+		else if (entry.size > 0)
+		{
+			memcpy(out.data(), stored, (size_t)entry.size);
+		}
+
+		return Hash::Fnv1a64(out.data(), out.size()) == entry.contentHash;
+	}
+
+	std::string AssetArchive::NormalizePath(const std::string& path)
+	{
+		std::string result = path;
+		std::replace(result.begin(), result.end(), '\\', '/');
+		while (result.compare(0, 2, "./") == 0) result.erase(0, 2);
+		return result;
+	}
+
+	int AssetArchive::ComparePath(const char* a, size_t aLength, const char* b, size_t bLength)
+	{
+		size_t length = std::min(aLength, bLength);
+		for (size_t i = 0; i < length; ++i)
+		{
+			char ca = ToLowerAscii(a[i]);
+			char cb = ToLowerAscii(b[i]);
+			if (ca != cb) return (unsigned char)ca < (unsigned char)cb ? -1 : 1;
+		}
+		if (aLength == bLength) return 0;
+		return aLength < bLength ? -1 : 1;
+	}
+
+	// ====================================================================================
+	// 書き出し
+	// ====================================================================================
+	void AssetArchiveWriter::AddFile(const std::string& archivePath, const std::string& diskPath, bool compress)
+	{
+		m_files.push_back({ AssetArchive::NormalizePath(archivePath), diskPath, compress && !IsPrecompressed(diskPath) });
+	}
+
+	bool AssetArchiveWriter::IsPrecompressed(const std::string& path)
+	{
+		std::string ext = std::filesystem::path(path).extension().string();
+		std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+		// .wav は BGM をストリーミング再生するので無圧縮のまま置く（展開すると曲全体がメモリに載る）
+		static const char* const extensions[] = { ".png", ".jpg", ".jpeg", ".ogg", ".mp3", ".zip", ".pak", ".wav" };
+		for (const char* e : extensions) if (ext == e) return true;
+		return false;
+	}
+
+	bool AssetArchiveWriter::Write(const std::string& outputPath, Report& report) const
+	{
+		using Entry = AssetArchive::Entry;
+		using Header = AssetArchive::Header;
+
+		// 目次の順に並べ、同じパス（大文字小文字違いを含む）は最初のものだけ残す
+		auto Compare = [](const SourceFile* a, const SourceFile* b) {
+			return AssetArchive::ComparePath(a->archivePath.data(), a->archivePath.size(), b->archivePath.data(), b->archivePath.size());
+			};
+
+		std::vector<const SourceFile*> sorted;
+		sorted.reserve(m_files.size());
+		for (const auto& file : m_files) sorted.push_back(&file);
+		std::stable_sort(sorted.begin(), sorted.end(), [&](const SourceFile* a, const SourceFile* b) { return Compare(a, b) < 0; });
+
+		std::vector<const SourceFile*> files;
+		files.reserve(sorted.size());
+		for (const SourceFile* file : sorted)
+		{
+			if (!files.empty() && Compare(files.back(), file) == 0)
+			{
+				report.errors.push_back("Duplicate path skipped: " + file->archivePath);
+				continue;
+			}
+			files.push_back(file);
+		}
+
+		std::string tempPath = outputPath + ".tmp";
+		std::ofstream ofs(tempPath, std::ios::binary | std::ios::trunc);
+		if (!ofs.is_open())
+		{
+			report.errors.push_back("Failed to open output: " + tempPath);
+			return false;
+		}
+
+		// ヘッダーは最後に書き直す
+		Header header = {};
+		ofs.write((const char*)&header, sizeof(header));
+		uint64_t position = sizeof(header);
+
+		auto Pad = [&](uint64_t alignment) {
+			static const char zeros[AssetArchive::ALIGNMENT] = {};
+			uint64_t aligned = AlignUp(position, alignment);
+			while (position < aligned)
+			{
+				uint64_t n = std::min<uint64_t>(aligned - position, sizeof(zeros));
+				ofs.write(zeros, (std::streamsize)n);
+				position += n;
+			}
+			};
+
+		std::vector<Entry> entries;
+		std::string strings;
+		entries.reserve(files.size());
+
+		std::vector<uint8_t> data;
+		std::vector<uint8_t> compressed;
+		for (const SourceFile* file : files)
+		{
+			if (!ReadFileBytes(file->diskPath, data))
+			{
+				report.errors.push_back("Failed to read: " + file->diskPath);
+				continue;
+			}
+
+			Entry entry = {};
+			entry.pathOffset = (uint32_t)strings.size();
+			entry.pathLength = (uint32_t)file->archivePath.size();
+			entry.size = data.size();
+			entry.contentHash = Hash::Fnv1a64(data.data(), data.size());
+			entry.compression = AssetArchive::Compression::None;
+
+			const uint8_t* stored = data.data();
+			uint64_t storedSize = data.size();
+
+			if (file->compress && !data.empty())
+			{
+				compressed.resize(Lz::GetMaxCompressedSize(data.size()));
+				size_t size = Lz::Compress(data.data(), data.size(), compressed.data(), compressed.size());
+				if (size > 0 && size * 100 <= data.size() * (100 - MIN_SAVING_PERCENT))
+				{
+					entry.compression = AssetArchive::Compression::Lz;
+					stored = compressed.data();
+					storedSize = size;
+					report.compressedCount++;
+				}
+			}
+
+			Pad(AssetArchive::ALIGNMENT);
+			entry.offset = position;
+			entry.storedSize = storedSize;
+			if (storedSize > 0) ofs.write((const char*)stored, (std::streamsize)storedSize);
+			position += storedSize;
+
+			strings += file->archivePath;
+			entries.push_back(entry);
+
+			report.fileCount++;
+			report.sourceBytes += data.size();
+		}
+
+		Pad(16);
+		header.magic = AssetArchive::MAGIC;
+		header.version = AssetArchive::VERSION;
+		header.entryCount = (uint32_t)entries.size();
+		header.tocOffset = position;
+		if (!entries.empty()) ofs.write((const char*)entries.data(), (std::streamsize)(entries.size() * sizeof(Entry)));
+		position += entries.size() * sizeof(Entry);
+
+		header.stringOffset = position;
+		header.stringSize = strings.size();
+		ofs.write(strings.data(), (std::streamsize)strings.size());
+		position += strings.size();
+
+		ofs.seekp(0);
+		ofs.write((const char*)&header, sizeof(header));
+		bool ok = (bool)ofs;
+		ofs.close();
+
+		std::error_code ec;
+		if (ok)
+		{
+			std::filesystem::rename(tempPath, outputPath, ec);
+			ok = !ec;
+		}
+		if (!ok)
+		{
+			std::filesystem::remove(tempPath, ec);
+			report.errors.push_back("Failed to write: " + outputPath);
+			return false;
+		}
+
+		report.archiveBytes = position;
+		return true;
+	}
+
+}	// namespace Arche
@@ -0,0 +1,140 @@
+﻿/*****************************************************************//**
+ * @file	AssetArchive.h
+ * @brief	リソースをまとめたパックファイル (.pak)
+ *
+ * @details	リリースビルド用。Resources/ 以下を1ファイルに詰め、メモリマップで参照する。
+ *			[Header][エントリ本体（4KB境界）...][目次 (Entry 配列)][文字列テーブル]
+ *			- 目次はパスの大文字小文字を無視した順に並べてあり、二分探索で引く
+ *			  （Windows のファイルシステムと同じ照合。文字列テーブルには元の表記のまま入れる）
+ *			- エントリ本体はページ境界に揃えてあり、無圧縮のものはマップしたまま直接読める
+ *			- 圧縮は Lz（展開優先）。縮まないもの・既に圧縮済みの形式はそのまま入れる
+ *			- contentHash は展開後の内容のハッシュ（破損検出・差分確認用）
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___ASSET_ARCHIVE_H___
+#define ___ASSET_ARCHIVE_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Resource/MappedFile.h"
+
+namespace Arche
+{
+	class ARCHE_API AssetArchive
+	{
+	public:
+		static constexpr uint32_t MAGIC = 0x43524141;	// "AARC"
+		static constexpr uint32_t VERSION = 1;
+		static constexpr uint64_t ALIGNMENT = 4096;
+		static constexpr const char* EXTENSION = ".pak";
+
+		enum class Compression : uint32_t
+		{
+			None,
+			Lz,
+		};
+
+		struct Header
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint32_t entryCount;
+			uint32_t reserved;
+			uint64_t tocOffset;
+			uint64_t stringOffset;
+			uint64_t stringSize;
+		};
+
+		struct Entry
+		{
+			uint32_t pathOffset;	// 文字列テーブル内の位置
+			uint32_t pathLength;
+			uint64_t offset;		// 本体の位置（ファイル先頭から）
+			uint64_t storedSize;	// パック内のサイズ
+			uint64_t size;			// 展開後のサイズ
+			uint64_t contentHash;
+			Compression compression;
+			uint32_t reserved;
+		};
+
+		bool Open(const std::string& path);
+		void Close();
+
+		bool IsOpen() const { return m_file.IsOpen(); }
+		const std::string& GetPath() const { return m_path; }
+
+		uint32_t GetEntryCount() const { return m_header ? m_header->entryCount : 0; }
+		const Entry* GetEntries() const { return m_entries; }
+
+		// 見つからなければ nullptr
+		const Entry* Find(const std::string& path) const;
+
+		std::string GetEntryPath(const Entry& entry) const;
+
+		// パック内の本体（圧縮されていれば圧縮されたまま）
+		const uint8_t* GetStoredData(const Entry& entry) const { return m_file.GetData() + entry.offset; }
+
+		// 展開して out に書き出す（サイズ・ハッシュが合わなければ false）
+		bool Extract(const Entry& entry, std::vector<uint8_t>& out) const;
+
+		// 区切りを '/' に揃え、先頭の "./" を除く
+		static std::string NormalizePath(const std::string& path);
+
+		// 大文字小文字を無視した比較（目次の並び順）
+		static int ComparePath(const char* a, size_t aLength, const char* b, size_t bLength);
+
+	private:
+		MappedFile m_file;
+		std::string m_path;
+		const Header* m_header = nullptr;
+		const Entry* m_entries = nullptr;
+		const char* m_strings = nullptr;
+	};
+
+	// ビルド時にパックを書き出す
+	class ARCHE_API AssetArchiveWriter
+	{
+	public:
+		struct Report
+		{
+			size_t fileCount = 0;
+			size_t compressedCount = 0;
+			uint64_t sourceBytes = 0;	// 入力の合計
+			uint64_t archiveBytes = 0;	// 書き出したパックのサイズ
+			std::vector<std::string> errors;
+		};
+
+		// 圧縮後が元の 90% 以下にならなければ無圧縮で入れる
+		static constexpr uint64_t MIN_SAVING_PERCENT = 10;
+
+		/**
+		 * @param	archivePath	パック内のパス（実行時に読むときのパスと同じもの。例: "Resources/Game/Textures/a.png"）
+		 * @param	diskPath	実際に読むファイル
+		 * @param	compress	false なら無圧縮で入れる
+		 */
+		void AddFile(const std::string& archivePath, const std::string& diskPath, bool compress);
+
+		size_t GetFileCount() const { return m_files.size(); }
+
+		bool Write(const std::string& outputPath, Report& report) const;
+
+		// 圧縮しない形式（既に圧縮されていて Lz をかけても縮まないもの、ストリーミング再生する .wav）
+		static bool IsPrecompressed(const std::string& path);
+
+	private:
+		struct SourceFile
+		{
+			std::string archivePath;
+			std::string diskPath;
+			bool compress;
+		};
+		std::vector<SourceFile> m_files;
+	};
+
+}	// namespace Arche
+
+#endif // !___ASSET_ARCHIVE_H___
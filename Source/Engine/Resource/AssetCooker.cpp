@@ -0,0 +1,383 @@
+﻿/*****************************************************************//**
+ * @file	AssetCooker.cpp
+ * @brief	アセットのオフライン変換（クック）
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Resource/AssetCooker.h"
+#include "Engine/Resource/AssetLoader.h"
+#include "Engine/Resource/ResourceManager.h"
+#include "Engine/Resource/VirtualFileSystem.h"
+#include "Engine/Renderer/Data/Model.h"
+#include "Engine/Renderer/Data/CookedMesh.h"
+#include "Engine/Scene/Serializer/SceneSerializer.h"
+#include "Engine/Scene/Serializer/ComponentSerializer.h"
+#include "Engine/Scene/Serializer/SceneBinary.h"
+#include "Engine/Core/Base/Hash.h"
+#include "Engine/Core/Base/Logger.h"
+#include <unordered_set>
+
+namespace Arche
+{
+	namespace
+	{
+		// クック済みモデルが書き出したときのままか（実行時の読み込みはハッシュを確かめないので、壊れていればここで作り直す）
+		bool IsCookedMeshIntact(const std::string& path)
+		{
+			FileView file;
+			return VirtualFileSystem::Instance().Open(path, file) && CookedMesh::VerifyPayload(file.GetData(), file.GetSize());
+		}
+
+		// 登録済みコンポーネントは ComponentRegistry を通して読み書きし直す（既定値の補完・不要なキーの除去）
+		// 未登録のキー（ID, IsActive, ゲーム側のコンポーネントなど）はそのまま残す
+		json NormalizeEntity(Registry& reg, const json& source)
+		{
+			if (!source.is_object()) return source;
+
+			Entity entity = reg.create();
+			ComponentSerializer::DeserializeEntity(reg, entity, source);
+
+			json result = json::object();
+			ComponentSerializer::SerializeEntity(reg, entity, result);
+
+			const auto& interfaces = ComponentRegistry::Instance().GetInterfaces();
+			for (const auto& [key, value] : source.items())
+			{
+				if (interfaces.count(key)) continue;
+
+				if (key == "Children" && value.is_array())
+				{
+					json children = json::array();
+					for (const auto& child : value) children.push_back(NormalizeEntity(reg, child));
+					result[key] = std::move(children);
+				}
+				else
+				{
+					result[key] = value;
+				}
+			}
+			return result;
+		}
+
+		bool IsUnder(const std::string& path, const char* directory)
+		{
+			return path.find(std::string("/") + directory + "/") != std::string::npos;
+		}
+	}
+
+	AssetCooker::AssetCooker(const CookSettings& settings)
+		: m_settings(settings)
+	{
+		// ResourceManager は初期化しない（エディタから呼ばれたときに、動いているマネージャーへ要求を積まないように）
+		// 検索規則だけを同じものにする
+		m_modelRegistry.Configure(ResourceManager::GetModelDirectories(), ResourceManager::GetModelExtensions());
+	}
+
+	CookReport AssetCooker::Run()
+	{
+		CookReport report;
+		auto startTime = std::chrono::high_resolution_clock::now();
+		auto Elapsed = [](std::chrono::high_resolution_clock::time_point from) {
+			return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - from).count();
+			};
+
+		// コンポーネントの型IDはここで確定させておく（型IDの採番はスレッドセーフではない）
+		{
+			Registry warmup;
+			Entity entity = warmup.create();
+			for (const auto& [name, iface] : ComponentRegistry::Instance().GetInterfaces()) iface.add(warmup, entity);
+		}
+		m_modelRegistry.Scan();
+
+		std::vector<Item> items;
+		Gather(items);
+		report.total = items.size();
+
+		AssetLoader workers;
+		workers.Start(m_settings.workerCount > 0 ? m_settings.workerCount : std::max(1u, std::thread::hardware_concurrency()));
+
+		// 1. 内容ハッシュと依存関係（並列）
+		auto hashStart = std::chrono::high_resolution_clock::now();
+		{
+			std::vector<std::future<bool>> futures;
+			futures.reserve(items.size());
+			for (auto& item : items)
+			{
+				futures.push_back(workers.Submit([this, &item]() { return HashItem(item); }));
+			}
+			for (auto& f : futures) f.wait();
+		}
+		ComputeKeys(items);
+		report.hashSeconds = Elapsed(hashStart);
+
+		// 2. 変更のあったものだけクック（並列）
+		CookDatabaseEntries database = m_settings.force ? CookDatabaseEntries() : CookDatabase::Load(m_settings.databasePath, VERSION);
+
+		std::vector<Item*> dirty;
+		for (auto& item : items)
+		{
+			if (!item.hashed)
+			{
+				++report.failed;
+				report.errors.push_back(item.path + ": " + item.error);
+				database.erase(item.path);
+				continue;
+			}
+
+			std::error_code ec;
+			bool upToDate = CookGraph::IsUpToDate(database, item) && std::filesystem::is_regular_file(GetOutputPath(item), ec);
+			if (upToDate && item.kind == AssetKind::Model) upToDate = IsCookedMeshIntact(GetOutputPath(item));
+
+			if (upToDate) ++report.upToDate;
+			else dirty.push_back(&item);
+		}
+
+		auto cookStart = std::chrono::high_resolution_clock::now();
+		{
+			struct Result { uint64_t bytes = 0; std::string error; };
+			std::vector<Result> results(dirty.size());
+			std::vector<std::future<bool>> futures;
+			futures.reserve(dirty.size());
+			for (size_t i = 0; i < dirty.size(); ++i)
+			{
+				const Item* item = dirty[i];
+				Result* result = &results[i];
+				futures.push_back(workers.Submit([this, item, result]() {
+					try { return CookItem(*item, result->bytes, result->error); }
+					catch (const std::exception& e) { result->error = e.what(); return false; }
+					}));
+			}
+
+			for (size_t i = 0; i < dirty.size(); ++i)
+			{
+				const Item& item = *dirty[i];
+				if (futures[i].get())
+				{
+					++report.cooked;
+					report.cookedBytes += item.size;
+					report.outputBytes += results[i].bytes;
+					database[item.path] = item.cookKey;
+				}
+				else
+				{
+					++report.failed;
+					report.errors.push_back(item.path + ": " + results[i].error);
+					database.erase(item.path);
+				}
+			}
+		}
+		report.cookSeconds = Elapsed(cookStart);
+
+		workers.Shutdown();
+
+		// 消えたソースの記録は捨てる
+		std::unordered_set<std::string> existing;
+		for (const auto& item : items) existing.insert(item.path);
+		CookDatabase::Prune(database, existing);
+		if (!CookDatabase::Save(m_settings.databasePath, VERSION, database))
+		{
+			Logger::LogError("Failed to write cook database: " + m_settings.databasePath);
+		}
+
+		report.totalSeconds = Elapsed(startTime);
+		return report;
+	}
+
+	void AssetCooker::Gather(std::vector<Item>& outItems) const
+	{
+		const auto& modelExts = ResourceManager::GetModelExtensions();
+
+		std::error_code ec;
+		for (auto it = std::filesystem::recursive_directory_iterator(m_settings.sourceRoot, ec); !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+		{
+			if (!it->is_regular_file(ec)) continue;
+
+			std::string path = NormalizePath(it->path().string());
+			// エディタの一時ファイル・クッカー自身のデータベース
+			if (IsUnder(path, "Cache")) continue;
+
+			std::string ext = it->path().extension().string();
+			std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+			Item item;
+			item.path = path;
+			if (std::find(modelExts.begin(), modelExts.end(), ext) != modelExts.end()) item.kind = AssetKind::Model;
+			else if (ext == ".json" && IsUnder(path, "Scenes")) item.kind = AssetKind::Scene;
+			else if (ext == ".json" && IsUnder(path, "Prefabs")) item.kind = AssetKind::Prefab;
+			else continue;
+
+			outItems.push_back(std::move(item));
+		}
+
+		// 出力順を安定させる
+		std::sort(outItems.begin(), outItems.end(), [](const Item& a, const Item& b) { return a.path < b.path; });
+	}
+
+	bool AssetCooker::HashItem(Item& item)
+	{
+		std::vector<uint8_t> bytes;
+		if (!ReadAllBytes(item.path, bytes))
+		{
+			item.error = "failed to read";
+			return false;
+		}
+		item.size = bytes.size();
+		item.contentHash = Hash::Fnv1a64(bytes.data(), bytes.size());
+
+		if (item.kind != AssetKind::Model)
+		{
+			json root = json::parse(bytes.begin(), bytes.end(), nullptr, false);
+			if (root.is_discarded())
+			{
+				item.error = "JSON parse error";
+				return false;
+			}
+
+			// 参照しているモデル・コントローラーが変わったら作り直す
+			std::vector<std::string> models, textures, sounds, controllers;
+			SceneSerializer::CollectAssets(root, models, textures, sounds, controllers);
+
+			for (const auto& key : models)
+			{
+				std::string path = m_modelRegistry.Resolve(key);
+				if (!path.empty()) item.dependencies.push_back(NormalizePath(path));
+			}
+			for (const auto& path : controllers) item.dependencies.push_back(NormalizePath(path));
+
+			CookGraph::SortDependencies(item);
+		}
+
+		item.hashed = true;
+		return true;
+	}
+
+	void AssetCooker::ComputeKeys(std::vector<Item>& items) const
+	{
+		std::vector<CookNode*> nodes;
+		nodes.reserve(items.size());
+		for (auto& item : items)
+		{
+			// コンポーネントのフィールドが変わったらバイナリシーンを作り直す
+			if (item.kind == AssetKind::Scene) item.salt = SceneBinary::GetSchemaHash();
+			nodes.push_back(&item);
+		}
+
+		CookGraph::ComputeKeys(nodes.data(), nodes.size(), VERSION, [](const std::string& path) {
+			std::vector<uint8_t> bytes;
+			return ReadAllBytes(path, bytes) ? Hash::Fnv1a64(bytes.data(), bytes.size()) : 0;
+			});
+	}
+
+	bool AssetCooker::CookItem(const Item& item, uint64_t& outBytes, std::string& outError) const
+	{
+		switch (item.kind)
+		{
+		case AssetKind::Model:	return CookModel(item, outBytes, outError);
+		case AssetKind::Scene:
+		case AssetKind::Prefab:	return CookDocument(item, outBytes, outError);
+		}
+		return false;
+	}
+
+	bool AssetCooker::CookModel(const Item& item, uint64_t& outBytes, std::string& outError) const
+	{
+		Model model;
+		if (!model.LoadSourceForCook(item.path))
+		{
+			outError = "import failed";
+			return false;
+		}
+
+		std::string output = GetOutputPath(item);
+		if (!model.SaveCooked(output))
+		{
+			outError = "failed to write " + output;
+			return false;
+		}
+
+		std::error_code ec;
+		outBytes = std::filesystem::file_size(output, ec);
+		return true;
+	}
+
+	bool AssetCooker::CookDocument(const Item& item, uint64_t& outBytes, std::string& outError) const
+	{
+		std::ifstream fin(item.path);
+		json source = json::parse(fin, nullptr, false);
+		if (source.is_discarded())
+		{
+			outError = "JSON parse error";
+			return false;
+		}
+
+		std::vector<uint8_t> bytes;
+		if (item.kind == AssetKind::Scene)
+		{
+			// シーンはバイナリ形式（正規化は DeserializeEntity を通す時点で行われる）
+			if (!SceneBinary::FromJson(source, bytes))
+			{
+				outError = "failed to build binary scene";
+				return false;
+			}
+		}
+		else
+		{
+			Registry scratch;
+			json result;
+			if (source.is_array())
+			{
+				// 旧形式のプレファブ（エンティティの配列）
+				result = json::array();
+				for (const auto& entity : source) result.push_back(NormalizeEntity(scratch, entity));
+			}
+			else
+			{
+				result = NormalizeEntity(scratch, source);
+			}
+			bytes = json::to_msgpack(result);
+		}
+
+		std::string output = GetOutputPath(item);
+		if (!CookDatabase::WriteFileAtomic(output, bytes.data(), bytes.size()))
+		{
+			outError = "failed to write " + output;
+			return false;
+		}
+
+		outBytes = bytes.size();
+		return true;
+	}
+
+	std::string AssetCooker::GetOutputPath(const Item& item)
+	{
+		if (item.kind == AssetKind::Model) return CookedMesh::GetCookedPath(item.path);
+		if (item.kind == AssetKind::Scene) return item.path + SceneBinary::EXTENSION;
+		return item.path + SceneSerializer::COOKED_EXTENSION;
+	}
+
+	std::string AssetCooker::NormalizePath(const std::string& path)
+	{
+		return std::filesystem::path(path).lexically_normal().generic_string();
+	}
+
+	bool AssetCooker::ReadAllBytes(const std::string& path, std::vector<uint8_t>& outBytes)
+	{
+		std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+		if (!ifs) return false;
+
+		std::streamsize size = ifs.tellg();
+		if (size < 0) return false;
+		ifs.seekg(0);
+
+		outBytes.resize((size_t)size);
+		return size == 0 || (bool)ifs.read(reinterpret_cast<char*>(outBytes.data()), size);
+	}
+
+}	// namespace Arche
@@ -0,0 +1,94 @@
+﻿/*****************************************************************//**
+ * @file	AssetCooker.h
+ * @brief	アセットのオフライン変換（クック）
+ *
+ * @details	Resources/ 以下を走査し、ランタイムが速く読める形式に変換する。
+ *			- モデル (.fbx/.obj/.gltf/.glb) → <ソース>.amesh（Model::SaveCooked）
+ *			- シーン (.json) → <ソース>.ascene（SceneBinary）
+ *			- プレファブ (.json) → <ソース>.msgpack（ComponentRegistry で正規化）
+ *			入力の内容ハッシュと依存先（モデル・コントローラー）のハッシュから
+ *			キーを作ってデータベースに記録し、キーが変わったものだけをクックする。
+ *			ハッシュ計算とクックはどちらも全コアで並列に行う。
+ *			キーと記録の扱いは CookGraph / CookDatabase にある（この2つは Windows 以外でもビルドできる）。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___ASSET_COOKER_H___
+#define ___ASSET_COOKER_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Resource/AssetRegistry.h"
+#include "Engine/Resource/CookGraph.h"
+
+namespace Arche
+{
+	struct CookSettings
+	{
+		std::string sourceRoot = "Resources/";
+		std::string databasePath = "Resources/Engine/Cache/CookDatabase.json";
+		size_t workerCount = 0;		// 0なら論理コア数
+		bool force = false;			// データベースを無視して全件クック
+	};
+
+	struct CookReport
+	{
+		size_t total = 0;			// 対象アセット数
+		size_t cooked = 0;			// 今回クックした数
+		size_t upToDate = 0;		// キャッシュヒット（クック不要）
+		size_t failed = 0;
+		uint64_t cookedBytes = 0;	// クックした入力の合計サイズ
+		uint64_t outputBytes = 0;	// 書き出した合計サイズ
+		double hashSeconds = 0.0;
+		double cookSeconds = 0.0;
+		double totalSeconds = 0.0;
+		std::vector<std::string> errors;
+
+		double GetHitRate() const { return total > 0 ? (double)upToDate / (double)total : 0.0; }
+		// クック処理の入力スループット (MB/s)
+		double GetThroughput() const { return cookSeconds > 0.0 ? (double)cookedBytes / (1024.0 * 1024.0) / cookSeconds : 0.0; }
+	};
+
+	class ARCHE_API AssetCooker
+	{
+	public:
+		// クック処理や出力形式を変えたら上げる（全件がクックし直しになる）
+		static constexpr uint32_t VERSION = 3;
+
+		explicit AssetCooker(const CookSettings& settings);
+
+		CookReport Run();
+
+	private:
+		enum class AssetKind { Model, Scene, Prefab };
+
+		struct Item : CookNode
+		{
+			AssetKind kind = AssetKind::Model;
+			uint64_t size = 0;
+			std::string error;
+		};
+
+		void Gather(std::vector<Item>& outItems) const;
+		bool HashItem(Item& item);
+		void ComputeKeys(std::vector<Item>& items) const;
+		bool CookItem(const Item& item, uint64_t& outBytes, std::string& outError) const;
+
+		bool CookModel(const Item& item, uint64_t& outBytes, std::string& outError) const;
+		bool CookDocument(const Item& item, uint64_t& outBytes, std::string& outError) const;
+
+		static std::string GetOutputPath(const Item& item);
+		static std::string NormalizePath(const std::string& path);
+		static bool ReadAllBytes(const std::string& path, std::vector<uint8_t>& outBytes);
+
+	private:
+		CookSettings m_settings;
+		AssetRegistry m_modelRegistry;	// modelKey → パス（ResourceManager と同じ規則）
+	};
+
+}	// namespace Arche
+
+#endif // !___ASSET_COOKER_H___
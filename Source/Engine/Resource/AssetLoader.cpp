@@ -0,0 +1,98 @@
+﻿/*****************************************************************//**
+ * @file	AssetLoader.cpp
+ * @brief	アセット読み込み用の固定サイズワーカープール
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Resource/AssetLoader.h"
+
+namespace Arche
+{
+	void AssetLoader::Start(size_t workerCount)
+	{
+		if (!m_workers.empty()) return;
+
+		if (workerCount == 0)
+		{
+			// メインスレッドと描画の分を残す（I/O待ちが多いので最低2本）
+			size_t cores = std::thread::hardware_concurrency();
+			workerCount = std::clamp<size_t>(cores > 2 ? cores - 2 : 1, 2, 8);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = false;
+		}
+
+		for (size_t i = 0; i < workerCount; ++i)
+		{
+			m_workers.emplace_back(&AssetLoader::WorkerMain, this);
+		}
+	}
+
+	void AssetLoader::Shutdown()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+			// 未着手のジョブは破棄（future側には broken_promise が伝わる）
+			m_queue = std::priority_queue<Job>();
+		}
+		m_cv.notify_all();
+
+		for (auto& worker : m_workers)
+		{
+			if (worker.joinable()) worker.join();
+		}
+		m_workers.clear();
+	}
+
+	std::future<bool> AssetLoader::Submit(std::function<bool()> job, LoadPriority priority)
+	{
+		if (m_workers.empty()) Start();
+
+		auto task = std::make_shared<std::packaged_task<bool()>>(std::move(job));
+		std::future<bool> future = task->get_future();
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_queue.push(Job{ priority, m_sequence++, std::move(task) });
+		}
+		m_cv.notify_one();
+
+		return future;
+	}
+
+	size_t AssetLoader::GetPendingCount()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_queue.size();
+	}
+
+	void AssetLoader::WorkerMain()
+	{
+		while (true)
+		{
+			Job job;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+				if (m_stop) return;
+
+				job = m_queue.top();
+				m_queue.pop();
+			}
+
+			// 例外は packaged_task が future に格納する
+			(*job.task)();
+		}
+	}
+
+}	// namespace Arche
@@ -0,0 +1,82 @@
+﻿/*****************************************************************//**
+ * @file	AssetLoader.h
+ * @brief	アセット読み込み用の固定サイズワーカープール
+ *
+ * @details	アセットごとにスレッドを作らず、決まった数のワーカーで
+ *			優先度付きキューからジョブを取り出して処理する。
+ *			同じ優先度の中では要求順（FIFO）に処理される。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___ASSET_LOADER_H___
+#define ___ASSET_LOADER_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include <future>
+#include <queue>
+#include <condition_variable>
+
+namespace Arche
+{
+	// 読み込み優先度（値が小さいほど先に処理）
+	enum class LoadPriority
+	{
+		High = 0,	// 画面にすぐ必要なもの（プレイヤー、UIなど）
+		Normal,
+		Low,		// 先読み
+	};
+
+	class AssetLoader
+	{
+	public:
+		AssetLoader() = default;
+		~AssetLoader() { Shutdown(); }
+
+		AssetLoader(const AssetLoader&) = delete;
+		AssetLoader& operator=(const AssetLoader&) = delete;
+
+		// ワーカー起動（0なら論理コア数から決める）
+		void Start(size_t workerCount = 0);
+
+		// 未処理のジョブを破棄し、実行中のジョブの完了を待って停止
+		void Shutdown();
+
+		// ジョブ投入（未起動なら起動する）
+		std::future<bool> Submit(std::function<bool()> job, LoadPriority priority = LoadPriority::Normal);
+
+		size_t GetWorkerCount() const { return m_workers.size(); }
+		size_t GetPendingCount();
+
+	private:
+		struct Job
+		{
+			LoadPriority priority;
+			uint64_t sequence;
+			std::shared_ptr<std::packaged_task<bool()>> task;
+
+			// priority_queue は最大ヒープなので「後に処理するもの」を小さくする
+			bool operator<(const Job& other) const
+			{
+				if (priority != other.priority) return priority > other.priority;
+				return sequence > other.sequence;
+			}
+		};
+
+		void WorkerMain();
+
+	private:
+		std::vector<std::thread> m_workers;
+		std::priority_queue<Job> m_queue;
+		std::mutex m_mutex;
+		std::condition_variable m_cv;
+		uint64_t m_sequence = 0;
+		bool m_stop = false;
+	};
+
+}	// namespace Arche
+
+#endif // !___ASSET_LOADER_H___
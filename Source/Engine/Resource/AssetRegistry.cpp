@@ -0,0 +1,259 @@
+﻿/*****************************************************************//**
+ * @file	AssetRegistry.cpp
+ * @brief	アセットのキー → ファイルパスの索引
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Resource/AssetRegistry.h"
+#include "Engine/Core/Base/Logger.h"
+#include "Engine/Resource/VirtualFileSystem.h"
+#include "Engine/Renderer/Data/CookedMesh.h"
+
+namespace Arche
+{
+	namespace
+	{
+		// 実際に開くパス（大文字小文字はそのまま、区切り文字だけ揃える）
+		std::string ToGenericPath(const std::string& path)
+		{
+			std::string result = path;
+			std::replace(result.begin(), result.end(), '\\', '/');
+			return result;
+		}
+	}
+
+	AssetRegistry::~AssetRegistry()
+	{
+		StopWatching();
+	}
+
+	void AssetRegistry::Configure(const std::vector<std::string>& directories, const std::vector<std::string>& extensions)
+	{
+		StopWatching();
+
+		std::unique_lock<std::shared_mutex> lock(m_mutex);
+		m_directories = directories;
+		m_extensions = extensions;
+		m_configRevision++;
+		m_entries.clear();
+		m_misses.clear();
+		m_scanned = false;
+	}
+
+	void AssetRegistry::Scan()
+	{
+		std::lock_guard<std::mutex> scanLock(m_scanMutex);
+		ScanLocked();
+	}
+
+	void AssetRegistry::EnsureScanned()
+	{
+		if (m_scanned) return;
+
+		// 先に走査を始めたスレッドがあれば、その完了を待って結果を使う
+		std::lock_guard<std::mutex> scanLock(m_scanMutex);
+		if (!m_scanned) ScanLocked();
+	}
+
+	void AssetRegistry::ScanLocked()
+	{
+		// 設定は Configure と競合しないようロック中に写してから、ロックの外で走査する
+		std::vector<std::string> directories;
+		std::vector<std::string> extensions;
+		uint32_t revision;
+		{
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
+			directories = m_directories;
+			extensions = m_extensions;
+			revision = m_configRevision;
+		}
+
+		std::unordered_map<std::string, std::string> entries;
+
+		// 同じキーは先に登録された方（優先度の高い方）を残す
+		auto Add = [&entries](const std::string& key, const std::string& path) {
+			entries.emplace(NormalizeKey(key), path);
+			};
+
+		// 1周目: 相対パス・フルパス（拡張子あり / 拡張子なし）
+		// 2周目: ファイル名のみ（深い階層のファイルは相対パスの方を優先させたいので後回し）
+		struct FoundFile { std::string relative; std::string path; size_t extPriority; };
+		std::vector<FoundFile> files;
+
+		for (const auto& dir : directories)
+		{
+			std::vector<FoundFile> dirFiles;
+			std::unordered_set<std::string> seen;
+
+			auto AddFound = [&](const std::string& relative) {
+				std::string ext = std::filesystem::path(relative).extension().string();
+				std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+				auto extIt = std::find(extensions.begin(), extensions.end(), ext);
+				if (extIt == extensions.end()) return;
+
+				FoundFile file;
+				file.relative = relative;
+				file.path = ToGenericPath(dir + file.relative);
+				file.extPriority = (size_t)std::distance(extensions.begin(), extIt);
+				if (seen.insert(NormalizeKey(file.path)).second) dirFiles.push_back(std::move(file));
+				};
+
+			// パックに入っているもの（ディスク上に同じファイルがあっても読まれるのはパック側）
+			// クック済みモデルだけが入っている場合は、元のソースのパスで登録する（Model::LoadCPU がクック済みを読む）
+			std::string prefix = ToGenericPath(dir);
+			if (!prefix.empty() && prefix.back() != '/') prefix += '/';
+			const std::string cookedExtension = CookedMesh::EXTENSION;
+			for (const auto& archived : VirtualFileSystem::Instance().ListArchived(dir))
+			{
+				std::string relative = archived.substr(prefix.size());
+				if (relative.size() > cookedExtension.size() &&
+					relative.compare(relative.size() - cookedExtension.size(), cookedExtension.size(), cookedExtension) == 0)
+				{
+					relative.resize(relative.size() - cookedExtension.size());
+				}
+				AddFound(relative);
+			}
+
+			// ディスク上のもの（パックだけで配布している場合はディレクトリ自体が無い）
+			std::error_code ec;
+			if (std::filesystem::exists(dir, ec))
+			{
+				for (auto it = std::filesystem::recursive_directory_iterator(dir, ec); !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+				{
+					if (!it->is_regular_file(ec)) continue;
+					AddFound(std::filesystem::relative(it->path(), dir, ec).generic_string());
+				}
+			}
+
+			// 拡張子なしのキーは拡張子の優先順で決まるよう並べる
+			std::stable_sort(dirFiles.begin(), dirFiles.end(), [](const FoundFile& a, const FoundFile& b) { return a.extPriority < b.extPriority; });
+
+			for (const auto& file : dirFiles)
+			{
+				std::filesystem::path rel(file.relative);
+				Add(file.path, file.path);
+				Add(file.relative, file.path);
+				Add((rel.parent_path() / rel.stem()).generic_string(), file.path);
+			}
+			files.insert(files.end(), dirFiles.begin(), dirFiles.end());
+		}
+
+		for (const auto& file : files)
+		{
+			std::filesystem::path rel(file.relative);
+			Add(rel.filename().generic_string(), file.path);
+			Add(rel.stem().generic_string(), file.path);
+		}
+
+		{
+			std::unique_lock<std::shared_mutex> lock(m_mutex);
+			if (revision != m_configRevision) return;	// 走査中に Configure された（次の Resolve で新しい設定で走査し直す）
+			m_entries.swap(entries);
+			m_misses.clear();
+			m_scanned = true;
+		}
+	}
+
+	std::string AssetRegistry::Resolve(const std::string& key)
+	{
+		if (key.empty()) return "";
+		EnsureScanned();
+
+		std::string normalized = NormalizeKey(key);
+		{
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
+			auto it = m_entries.find(normalized);
+			if (it != m_entries.end()) return it->second;
+
+			auto miss = m_misses.find(normalized);
+			if (miss != m_misses.end() && Clock::now() < miss->second) return "";
+		}
+
+		// 索引外（検索ディレクトリ以外のパス指定など）は実際に調べる
+		// 見つかったものは覚え、見つからなかったものは期限付きで覚える
+		bool exists = VirtualFileSystem::Instance().Exists(key);
+
+		std::unique_lock<std::shared_mutex> lock(m_mutex);
+		if (exists)
+		{
+			m_misses.erase(normalized);
+			m_entries.emplace(normalized, key);
+			return key;
+		}
+		m_misses[normalized] = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(MISS_RETRY_SECONDS));
+		return "";
+	}
+
+	void AssetRegistry::PollChanges()
+	{
+		bool changed = false;
+		for (HANDLE handle : m_watchHandles)
+		{
+			if (WaitForSingleObject(handle, 0) == WAIT_OBJECT_0)
+			{
+				changed = true;
+				FindNextChangeNotification(handle);
+			}
+		}
+
+		if (changed)
+		{
+			Scan();
+			Logger::Log("AssetRegistry rescanned (" + std::to_string(GetEntryCount()) + " keys)");
+		}
+	}
+
+	size_t AssetRegistry::GetEntryCount() const
+	{
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		return m_entries.size();
+	}
+
+	std::string AssetRegistry::NormalizeKey(const std::string& key)
+	{
+		std::string result = key;
+		for (char& c : result)
+		{
+			if (c == '\\') c = '/';
+			else if (c >= 'A' && c <= 'Z') c = (char)(c - 'A' + 'a');
+		}
+		return result;
+	}
+
+	void AssetRegistry::StartWatching()
+	{
+		if (!m_watchHandles.empty()) return;
+
+		std::vector<std::string> directories;
+		{
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
+			directories = m_directories;
+		}
+
+		for (const auto& dir : directories)
+		{
+			std::error_code ec;
+			if (!std::filesystem::exists(dir, ec)) continue;
+
+			// ファイルの追加・削除・リネームを監視（内容の更新は対象外）
+			HANDLE handle = FindFirstChangeNotificationW(std::filesystem::path(dir).wstring().c_str(), TRUE,
+				FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME);
+			if (handle != INVALID_HANDLE_VALUE) m_watchHandles.push_back(handle);
+		}
+	}
+
+	void AssetRegistry::StopWatching()
+	{
+		for (HANDLE handle : m_watchHandles) FindCloseChangeNotification(handle);
+		m_watchHandles.clear();
+	}
+
+}	// namespace Arche
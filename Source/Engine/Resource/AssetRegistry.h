@@ -0,0 +1,91 @@
+﻿/*****************************************************************//**
+ * @file	AssetRegistry.h
+ * @brief	アセットのキー → ファイルパスの索引
+ *
+ * @details	起動時に検索ディレクトリを1回だけ走査し、以下のキーを実パスに対応付ける。
+ *			- ディレクトリからの相対パス（拡張子あり / なし）
+ *			- ファイル名のみ（拡張子あり / なし）
+ *			- 検索ディレクトリ込みのパス
+ *			優先度は従来の ResolvePath と同じく「ディレクトリ順 → 拡張子順」。
+ *			キーは区切り文字と大文字小文字を揃えて比べる（Windows のファイルシステムと同じく "Player.PNG" と "player.png" は同じ）。
+ *			見つからなかったキーは MISS_RETRY_SECONDS の間だけ記録し、その間は同じキーでファイルシステムを調べない。
+ *			（索引外のパスは変更通知の対象外なので、期限を切らないと後から置かれたファイルが見つからない）
+ *			ディレクトリの変更は変更通知で検知し、次の PollChanges で索引を作り直す。
+ *			走査は m_scanMutex で1つずつ行う（Scan 前に Resolve が複数のスレッドから来ても走査は1回だけ）。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___ASSET_REGISTRY_H___
+#define ___ASSET_REGISTRY_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+#include <atomic>
+#include <chrono>
+
+namespace Arche
+{
+	class AssetRegistry
+	{
+	public:
+		// 見つからなかったキーを調べ直すまでの秒数
+		static constexpr double MISS_RETRY_SECONDS = 1.0;
+
+		AssetRegistry() = default;
+		~AssetRegistry();
+
+		AssetRegistry(const AssetRegistry&) = delete;
+		AssetRegistry& operator=(const AssetRegistry&) = delete;
+
+		// 検索ディレクトリと拡張子（どちらも優先度順）を設定
+		void Configure(const std::vector<std::string>& directories, const std::vector<std::string>& extensions);
+
+		// ディレクトリを走査して索引を作り直す（どのスレッドからでも可）
+		void Scan();
+
+		// キーを実パスに解決（見つからなければ空文字）。どのスレッドからでも可
+		std::string Resolve(const std::string& key);
+
+		// ディレクトリの変更通知を有効化 / 確認（どちらもメインスレッドから呼ぶ）
+		void StartWatching();
+		void PollChanges();
+
+		size_t GetEntryCount() const;
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		// 区切り文字を '/' に、英字を小文字に揃える
+		static std::string NormalizeKey(const std::string& key);
+
+		// 未走査なら走査する（すでに走査済みなら何もしない）
+		void EnsureScanned();
+
+		// m_scanMutex を持った状態で走査する
+		void ScanLocked();
+
+		void StopWatching();
+
+	private:
+		mutable std::shared_mutex m_mutex;
+		std::vector<std::string> m_directories;	// 以下 m_mutex で保護
+		std::vector<std::string> m_extensions;
+		uint32_t m_configRevision = 0;			// Configure のたびに増やす（走査中に設定が変わったら結果を捨てる）
+
+		std::unordered_map<std::string, std::string> m_entries;	// キー → 実パス
+		std::unordered_map<std::string, Clock::time_point> m_misses;	// 見つからなかったキー → 調べ直す時刻
+		std::atomic<bool> m_scanned{ false };
+		std::mutex m_scanMutex;		// 走査を1つずつにする
+
+		std::vector<HANDLE> m_watchHandles;
+	};
+
+}	// namespace Arche
+
+#endif // !___ASSET_REGISTRY_H___
@@ -0,0 +1,123 @@
+﻿/*****************************************************************//**
+ * @file	AssetRegistryBenchmark.cpp
+ * @brief	アセットのキー解決の計測（ファイルシステムの総当たりと索引の比較）
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Resource/AssetRegistryBenchmark.h"
+#include "Engine/Resource/AssetRegistry.h"
+
+namespace Arche
+{
+	namespace
+	{
+		// 1ディレクトリあたりのファイル数
+		constexpr uint32_t FILES_PER_DIRECTORY = 200;
+		// 存在しないキーの割合（1 / MISS_INTERVAL）
+		constexpr uint32_t MISS_INTERVAL = 10;
+
+		double Elapsed(std::chrono::high_resolution_clock::time_point from)
+		{
+			return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - from).count();
+		}
+
+		// 変更前の ResourceManager::ResolvePath
+		std::string ProbePath(const std::string& keyName, const std::vector<std::string>& directories, const std::vector<std::string>& extensions)
+		{
+			if (std::filesystem::exists(keyName)) return keyName;
+			for (const auto& dir : directories)
+			{
+				std::string tryPath = dir + keyName;
+				if (std::filesystem::exists(tryPath)) return tryPath;
+				for (const auto& ext : extensions)
+				{
+					std::string tryPathExt = tryPath + ext;
+					if (std::filesystem::exists(tryPathExt)) return tryPathExt;
+				}
+			}
+			return "";
+		}
+
+		std::string ToUpper(std::string text)
+		{
+			std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return (char)std::toupper(c); });
+			return text;
+		}
+	}
+
+	AssetRegistryBenchmarkResult AssetRegistryBenchmark::Run(uint32_t fileCount)
+	{
+		AssetRegistryBenchmarkResult result;
+		result.fileCount = fileCount;
+
+		std::error_code ec;
+		const std::filesystem::path root = std::filesystem::temp_directory_path(ec) / "ArcheAssetRegistryBenchmark";
+		std::filesystem::remove_all(root, ec);
+
+		// テクスチャと同じ構成（ディレクトリ2つ・拡張子6種）
+		const std::string rootPath = root.generic_string() + "/";
+		const std::vector<std::string> directories = { rootPath + "Game/Textures/", rootPath + "Engine/Textures/" };
+		const std::vector<std::string> extensions = { ".png", ".jpg", ".jpeg", ".tga", ".bmp", ".dds" };
+
+		std::vector<std::string> keys;
+		keys.reserve(fileCount + fileCount / MISS_INTERVAL);
+		for (uint32_t i = 0; i < fileCount; ++i)
+		{
+			const std::string& dir = directories[i % directories.size()];
+			std::string relative = "Set_" + std::to_string(i / FILES_PER_DIRECTORY) + "/Tex_" + std::to_string(i);
+
+			std::filesystem::create_directories(dir + "Set_" + std::to_string(i / FILES_PER_DIRECTORY), ec);
+			std::ofstream(dir + relative + extensions[i % extensions.size()], std::ios::binary);
+
+			keys.push_back(relative);
+			if (i % MISS_INTERVAL == 0) keys.push_back(relative + "_Missing");
+		}
+		result.keyCount = (uint32_t)keys.size();
+
+		auto start = std::chrono::high_resolution_clock::now();
+		std::vector<std::string> probed;
+		probed.reserve(keys.size());
+		for (const auto& key : keys) probed.push_back(ProbePath(key, directories, extensions));
+		result.probeSeconds = Elapsed(start);
+
+		AssetRegistry registry;
+		registry.Configure(directories, extensions);
+
+		start = std::chrono::high_resolution_clock::now();
+		registry.Scan();
+		result.scanSeconds = Elapsed(start);
+
+		bool matched = true;
+		start = std::chrono::high_resolution_clock::now();
+		for (size_t i = 0; i < keys.size(); ++i)
+		{
+			if (registry.Resolve(keys[i]) != probed[i]) matched = false;
+		}
+		result.firstResolveSeconds = Elapsed(start);
+
+		start = std::chrono::high_resolution_clock::now();
+		for (size_t i = 0; i < keys.size(); ++i)
+		{
+			if (registry.Resolve(keys[i]) != probed[i]) matched = false;
+		}
+		result.resolveSeconds = Elapsed(start);
+
+		// 大文字小文字の違うキーも同じファイルを指す
+		for (size_t i = 0; i < keys.size(); i += 97)
+		{
+			if (registry.Resolve(ToUpper(keys[i])) != probed[i]) matched = false;
+		}
+
+		result.succeeded = matched;
+		std::filesystem::remove_all(root, ec);
+		return result;
+	}
+
+}	// namespace Arche
@@ -0,0 +1,47 @@
+﻿/*****************************************************************//**
+ * @file	AssetRegistryBenchmark.h
+ * @brief	アセットのキー解決の計測（ファイルシステムの総当たりと索引の比較）
+ *
+ * @details	一時ディレクトリに大量の空ファイルを作り、拡張子なしの相対パスと存在しないキーを解決する時間を測る。
+ *			「変更前」は検索ディレクトリ × 拡張子の順に std::filesystem::exists を呼んでいた ResolvePath の再現。
+ *			両方の解決結果が一致することと、大文字小文字の違うキーが同じファイルに解決されることも確かめる。
+ *			デバイスを使わないので ArcheCook --bench-assets から呼べる。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___ASSET_REGISTRY_BENCHMARK_H___
+#define ___ASSET_REGISTRY_BENCHMARK_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+
+namespace Arche
+{
+	struct AssetRegistryBenchmarkResult
+	{
+		uint32_t fileCount = 0;
+		uint32_t keyCount = 0;			// 存在するキー + 存在しないキー
+		bool succeeded = false;			// 解決結果が総当たりと一致したか
+
+		double scanSeconds = 0.0;		// 索引の作成（起動時に1回）
+		double probeSeconds = 0.0;		// 総当たりで全キーを1回ずつ解決
+		double firstResolveSeconds = 0.0;	// 索引で全キーを1回ずつ解決（存在しないキーの確認を含む）
+		double resolveSeconds = 0.0;	// 2回目以降（毎フレームの GetXXX と同じ状況）
+
+		double GetProbeMicroseconds() const { return keyCount ? probeSeconds * 1e6 / keyCount : 0.0; }
+		double GetResolveMicroseconds() const { return keyCount ? resolveSeconds * 1e6 / keyCount : 0.0; }
+		double GetSpeedup() const { return resolveSeconds > 0.0 ? probeSeconds / resolveSeconds : 0.0; }
+	};
+
+	class ARCHE_API AssetRegistryBenchmark
+	{
+	public:
+		static AssetRegistryBenchmarkResult Run(uint32_t fileCount);
+	};
+
+}	// namespace Arche
+
+#endif // !___ASSET_REGISTRY_BENCHMARK_H___
@@ -0,0 +1,90 @@
+﻿/*****************************************************************//**
+ * @file	CookDatabase.cpp
+ * @brief	クックの記録（正規化済みパス → クックキー）の読み書き
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+// pch.h は含めない（Tests/ からもビルドする。vcxproj でもプリコンパイル済みヘッダーを使わない）
+#include "Engine/Resource/CookDatabase.h"
+#include <json.hpp>
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+namespace Arche
+{
+	namespace CookDatabase
+	{
+		CookDatabaseEntries Load(const std::string& path, uint32_t version)
+		{
+			CookDatabaseEntries entries;
+
+			std::ifstream fin(path);
+			if (!fin.is_open()) return entries;
+
+			nlohmann::json root = nlohmann::json::parse(fin, nullptr, false);
+			if (root.is_discarded() || !root.is_object() || root.value("Version", 0u) != version) return entries;
+
+			auto it = root.find("Entries");
+			if (it == root.end() || !it->is_object()) return entries;
+
+			for (const auto& [entryPath, key] : it->items())
+			{
+				if (key.is_number_unsigned()) entries[entryPath] = key.get<uint64_t>();
+			}
+			return entries;
+		}
+
+		bool Save(const std::string& path, uint32_t version, const CookDatabaseEntries& entries)
+		{
+			std::map<std::string, uint64_t> sorted(entries.begin(), entries.end());
+
+			nlohmann::json root;
+			root["Version"] = version;
+			root["Entries"] = sorted;
+
+			std::error_code ec;
+			std::filesystem::path parent = std::filesystem::path(path).parent_path();
+			if (!parent.empty()) std::filesystem::create_directories(parent, ec);
+
+			std::string text = root.dump(4);
+			return WriteFileAtomic(path, text.data(), text.size());
+		}
+
+		void Prune(CookDatabaseEntries& entries, const std::unordered_set<std::string>& existing)
+		{
+			for (auto it = entries.begin(); it != entries.end();)
+			{
+				it = existing.count(it->first) ? std::next(it) : entries.erase(it);
+			}
+		}
+
+		bool WriteFileAtomic(const std::string& path, const void* data, size_t size)
+		{
+			std::string tempPath = path + ".tmp";
+			{
+				std::ofstream ofs(tempPath, std::ios::binary | std::ios::trunc);
+				if (!ofs) return false;
+				ofs.write(static_cast<const char*>(data), (std::streamsize)size);
+				if (!ofs) return false;
+			}
+
+			std::error_code ec;
+			std::filesystem::rename(tempPath, path, ec);
+			if (ec)
+			{
+				std::filesystem::remove(tempPath, ec);
+				return false;
+			}
+			return true;
+		}
+
+	}	// namespace CookDatabase
+
+}	// namespace Arche
@@ -0,0 +1,46 @@
+﻿/*****************************************************************//**
+ * @file	CookDatabase.h
+ * @brief	クックの記録（正規化済みパス → クックキー）の読み書き
+ *
+ * @details	AssetCooker が Resources/Engine/Cache/CookDatabase.json に保存する。
+ *			バージョンが違う・読めない記録は空として扱う（全件がクックし直しになる）。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___COOK_DATABASE_H___
+#define ___COOK_DATABASE_H___
+
+// ===== インクルード =====
+// 標準ライブラリだけで書く（pch.h を含めず、Tests/ からも使えるように）
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Arche
+{
+	using CookDatabaseEntries = std::unordered_map<std::string, uint64_t>;
+
+	namespace CookDatabase
+	{
+		// 記録を読む（無い・壊れている・version が違うときは空）
+		CookDatabaseEntries Load(const std::string& path, uint32_t version);
+
+		// 記録を書く（差分が見やすいようパス順。ディレクトリが無ければ作る）
+		bool Save(const std::string& path, uint32_t version, const CookDatabaseEntries& entries);
+
+		// 今あるソースに含まれない記録を捨てる
+		void Prune(CookDatabaseEntries& entries, const std::unordered_set<std::string>& existing);
+
+		// 途中で落ちても壊れたファイルを残さないよう、一時ファイルに書いてから置き換える
+		bool WriteFileAtomic(const std::string& path, const void* data, size_t size);
+
+	}	// namespace CookDatabase
+
+}	// namespace Arche
+
+#endif // !___COOK_DATABASE_H___
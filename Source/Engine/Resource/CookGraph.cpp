@@ -0,0 +1,69 @@
+﻿/*****************************************************************//**
+ * @file	CookGraph.cpp
+ * @brief	クック対象の依存関係とクックキー
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+// pch.h は含めない（Tests/ からもビルドする。vcxproj でもプリコンパイル済みヘッダーを使わない）
+#include "Engine/Resource/CookGraph.h"
+#include "Engine/Core/Base/Hash.h"
+#include <algorithm>
+#include <unordered_map>
+
+namespace Arche
+{
+	namespace CookGraph
+	{
+		void SortDependencies(CookNode& node)
+		{
+			auto& deps = node.dependencies;
+			std::sort(deps.begin(), deps.end());
+			deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+		}
+
+		void ComputeKeys(CookNode* const* nodes, size_t count, uint32_t version, const HashFileFunc& hashFile)
+		{
+			std::unordered_map<std::string, uint64_t> hashes;
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (nodes[i]->hashed) hashes[nodes[i]->path] = nodes[i]->contentHash;
+			}
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				CookNode& node = *nodes[i];
+				if (!node.hashed) continue;
+
+				uint64_t key = Hash::Fnv1a64(&version, sizeof(version));
+				key = Hash::Fnv1a64(&node.contentHash, sizeof(node.contentHash), key);
+				if (node.salt != 0) key = Hash::Fnv1a64(&node.salt, sizeof(node.salt), key);
+
+				for (const auto& dependency : node.dependencies)
+				{
+					// クック対象外の依存先（コントローラーなど）はここで直接ハッシュを取る
+					auto it = hashes.find(dependency);
+					if (it == hashes.end()) it = hashes.emplace(dependency, hashFile ? hashFile(dependency) : 0).first;
+
+					key = Hash::Fnv1a64(dependency, key);
+					key = Hash::Fnv1a64(&it->second, sizeof(it->second), key);
+				}
+				node.cookKey = key;
+			}
+		}
+
+		bool IsUpToDate(const CookDatabaseEntries& entries, const CookNode& node)
+		{
+			if (!node.hashed) return false;
+			auto it = entries.find(node.path);
+			return it != entries.end() && it->second == node.cookKey;
+		}
+
+	}	// namespace CookGraph
+
+}	// namespace Arche
@@ -0,0 +1,58 @@
+﻿/*****************************************************************//**
+ * @file	CookGraph.h
+ * @brief	クック対象の依存関係とクックキー
+ *
+ * @details	キー = クッカーのバージョン + 内容ハッシュ + 種類ごとの値（シーンはスキーマのハッシュ）
+ *			      + 依存先ごとの（パス, 内容ハッシュ）
+ *			依存先がクック対象に含まれていればその内容ハッシュを使い、含まれていなければ（コントローラーなど）
+ *			呼び出し元から渡された関数でハッシュを取る。記録と同じキーのものはクックしなくてよい。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___COOK_GRAPH_H___
+#define ___COOK_GRAPH_H___
+
+// ===== インクルード =====
+// 標準ライブラリだけで書く（pch.h を含めず、Tests/ からも使えるように）
+#include "Engine/Resource/CookDatabase.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Arche
+{
+	// クック対象1つ（AssetCooker の Item はこれを継承する）
+	struct CookNode
+	{
+		std::string path;						// 正規化済みパス（記録のキー）
+		uint64_t contentHash = 0;
+		uint64_t salt = 0;						// 種類ごとにキーへ混ぜる値（0 なら混ぜない）
+		std::vector<std::string> dependencies;	// 正規化済みパス（整列・重複なし）
+		uint64_t cookKey = 0;
+		bool hashed = false;					// 内容ハッシュと依存先が揃っているか（false のものはキーを作らない）
+	};
+
+	namespace CookGraph
+	{
+		// クック対象外の依存先の内容ハッシュ（読めなければ 0）
+		using HashFileFunc = std::function<uint64_t(const std::string&)>;
+
+		// 依存先を整列して重複を除く
+		void SortDependencies(CookNode& node);
+
+		// hashed のものすべてに cookKey を付ける（依存先のハッシュは1つにつき1回だけ取る）
+		void ComputeKeys(CookNode* const* nodes, size_t count, uint32_t version, const HashFileFunc& hashFile);
+
+		// 記録のキーと一致するか（出力ファイルがあるかどうかは呼び出し元で確かめる）
+		bool IsUpToDate(const CookDatabaseEntries& entries, const CookNode& node);
+
+	}	// namespace CookGraph
+
+}	// namespace Arche
+
+#endif // !___COOK_GRAPH_H___
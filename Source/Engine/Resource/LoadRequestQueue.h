@@ -0,0 +1,72 @@
+﻿/*****************************************************************//**
+ * @file	LoadRequestQueue.h
+ * @brief	メインスレッド以外から積まれたロード要求のキュー
+ *
+ * @details	BindOwnerThread を呼んだスレッドだけが「持ち主」になり、要求をその場で処理してよい。
+ *			それ以外のスレッドは Push で積むだけにし、持ち主が Drain でまとめて受け取る。
+ *			Bind 前はどのスレッドも持ち主ではない（std::thread::id() はどの実スレッドの id とも一致しない）ので、
+ *			初期化前に呼ばれた要求も積まれるだけになる。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___LOAD_REQUEST_QUEUE_H___
+#define ___LOAD_REQUEST_QUEUE_H___
+
+// ===== インクルード =====
+// 標準ライブラリだけで書く（pch.h を含めず、Tests/ からも使えるように）
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Arche
+{
+	template<typename Request>
+	class LoadRequestQueue
+	{
+	public:
+		void BindOwnerThread() { m_owner.store(std::this_thread::get_id()); }
+		bool IsOwnerThread() const { return std::this_thread::get_id() == m_owner.load(); }
+
+		void Push(Request request)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_requests.push_back(std::move(request));
+			m_hasPending = true;
+		}
+
+		// 積まれていた要求をすべて out へ移す（無ければ false。ロックも取らない）
+		bool Drain(std::vector<Request>& out)
+		{
+			if (!m_hasPending.load()) return false;
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			out.swap(m_requests);
+			m_requests.clear();
+			m_hasPending = false;
+			return !out.empty();
+		}
+
+		bool HasPending() const { return m_hasPending.load(); }
+
+		void Clear()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_requests.clear();
+			m_hasPending = false;
+		}
+
+	private:
+		std::atomic<std::thread::id> m_owner{};
+		std::mutex m_mutex;
+		std::vector<Request> m_requests;
+		std::atomic<bool> m_hasPending{ false };
+	};
+
+}	// namespace Arche
+
+#endif // !___LOAD_REQUEST_QUEUE_H___
@@ -0,0 +1,82 @@
+﻿/*****************************************************************//**
+ * @file	MappedFile.cpp
+ * @brief	読み取り専用のメモリマップドファイル
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Resource/MappedFile.h"
+
+namespace Arche
+{
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Close();
+			m_file = other.m_file;
+			m_mapping = other.m_mapping;
+			m_data = other.m_data;
+			m_size = other.m_size;
+
+			other.m_file = INVALID_HANDLE_VALUE;
+			other.m_mapping = nullptr;
+			other.m_data = nullptr;
+			other.m_size = 0;
+		}
+		return *this;
+	}
+
+	bool MappedFile::Open(const std::string& path)
+	{
+		Close();
+
+		// マップ中でも削除は妨げない（読み込み途中の一時ファイルを消す場合など）
+		m_file = CreateFileW(std::filesystem::path(path).wstring().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (m_file == INVALID_HANDLE_VALUE) return false;
+
+		LARGE_INTEGER size = {};
+		if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+		{
+			Close();
+			return false;
+		}
+
+		m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!m_mapping)
+		{
+			Close();
+			return false;
+		}
+
+		m_data = static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+		if (!m_data)
+		{
+			Close();
+			return false;
+		}
+
+		m_size = (size_t)size.QuadPart;
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_data) UnmapViewOfFile(m_data);
+		if (m_mapping) CloseHandle(m_mapping);
+		if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+
+		m_data = nullptr;
+		m_mapping = nullptr;
+		m_file = INVALID_HANDLE_VALUE;
+		m_size = 0;
+	}
+
+}	// namespace Arche
@@ -0,0 +1,56 @@
+﻿/*****************************************************************//**
+ * @file	MappedFile.h
+ * @brief	読み取り専用のメモリマップドファイル
+ *
+ * @details	ファイル全体を仮想メモリに割り当て、ReadFile を経由せずに参照する。
+ *			実際の読み込みはページ単位で必要になった時点でOSが行う。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___MAPPED_FILE_H___
+#define ___MAPPED_FILE_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+
+namespace Arche
+{
+	class ARCHE_API MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile() { Close(); }
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		bool Open(const std::string& path);
+		void Close();
+
+		bool IsOpen() const { return m_data != nullptr; }
+		const uint8_t* GetData() const { return m_data; }
+		size_t GetSize() const { return m_size; }
+
+		// 範囲チェック付きで offset 位置を T として参照（範囲外なら nullptr）
+		template<typename T>
+		const T* At(uint64_t offset, uint64_t count = 1) const
+		{
+			if (!m_data || offset > m_size || count > (m_size - offset) / sizeof(T)) return nullptr;
+			return reinterpret_cast<const T*>(m_data + offset);
+		}
+
+	private:
+		HANDLE m_file = INVALID_HANDLE_VALUE;
+		HANDLE m_mapping = nullptr;
+		const uint8_t* m_data = nullptr;
+		size_t m_size = 0;
+	};
+
+}	// namespace Arche
+
+#endif // !___MAPPED_FILE_H___
@@ -0,0 +1,289 @@
+﻿/*****************************************************************//**
+ * @file	ResourceCache.h
+ * @brief	スレッドセーフなリソースキャッシュ（シャード分割）
+ *
+ * @details	キーのハッシュで複数のシャードに振り分け、シャードごとに
+ *			読み書きロック（shared_mutex）を持つ。
+ *			読み込み済みリソースの取得は「1回のハッシュ計算 + 1シャードの共有ロック」で済み、
+ *			別スレッドの登録処理とぶつかるのは同じシャードに入ったときだけになる。
+ *			エントリごとに ResourceSlot（参照カウント・最終使用フレーム・メモリ量）を持ち、
+ *			EvictLru で予算に収まるまで未参照のものを古い順に捨てられる。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___RESOURCE_CACHE_H___
+#define ___RESOURCE_CACHE_H___
+
+// ===== インクルード =====
+// 標準ライブラリだけで書く（pch.h を含めず、Tests/ からも使えるように）
+#include "Engine/Resource/ResourceHandle.h"
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Arche
+{
+	// カテゴリ全体の使用量
+	struct ResourceUsage
+	{
+		size_t count = 0;
+		size_t referenced = 0;		// ハンドルか外部の shared_ptr から参照されている数
+		ResourceMemory memory;
+	};
+
+	// エディタ表示用のエントリ情報
+	struct ResourceEntryInfo
+	{
+		std::string key;
+		ResourceMemory memory;
+		uint32_t handleCount = 0;	// ハンドル経由の参照数
+		long sharedCount = 0;		// キャッシュ以外が持っている shared_ptr の数
+		uint64_t lastUseFrame = 0;
+	};
+
+	template<typename T>
+	class ResourceCache
+	{
+	public:
+		using Map = std::unordered_map<std::string, std::shared_ptr<T>>;
+
+		// 見つかれば true（値が nullptr の「失敗をキャッシュした」エントリも true）
+		bool TryGet(const std::string& key, std::shared_ptr<T>& out) const
+		{
+			const Shard& shard = GetShard(key);
+			std::shared_lock<std::shared_mutex> lock(shard.mutex);
+			auto it = shard.map.find(key);
+			if (it == shard.map.end()) return false;
+			Touch(it->second);
+			out = it->second.value;
+			return true;
+		}
+
+		std::shared_ptr<T> Find(const std::string& key) const
+		{
+			std::shared_ptr<T> out;
+			TryGet(key, out);
+			return out;
+		}
+
+		// 参照カウント付きで取得（無ければ空のハンドル）
+		ResourceHandle<T> Acquire(const std::string& key) const
+		{
+			const Shard& shard = GetShard(key);
+			std::shared_lock<std::shared_mutex> lock(shard.mutex);
+			auto it = shard.map.find(key);
+			if (it == shard.map.end() || !it->second.value) return nullptr;
+			Touch(it->second);
+			return ResourceHandle<T>(it->second.value, it->second.slot);
+		}
+
+		bool Contains(const std::string& key) const
+		{
+			const Shard& shard = GetShard(key);
+			std::shared_lock<std::shared_mutex> lock(shard.mutex);
+			return shard.map.count(key) != 0;
+		}
+
+		// 既にあればそれを返す（複数スレッドが同時にロードしても登録されるのは最初の1つ）
+		std::shared_ptr<T> Insert(const std::string& key, std::shared_ptr<T> value, const ResourceMemory& memory = {})
+		{
+			Shard& shard = GetShard(key);
+			std::unique_lock<std::shared_mutex> lock(shard.mutex);
+			auto result = shard.map.try_emplace(key);
+			Entry& entry = result.first->second;
+			if (result.second)
+			{
+				entry.value = std::move(value);
+				entry.slot = std::make_shared<ResourceSlot>();
+				entry.slot->memory = memory;
+			}
+			Touch(entry);
+			return entry.value;
+		}
+
+		// 上書き登録（リロード用。既存のハンドルの参照カウントは引き継ぐ）
+		void Assign(const std::string& key, std::shared_ptr<T> value, const ResourceMemory& memory = {})
+		{
+			Shard& shard = GetShard(key);
+			std::unique_lock<std::shared_mutex> lock(shard.mutex);
+			Entry& entry = shard.map[key];
+			entry.value = std::move(value);
+			if (!entry.slot) entry.slot = std::make_shared<ResourceSlot>();
+			entry.slot->memory = memory;
+			Touch(entry);
+		}
+
+		void Erase(const std::string& key)
+		{
+			Shard& shard = GetShard(key);
+			std::unique_lock<std::shared_mutex> lock(shard.mutex);
+			shard.map.erase(key);
+		}
+
+		void Clear()
+		{
+			for (auto& shard : m_shards)
+			{
+				std::unique_lock<std::shared_mutex> lock(shard.mutex);
+				shard.map.clear();
+			}
+		}
+
+		// エディタ表示用のコピー
+		Map Snapshot() const
+		{
+			Map result;
+			for (const auto& shard : m_shards)
+			{
+				std::shared_lock<std::shared_mutex> lock(shard.mutex);
+				for (const auto& [key, entry] : shard.map) result.emplace(key, entry.value);
+			}
+			return result;
+		}
+
+		// LRU 用の現在フレーム（メインスレッドが毎フレーム進める）
+		void SetFrame(uint64_t frame) { m_frame.store(frame, std::memory_order_relaxed); }
+
+		ResourceUsage GetUsage() const
+		{
+			ResourceUsage usage;
+			for (const auto& shard : m_shards)
+			{
+				std::shared_lock<std::shared_mutex> lock(shard.mutex);
+				for (const auto& [key, entry] : shard.map)
+				{
+					usage.count++;
+					if (IsReferenced(entry)) usage.referenced++;
+					usage.memory.cpuBytes += entry.slot->memory.cpuBytes;
+					usage.memory.gpuBytes += entry.slot->memory.gpuBytes;
+				}
+			}
+			return usage;
+		}
+
+		std::vector<ResourceEntryInfo> GetEntryInfos() const
+		{
+			std::vector<ResourceEntryInfo> infos;
+			for (const auto& shard : m_shards)
+			{
+				std::shared_lock<std::shared_mutex> lock(shard.mutex);
+				for (const auto& [key, entry] : shard.map)
+				{
+					ResourceEntryInfo info;
+					info.key = key;
+					info.memory = entry.slot->memory;
+					info.handleCount = entry.slot->refCount.load(std::memory_order_relaxed);
+					info.sharedCount = entry.value ? entry.value.use_count() - 1 : 0;
+					info.lastUseFrame = entry.slot->lastUseFrame.load(std::memory_order_relaxed);
+					infos.push_back(std::move(info));
+				}
+			}
+			return infos;
+		}
+
+		/**
+		 * @brief	合計が budgetBytes 以下になるまで、未参照のエントリを使われた順の古いものから捨てる
+		 * @param	isPinned	true を返したキーは残す
+		 * @details	直近2フレーム以内に使われたもの（毎フレーム GetXXX で引かれているもの）も残す。
+		 *			予算に収まらなくても、捨てられるものが無くなった時点で終わる。
+		 * @return	捨てたエントリの数とメモリ量
+		 */
+		template<typename Pred>
+		std::pair<size_t, ResourceMemory> EvictLru(uint64_t budgetBytes, Pred isPinned)
+		{
+			std::pair<size_t, ResourceMemory> evicted = { 0, {} };
+
+			uint64_t total = GetUsage().memory.GetTotal();
+			if (total <= budgetBytes) return evicted;
+
+			const uint64_t frame = m_frame.load(std::memory_order_relaxed);
+
+			struct Candidate { std::string key; uint64_t lastUse; };
+			std::vector<Candidate> candidates;
+			for (const auto& shard : m_shards)
+			{
+				std::shared_lock<std::shared_mutex> lock(shard.mutex);
+				for (const auto& [key, entry] : shard.map)
+				{
+					if (!IsEvictable(entry, frame) || isPinned(key)) continue;
+					candidates.push_back({ key, entry.slot->lastUseFrame.load(std::memory_order_relaxed) });
+				}
+			}
+			std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) { return a.lastUse < b.lastUse; });
+
+			// 破棄（GPUリソースの解放を含む）はロックの外で行う
+			std::vector<std::shared_ptr<T>> released;
+			for (const auto& candidate : candidates)
+			{
+				if (total <= budgetBytes) break;
+
+				Shard& shard = GetShard(candidate.key);
+				std::unique_lock<std::shared_mutex> lock(shard.mutex);
+				auto it = shard.map.find(candidate.key);
+				// 候補を集めてからここまでの間に参照されたものは残す
+				if (it == shard.map.end() || !IsEvictable(it->second, frame)) continue;
+
+				const ResourceMemory& memory = it->second.slot->memory;
+				total -= std::min(total, memory.GetTotal());
+				evicted.first++;
+				evicted.second.cpuBytes += memory.cpuBytes;
+				evicted.second.gpuBytes += memory.gpuBytes;
+
+				released.push_back(std::move(it->second.value));
+				shard.map.erase(it);
+			}
+			return evicted;
+		}
+
+	private:
+		static constexpr size_t SHARD_COUNT = 16;
+
+		struct Entry
+		{
+			std::shared_ptr<T> value;
+			std::shared_ptr<ResourceSlot> slot;
+		};
+
+		struct Shard
+		{
+			mutable std::shared_mutex mutex;
+			std::unordered_map<std::string, Entry> map;
+		};
+
+		Shard& GetShard(const std::string& key) { return m_shards[std::hash<std::string>{}(key) % SHARD_COUNT]; }
+		const Shard& GetShard(const std::string& key) const { return m_shards[std::hash<std::string>{}(key) % SHARD_COUNT]; }
+
+		void Touch(const Entry& entry) const
+		{
+			entry.slot->lastUseFrame.store(m_frame.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+
+		static bool IsReferenced(const Entry& entry)
+		{
+			// ハンドルの他、コンポーネント等が直接持っている shared_ptr も参照として扱う
+			return entry.slot->refCount.load(std::memory_order_relaxed) > 0 || (entry.value && entry.value.use_count() > 1);
+		}
+
+		static bool IsEvictable(const Entry& entry, uint64_t frame)
+		{
+			if (!entry.value || IsReferenced(entry)) return false;
+			return entry.slot->lastUseFrame.load(std::memory_order_relaxed) + 2 <= frame;
+		}
+
+	private:
+		std::array<Shard, SHARD_COUNT> m_shards;
+		std::atomic<uint64_t> m_frame{ 0 };
+	};
+
+}	// namespace Arche
+
+#endif // !___RESOURCE_CACHE_H___
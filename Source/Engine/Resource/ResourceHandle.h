@@ -0,0 +1,144 @@
+﻿/*****************************************************************//**
+ * @file	ResourceHandle.h
+ * @brief	参照カウント付きのリソースハンドルとメモリ使用量
+ *
+ * @details	ResourceCache の各エントリは ResourceSlot を1つ持ち、
+ *			ハンドルが生きている間だけ refCount が増える。
+ *			refCount が0でピン留めもされていないエントリだけが、予算超過時に
+ *			最後に使われたフレームの古い順（LRU）で追い出される。
+ *			ハンドルはリソース本体も保持するので、追い出された後も手元の参照は有効なまま。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___RESOURCE_HANDLE_H___
+#define ___RESOURCE_HANDLE_H___
+
+// ===== インクルード =====
+// 標準ライブラリだけで書く（pch.h を含めず、Tests/ からも使えるように）
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Arche
+{
+	// 予算・統計の単位
+	enum class ResourceCategory
+	{
+		Texture,
+		Model,
+		Sound,
+		Count
+	};
+
+	inline const char* GetResourceCategoryName(ResourceCategory category)
+	{
+		switch (category)
+		{
+		case ResourceCategory::Texture:	return "Texture";
+		case ResourceCategory::Model:	return "Model";
+		case ResourceCategory::Sound:	return "Sound";
+		default:						return "Unknown";
+		}
+	}
+
+	// リソース1つが使っているメモリ（見積もり）
+	struct ResourceMemory
+	{
+		uint64_t cpuBytes = 0;
+		uint64_t gpuBytes = 0;
+
+		uint64_t GetTotal() const { return cpuBytes + gpuBytes; }
+	};
+
+	// キャッシュのエントリごとの管理情報（ハンドルと共有する）
+	struct ResourceSlot
+	{
+		std::atomic<uint32_t> refCount{ 0 };
+		std::atomic<uint64_t> lastUseFrame{ 0 };
+		ResourceMemory memory;	// 登録時に確定（以後変わらない）
+	};
+
+	template<typename T>
+	class ResourceHandle
+	{
+	public:
+		ResourceHandle() = default;
+		ResourceHandle(std::nullptr_t) {}
+
+		ResourceHandle(std::shared_ptr<T> resource, std::shared_ptr<ResourceSlot> slot)
+			: m_resource(std::move(resource)), m_slot(std::move(slot))
+		{
+			if (m_slot) m_slot->refCount.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		ResourceHandle(const ResourceHandle& other)
+			: m_resource(other.m_resource), m_slot(other.m_slot)
+		{
+			if (m_slot) m_slot->refCount.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		ResourceHandle(ResourceHandle&& other) noexcept
+			: m_resource(std::move(other.m_resource)), m_slot(std::move(other.m_slot))
+		{
+		}
+
+		ResourceHandle& operator=(const ResourceHandle& other)
+		{
+			if (this != &other)
+			{
+				ResourceHandle copy(other);
+				Swap(copy);
+			}
+			return *this;
+		}
+
+		ResourceHandle& operator=(ResourceHandle&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Reset();
+				Swap(other);
+			}
+			return *this;
+		}
+
+		ResourceHandle& operator=(std::nullptr_t) { Reset(); return *this; }
+
+		~ResourceHandle() { Reset(); }
+
+		void Reset()
+		{
+			if (m_slot) m_slot->refCount.fetch_sub(1, std::memory_order_relaxed);
+			m_slot.reset();
+			m_resource.reset();
+		}
+
+		T* get() const { return m_resource.get(); }
+		T* operator->() const { return m_resource.get(); }
+		T& operator*() const { return *m_resource; }
+		explicit operator bool() const { return m_resource != nullptr; }
+
+		// shared_ptr を受け取る既存APIに渡す用
+		const std::shared_ptr<T>& GetShared() const { return m_resource; }
+
+		uint32_t GetRefCount() const { return m_slot ? m_slot->refCount.load(std::memory_order_relaxed) : 0; }
+
+	private:
+		void Swap(ResourceHandle& other) noexcept
+		{
+			m_resource.swap(other.m_resource);
+			m_slot.swap(other.m_slot);
+		}
+
+	private:
+		std::shared_ptr<T> m_resource;
+		std::shared_ptr<ResourceSlot> m_slot;
+	};
+
+}	// namespace Arche
+
+#endif // !___RESOURCE_HANDLE_H___
@@ -21,58 +21,88 @@
 #include "Engine/pch.h"
 #include "Engine/Resource/ResourceManager.h"
 #include "Engine/Core/Base/Logger.h"
+#include "Engine/Resource/VirtualFileSystem.h"
 #include "Engine/Renderer/RHI/Texture.h"
 #include "Engine/Renderer/Data/Model.h"
 #include "Engine/Audio/Sound.h"
+#include "Engine/Scene/Serializer/AnimatorControllerSerializer.h"
 
 namespace Arche
 {
+	namespace
+	{
+		template<typename T>
+		ResourceMemory MeasureMemory(const std::shared_ptr<T>& resource)
+		{
+			return resource ? resource->GetMemoryUsage() : ResourceMemory{};
+		}
+
+		std::string FormatMegabytes(uint64_t bytes)
+		{
+			char buf[32];
+			snprintf(buf, sizeof(buf), "%.2f MB", (double)bytes / (1024.0 * 1024.0));
+			return buf;
+		}
+	}
+
 	void ResourceManager::Initialize(ID3D11Device* device)
 	{
 		m_device = device;
+		m_requests.BindOwnerThread();
+		InitializeRegistries();
 		CreateSystemTextures();
 	}
 
 	void ResourceManager::Clear()
 	{
-		m_textures.clear();
-		m_models.clear();
-		m_sounds.clear();
-		m_tasks.clear(); // タスクもクリア
+		m_textures.Clear();
+		m_models.Clear();
+		m_sounds.Clear();
+		m_controllers.Clear();
+
+		// 未着手のジョブを捨て、実行中のジョブを待ってからタスクをクリア
+		m_loader.Shutdown();
+		m_tasks.clear();
+		m_totalTasks = 0;
+		m_completedTasks = 0;
+		m_totalBytes = 0;
+		m_completedBytes = 0;
+		m_evictedCounts = {};
+		m_evictedMemory = {};
+		m_requests.Clear();
 	}
 
 	// --------------------------------------------------------
 	// 非同期ロードリクエスト
 	// --------------------------------------------------------
-	void ResourceManager::LoadModelAsync(const std::string& path)
+	void ResourceManager::LoadModelAsync(const std::string& path, LoadPriority priority)
 	{
-		std::string key = ResolvePath(path, m_modelDirs, m_modelExts);
-		if (key.empty() || m_models.count(key)) return; // 既存
+		if (!IsMainThread()) { QueueRequest(AsyncTask::TaskType::ModelType, path, priority); return; }
+
+		std::string key = m_modelRegistry.Resolve(path);
+		if (key.empty() || m_models.Contains(key)) return; // 既存
 
 		// 重複チェック (ポインタ経由でアクセス)
 		for (const auto& t : m_tasks) if (t->key == key && t->type == AsyncTask::TaskType::ModelType) return;
 
-		// ポインタとして作成
 		auto t = std::make_unique<AsyncTask>();
 		t->type = AsyncTask::TaskType::ModelType;
 		t->key = key;
 		t->modelData = std::make_shared<Model>();
 
-		// 別スレッドでロード開始
+		// ワーカーでCPU側のロード
 		std::shared_ptr<Model> ptr = t->modelData;
-		t->task = std::async(std::launch::async, [ptr, key]() -> bool {
+		EnqueueTask(std::move(t), [ptr, key]() -> bool {
 			return ptr->LoadCPU(key);
-			});
-
-		// ポインタをリストに移動
-		m_tasks.push_back(std::move(t));
-		m_totalTasks++;
+			}, priority);
 	}
 
-	void ResourceManager::LoadTextureAsync(const std::string& path)
+	void ResourceManager::LoadTextureAsync(const std::string& path, LoadPriority priority)
 	{
-		std::string key = ResolvePath(path, m_textureDirs, m_imgExts);
-		if (key.empty() || m_textures.count(key)) return;
+		if (!IsMainThread()) { QueueRequest(AsyncTask::TaskType::TextureType, path, priority); return; }
+
+		std::string key = m_textureRegistry.Resolve(path);
+		if (key.empty() || m_textures.Contains(key)) return;
 
 		for (const auto& t : m_tasks) if (t->key == key && t->type == AsyncTask::TaskType::TextureType) return;
 
@@ -82,18 +112,17 @@ namespace Arche
 		t->textureData = std::make_shared<Texture>();
 
 		std::shared_ptr<Texture> ptr = t->textureData;
-		t->task = std::async(std::launch::async, [ptr, key]() -> bool {
+		EnqueueTask(std::move(t), [ptr, key]() -> bool {
 			return ptr->LoadCPU(key);
-			});
-
-		m_tasks.push_back(std::move(t));
-		m_totalTasks++;
+			}, priority);
 	}
 
-	void ResourceManager::LoadSoundAsync(const std::string& path)
+	void ResourceManager::LoadSoundAsync(const std::string& path, LoadPriority priority)
 	{
-		std::string key = ResolvePath(path, m_soundDirs, m_soundExts);
-		if (key.empty() || m_sounds.count(key)) return;
+		if (!IsMainThread()) { QueueRequest(AsyncTask::TaskType::SoundType, path, priority); return; }
+
+		std::string key = m_soundRegistry.Resolve(path);
+		if (key.empty() || m_sounds.Contains(key)) return;
 
 		for (const auto& t : m_tasks) if (t->key == key && t->type == AsyncTask::TaskType::SoundType) return;
 
@@ -103,72 +132,185 @@ namespace Arche
 		t->soundData = std::make_shared<Sound>();
 
 		std::shared_ptr<Sound> ptr = t->soundData;
-		t->task = std::async(std::launch::async, [ptr, key]() -> bool {
+		EnqueueTask(std::move(t), [ptr, key]() -> bool {
 			return ptr->LoadCPU(key);
-			});
+			}, priority);
+	}
+
+	void ResourceManager::LoadAnimatorControllerAsync(const std::string& path, LoadPriority priority)
+	{
+		if (!IsMainThread()) { QueueRequest(AsyncTask::TaskType::ControllerType, path, priority); return; }
 
-		m_tasks.push_back(std::move(t));
+		std::string key = MakeControllerKey(path);
+		if (key.empty() || m_controllers.Contains(key) || !VirtualFileSystem::Instance().Exists(key)) return;
+
+		for (const auto& t : m_tasks) if (t->key == key && t->type == AsyncTask::TaskType::ControllerType) return;
+
+		auto t = std::make_unique<AsyncTask>();
+		t->type = AsyncTask::TaskType::ControllerType;
+		t->key = key;
+		t->controllerData = std::make_shared<AnimatorController>();
+
+		// JSON解析とコンパイルまでワーカーで行う
+		std::shared_ptr<AnimatorController> ptr = t->controllerData;
+		EnqueueTask(std::move(t), [ptr, key]() -> bool {
+			auto loaded = AnimatorControllerSerializer::Deserialize(key);
+			if (!loaded) return false;
+			*ptr = std::move(*loaded);
+			return true;
+			}, priority);
+	}
+
+	void ResourceManager::EnqueueTask(std::unique_ptr<AsyncTask> task, std::function<bool()> job, LoadPriority priority)
+	{
+		// 進捗はファイルサイズで重み付けする（取得できなければ1バイト扱い）
+		uint64_t size = VirtualFileSystem::Instance().GetFileSize(task->key);
+		task->bytes = size == 0 ? 1 : size;
+
+		task->task = m_loader.Submit(std::move(job), priority);
+
+		m_totalBytes += task->bytes;
 		m_totalTasks++;
+		m_tasks.push_back(std::move(task));
 	}
 
 	// --------------------------------------------------------
 	// 更新処理（メインスレッド）
 	// --------------------------------------------------------
+	bool ResourceManager::IsMainThread() const
+	{
+		// Initialize 前はどのスレッドもメインではない（要求は積まれ、Initialize 後の Update で処理される）
+		return m_requests.IsOwnerThread();
+	}
+
+	void ResourceManager::QueueRequest(AsyncTask::TaskType type, const std::string& path, LoadPriority priority)
+	{
+		m_requests.Push({ type, path, priority });
+	}
+
+	void ResourceManager::ProcessPendingRequests()
+	{
+		std::vector<LoadRequest> requests;
+		if (!m_requests.Drain(requests)) return;
+
+		for (const auto& req : requests)
+		{
+			switch (req.type)
+			{
+			case AsyncTask::TaskType::ModelType:		LoadModelAsync(req.path, req.priority); break;
+			case AsyncTask::TaskType::TextureType:		LoadTextureAsync(req.path, req.priority); break;
+			case AsyncTask::TaskType::SoundType:		LoadSoundAsync(req.path, req.priority); break;
+			case AsyncTask::TaskType::ControllerType:	LoadAnimatorControllerAsync(req.path, req.priority); break;
+			}
+		}
+	}
+
 	void ResourceManager::Update()
 	{
+		// ファイルの追加・削除を索引に反映
+		m_textureRegistry.PollChanges();
+		m_modelRegistry.PollChanges();
+		m_soundRegistry.PollChanges();
+
+		// LRU 用のフレームを進め、予算超過分を追い出す
+		m_frame++;
+		m_textures.SetFrame(m_frame);
+		m_models.SetFrame(m_frame);
+		m_sounds.SetFrame(m_frame);
+		EnforceBudgets();
+
+		// ワーカー（モデル読み込み中のマテリアル等）から積まれた要求を受け付ける
+		ProcessPendingRequests();
+
 		if (m_tasks.empty()) return;
 
-		// 先頭のタスクを取得 (ポインタへの参照)
-		auto& taskPtr = m_tasks.front();
+		// 完了したタスクから順不同で仕上げる（予算を超えたら次のフレームへ）
+		// 最低1件は処理するので、予算より重いアップロードがあっても止まらない
+		auto start = std::chrono::high_resolution_clock::now();
+		bool finalizedAny = false;
 
-		// タスク完了確認 (ブロックしない)
-		if (taskPtr->task.valid() && taskPtr->task.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+		for (auto it = m_tasks.begin(); it != m_tasks.end(); )
 		{
-			bool success = taskPtr->task.get(); // 結果取得
-
-			if (success)
+			if (finalizedAny)
 			{
-				// GPUリソース生成 / 初期化
-				if (taskPtr->type == AsyncTask::TaskType::TextureType)
-				{
-					if (taskPtr->textureData->UploadGPU(m_device)) {
-						m_textures[taskPtr->key] = taskPtr->textureData;
-						Logger::Log("Async Loaded Texture: " + taskPtr->key);
-					}
-				}
-				else if (taskPtr->type == AsyncTask::TaskType::ModelType)
-				{
-					taskPtr->modelData->UploadGPU();
-					m_models[taskPtr->key] = taskPtr->modelData;
-					Logger::Log("Async Loaded Model: " + taskPtr->key);
-				}
-				else if (taskPtr->type == AsyncTask::TaskType::SoundType)
-				{
-					taskPtr->soundData->Initialize();
-					m_sounds[taskPtr->key] = taskPtr->soundData;
-					Logger::Log("Async Loaded Sound: " + taskPtr->key);
-				}
+				double elapsed = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+				if (elapsed >= m_finalizeBudgetMs) break;
 			}
-			else
+
+			AsyncTask& task = **it;
+
+			// タスク完了確認 (ブロックしない)
+			if (!task.task.valid() || task.task.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
 			{
-				Logger::LogError("Async Load Failed: " + taskPtr->key);
+				++it;
+				continue;
 			}
 
-			// リストから削除（unique_ptrなのでここでデストラクタが呼ばれ、futureも破棄される）
-			m_tasks.pop_front();
+			FinalizeTask(task);
+			finalizedAny = true;
+
+			m_completedBytes += task.bytes;
 			m_completedTasks++;
 
-			if (m_tasks.empty()) {
-				m_totalTasks = 0;
-				m_completedTasks = 0;
+			// リストから削除（unique_ptrなのでここでデストラクタが呼ばれ、futureも破棄される）
+			it = m_tasks.erase(it);
+		}
+
+		if (m_tasks.empty()) {
+			m_totalTasks = 0;
+			m_completedTasks = 0;
+			m_totalBytes = 0;
+			m_completedBytes = 0;
+		}
+	}
+
+	void ResourceManager::FinalizeTask(AsyncTask& task)
+	{
+		bool success = false;
+		try {
+			success = task.task.get(); // 結果取得
+		}
+		catch (const std::exception& e) {
+			Logger::LogError("Async Load Exception: " + task.key + " (" + e.what() + ")");
+		}
+
+		if (!success)
+		{
+			Logger::LogError("Async Load Failed: " + task.key);
+			return;
+		}
+
+		// GPUリソース生成 / 初期化
+		if (task.type == AsyncTask::TaskType::TextureType)
+		{
+			if (task.textureData->UploadGPU(m_device)) {
+				m_textures.Insert(task.key, task.textureData, MeasureMemory(task.textureData));
+				Logger::Log("Async Loaded Texture: " + task.key);
 			}
 		}
+		else if (task.type == AsyncTask::TaskType::ModelType)
+		{
+			task.modelData->UploadGPU();
+			m_models.Insert(task.key, task.modelData, MeasureMemory(task.modelData));
+			Logger::Log("Async Loaded Model: " + task.key);
+		}
+		else if (task.type == AsyncTask::TaskType::SoundType)
+		{
+			task.soundData->Initialize();
+			m_sounds.Insert(task.key, task.soundData, MeasureMemory(task.soundData));
+			Logger::Log("Async Loaded Sound: " + task.key);
+		}
+		else if (task.type == AsyncTask::TaskType::ControllerType)
+		{
+			m_controllers.Assign(task.key, task.controllerData);
+			Logger::Log("Async Loaded AnimatorController: " + task.key);
+		}
 	}
 
 	float ResourceManager::GetProgress() const
 	{
-		if (m_totalTasks == 0) return 1.0f;
-		return (float)m_completedTasks / (float)m_totalTasks;
+		if (m_totalBytes == 0) return 1.0f;
+		return (float)((double)m_completedBytes / (double)m_totalBytes);
 	}
 
 	// --------------------------------------------------------
@@ -176,42 +318,171 @@ namespace Arche
 	// --------------------------------------------------------
 	std::shared_ptr<Texture> ResourceManager::GetTexture(const std::string& keyName)
 	{
-		if (m_textures.count(keyName)) return m_textures[keyName];
+		std::shared_ptr<Texture> cached;
+		if (m_textures.TryGet(keyName, cached)) return cached;
 
-		std::string path = ResolvePath(keyName, m_textureDirs, m_imgExts);
-		if (path.empty()) {
-			if (std::filesystem::exists(keyName)) path = keyName;
-			else return m_textures["White"];
-		}
-		// 同期ロード
+		// 見つからないキーは索引側で期限付きで記録されるので、毎フレーム呼ばれてもファイルシステムを見に行くのは一定間隔だけ
+		std::string path = m_textureRegistry.Resolve(keyName);
+		if (path.empty()) return m_textures.Find("White");
+		// 同期ロード（同時に複数スレッドがロードした場合は先に登録された方を使う）
 		auto tex = LoadTextureSync(path);
-		if (tex) m_textures[keyName] = tex;
-		else m_textures[keyName] = m_textures["White"];
-		return m_textures[keyName];
+		if (!tex) return m_textures.Insert(keyName, m_textures.Find("White"));
+		return m_textures.Insert(keyName, tex, MeasureMemory(tex));
 	}
 
 	std::shared_ptr<Model> ResourceManager::GetModel(const std::string& keyName)
 	{
-		if (m_models.count(keyName)) return m_models[keyName];
+		std::shared_ptr<Model> cached;
+		if (m_models.TryGet(keyName, cached)) return cached;
 
-		std::string path = ResolvePath(keyName, m_modelDirs, m_modelExts);
-		if (path.empty()) path = keyName;
+		std::string path = m_modelRegistry.Resolve(keyName);
+		if (path.empty()) return nullptr;
 
 		auto model = LoadModelSync(path);
-		if (model) m_models[keyName] = model;
-		return model;
+		if (!model) return nullptr;
+		return m_models.Insert(keyName, model, MeasureMemory(model));
 	}
 
 	std::shared_ptr<Sound> ResourceManager::GetSound(const std::string& keyName)
 	{
-		if (m_sounds.count(keyName)) return m_sounds[keyName];
+		std::shared_ptr<Sound> cached;
+		if (m_sounds.TryGet(keyName, cached)) return cached;
 
-		std::string path = ResolvePath(keyName, m_soundDirs, m_soundExts);
+		std::string path = m_soundRegistry.Resolve(keyName);
 		if (path.empty()) return nullptr;
 
 		auto sound = LoadSoundSync(path);
-		if (sound) m_sounds[keyName] = sound;
-		return sound;
+		if (!sound) return nullptr;
+		return m_sounds.Insert(keyName, sound, MeasureMemory(sound));
+	}
+
+	std::shared_ptr<AnimatorController> ResourceManager::GetAnimatorController(const std::string& path)
+	{
+		std::string key = MakeControllerKey(path);
+		if (key.empty()) return nullptr;
+
+		std::shared_ptr<AnimatorController> cached;
+		if (m_controllers.TryGet(key, cached)) return cached;
+
+		// 同期ロード（失敗しても nullptr をキャッシュし、毎フレームの再解析を防ぐ）
+		auto controller = AnimatorControllerSerializer::Deserialize(key);
+		if (!controller) Logger::LogWarning("AnimatorController not found: " + key);
+		return m_controllers.Insert(key, controller);
+	}
+
+	TextureHandle ResourceManager::AcquireTexture(const std::string& keyName)
+	{
+		GetTexture(keyName);	// 無ければここで読み込む
+		auto handle = m_textures.Acquire(keyName);
+		return handle ? handle : m_textures.Acquire("White");
+	}
+
+	ModelHandle ResourceManager::AcquireModel(const std::string& keyName)
+	{
+		if (!GetModel(keyName)) return nullptr;
+		return m_models.Acquire(keyName);
+	}
+
+	SoundHandle ResourceManager::AcquireSound(const std::string& keyName)
+	{
+		if (!GetSound(keyName)) return nullptr;
+		return m_sounds.Acquire(keyName);
+	}
+
+	// --------------------------------------------------------
+	// メモリ予算 / ピン留め
+	// --------------------------------------------------------
+	ResourceStats ResourceManager::GetStats(ResourceCategory category) const
+	{
+		ResourceStats stats;
+		size_t index = (size_t)category;
+		switch (category)
+		{
+		case ResourceCategory::Texture:	stats.usage = m_textures.GetUsage(); break;
+		case ResourceCategory::Model:	stats.usage = m_models.GetUsage(); break;
+		case ResourceCategory::Sound:	stats.usage = m_sounds.GetUsage(); break;
+		default: return stats;
+		}
+		stats.budget = m_budgets[index];
+		stats.evictedCount = m_evictedCounts[index];
+		stats.evictedMemory = m_evictedMemory[index];
+
+		for (const auto& info : GetEntryInfos(category))
+		{
+			if (IsPinned(category, info.key)) stats.pinned++;
+		}
+		return stats;
+	}
+
+	std::vector<ResourceEntryInfo> ResourceManager::GetEntryInfos(ResourceCategory category) const
+	{
+		switch (category)
+		{
+		case ResourceCategory::Texture:	return m_textures.GetEntryInfos();
+		case ResourceCategory::Model:	return m_models.GetEntryInfos();
+		case ResourceCategory::Sound:	return m_sounds.GetEntryInfos();
+		default: return {};
+		}
+	}
+
+	void ResourceManager::Pin(ResourceCategory category, const std::string& keyName)
+	{
+		if (keyName.empty() || category == ResourceCategory::Count) return;
+
+		// シーンに書かれたキーと、非同期ロードで登録される解決後のパスの両方を押さえる
+		std::string path;
+		if (AssetRegistry* registry = GetRegistry(category)) path = registry->Resolve(keyName);
+
+		std::lock_guard<std::mutex> lock(m_pinMutex);
+		auto& pins = m_pins[(size_t)category];
+		pins[keyName]++;
+		if (!path.empty() && path != keyName) pins[path]++;
+	}
+
+	void ResourceManager::Unpin(ResourceCategory category, const std::string& keyName)
+	{
+		if (keyName.empty() || category == ResourceCategory::Count) return;
+
+		std::string path;
+		if (AssetRegistry* registry = GetRegistry(category)) path = registry->Resolve(keyName);
+
+		std::lock_guard<std::mutex> lock(m_pinMutex);
+		auto& pins = m_pins[(size_t)category];
+		auto Release = [&](const std::string& key) {
+			auto it = pins.find(key);
+			if (it != pins.end() && --it->second <= 0) pins.erase(it);
+			};
+		Release(keyName);
+		if (!path.empty() && path != keyName) Release(path);
+	}
+
+	bool ResourceManager::IsPinned(ResourceCategory category, const std::string& key) const
+	{
+		if (category == ResourceCategory::Count) return false;
+		std::lock_guard<std::mutex> lock(m_pinMutex);
+		return m_pins[(size_t)category].count(key) != 0;
+	}
+
+	void ResourceManager::EnforceBudgets()
+	{
+		auto Enforce = [&](ResourceCategory category, auto& cache) {
+			size_t index = (size_t)category;
+			if (m_budgets[index] == 0) return;
+
+			auto evicted = cache.EvictLru(m_budgets[index], [&](const std::string& key) { return IsPinned(category, key); });
+			if (evicted.first == 0) return;
+
+			m_evictedCounts[index] += evicted.first;
+			m_evictedMemory[index].cpuBytes += evicted.second.cpuBytes;
+			m_evictedMemory[index].gpuBytes += evicted.second.gpuBytes;
+			Logger::Log(std::string("Evicted ") + std::to_string(evicted.first) + " " + GetResourceCategoryName(category) +
+				" asset(s) (" + FormatMegabytes(evicted.second.GetTotal()) + ")");
+			};
+
+		// モデルを先に捨てると、そのマテリアルだけが使っていたテクスチャも同じフレームで対象になる
+		Enforce(ResourceCategory::Model, m_models);
+		Enforce(ResourceCategory::Texture, m_textures);
+		Enforce(ResourceCategory::Sound, m_sounds);
 	}
 
 	// --------------------------------------------------------
@@ -245,21 +516,39 @@ namespace Arche
 	// --------------------------------------------------------
 	void ResourceManager::ReloadTexture(const std::string& keyName)
 	{
-		if (m_textures.find(keyName) != m_textures.end())
+		auto current = m_textures.Find(keyName);
+		if (!current) return;
+
+		std::string path = current->filepath;
+		if (path.find("System::") == std::string::npos && VirtualFileSystem::Instance().Exists(path))
 		{
-			std::string path = m_textures[keyName]->filepath;
-			if (path.find("System::") == std::string::npos && std::filesystem::exists(path))
-			{
-				auto newTex = LoadTextureSync(path);
-				if (newTex) m_textures[keyName] = newTex;
-				Logger::Log("Reloaded Texture: " + keyName);
-			}
+			auto newTex = LoadTextureSync(path);
+			if (newTex) m_textures.Assign(keyName, newTex, MeasureMemory(newTex));
+			Logger::Log("Reloaded Texture: " + keyName);
 		}
 	}
 
+	void ResourceManager::ReloadAnimatorController(const std::string& path)
+	{
+		std::string key = MakeControllerKey(path);
+		std::shared_ptr<AnimatorController> current;
+		if (!m_controllers.TryGet(key, current)) return;
+
+		auto loaded = AnimatorControllerSerializer::Deserialize(key);
+		if (!loaded) return;
+
+		// 参照中の Animator がそのまま新しい内容を使えるよう中身だけ入れ替える
+		// （プログラムのリビジョンが変わるため、次のフレームで再バインドされる）
+		if (current) *current = std::move(*loaded);
+		else m_controllers.Assign(key, loaded);
+		Logger::Log("Reloaded AnimatorController: " + key);
+	}
+
 	void ResourceManager::AddResource(const std::string& key, std::shared_ptr<Texture> resource)
 	{
-		m_textures[key] = resource;
+		m_textures.Assign(key, resource, MeasureMemory(resource));
+		// ファイルから読み直せないので追い出さない
+		if (!IsPinned(ResourceCategory::Texture, key)) Pin(ResourceCategory::Texture, key);
 	}
 
 	// --------------------------------------------------------
@@ -279,19 +568,53 @@ namespace Arche
 		m_device->CreateShaderResourceView(tex2D.Get(), nullptr, srv.GetAddressOf());
 		auto tex = std::make_shared<Texture>();
 		tex->filepath = "System::White"; tex->width = 1; tex->height = 1; tex->srv = srv;
-		m_textures["White"] = tex;
+		m_textures.Assign("White", tex, { 0, sizeof(uint32_t) });
+		if (!IsPinned(ResourceCategory::Texture, "White")) Pin(ResourceCategory::Texture, "White");
 	}
 
-	std::string ResourceManager::ResolvePath(const std::string& keyName, const std::vector<std::string>& directories, const std::vector<std::string>& extensions) {
-		if (std::filesystem::exists(keyName)) return keyName;
-		for (const auto& dir : directories) {
-			std::string tryPath = dir + keyName;
-			if (std::filesystem::exists(tryPath)) return tryPath;
-			for (const auto& ext : extensions) {
-				std::string tryPathExt = tryPath + ext;
-				if (std::filesystem::exists(tryPathExt)) return tryPathExt;
-			}
+	std::string ResourceManager::ResolvePath(ResourceCategory category, const std::string& keyName)
+	{
+		AssetRegistry* registry = GetRegistry(category);
+		return registry ? registry->Resolve(keyName) : "";
+	}
+
+	AssetRegistry* ResourceManager::GetRegistry(ResourceCategory category)
+	{
+		switch (category)
+		{
+		case ResourceCategory::Texture:	return &m_textureRegistry;
+		case ResourceCategory::Model:	return &m_modelRegistry;
+		case ResourceCategory::Sound:	return &m_soundRegistry;
+		default: return nullptr;
 		}
-		return "";
+	}
+
+	std::string ResourceManager::MakeControllerKey(const std::string& path) const
+	{
+		if (path.empty()) return "";
+		// 区切り文字の違い（\ と /）で別エントリにならないよう正規化
+		return std::filesystem::path(path).lexically_normal().generic_string();
+	}
+
+	void ResourceManager::InitializeRegistries()
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+
+		m_textureRegistry.Configure(s_textureDirs, s_imgExts);
+		m_modelRegistry.Configure(s_modelDirs, s_modelExts);
+		m_soundRegistry.Configure(s_soundDirs, s_soundExts);
+
+		m_textureRegistry.Scan();
+		m_modelRegistry.Scan();
+		m_soundRegistry.Scan();
+
+		m_textureRegistry.StartWatching();
+		m_modelRegistry.StartWatching();
+		m_soundRegistry.StartWatching();
+
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		Logger::Log("AssetRegistry built: " +
+			std::to_string(m_textureRegistry.GetEntryCount() + m_modelRegistry.GetEntryCount() + m_soundRegistry.GetEntryCount()) +
+			" keys (" + std::to_string(ms) + " ms)");
 	}
 }
\ No newline at end of file
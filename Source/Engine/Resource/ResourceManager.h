@@ -2,7 +2,13 @@
 #define ___RESOURCE_MANAGER_H___
 
 #include "Engine/pch.h"
+#include "Engine/Resource/AssetLoader.h"
+#include "Engine/Resource/ResourceCache.h"
+#include "Engine/Resource/ResourceHandle.h"
+#include "Engine/Resource/AssetRegistry.h"
+#include "Engine/Resource/LoadRequestQueue.h"
 #include <future>
+#include <atomic>
 #include <list>
 #include <unordered_map>
 #include <string>
@@ -14,23 +20,41 @@ namespace Arche {
 	class Texture;
 	class Model;
 	class Sound;
+	struct AnimatorController;
 }
 
 namespace Arche
 {
+	using TextureHandle = ResourceHandle<Texture>;
+	using ModelHandle = ResourceHandle<Model>;
+	using SoundHandle = ResourceHandle<Sound>;
+
+	// カテゴリごとの統計（エディタ表示用）
+	struct ResourceStats
+	{
+		ResourceUsage usage;
+		uint64_t budget = 0;			// 0なら無制限
+		size_t pinned = 0;				// 読み込み済みのうちピン留めされている数
+		size_t evictedCount = 0;		// 起動（または Clear）からの累計
+		ResourceMemory evictedMemory;
+	};
+
 	// 非同期タスク構造体
 	struct AsyncTask {
 		enum class TaskType {
 			ModelType,
 			TextureType,
-			SoundType
+			SoundType,
+			ControllerType
 		} type;
 
 		std::string key;
+		uint64_t bytes = 0;	// 進捗計算用のファイルサイズ
 
 		std::shared_ptr<Arche::Model> modelData;
 		std::shared_ptr<Arche::Texture> textureData;
 		std::shared_ptr<Arche::Sound> soundData;
+		std::shared_ptr<Arche::AnimatorController> controllerData;
 
 		std::future<bool> task;
 
@@ -61,26 +85,67 @@ namespace Arche
 		void Clear();
 		void Update();
 
-		// 非同期ロード要求
-		void LoadModelAsync(const std::string& path);
-		void LoadTextureAsync(const std::string& path);
-		void LoadSoundAsync(const std::string& path);
+		// 非同期ロード要求（ワーカープールで優先度順に処理）
+		// メインスレッド以外から呼ばれた場合は要求だけ積み、次の Update で処理する
+		void LoadModelAsync(const std::string& path, LoadPriority priority = LoadPriority::Normal);
+		void LoadTextureAsync(const std::string& path, LoadPriority priority = LoadPriority::Normal);
+		void LoadSoundAsync(const std::string& path, LoadPriority priority = LoadPriority::Normal);
+		void LoadAnimatorControllerAsync(const std::string& path, LoadPriority priority = LoadPriority::Normal);
+
+		// 1フレームで完了処理（GPUアップロード等）に使ってよい時間
+		void SetFinalizeBudget(float milliseconds) { m_finalizeBudgetMs = milliseconds; }
+		float GetFinalizeBudget() const { return m_finalizeBudgetMs; }
 
-		// 取得
+		// 取得（どのスレッドからでも可。読み込み済みならシャード単位の共有ロックのみ）
 		std::shared_ptr<Texture> GetTexture(const std::string& keyName);
 		std::shared_ptr<Model>	 GetModel(const std::string& keyName);
 		std::shared_ptr<Sound>	 GetSound(const std::string& keyName);
+		// 同じパスを参照する Animator 間で共有される
+		std::shared_ptr<AnimatorController> GetAnimatorController(const std::string& path);
+
+		// 参照カウント付きの取得（ハンドルが生きている間は追い出されない）
+		// 読み込まれていなければ Get と同様に同期ロードする
+		TextureHandle AcquireTexture(const std::string& keyName);
+		ModelHandle	  AcquireModel(const std::string& keyName);
+		SoundHandle	  AcquireSound(const std::string& keyName);
+
+		// メモリ予算（CPU + GPU の合計バイト。0なら無制限）
+		// 超えたカテゴリは Update のたびに、未参照・未ピン留めのものを使われた順の古いものから追い出す
+		void SetBudget(ResourceCategory category, uint64_t bytes) { m_budgets[(size_t)category] = bytes; }
+		uint64_t GetBudget(ResourceCategory category) const { return m_budgets[(size_t)category]; }
+		ResourceStats GetStats(ResourceCategory category) const;
+		std::vector<ResourceEntryInfo> GetEntryInfos(ResourceCategory category) const;
+
+		// シーンが近いうちにまた使うアセットを残しておく（読み込み前でも可。Pin した回数だけ Unpin で外れる）
+		void Pin(ResourceCategory category, const std::string& keyName);
+		void Unpin(ResourceCategory category, const std::string& keyName);
+		bool IsPinned(ResourceCategory category, const std::string& key) const;
+
+		// 予算超過分を今すぐ追い出す
+		void EnforceBudgets();
 
 		// 状況確認
-		bool IsLoading() const { return !m_tasks.empty(); }
+		bool IsLoading() const { return !m_tasks.empty() || m_requests.HasPending(); }
+		// 読み込み済みバイト数 / 要求バイト数
 		float GetProgress() const;
 
-		// ユーティリティ
-		const std::unordered_map<std::string, std::shared_ptr<Texture>>& GetTextureMap() const { return m_textures; }
-		const std::unordered_map<std::string, std::shared_ptr<Model>>& GetModelMap() const { return m_models; }
-		const std::unordered_map<std::string, std::shared_ptr<Sound>>& GetSoundMap() const { return m_sounds; }
+		// ユーティリティ（エディタ表示用のスナップショット）
+		std::unordered_map<std::string, std::shared_ptr<Texture>> GetTextureMap() const { return m_textures.Snapshot(); }
+		std::unordered_map<std::string, std::shared_ptr<Model>> GetModelMap() const { return m_models.Snapshot(); }
+		std::unordered_map<std::string, std::shared_ptr<Sound>> GetSoundMap() const { return m_sounds.Snapshot(); }
+		std::unordered_map<std::string, std::shared_ptr<AnimatorController>> GetAnimatorControllerMap() const { return m_controllers.Snapshot(); }
+
+		// モデルの検索ディレクトリ / 拡張子（クッカーが同じ規則でキーを解決するため）
+		// （インスタンスを作らずに使えるので、ResourceManager を初期化しないクッカーからも呼べる）
+		static const std::vector<std::string>& GetModelDirectories() { return s_modelDirs; }
+		static const std::vector<std::string>& GetModelExtensions() { return s_modelExts; }
+
+		// キー → 実際に読むファイルのパス（見つからなければ空）
+		std::string ResolvePath(ResourceCategory category, const std::string& keyName);
 
 		void ReloadTexture(const std::string& keyName);
+		// エディタで保存されたコントローラーを読み直す（共有中のインスタンスをその場で差し替える）
+		void ReloadAnimatorController(const std::string& path);
 		void AddResource(const std::string& key, std::shared_ptr<Texture> resource);
 
 	private:
@@ -89,31 +154,77 @@ namespace Arche
 		~ResourceManager() = default;
 
 		void CreateSystemTextures();
-		std::string ResolvePath(const std::string& keyName, const std::vector<std::string>& directories, const std::vector<std::string>& extensions);
+		void InitializeRegistries();
+		std::string MakeControllerKey(const std::string& path) const;
+
+		// タスクをキューに積み、進捗の母数に加える
+		void EnqueueTask(std::unique_ptr<AsyncTask> task, std::function<bool()> job, LoadPriority priority);
+		void FinalizeTask(AsyncTask& task);
+
+		// ワーカーからのロード要求
+		bool IsMainThread() const;
+		void QueueRequest(AsyncTask::TaskType type, const std::string& path, LoadPriority priority);
+		void ProcessPendingRequests();
 
 		std::shared_ptr<Texture> LoadTextureSync(const std::string& path);
 		std::shared_ptr<Model>	 LoadModelSync(const std::string& path);
 		std::shared_ptr<Sound>	 LoadSoundSync(const std::string& path);
 
+		AssetRegistry* GetRegistry(ResourceCategory category);
+
 	private:
 		ID3D11Device* m_device = nullptr;
 
-		std::unordered_map<std::string, std::shared_ptr<Texture>> m_textures;
-		std::unordered_map<std::string, std::shared_ptr<Model>>	  m_models;
-		std::unordered_map<std::string, std::shared_ptr<Sound>>	  m_sounds;
+		ResourceCache<Texture>	m_textures;
+		ResourceCache<Model>	m_models;
+		ResourceCache<Sound>	m_sounds;
+		ResourceCache<AnimatorController> m_controllers;
 
-		// std::unique_ptr のリスト（安全のため）
+		// std::unique_ptr のリスト（メインスレッドのみが触る）
 		std::list<std::unique_ptr<AsyncTask>> m_tasks;
 
+		// メインスレッド以外からのロード要求
+		struct LoadRequest
+		{
+			AsyncTask::TaskType type;
+			std::string path;
+			LoadPriority priority;
+		};
+		LoadRequestQueue<LoadRequest> m_requests;
+		AssetLoader m_loader;
+
 		int m_totalTasks = 0;
 		int m_completedTasks = 0;
-
-		const std::vector<std::string> m_textureDirs = { "Resources/Game/Textures/", "Resources/Engine/Textures/" };
-		const std::vector<std::string> m_modelDirs = { "Resources/Game/Models/",   "Resources/Engine/Models/" };
-		const std::vector<std::string> m_soundDirs = { "Resources/Game/Sounds/",   "Resources/Engine/Sounds/" };
-		const std::vector<std::string> m_imgExts = { ".png", ".jpg", ".jpeg", ".tga", ".bmp", ".dds" };
-		const std::vector<std::string> m_modelExts = { ".fbx", ".obj", ".gltf", ".glb" };
-		const std::vector<std::string> m_soundExts = { ".wav", ".mp3", ".ogg" };
+		uint64_t m_totalBytes = 0;
+		uint64_t m_completedBytes = 0;
+		float m_finalizeBudgetMs = 4.0f;
+
+		// メモリ予算と LRU
+		static constexpr size_t CATEGORY_COUNT = (size_t)ResourceCategory::Count;
+		uint64_t m_frame = 0;
+		std::array<uint64_t, CATEGORY_COUNT> m_budgets = {
+			1024ull * 1024 * 1024,	// Texture
+			512ull * 1024 * 1024,	// Model
+			256ull * 1024 * 1024,	// Sound
+		};
+		std::array<size_t, CATEGORY_COUNT> m_evictedCounts = {};
+		std::array<ResourceMemory, CATEGORY_COUNT> m_evictedMemory = {};
+
+		// ピン留め（キー → 回数）。キーと解決後のパスの両方で登録する
+		mutable std::mutex m_pinMutex;
+		std::array<std::unordered_map<std::string, int>, CATEGORY_COUNT> m_pins;
+
+		static inline const std::vector<std::string> s_textureDirs = { "Resources/Game/Textures/", "Resources/Engine/Textures/" };
+		static inline const std::vector<std::string> s_modelDirs = { "Resources/Game/Models/",   "Resources/Engine/Models/" };
+		static inline const std::vector<std::string> s_soundDirs = { "Resources/Game/Sounds/",   "Resources/Engine/Sounds/" };
+		static inline const std::vector<std::string> s_imgExts = { ".png", ".jpg", ".jpeg", ".tga", ".bmp", ".dds" };
+		static inline const std::vector<std::string> s_modelExts = { ".fbx", ".obj", ".gltf", ".glb" };
+		static inline const std::vector<std::string> s_soundExts = { ".wav", ".mp3", ".ogg" };
+
+		// キー → 実パスの索引（ResolvePath の代わり。存在確認はここで1回だけ行う）
+		AssetRegistry m_textureRegistry;
+		AssetRegistry m_modelRegistry;
+		AssetRegistry m_soundRegistry;
 	};
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,138 @@
+﻿/*****************************************************************//**
+ * @file	StreamReader.h
+ * @brief	ファイルの一部だけを少しずつ読むための読み込み口
+ *
+ * @details	ファイル全体をマップ・展開せず、必要な範囲だけを呼び出し側のバッファへ読む。
+ *			ストリーミング再生のように、読む量を固定サイズのブロックに抑えたい所で使う。
+ *			- FileStreamReader		: ディスク上のファイル（パック内の無圧縮エントリは、パックの一部として開く）
+ *			- MemoryStreamReader	: メモリ上のデータ（圧縮エントリを展開したもの、テスト用）
+ *			1つの StreamReader を複数のスレッドから同時に読んではいけない。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___STREAM_READER_H___
+#define ___STREAM_READER_H___
+
+// ===== インクルード =====
+// 標準ライブラリだけで書く（pch.h を含めず、Tests/ からも使えるように）
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+namespace Arche
+{
+	/**
+	 * @class	StreamReader
+	 * @brief	範囲を指定して読む読み込み口
+	 */
+	class StreamReader
+	{
+	public:
+		virtual ~StreamReader() = default;
+
+		virtual uint64_t GetSize() const = 0;
+
+		// offset から size バイトを dst へ読む（範囲外・読み込み失敗なら false）
+		virtual bool Read(uint64_t offset, void* dst, size_t size) = 0;
+
+		template<typename T>
+		bool ReadValue(uint64_t offset, T& out) { return Read(offset, &out, sizeof(T)); }
+
+	protected:
+		bool IsInRange(uint64_t offset, size_t size) const
+		{
+			const uint64_t total = GetSize();
+			return offset <= total && size <= total - offset;
+		}
+	};
+
+	/**
+	 * @class	MemoryStreamReader
+	 * @brief	メモリ上のデータを読む
+	 */
+	class MemoryStreamReader : public StreamReader
+	{
+	public:
+		// data は呼び出し側が保持する
+		MemoryStreamReader(const void* data, size_t size) : m_data(static_cast<const uint8_t*>(data)), m_size(size) {}
+		// buffer を受け取って保持する
+		explicit MemoryStreamReader(std::vector<uint8_t> buffer)
+			: m_buffer(std::move(buffer)), m_data(m_buffer.data()), m_size(m_buffer.size()) {}
+
+		MemoryStreamReader(const MemoryStreamReader&) = delete;
+		MemoryStreamReader& operator=(const MemoryStreamReader&) = delete;
+
+		uint64_t GetSize() const override { return m_size; }
+
+		bool Read(uint64_t offset, void* dst, size_t size) override
+		{
+			if (!IsInRange(offset, size)) return false;
+			if (size > 0) std::memcpy(dst, m_data + offset, size);
+			return true;
+		}
+
+	private:
+		std::vector<uint8_t> m_buffer;
+		const uint8_t* m_data = nullptr;
+		size_t m_size = 0;
+	};
+
+	/**
+	 * @class	FileStreamReader
+	 * @brief	ディスク上のファイル（またはその一部）を読む
+	 */
+	class FileStreamReader : public StreamReader
+	{
+	public:
+		// ファイル全体を開く
+		bool Open(const std::filesystem::path& path)
+		{
+			std::error_code ec;
+			const uintmax_t size = std::filesystem::file_size(path, ec);
+			if (ec) return false;
+			return Open(path, 0, (uint64_t)size);
+		}
+
+		// ファイルの [offset, offset + size) だけを1つのファイルとして開く（パック内のエントリ用）
+		bool Open(const std::filesystem::path& path, uint64_t offset, uint64_t size)
+		{
+			m_file.close();
+			m_file.clear();
+			m_file.open(path, std::ios::binary);
+			if (!m_file) return false;
+
+			m_offset = offset;
+			m_size = size;
+			return true;
+		}
+
+		bool IsOpen() const { return m_file.is_open(); }
+		uint64_t GetSize() const override { return m_size; }
+
+		bool Read(uint64_t offset, void* dst, size_t size) override
+		{
+			if (!m_file.is_open() || !IsInRange(offset, size)) return false;
+			if (size == 0) return true;
+
+			m_file.clear();
+			m_file.seekg((std::streamoff)(m_offset + offset));
+			m_file.read(static_cast<char*>(dst), (std::streamsize)size);
+			return (size_t)m_file.gcount() == size;
+		}
+
+	private:
+		std::ifstream m_file;
+		uint64_t m_offset = 0;
+		uint64_t m_size = 0;
+	};
+
+}	// namespace Arche
+
+#endif // !___STREAM_READER_H___
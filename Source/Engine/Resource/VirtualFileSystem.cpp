@@ -0,0 +1,207 @@
+﻿/*****************************************************************//**
+ * @file	VirtualFileSystem.cpp
+ * @brief	パックとディスク上のファイルをまとめて扱う読み込み層
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Resource/VirtualFileSystem.h"
+#include "Engine/Core/Base/Logger.h"
+
+namespace Arche
+{
+	// ====================================================================================
+	// FileView
+	// ====================================================================================
+	FileView& FileView::operator=(FileView&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Close();
+			m_mapped = std::move(other.m_mapped);
+			m_buffer = std::move(other.m_buffer);
+			m_data = other.m_data;
+			m_size = other.m_size;
+
+			other.m_data = nullptr;
+			other.m_size = 0;
+		}
+		return *this;
+	}
+
+	void FileView::Close()
+	{
+		m_mapped.Close();
+		m_buffer.clear();
+		m_buffer.shrink_to_fit();
+		m_data = nullptr;
+		m_size = 0;
+	}
+
+	// ====================================================================================
+	// VirtualFileSystem
+	// ====================================================================================
+	bool VirtualFileSystem::Mount(const std::string& archivePath)
+	{
+		auto archive = std::make_unique<AssetArchive>();
+		if (!archive->Open(archivePath))
+		{
+			Logger::LogError("Failed to mount archive: " + archivePath);
+			return false;
+		}
+
+		Logger::Log("Mounted archive: " + archivePath + " (" + std::to_string(archive->GetEntryCount()) + " files)");
+		m_archives.push_back(std::move(archive));
+		return true;
+	}
+
+	void VirtualFileSystem::UnmountAll()
+	{
+		m_archives.clear();
+	}
+
+	const AssetArchive::Entry* VirtualFileSystem::Find(const std::string& path, const AssetArchive** outArchive) const
+	{
+		for (auto it = m_archives.rbegin(); it != m_archives.rend(); ++it)
+		{
+			if (const AssetArchive::Entry* entry = (*it)->Find(path))
+			{
+				if (outArchive) *outArchive = it->get();
+				return entry;
+			}
+		}
+		return nullptr;
+	}
+
+	bool VirtualFileSystem::Exists(const std::string& path) const
+	{
+		if (path.empty()) return false;
+		if (Find(path, nullptr)) return true;
+
+		std::error_code ec;
+		return std::filesystem::is_regular_file(path, ec);
+	}
+
+	bool VirtualFileSystem::IsArchived(const std::string& path) const
+	{
+		return !path.empty() && Find(path, nullptr) != nullptr;
+	}
+
+	uint64_t VirtualFileSystem::GetFileSize(const std::string& path) const
+	{
+		if (path.empty()) return 0;
+		if (const AssetArchive::Entry* entry = Find(path, nullptr)) return entry->size;
+
+		std::error_code ec;
+		uintmax_t size = std::filesystem::file_size(path, ec);
+		return ec ? 0 : (uint64_t)size;
+	}
+
+	bool VirtualFileSystem::Open(const std::string& path, FileView& out) const
+	{
+		out.Close();
+		if (path.empty()) return false;
+
+		const AssetArchive* archive = nullptr;
+		if (const AssetArchive::Entry* entry = Find(path, &archive))
+		{
+			// 空のファイルは開けなかった扱い（MappedFile と同じ）
+			if (entry->size == 0) return false;
+
+			if (entry->compression == AssetArchive::Compression::None)
+			{
+				out.m_data = archive->GetStoredData(*entry);
+				out.m_size = (size_t)entry->size;
+				return true;
+			}
+
+			if (!archive->Extract(*entry, out.m_buffer))
+			{
+				Logger::LogError("Archive entry is corrupted: " + path);
+				out.Close();
+				return false;
+			}
+			out.m_data = out.m_buffer.data();
+			out.m_size = out.m_buffer.size();
+			return true;
+		}
+
+		if (!out.m_mapped.Open(path)) return false;
+		out.m_data = out.m_mapped.GetData();
+		out.m_size = out.m_mapped.GetSize();
+		return true;
+	}
+
+	bool VirtualFileSystem::ReadText(const std::string& path, std::string& out) const
+	{
+		FileView view;
+		if (!Open(path, view)) return false;
+		out.assign((const char*)view.GetData(), view.GetSize());
+		return true;
+	}
+
+	std::unique_ptr<StreamReader> VirtualFileSystem::OpenStream(const std::string& path) const
+	{
+		if (path.empty()) return nullptr;
+
+		const AssetArchive* archive = nullptr;
+		if (const AssetArchive::Entry* entry = Find(path, &archive))
+		{
+			if (entry->size == 0) return nullptr;
+
+			// 無圧縮のエントリはパックの中の範囲をそのまま読む
+			if (entry->compression == AssetArchive::Compression::None)
+			{
+				auto reader = std::make_unique<FileStreamReader>();
+				if (!reader->Open(std::filesystem::path(archive->GetPath()), entry->offset, entry->size)) return nullptr;
+				return reader;
+			}
+
+			std::vector<uint8_t> buffer;
+			if (!archive->Extract(*entry, buffer))
+			{
+				Logger::LogError("Archive entry is corrupted: " + path);
+				return nullptr;
+			}
+			return std::make_unique<MemoryStreamReader>(std::move(buffer));
+		}
+
+		auto reader = std::make_unique<FileStreamReader>();
+		if (!reader->Open(std::filesystem::path(path)) || reader->GetSize() == 0) return nullptr;
+		return reader;
+	}
+
+	std::vector<std::string> VirtualFileSystem::ListArchived(const std::string& directory) const
+	{
+		std::string prefix = AssetArchive::NormalizePath(directory);
+		if (!prefix.empty() && prefix.back() != '/') prefix += '/';
+
+		std::vector<std::string> result;
+		for (const auto& archive : m_archives)
+		{
+			// 目次はパス順なので、prefix で始まるものは連続している
+			const AssetArchive::Entry* begin = archive->GetEntries();
+			const AssetArchive::Entry* end = begin + archive->GetEntryCount();
+			const AssetArchive::Entry* entry = std::lower_bound(begin, end, prefix, [&](const AssetArchive::Entry& e, const std::string& key) {
+				std::string entryPath = archive->GetEntryPath(e);
+				return AssetArchive::ComparePath(entryPath.data(), entryPath.size(), key.data(), key.size()) < 0;
+				});
+
+			for (; entry != end; ++entry)
+			{
+				std::string entryPath = archive->GetEntryPath(*entry);
+				if (entryPath.size() < prefix.size() ||
+					AssetArchive::ComparePath(entryPath.data(), prefix.size(), prefix.data(), prefix.size()) != 0) break;
+				result.push_back(std::move(entryPath));
+			}
+		}
+		return result;
+	}
+
+}	// namespace Arche
@@ -0,0 +1,102 @@
+﻿/*****************************************************************//**
+ * @file	VirtualFileSystem.h
+ * @brief	パックとディスク上のファイルをまとめて扱う読み込み層
+ *
+ * @details	マウントしたパック (AssetArchive) にあるファイルはそちらを優先し、
+ *			無ければディスクから読む。ファイルの中身は FileView で受け取る。
+ *			- パック内の無圧縮エントリ: マップ済みのメモリをそのまま参照（コピー無し）
+ *			- パック内の圧縮エントリ: FileView が持つバッファに展開
+ *			- ディスク上のファイル: メモリマップ
+ *			長いファイルを少しずつ読む場合は OpenStream で StreamReader を受け取る（全体をマップしない）。
+ *			Mount は起動時（読み込みスレッドが動き出す前）にだけ行う。
+ *			それ以降の読み込みはどのスレッドからでも呼べる。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___VIRTUAL_FILE_SYSTEM_H___
+#define ___VIRTUAL_FILE_SYSTEM_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Resource/AssetArchive.h"
+#include "Engine/Resource/MappedFile.h"
+#include "Engine/Resource/StreamReader.h"
+
+namespace Arche
+{
+	// 読み込んだファイルの中身（読み取り専用・ムーブのみ）
+	class ARCHE_API FileView
+	{
+	public:
+		FileView() = default;
+		FileView(const FileView&) = delete;
+		FileView& operator=(const FileView&) = delete;
+		FileView(FileView&& other) noexcept { *this = std::move(other); }
+		FileView& operator=(FileView&& other) noexcept;
+
+		void Close();
+
+		bool IsOpen() const { return m_data != nullptr; }
+		const uint8_t* GetData() const { return m_data; }
+		size_t GetSize() const { return m_size; }
+
+		// 範囲チェック付きで offset 位置を T として参照（範囲外なら nullptr）
+		template<typename T>
+		const T* At(uint64_t offset, uint64_t count = 1) const
+		{
+			if (!m_data || offset > m_size || count > (m_size - offset) / sizeof(T)) return nullptr;
+			return reinterpret_cast<const T*>(m_data + offset);
+		}
+
+	private:
+		friend class VirtualFileSystem;
+
+		MappedFile m_mapped;			// ディスク上のファイル
+		std::vector<uint8_t> m_buffer;	// 展開したエントリ
+		const uint8_t* m_data = nullptr;
+		size_t m_size = 0;
+	};
+
+	class ARCHE_API VirtualFileSystem
+	{
+	public:
+		static VirtualFileSystem& Instance() { static VirtualFileSystem instance; return instance; }
+
+		VirtualFileSystem(const VirtualFileSystem&) = delete;
+		VirtualFileSystem& operator=(const VirtualFileSystem&) = delete;
+
+		// 後からマウントしたパックほど優先される
+		bool Mount(const std::string& archivePath);
+		void UnmountAll();
+		bool HasArchive() const { return !m_archives.empty(); }
+
+		bool Exists(const std::string& path) const;
+		bool IsArchived(const std::string& path) const;
+		// 展開後のサイズ（無ければ 0）
+		uint64_t GetFileSize(const std::string& path) const;
+
+		bool Open(const std::string& path, FileView& out) const;
+		bool ReadText(const std::string& path, std::string& out) const;
+
+		// 範囲を指定して読む読み込み口（無圧縮ならファイルから直接読み、圧縮エントリは展開したものを読む。開けなければ nullptr）
+		std::unique_ptr<StreamReader> OpenStream(const std::string& path) const;
+
+		// directory 以下にあるパック内のファイル（パック内の表記のまま）
+		std::vector<std::string> ListArchived(const std::string& directory) const;
+
+	private:
+		VirtualFileSystem() = default;
+
+		// 見つかったエントリとその持ち主
+		const AssetArchive::Entry* Find(const std::string& path, const AssetArchive** outArchive) const;
+
+	private:
+		std::vector<std::unique_ptr<AssetArchive>> m_archives;
+	};
+
+}	// namespace Arche
+
+#endif // !___VIRTUAL_FILE_SYSTEM_H___
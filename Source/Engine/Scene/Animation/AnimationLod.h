@@ -0,0 +1,99 @@
+﻿/*****************************************************************//**
+ * @file	AnimationLod.h
+ * @brief	アニメーションLOD（カメラ距離による更新頻度・ボーン数の間引き）
+ *
+ * @details	距離に応じて4段階に分ける。
+ *			- Full		: 毎フレーム更新
+ *			- Half		: midInterval フレームに1回（間は姿勢を保持）
+ *			- Low		: farInterval フレームに1回
+ *			- UpperBody	: farInterval フレームに1回 + 上半身ボーンのみ評価
+ *			間引き更新はエンティティIDでフレームをずらし、同じフレームに集中しないようにする。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___ANIMATION_LOD_H___
+#define ___ANIMATION_LOD_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+
+namespace Arche
+{
+	enum class AnimationLodLevel
+	{
+		Full = 0,
+		Half,
+		Low,
+		UpperBody,
+		Count
+	};
+
+	/**
+	 * @struct	AnimationLodStats
+	 * @brief	直近フレームのLOD集計（SystemMonitorWindowで表示）
+	 */
+	struct AnimationLodStats
+	{
+		int levelCounts[(int)AnimationLodLevel::Count] = {};
+		int evaluated = 0;	// 姿勢を評価したインスタンス数
+		int held = 0;		// 前回の姿勢を保持したインスタンス数
+
+		void Reset() { *this = AnimationLodStats(); }
+
+		static AnimationLodStats& Instance()
+		{
+			static AnimationLodStats instance;
+			return instance;
+		}
+	};
+
+	namespace AnimationLod
+	{
+		inline const char* GetLevelName(AnimationLodLevel level)
+		{
+			switch (level)
+			{
+			case AnimationLodLevel::Full:		return "Full";
+			case AnimationLodLevel::Half:		return "Half";
+			case AnimationLodLevel::Low:		return "Low";
+			case AnimationLodLevel::UpperBody:	return "UpperBody";
+			default:							return "Unknown";
+			}
+		}
+
+		// カメラとの距離(2乗)からLODを選択
+		inline AnimationLodLevel Select(float distanceSq, float halfDistance, float lowDistance, float upperBodyDistance)
+		{
+			if (distanceSq >= upperBodyDistance * upperBodyDistance) return AnimationLodLevel::UpperBody;
+			if (distanceSq >= lowDistance * lowDistance) return AnimationLodLevel::Low;
+			if (distanceSq >= halfDistance * halfDistance) return AnimationLodLevel::Half;
+			return AnimationLodLevel::Full;
+		}
+
+		// LODごとの更新間隔（フレーム数）
+		inline int GetInterval(AnimationLodLevel level, int midInterval, int farInterval)
+		{
+			switch (level)
+			{
+			case AnimationLodLevel::Half:		return std::max(1, midInterval);
+			case AnimationLodLevel::Low:
+			case AnimationLodLevel::UpperBody:	return std::max(1, farInterval);
+			default:							return 1;
+			}
+		}
+
+		// このフレームで更新するか（エンティティIDで位相をずらして負荷を分散）
+		inline bool ShouldUpdate(uint64_t frameIndex, uint32_t entity, int interval)
+		{
+			if (interval <= 1) return true;
+			return ((frameIndex + entity) % (uint64_t)interval) == 0;
+		}
+
+	}	// namespace AnimationLod
+
+}	// namespace Arche
+
+#endif // !___ANIMATION_LOD_H___
@@ -0,0 +1,279 @@
+﻿/*****************************************************************//**
+ * @file	AnimatorBenchmark.cpp
+ * @brief	アニメーターの遷移評価の計測（文字列のmap と コンパイル済みプログラムの比較）
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+// pch.h は含めない（Tests/ からもビルドする。vcxproj でもプリコンパイル済みヘッダーを使わない）
+#include "Engine/Scene/Animation/AnimatorBenchmark.h"
+#include "Engine/Scene/Animation/AnimatorControllerTypes.h"
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Arche
+{
+	namespace
+	{
+		constexpr uint32_t STATE_COUNT = 8;
+		constexpr float FRAME_TIME = 1.0f / 60.0f;
+		constexpr float MOTION_LENGTH = 1.0f;
+
+		double Elapsed(std::chrono::high_resolution_clock::time_point from)
+		{
+			return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - from).count();
+		}
+
+		// 移動・武器・接地で分岐する、ゲームでよくある形のコントローラー
+		AnimatorController MakeController()
+		{
+			AnimatorController controller;
+			controller.parameters = {
+				{ "Speed", AnimatorParameterType::Float },
+				{ "AimPitch", AnimatorParameterType::Float },
+				{ "Health", AnimatorParameterType::Float, 100.0f },
+				{ "Weapon", AnimatorParameterType::Int },
+				{ "Combo", AnimatorParameterType::Int },
+				{ "IsGrounded", AnimatorParameterType::Bool, 0.0f, 0, true },
+				{ "IsCrouching", AnimatorParameterType::Bool },
+			};
+
+			for (uint32_t s = 0; s < STATE_COUNT; ++s)
+			{
+				AnimatorState state;
+				state.name = StringId("State_" + std::to_string(s));
+				state.motionName = "Motion_" + std::to_string(s);
+				controller.states.push_back(state);
+			}
+			controller.entryState = controller.states[0].name;
+
+			auto stateName = [&](uint32_t s) { return controller.states[s % STATE_COUNT].name; };
+			for (uint32_t s = 0; s < STATE_COUNT; ++s)
+			{
+				auto& transitions = controller.states[s].transitions;
+
+				AnimatorTransition toFall;
+				toFall.targetState = stateName(s + 4);
+				toFall.conditions = { { AnimatorConditionMode::IfNot, "IsGrounded", 0.0f }, { AnimatorConditionMode::Greater, "Health", 0.0f } };
+				transitions.push_back(toFall);
+
+				AnimatorTransition toRun;
+				toRun.targetState = stateName(s + 1);
+				toRun.conditions = { { AnimatorConditionMode::Greater, "Speed", 0.5f + 0.05f * s }, { AnimatorConditionMode::If, "IsGrounded", 0.0f } };
+				transitions.push_back(toRun);
+
+				AnimatorTransition toWeapon;
+				toWeapon.targetState = stateName(s + 2);
+				toWeapon.conditions = { { AnimatorConditionMode::Equals, "Weapon", (float)(s % 3) }, { AnimatorConditionMode::Less, "AimPitch", 0.0f }, { AnimatorConditionMode::NotEqual, "Combo", 0.0f } };
+				transitions.push_back(toWeapon);
+
+				AnimatorTransition toIdle;
+				toIdle.targetState = stateName(s + STATE_COUNT - 1);
+				toIdle.hasExitTime = true;
+				toIdle.exitTime = 0.9f;
+				toIdle.conditions = { { AnimatorConditionMode::Less, "Speed", 0.2f }, { AnimatorConditionMode::IfNot, "IsCrouching", 0.0f } };
+				transitions.push_back(toIdle);
+			}
+
+			controller.Compile();
+			return controller;
+		}
+
+		// フレームとAnimatorの番号から決まる入力（スクリプトからの設定の代わり）
+		struct Input
+		{
+			float speed;
+			float aimPitch;
+			int weapon;
+			int combo;
+			bool grounded;
+			bool crouching;
+		};
+
+		Input MakeInput(uint32_t animator, uint32_t frame)
+		{
+			Input in;
+			in.speed = 0.5f + 0.5f * std::sin((frame + animator * 7) * 0.05f);
+			in.aimPitch = std::cos((frame + animator * 3) * 0.03f);
+			in.weapon = (int)((frame / 50 + animator) % 3);
+			in.combo = (int)((frame / 20 + animator) % 4);
+			in.grounded = ((frame + animator) % 90) >= 6;
+			in.crouching = ((frame / 120 + animator) % 5) == 0;
+			return in;
+		}
+
+		// 変更前の評価方法（パラメータは名前で、ステートは名前で探す）
+		struct LegacyAnimator
+		{
+			StringId currentState;
+			float time = 0.0f;
+			std::map<std::string, float> floats;
+			std::map<std::string, int> ints;
+			std::map<std::string, bool> bools;
+		};
+
+		const AnimatorState* FindStateByName(const AnimatorController& controller, const StringId& name)
+		{
+			for (const auto& state : controller.states)
+			{
+				if (state.name == name) return &state;
+			}
+			return nullptr;
+		}
+
+		bool EvaluateLegacyCondition(LegacyAnimator& animator, const AnimatorCondition& cond)
+		{
+			switch (cond.mode)
+			{
+			case AnimatorConditionMode::If:		 return animator.bools[cond.parameter] == true;
+			case AnimatorConditionMode::IfNot:	 return animator.bools[cond.parameter] == false;
+			case AnimatorConditionMode::Greater: return animator.floats[cond.parameter] > cond.threshold;
+			case AnimatorConditionMode::Less:	 return animator.floats[cond.parameter] < cond.threshold;
+			case AnimatorConditionMode::Equals:	 return animator.ints[cond.parameter] == (int)cond.threshold;
+			case AnimatorConditionMode::NotEqual:return animator.ints[cond.parameter] != (int)cond.threshold;
+			default: return false;
+			}
+		}
+
+		uint64_t RunLegacy(const AnimatorController& controller, uint32_t animatorCount, uint32_t frameCount)
+		{
+			std::vector<LegacyAnimator> animators(animatorCount);
+			for (auto& animator : animators)
+			{
+				animator.currentState = controller.entryState;
+				for (const auto& param : controller.parameters)
+				{
+					if (param.type == AnimatorParameterType::Float) animator.floats[param.name] = param.defaultFloat;
+					else if (param.type == AnimatorParameterType::Int) animator.ints[param.name] = param.defaultInt;
+					else animator.bools[param.name] = param.defaultBool;
+				}
+			}
+
+			uint64_t transitions = 0;
+			for (uint32_t frame = 0; frame < frameCount; ++frame)
+			{
+				for (uint32_t a = 0; a < animatorCount; ++a)
+				{
+					auto& animator = animators[a];
+					Input in = MakeInput(a, frame);
+					animator.floats["Speed"] = in.speed;
+					animator.floats["AimPitch"] = in.aimPitch;
+					animator.ints["Weapon"] = in.weapon;
+					animator.ints["Combo"] = in.combo;
+					animator.bools["IsGrounded"] = in.grounded;
+					animator.bools["IsCrouching"] = in.crouching;
+
+					animator.time += FRAME_TIME;
+
+					const AnimatorState* currentState = FindStateByName(controller, animator.currentState);
+					if (!currentState) continue;
+
+					for (const auto& transition : currentState->transitions)
+					{
+						if (transition.hasExitTime && animator.time / MOTION_LENGTH < transition.exitTime) continue;
+
+						bool passed = true;
+						for (const auto& cond : transition.conditions)
+						{
+							if (!EvaluateLegacyCondition(animator, cond)) { passed = false; break; }
+						}
+						if (!passed) continue;
+
+						const AnimatorState* nextState = FindStateByName(controller, transition.targetState);
+						if (nextState)
+						{
+							animator.currentState = nextState->name;
+							animator.time = 0.0f;
+							transitions++;
+							break;
+						}
+					}
+				}
+			}
+			return transitions;
+		}
+
+		// 変更後の評価方法（スロットは読み込み時に1度だけ引く）
+		struct CompiledAnimator
+		{
+			int currentState = AnimatorProgram::INVALID_INDEX;
+			float time = 0.0f;
+			std::vector<AnimatorValue> params;
+		};
+
+		uint64_t RunProgram(const AnimatorController& controller, uint32_t animatorCount, uint32_t frameCount)
+		{
+			const AnimatorProgram& program = controller.program;
+			const int speedSlot = program.FindParameter("Speed");
+			const int aimSlot = program.FindParameter("AimPitch");
+			const int weaponSlot = program.FindParameter("Weapon");
+			const int comboSlot = program.FindParameter("Combo");
+			const int groundedSlot = program.FindParameter("IsGrounded");
+			const int crouchingSlot = program.FindParameter("IsCrouching");
+
+			std::vector<CompiledAnimator> animators(animatorCount);
+			for (auto& animator : animators)
+			{
+				animator.currentState = program.GetEntryState();
+				program.InitParameters(animator.params);
+			}
+
+			uint64_t transitions = 0;
+			for (uint32_t frame = 0; frame < frameCount; ++frame)
+			{
+				for (uint32_t a = 0; a < animatorCount; ++a)
+				{
+					auto& animator = animators[a];
+					Input in = MakeInput(a, frame);
+					AnimatorValue* params = animator.params.data();
+					params[speedSlot].f = in.speed;
+					params[aimSlot].f = in.aimPitch;
+					params[weaponSlot].i = in.weapon;
+					params[comboSlot].i = in.combo;
+					params[groundedSlot].i = in.grounded ? 1 : 0;
+					params[crouchingSlot].i = in.crouching ? 1 : 0;
+
+					animator.time += FRAME_TIME;
+
+					int fired = program.EvaluateTransitions(animator.currentState, params, animator.time / MOTION_LENGTH);
+					if (fired == AnimatorProgram::INVALID_INDEX) continue;
+
+					animator.currentState = program.GetTransition(fired).targetState;
+					animator.time = 0.0f;
+					transitions++;
+				}
+			}
+			return transitions;
+		}
+	}
+
+	AnimatorBenchmarkResult AnimatorBenchmark::Run(uint32_t animatorCount, uint32_t frameCount)
+	{
+		AnimatorBenchmarkResult result;
+		result.animatorCount = animatorCount;
+		result.frameCount = frameCount;
+
+		AnimatorController controller = MakeController();
+
+		auto start = std::chrono::high_resolution_clock::now();
+		uint64_t legacyTransitions = RunLegacy(controller, animatorCount, frameCount);
+		result.legacySeconds = Elapsed(start);
+
+		start = std::chrono::high_resolution_clock::now();
+		uint64_t programTransitions = RunProgram(controller, animatorCount, frameCount);
+		result.programSeconds = Elapsed(start);
+
+		result.transitionCount = programTransitions;
+		result.succeeded = legacyTransitions == programTransitions;
+		return result;
+	}
+
+}	// namespace Arche
@@ -0,0 +1,55 @@
+﻿/*****************************************************************//**
+ * @file	AnimatorBenchmark.h
+ * @brief	アニメーターの遷移評価の計測（文字列のmap と コンパイル済みプログラムの比較）
+ *
+ * @details	同じコントローラーを共有する Animator を大量に用意し、毎フレーム
+ *			パラメータの設定 → 現在ステートの遷移評価 → ステート変更 を行う時間を測る。
+ *			「変更前」はパラメータを std::map<std::string, ...> に持ち、条件ごとに名前で引き、
+ *			遷移先を名前で探す以前の評価方法をそのまま再現したもの。
+ *			両方で成立した遷移の数が一致することも確かめる。デバイスを使わないので ArcheCook --bench-animator と
+ *			Tests/AnimatorBenchmarkTest から呼べる。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___ANIMATOR_BENCHMARK_H___
+#define ___ANIMATOR_BENCHMARK_H___
+
+// ===== インクルード =====
+// 標準ライブラリだけで書く（pch.h を含めず、Tests/ からも使えるように）
+#include <cstdint>
+
+#ifdef _WIN32
+#include "Engine/Core/Core.h"
+#else
+#define ARCHE_API	// Tests/（Windows 以外）では DLL の境界が無い
+#endif // _WIN32
+
+namespace Arche
+{
+	struct AnimatorBenchmarkResult
+	{
+		uint32_t animatorCount = 0;
+		uint32_t frameCount = 0;
+		bool succeeded = false;		// 両方の方法で成立した遷移の数が一致したか
+
+		double legacySeconds = 0.0;		// 文字列のmap + 名前での検索
+		double programSeconds = 0.0;	// スロット + 命令列
+		uint64_t transitionCount = 0;
+
+		double GetLegacyFrameMs() const { return frameCount ? legacySeconds * 1000.0 / frameCount : 0.0; }
+		double GetProgramFrameMs() const { return frameCount ? programSeconds * 1000.0 / frameCount : 0.0; }
+		double GetSpeedup() const { return programSeconds > 0.0 ? legacySeconds / programSeconds : 0.0; }
+	};
+
+	class ARCHE_API AnimatorBenchmark
+	{
+	public:
+		static AnimatorBenchmarkResult Run(uint32_t animatorCount, uint32_t frameCount = 600);
+	};
+
+}	// namespace Arche
+
+#endif // !___ANIMATOR_BENCHMARK_H___
@@ -0,0 +1,114 @@
+﻿/*****************************************************************//**
+ * @file	AnimatorControllerTypes.h
+ * @brief	アニメーターコントローラーのデータ定義
+ *
+ * @details	AnimatorProgram のコンパイルと AnimatorBenchmark が使う部分だけを、pch.h に依存しない形で置く。
+ *			リフレクション定義（シリアライズ用）は AnimatorController.h にある。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___ANIMATOR_CONTROLLER_TYPES_H___
+#define ___ANIMATOR_CONTROLLER_TYPES_H___
+
+// ===== インクルード =====
+// 標準ライブラリだけで書く（pch.h を含めず、Tests/ からも使えるように）
+#include "Engine/Core/Base/StringId.h"
+#include "Engine/Scene/Animation/AnimatorProgram.h"
+#include <string>
+#include <vector>
+
+namespace Arche
+{
+	// パラメータの型
+	enum class AnimatorParameterType
+	{
+		Float,
+		Int,
+		Bool,
+		Trigger
+	};
+
+	// 比較演算子
+	enum class AnimatorConditionMode
+	{
+		If,				// Bool true
+		IfNot,			// Bool false
+		Greater,		// Float/Int >
+		Less,			// Float/Int <
+		Equals,			// Int ==
+		NotEqual		// Int !=
+	};
+
+	// 遷移条件
+	struct AnimatorCondition
+	{
+		AnimatorConditionMode mode;
+		std::string parameter; // パラメータ名
+		float threshold;	   // 閾値 (int/boolもここにキャストして格納)
+	};
+
+	// ステート遷移
+	struct AnimatorTransition
+	{
+		StringId targetState;			// 遷移先ステート名
+		bool hasExitTime = false;		// モーション終了時に自動遷移するか
+		float exitTime = 1.0f;			// 遷移開始タイミング (0.0-1.0)
+		float duration = 0.25f;			// クロスフェード時間
+		std::vector<AnimatorCondition> conditions; // 遷移条件リスト
+	};
+
+	// ステート (1つのノード)
+	struct AnimatorState
+	{
+		StringId name;				// ステート名 (例: "Idle", "Run")
+		std::string motionName;		// 再生するモーション名 (Model内のキー)
+		float speed = 1.0f;			// 再生速度
+		bool loop = true;			// ループするか
+
+		// エディタ用座標 (ImNodesで位置を復元するため)
+		float position[2] = { 0.0f, 0.0f };
+
+		std::vector<AnimatorTransition> transitions;
+	};
+
+	// パラメータ定義
+	struct AnimatorParameter
+	{
+		std::string name;
+		AnimatorParameterType type;
+		float defaultFloat = 0.0f;
+		int defaultInt = 0;
+		bool defaultBool = false;
+	};
+
+	// アニメーターコントローラー (全体のアセットデータ)
+	struct AnimatorController
+	{
+		std::vector<AnimatorParameter> parameters;
+		std::vector<AnimatorState> states;
+		StringId entryState; // 初期ステート
+
+		// 実行用にコンパイルしたデータ（ロード・編集後に Compile() で更新）
+		AnimatorProgram program;
+
+		void Compile() { program.Build(*this); }
+
+		// ヘルパー: 名前からステート検索
+		const AnimatorState* FindState(const StringId& name) const
+		{
+			int index = program.FindState(name);
+			if (index != AnimatorProgram::INVALID_INDEX && index < (int)states.size() && states[index].name == name) return &states[index];
+			for (const auto& state : states)
+			{
+				if (state.name == name) return &state;
+			}
+			return nullptr;
+		}
+	};
+
+}	// namespace Arche
+
+#endif // !___ANIMATOR_CONTROLLER_TYPES_H___
@@ -0,0 +1,192 @@
+﻿/*****************************************************************//**
+ * @file	AnimatorProgram.cpp
+ * @brief	ロード時にコンパイルされたアニメーターコントローラー
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+// pch.h は含めない（Tests/ からもビルドする。vcxproj でもプリコンパイル済みヘッダーを使わない）
+#include "Engine/Scene/Animation/AnimatorProgram.h"
+#include "Engine/Scene/Animation/AnimatorControllerTypes.h"
+#include <atomic>
+
+namespace Arche
+{
+	namespace
+	{
+		// 比較モードとパラメータ型から命令を決める
+		AnimatorOp SelectOp(AnimatorConditionMode mode, AnimatorParameterType type)
+		{
+			bool isFloat = (type == AnimatorParameterType::Float);
+			switch (mode)
+			{
+			case AnimatorConditionMode::If:			return AnimatorOp::If;
+			case AnimatorConditionMode::IfNot:		return AnimatorOp::IfNot;
+			case AnimatorConditionMode::Greater:	return isFloat ? AnimatorOp::GreaterF : AnimatorOp::GreaterI;
+			case AnimatorConditionMode::Less:		return isFloat ? AnimatorOp::LessF : AnimatorOp::LessI;
+			case AnimatorConditionMode::Equals:		return isFloat ? AnimatorOp::EqualsF : AnimatorOp::EqualsI;
+			case AnimatorConditionMode::NotEqual:	return isFloat ? AnimatorOp::NotEqualF : AnimatorOp::NotEqualI;
+			default:								return AnimatorOp::If;
+			}
+		}
+
+		// 未定義パラメータを参照する条件の型を、比較モードから推測する
+		AnimatorParameterType GuessType(AnimatorConditionMode mode)
+		{
+			switch (mode)
+			{
+			case AnimatorConditionMode::Greater:
+			case AnimatorConditionMode::Less:		return AnimatorParameterType::Float;
+			case AnimatorConditionMode::Equals:
+			case AnimatorConditionMode::NotEqual:	return AnimatorParameterType::Int;
+			default:								return AnimatorParameterType::Bool;
+			}
+		}
+
+		inline bool Execute(const AnimatorInstruction& inst, const AnimatorValue& v)
+		{
+			switch (inst.op)
+			{
+			case AnimatorOp::If:		return v.i != 0;
+			case AnimatorOp::IfNot:		return v.i == 0;
+			case AnimatorOp::GreaterF:	return v.f > inst.threshold;
+			case AnimatorOp::LessF:		return v.f < inst.threshold;
+			case AnimatorOp::GreaterI:	return (float)v.i > inst.threshold;
+			case AnimatorOp::LessI:		return (float)v.i < inst.threshold;
+			case AnimatorOp::EqualsI:	return v.i == (int)inst.threshold;
+			case AnimatorOp::NotEqualI:	return v.i != (int)inst.threshold;
+			case AnimatorOp::EqualsF:	return (int)v.f == (int)inst.threshold;
+			case AnimatorOp::NotEqualF:	return (int)v.f != (int)inst.threshold;
+			default:					return false;
+			}
+		}
+	}
+
+	void AnimatorProgram::Build(const AnimatorController& controller)
+	{
+		static std::atomic<uint32_t> s_revisionCounter{ 0 };
+
+		*this = AnimatorProgram();
+		m_revision = ++s_revisionCounter;
+
+		// 1. パラメータ → スロット
+		for (const auto& param : controller.parameters)
+		{
+			if (m_parameterSlots.count(StringId(param.name).GetHash())) continue;
+
+			AnimatorValue value = {};
+			if (param.type == AnimatorParameterType::Float) value.f = param.defaultFloat;
+			else if (param.type == AnimatorParameterType::Int) value.i = param.defaultInt;
+			else if (param.type == AnimatorParameterType::Bool) value.i = param.defaultBool ? 1 : 0;
+
+			m_parameterSlots[StringId(param.name).GetHash()] = (int)m_defaults.size();
+			m_defaults.push_back(value);
+			m_types.push_back(param.type);
+		}
+
+		// 2. ステート → インデックス
+		for (size_t i = 0; i < controller.states.size(); ++i)
+		{
+			m_stateIndices.emplace(controller.states[i].name.GetHash(), (int)i);
+		}
+
+		if (controller.entryState.GetHash() != 0) m_entryState = FindState(controller.entryState);
+		if (m_entryState == INVALID_INDEX && !controller.states.empty()) m_entryState = 0;
+
+		// 3. 遷移と条件を命令列へ
+		m_states.resize(controller.states.size());
+		for (size_t s = 0; s < controller.states.size(); ++s)
+		{
+			m_states[s].firstTransition = (uint32_t)m_transitions.size();
+
+			for (const auto& trans : controller.states[s].transitions)
+			{
+				// 遷移先が存在しない遷移は成立しても何も起きないので捨てる
+				int target = FindState(trans.targetState);
+				if (target == INVALID_INDEX) continue;
+
+				AnimatorCompiledTransition compiled = {};
+				compiled.targetState = target;
+				compiled.hasExitTime = trans.hasExitTime;
+				compiled.exitTime = trans.exitTime;
+				compiled.duration = trans.duration;
+				compiled.firstInstruction = (uint32_t)m_code.size();
+
+				for (const auto& cond : trans.conditions)
+				{
+					int slot = FindParameter(cond.parameter);
+					if (slot == INVALID_INDEX) slot = AddImplicitParameter(cond.parameter, GuessType(cond.mode));
+
+					AnimatorInstruction inst = {};
+					inst.op = SelectOp(cond.mode, m_types[slot]);
+					inst.isTrigger = (m_types[slot] == AnimatorParameterType::Trigger) ? 1 : 0;
+					inst.slot = (uint16_t)slot;
+					inst.threshold = cond.threshold;
+					m_code.push_back(inst);
+				}
+
+				compiled.instructionCount = (uint32_t)m_code.size() - compiled.firstInstruction;
+				m_transitions.push_back(compiled);
+			}
+
+			m_states[s].transitionCount = (uint32_t)m_transitions.size() - m_states[s].firstTransition;
+		}
+	}
+
+	int AnimatorProgram::FindParameter(const std::string& name) const
+	{
+		auto it = m_parameterSlots.find(StringId(name).GetHash());
+		return (it != m_parameterSlots.end()) ? it->second : INVALID_INDEX;
+	}
+
+	int AnimatorProgram::FindState(const StringId& name) const
+	{
+		auto it = m_stateIndices.find(name.GetHash());
+		return (it != m_stateIndices.end()) ? it->second : INVALID_INDEX;
+	}
+
+	int AnimatorProgram::EvaluateTransitions(int stateIndex, AnimatorValue* params, float normalizedTime) const
+	{
+		if (stateIndex < 0 || stateIndex >= (int)m_states.size()) return INVALID_INDEX;
+
+		const auto& state = m_states[stateIndex];
+		for (uint32_t t = 0; t < state.transitionCount; ++t)
+		{
+			const auto& trans = m_transitions[state.firstTransition + t];
+
+			// 指定時間に達していないなら遷移しない
+			if (trans.hasExitTime && normalizedTime < trans.exitTime) continue;
+
+			const AnimatorInstruction* code = m_code.data() + trans.firstInstruction;
+			bool passed = true;
+			for (uint32_t c = 0; c < trans.instructionCount && passed; ++c)
+			{
+				passed = Execute(code[c], params[code[c].slot]);
+			}
+			if (!passed) continue;
+
+			// トリガー消費
+			for (uint32_t c = 0; c < trans.instructionCount; ++c)
+			{
+				if (code[c].isTrigger) params[code[c].slot].i = 0;
+			}
+			return (int)(state.firstTransition + t);
+		}
+		return INVALID_INDEX;
+	}
+
+	int AnimatorProgram::AddImplicitParameter(const std::string& name, AnimatorParameterType type)
+	{
+		int slot = (int)m_defaults.size();
+		m_parameterSlots[StringId(name).GetHash()] = slot;
+		m_defaults.push_back(AnimatorValue{});
+		m_types.push_back(type);
+		return slot;
+	}
+
+}	// namespace Arche
@@ -0,0 +1,131 @@
+﻿/*****************************************************************//**
+ * @file	AnimatorProgram.h
+ * @brief	ロード時にコンパイルされたアニメーターコントローラー
+ *
+ * @details	文字列で記述されたコントローラーを実行用の形式に変換する。
+ *			- パラメータ	: 名前 → 連番スロット（Animatorは値の配列だけ持つ）
+ *			- ステート		: 名前 → インデックス
+ *			- 遷移条件		: スロット番号と比較命令を並べたフラットな命令列
+ *			実行時は文字列比較・mapの検索を一切行わない。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___ANIMATOR_PROGRAM_H___
+#define ___ANIMATOR_PROGRAM_H___
+
+// ===== インクルード =====
+// 標準ライブラリだけで書く（pch.h を含めず、Tests/ からも使えるように）
+#include "Engine/Core/Base/StringId.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Arche
+{
+	struct AnimatorController;
+	enum class AnimatorParameterType;
+
+	// パラメータ値（型はスロット側で管理する）
+	union AnimatorValue
+	{
+		float f;
+		int32_t i;	// Int / Bool / Trigger (0 or 1)
+	};
+
+	// 条件命令（比較する型はコンパイル時に確定させる）
+	enum class AnimatorOp : uint8_t
+	{
+		If,			// i != 0
+		IfNot,		// i == 0
+		GreaterF,	// f > threshold
+		LessF,		// f < threshold
+		GreaterI,	// i > threshold
+		LessI,		// i < threshold
+		EqualsI,	// i == (int)threshold
+		NotEqualI,	// i != (int)threshold
+		EqualsF,	// (int)f == (int)threshold
+		NotEqualF,	// (int)f != (int)threshold
+	};
+
+	struct AnimatorInstruction
+	{
+		AnimatorOp op;
+		uint8_t isTrigger;	// 遷移成立時に0へ戻すか
+		uint16_t slot;
+		float threshold;
+	};
+
+	struct AnimatorCompiledTransition
+	{
+		int targetState;
+		bool hasExitTime;
+		float exitTime;
+		float duration;
+		uint32_t firstInstruction;
+		uint32_t instructionCount;
+	};
+
+	struct AnimatorCompiledState
+	{
+		uint32_t firstTransition;
+		uint32_t transitionCount;
+	};
+
+	/**
+	 * @class	AnimatorProgram
+	 * @brief	コントローラー1つ分の実行用データ（全Animatorで共有）
+	 */
+	class AnimatorProgram
+	{
+	public:
+		static constexpr int INVALID_INDEX = -1;
+
+		// コントローラーからコンパイル
+		void Build(const AnimatorController& controller);
+
+		// 名前解決（ロード時やスクリプトからの設定時のみ使う）
+		int FindParameter(const std::string& name) const;
+		int FindState(const StringId& name) const;
+
+		// Build のたびに変わる番号（ホットリロード検出用）
+		uint32_t GetRevision() const { return m_revision; }
+		int GetEntryState() const { return m_entryState; }
+		size_t GetParameterCount() const { return m_defaults.size(); }
+		size_t GetStateCount() const { return m_states.size(); }
+		AnimatorParameterType GetParameterType(int slot) const { return m_types[slot]; }
+		const AnimatorCompiledTransition& GetTransition(int index) const { return m_transitions[index]; }
+
+		// パラメータ配列を既定値で初期化
+		void InitParameters(std::vector<AnimatorValue>& outParams) const { outParams = m_defaults; }
+
+		/**
+		 * @brief	現在ステートの遷移を評価
+		 * @param	normalizedTime	現在モーションの正規化時間（長さ0なら十分大きい値）
+		 * @return	成立した遷移のインデックス（なければ INVALID_INDEX）。成立時はトリガーを消費する
+		 */
+		int EvaluateTransitions(int stateIndex, AnimatorValue* params, float normalizedTime) const;
+
+	private:
+		int AddImplicitParameter(const std::string& name, AnimatorParameterType type);
+
+	private:
+		std::vector<AnimatorValue> m_defaults;
+		std::vector<AnimatorParameterType> m_types;
+		std::unordered_map<StringId::ValueType, int> m_parameterSlots;
+		std::unordered_map<StringId::ValueType, int> m_stateIndices;
+
+		std::vector<AnimatorCompiledState> m_states;
+		std::vector<AnimatorCompiledTransition> m_transitions;
+		std::vector<AnimatorInstruction> m_code;
+
+		int m_entryState = INVALID_INDEX;
+		uint32_t m_revision = 0;
+	};
+
+}	// namespace Arche
+
+#endif // !___ANIMATOR_PROGRAM_H___
@@ -19,7 +19,10 @@
 #include "Engine/Config.h"
 #include "Engine/Scene/Serializer/ComponentRegistry.h"
 #include "Engine/Scene/Animation/AnimatorController.h"
+#include "Engine/Scene/Animation/AnimationLod.h"
 #include "Engine/Renderer/Data/Model.h"
+#include "Engine/Resource/ResourceHandle.h"
+#include "Engine/Renderer/Data/SkinningPalette.h"
 
 namespace Arche
 {
@@ -501,7 +504,8 @@ namespace Arche
 		XMFLOAT3 scaleOffset;	// モデル固有のスケール補正（アセットが巨大/極小な場合用）
 		XMFLOAT4 color;			// マテリアルカラー乗算用
 
-		std::shared_ptr<Model> pModel = nullptr;
+		// 参照カウント付き（持っている間はメモリ予算を超えても追い出されない）
+		ResourceHandle<Model> pModel = nullptr;
 
 		std::string loadedKey = "";
 
@@ -621,13 +625,25 @@ namespace Arche
 		float fov;			// 視野角（Radian）
 		float nearZ, farZ;	// 視錐台の範囲
 		float aspect;		// アスペクト比
+		bool isMain = false;	// メインカメラ（複数あるときは描画・アニメーションLODの基準になる）
 
 		// コンストラクタ
 		Camera(float f = XM_PIDIV4, float n = 0.1f, float r = 1000.0f, float a = static_cast<float>(Config::SCREEN_WIDTH) / static_cast<float>(Config::SCREEN_HEIGHT))
 			: fov(f), nearZ(n), farZ(r), aspect(a) {
 		}
+
+		// 有効なカメラのうち isMain のもの（無ければ最初に見つかったもの）。無ければ NullEntity
+		static Entity FindMain(Registry& registry)
+		{
+			Entity found = NullEntity;
+			registry.view<Camera, Transform>().each([&](Entity e, Camera& cam, Transform&)
+				{
+					if (found == NullEntity || (cam.isMain && !registry.get<Camera>(found).isMain)) found = e;
+				});
+			return found;
+		}
 	};
-	ARCHE_COMPONENT(Camera, REFLECT_VAR(fov) REFLECT_VAR(nearZ) REFLECT_VAR(farZ) REFLECT_VAR(aspect))
+	ARCHE_COMPONENT(Camera, REFLECT_VAR(fov) REFLECT_VAR(nearZ) REFLECT_VAR(farZ) REFLECT_VAR(aspect) REFLECT_VAR(isMain))
 
 	// ============================================================
 	// 2D / UI関連
@@ -747,28 +763,101 @@ namespace Arche
 
 		// ランタイム状態
 		StringId currentState;
+		int currentStateIndex = AnimatorProgram::INVALID_INDEX;
 		float stateTime = 0.0f;	// 現在のステートの経過時間
 
-		// パラメータの現在値
-		std::map<std::string, float> floats;
-		std::map<std::string, int> ints;
-		std::map<std::string, bool> bools;
-		std::map<std::string, bool> triggers;	// Triggerは一度消費されると false に戻る
+		// パラメータの現在値（AnimatorProgram のスロット順。Triggerは一度消費されると 0 に戻る）
+		std::vector<AnimatorValue> params;
+		const AnimatorProgram* boundProgram = nullptr;
+		uint32_t boundRevision = 0;
+
+		// コントローラー読み込み前に設定された値（バインド時に反映）
+		std::vector<std::pair<std::string, AnimatorValue>> pendingParams;
 
 		bool isPlaying = true;
 
+		// --- アニメーションLOD（カメラ距離で更新頻度を落とす） ---
+		bool useLod = true;
+		float lodHalfDistance = 15.0f;		// これより遠いと midInterval ごとに更新
+		float lodLowDistance = 30.0f;		// これより遠いと farInterval ごとに更新
+		float lodUpperBodyDistance = 60.0f;	// これより遠いと上半身のみ評価
+		int lodMidInterval = 2;
+		int lodFarInterval = 4;
+		std::string lodUpperBodyBone = "Spine";	// 上半身のルートとなるボーン名
+
+		// LODランタイム状態
+		AnimationLodLevel lodLevel = AnimationLodLevel::Full;
+		float lodPendingTime = 0.0f;			// 間引いた分の経過時間（次の更新でまとめて進める）
+		std::vector<uint8_t> lodUpperBodyMask;	// 上半身マスク（空なら全身）
+		const Model* lodMaskSource = nullptr;	// マスク作成元のモデル
+		uint32_t lodMaskBoneHash = 0;			// マスク作成時の lodUpperBodyBone（インスペクターで変えたら作り直す）
+
+		// 最終スキニング行列（AnimationSystemが毎フレーム更新し、描画側はそのまま使う）
+		SkinningPalette palette;
+
 		Animator() = default;
 
-		void SetFloat(const std::string& name, float value) { floats[name] = value; }
-		void SetInt(const std::string& name, int value) { ints[name] = value; }
-		void SetBool(const std::string& name, bool value) { bools[name] = value; }
-		void SetTrigger(const std::string& name) { triggers[name] = true; }
+		// コンパイル済みコントローラーに合わせてパラメータ配列を用意する
+		void Bind(const AnimatorProgram& program)
+		{
+			program.InitParameters(params);
+			boundProgram = &program;
+			boundRevision = program.GetRevision();
+			currentStateIndex = AnimatorProgram::INVALID_INDEX;
+
+			for (const auto& [name, value] : pendingParams)
+			{
+				int slot = program.FindParameter(name);
+				if (slot != AnimatorProgram::INVALID_INDEX) params[slot] = value;
+			}
+			pendingParams.clear();
+		}
 
-		float GetFloat(const std::string& name) { return floats[name]; }
-		int GetInt(const std::string& name) { return ints[name]; }
-		bool GetBool(const std::string& name) { return bools[name]; }
+		// 名前からスロット番号を取得（毎フレーム設定する場合はこれをキャッシュして使う）
+		int GetParameterSlot(const std::string& name) const
+		{
+			return boundProgram ? boundProgram->FindParameter(name) : AnimatorProgram::INVALID_INDEX;
+		}
+
+		void SetFloat(int slot, float value) { if (IsValidSlot(slot)) params[slot].f = value; }
+		void SetInt(int slot, int value) { if (IsValidSlot(slot)) params[slot].i = value; }
+		void SetBool(int slot, bool value) { if (IsValidSlot(slot)) params[slot].i = value ? 1 : 0; }
+		void SetTrigger(int slot) { if (IsValidSlot(slot)) params[slot].i = 1; }
+
+		float GetFloat(int slot) const { return IsValidSlot(slot) ? params[slot].f : 0.0f; }
+		int GetInt(int slot) const { return IsValidSlot(slot) ? params[slot].i : 0; }
+		bool GetBool(int slot) const { return IsValidSlot(slot) ? params[slot].i != 0 : false; }
+
+		void SetFloat(const std::string& name, float value) { AnimatorValue v; v.f = value; SetValue(name, v); }
+		void SetInt(const std::string& name, int value) { AnimatorValue v; v.i = value; SetValue(name, v); }
+		void SetBool(const std::string& name, bool value) { AnimatorValue v; v.i = value ? 1 : 0; SetValue(name, v); }
+		void SetTrigger(const std::string& name) { AnimatorValue v; v.i = 1; SetValue(name, v); }
+
+		float GetFloat(const std::string& name) const { return GetFloat(GetParameterSlot(name)); }
+		int GetInt(const std::string& name) const { return GetInt(GetParameterSlot(name)); }
+		bool GetBool(const std::string& name) const { return GetBool(GetParameterSlot(name)); }
+
+	private:
+		bool IsValidSlot(int slot) const { return slot >= 0 && slot < (int)params.size(); }
+
+		void SetValue(const std::string& name, const AnimatorValue& value)
+		{
+			if (!boundProgram)
+			{
+				for (auto& [pendingName, pendingValue] : pendingParams)
+				{
+					if (pendingName == name) { pendingValue = value; return; }
+				}
+				pendingParams.emplace_back(name, value);
+				return;
+			}
+			int slot = boundProgram->FindParameter(name);
+			if (IsValidSlot(slot)) params[slot] = value;
+		}
 	};
-	ARCHE_COMPONENT(Animator, REFLECT_VAR(controllerPath) REFLECT_VAR(currentState) REFLECT_VAR(isPlaying))
+	ARCHE_COMPONENT(Animator, REFLECT_VAR(controllerPath) REFLECT_VAR(currentState) REFLECT_VAR(isPlaying)
+		REFLECT_VAR(useLod) REFLECT_VAR(lodHalfDistance) REFLECT_VAR(lodLowDistance) REFLECT_VAR(lodUpperBodyDistance)
+		REFLECT_VAR(lodMidInterval) REFLECT_VAR(lodFarInterval) REFLECT_VAR(lodUpperBodyBone))
 
 	/**
 	 * @struct	PointLight
@@ -179,6 +179,16 @@ namespace Arche
 			return data.back();
 		}
 
+		// まとめて追加する前に確保しておく（シーン読み込みなど）
+		void reserve(std::size_t count)
+		{
+			dense.reserve(count);
+			data.reserve(count);
+			enabled.reserve(count);
+		}
+
+		std::size_t capacity() const { return data.capacity(); }
+
 		// コンポーネントの取得
 		T& get(Entity entity)
 		{
@@ -337,6 +347,34 @@ namespace Arche
 			return id;
 		}
 
+		// まとめて作成（プレファブの一括生成など）
+		void create(std::size_t count, std::vector<Entity>& outEntities)
+		{
+			outEntities.reserve(outEntities.size() + count);
+
+			// 空きIDを先に使い、残りは連番で確保する
+			std::size_t reused = std::min(count, freeIds.size());
+			for (std::size_t i = 0; i < reused; ++i)
+			{
+				Entity id = freeIds.back();
+				freeIds.pop_back();
+				outEntities.push_back(id);
+			}
+			for (std::size_t i = reused; i < count; ++i)
+			{
+				outEntities.push_back(nextEntity++);
+			}
+
+			if (entityActiveStates.size() < nextEntity)
+			{
+				entityActiveStates.resize(nextEntity, true);
+			}
+			for (std::size_t i = outEntities.size() - count; i < outEntities.size(); ++i)
+			{
+				entityActiveStates[outEntities[i]] = true;
+			}
+		}
+
 		// EntityのActive操作
 		void setActive(Entity entity, bool active)
 		{
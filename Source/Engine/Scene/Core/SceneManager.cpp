@@ -13,6 +13,11 @@
 #include "Engine/pch.h"
 #include "Engine/Scene/Core/SceneManager.h"
 #include "Engine/Scene/Serializer/SceneSerializer.h"
+#include "Engine/Scene/Serializer/SceneManifest.h"
+#include "Engine/Scene/Serializer/SceneBinary.h"
+#include "Engine/Scene/Serializer/SceneSaver.h"
+#include "Engine/Scene/Serializer/SceneStreamLoader.h"
+#include "Engine/Resource/VirtualFileSystem.h"
 #include "Engine/Scene/Serializer/SystemRegistry.h"
 #include "Engine/Resource/ResourceManager.h"
 #include "Engine/Core/Time/Time.h"
@@ -57,6 +62,14 @@ namespace Arche
 		// 遷移エフェクト更新
 		if (m_transition)
 		{
+			// マニフェストが無かったシーンは、ワーカーで読んでいるシーンが揃った時点でアセットを集めて要求する
+			if (m_isAsyncLoading && !m_assetsRequested && PollSceneDocument())
+			{
+				if (m_loadedDocument.binary) RequestAssets(SceneManifest::Collect(m_loadedDocument.binary->ToJson()));
+				else if (m_loadedDocument.streamed) RequestAssets(SceneManifest::Collect(m_loadedDocument.streamed->ToJson()));
+				else RequestAssets(SceneManifest::Collect(m_loadedDocument.root));
+			}
+
 			// フェード更新。trueが帰ってきたらそのフェーズ完了
 			if (m_transition->Update(dt))
 			{
@@ -67,21 +80,10 @@ namespace Arche
 				{
 					if (m_isAsyncLoading)
 					{
-						// --- 非同期ロード開始 ---
+						// --- 非同期ロード待ち ---
+						// 読み込み自体は LoadSceneAsync の時点で始まっている（フェードアウトと並行）
 						m_transition->SetPhase(ISceneTransition::Phase::WaitAsync);
 						m_transition->ResetTimer();
-
-						// A. シーンファイルから必要なアセットを自動収集
-						std::vector<std::string> models, textures, sounds;
-						SceneSerializer::CollectAssets(m_nextScenePath, models, textures, sounds);
-
-						// B. ResourceManagerに一括リクエスト
-						auto& rm = ResourceManager::Instance();
-						for (const auto& path : models)	  rm.LoadModelAsync(path);
-						for (const auto& path : textures) rm.LoadTextureAsync(path);
-						for (const auto& path : sounds)	  rm.LoadSoundAsync(path);
-
-						Logger::Log("Async Load Requested for: " + m_nextScenePath);
 					}
 					else
 					{
@@ -106,11 +108,11 @@ namespace Arche
 					m_currentAsyncOp->progress = rm.GetProgress();
 				}
 
-				// ロード完了チェック
-				if (!rm.IsLoading())
+				// ロード完了チェック（アセットとシーンJSONの両方）
+				if (m_assetsRequested && !rm.IsLoading() && PollSceneDocument())
 				{
-					// ロードが終わったので、実際にシーンを構築（リソースはキャッシュにあるので一瞬）
-					PerformLoad(m_nextScenePath);
+					// ロードが終わったので、読み込み済みのJSONから実際にシーンを構築（リソースはキャッシュにあるので一瞬）
+					PerformLoad(m_nextScenePath, m_loadedDocument);
 
 					if (m_currentAsyncOp)
 					{
@@ -129,6 +131,13 @@ namespace Arche
 			// 3. 終了判定
 			if (m_transition->GetPhase() == ISceneTransition::Phase::Finished)
 			{
+				// フェードイン中の描画でコンポーネントが参照を持ったので、ロード用のピンを外す
+				PinAssets(m_loadingAssets, false);
+				m_loadingAssets = {};
+				m_assetsRequested = false;
+				m_loadedDocument = SceneDocument{};
+				m_documentReady = false;
+
 				m_transition = nullptr;
 				m_isAsyncLoading = false;
 				m_currentAsyncOp = nullptr;
@@ -224,18 +233,165 @@ namespace Arche
 		m_transition->Start();
 		Logger::Log("Transition Started (Async): " + filepath);
 
+		// フェードアウトを待たずに読み込みを始める
+		BeginAsyncLoad(filepath);
+
 		return m_currentAsyncOp;
 	}
 
+	void SceneManager::PinSceneAssets(const std::string& scenePath)
+	{
+		SceneAssets assets = CollectSceneAssets(scenePath);
+		PinAssets(assets, true);
+		m_pinnedScenes[scenePath].push_back(std::move(assets));
+	}
+
+	void SceneManager::UnpinSceneAssets(const std::string& scenePath)
+	{
+		auto it = m_pinnedScenes.find(scenePath);
+		if (it == m_pinnedScenes.end() || it->second.empty()) return;
+
+		PinAssets(it->second.back(), false);
+		it->second.pop_back();
+		if (it->second.empty()) m_pinnedScenes.erase(it);
+	}
+
+	SceneManager::SceneAssets SceneManager::CollectSceneAssets(const std::string& scenePath)
+	{
+		// マニフェストがあればシーン本体は開かない
+		SceneManifest manifest;
+		if (!SceneManifest::Load(scenePath, manifest))
+		{
+			json sceneJson;
+			if (!SceneSerializer::ReadDocument(scenePath, sceneJson)) return {};
+			manifest = SceneManifest::Collect(sceneJson);
+		}
+		return ToSceneAssets(manifest);
+	}
+
+	SceneManager::SceneAssets SceneManager::ToSceneAssets(const SceneManifest& manifest)
+	{
+		SceneAssets assets;
+		manifest.GetKeys(SceneManifest::AssetType::Model, assets.models);
+		manifest.GetKeys(SceneManifest::AssetType::Texture, assets.textures);
+		manifest.GetKeys(SceneManifest::AssetType::Sound, assets.sounds);
+		return assets;
+	}
+
+	void SceneManager::BeginAsyncLoad(const std::string& path)
+	{
+		m_assetsRequested = false;
+		m_loadedDocument = SceneDocument{};
+		m_documentReady = false;
+
+		// ファイルはここで開き（マップするだけ）、パースはワーカーで行って構築時にそのまま使う
+		auto file = std::make_shared<FileView>();
+		SceneSerializer::DocumentFormat format = SceneSerializer::DocumentFormat::Json;
+		if (!SceneSerializer::OpenDocument(path, *file, format))
+		{
+			std::promise<SceneDocument> failed;
+			failed.set_value(SceneDocument{});
+			m_documentTask = failed.get_future();
+		}
+		else
+		{
+			// ワーカーで作業用のレジストリへ復元するので、型IDはここで確定させておく
+			SceneStreamLoader::Prepare();
+			m_documentTask = std::async(std::launch::async, [path, file, format]() {
+				SceneDocument document;
+				SceneSerializer::ParseScene(path, *file, format, document);
+				return document;
+				});
+		}
+
+		// マニフェストがあればそれだけで先読みを始める（無ければ JSON が揃ってから）
+		SceneManifest manifest;
+		if (SceneManifest::Load(path, manifest)) RequestAssets(manifest);
+	}
+
+	void SceneManager::RequestAssets(const SceneManifest& manifest)
+	{
+		// 大きいものから要求して、時間のかかる読み込みを先に始める
+		std::vector<const SceneManifest::Asset*> order;
+		order.reserve(manifest.assets.size());
+		for (const auto& asset : manifest.assets) order.push_back(&asset);
+		std::stable_sort(order.begin(), order.end(), [](const SceneManifest::Asset* a, const SceneManifest::Asset* b) { return a->size > b->size; });
+
+		auto& rm = ResourceManager::Instance();
+		for (const SceneManifest::Asset* asset : order)
+		{
+			switch (asset->type)
+			{
+			case SceneManifest::AssetType::Model:		rm.LoadModelAsync(asset->key); break;
+			case SceneManifest::AssetType::Texture:		rm.LoadTextureAsync(asset->key); break;
+			case SceneManifest::AssetType::Sound:		rm.LoadSoundAsync(asset->key); break;
+			case SceneManifest::AssetType::Controller:	rm.LoadAnimatorControllerAsync(asset->key); break;
+			}
+		}
+
+		// 読み込んだものがシーン構築前に追い出されないよう、遷移が終わるまで留めておく
+		m_loadingAssets = ToSceneAssets(manifest);
+		PinAssets(m_loadingAssets, true);
+		m_assetsRequested = true;
+
+		Logger::Log("Async Load Requested for: " + m_nextScenePath + " (" + std::to_string(manifest.assets.size()) + " assets)");
+	}
+
+	bool SceneManager::PollSceneDocument()
+	{
+		if (m_documentReady) return true;
+		if (!m_documentTask.valid() || m_documentTask.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return false;
+
+		m_loadedDocument = m_documentTask.get();
+		m_documentReady = true;
+		return true;
+	}
+
+	void SceneManager::PinAssets(const SceneAssets& assets, bool pin)
+	{
+		auto& rm = ResourceManager::Instance();
+		auto Apply = [&](ResourceCategory category, const std::vector<std::string>& keys) {
+			for (const auto& key : keys)
+			{
+				if (pin) rm.Pin(category, key);
+				else rm.Unpin(category, key);
+			}
+			};
+		Apply(ResourceCategory::Model, assets.models);
+		Apply(ResourceCategory::Texture, assets.textures);
+		Apply(ResourceCategory::Sound, assets.sounds);
+	}
+
 	// 同期ロード用ヘルパー
 	void SceneManager::PerformLoad(const std::string& path)
 	{
 		m_world.clearSystems();
 		m_world.clearEntities();
 
+		SceneSerializer::LoadScene(m_world, path);
+
+		m_currentScenePath = path;
+		m_isDirty = false;
+
+		Logger::Log("Scene Loaded: " + m_currentScenePath);
+	}
+
+	void SceneManager::RestoreScene(const std::string& filepath, const SceneDocument& document, bool isDirty)
+	{
+		PerformLoad(filepath, document);
+		m_isDirty = isDirty;
+	}
+
+	// 非同期ロード用（シーンはワーカーで読み込み済み）
+	void SceneManager::PerformLoad(const std::string& path, const SceneDocument& document)
+	{
+		m_world.clearSystems();
+		m_world.clearEntities();
+
 		// ここで呼び出すLoadSceneは、内部でResourceManager::GetModelなどを呼ぶが、
 		// 既にAsyncLoadでキャッシュに乗っているため、ディスク読み込みは発生しない（高速）
-		SceneSerializer::LoadScene(m_world, path);
+		if (!document.valid) Logger::LogError("Failed to load scene: " + path);
+		else SceneSerializer::LoadScene(m_world, document, path);
 
 		m_currentScenePath = path;
 		m_isDirty = false;
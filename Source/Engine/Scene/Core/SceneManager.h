@@ -16,9 +16,12 @@
 #include "Engine/pch.h"
 #include "Engine/Scene/Core/ECS/ECS.h"
 #include "Engine/Scene/Core/SceneTransition.h"
+#include "Engine/Scene/Serializer/SceneSerializer.h"
 
 namespace Arche
 {
+	class SceneManifest;
+
 	struct AsyncOperation
 	{
 		bool isDone = false;
@@ -53,9 +56,17 @@ namespace Arche
 		// 2. 非同期ロード（推奨）
 		std::shared_ptr<AsyncOperation> LoadSceneAsync(const std::string& filepath, ISceneTransition* transition = nullptr);
 
+		// 3. 読み込み済みのシーンから作り直す（ホットリロードの復帰用。遷移もアセットの先読みもしない）
+		void RestoreScene(const std::string& filepath, const SceneDocument& document, bool isDirty);
+
 		// シーン管理用追加
 		const std::string& GetCurrentScenePath() const { return m_currentScenePath; }
 
+		// 近いうちに戻ってくるシーンのアセットをメモリ予算による追い出しから守る
+		// （例: ステージ → リザルト → ステージ）。Pin した回数だけ Unpin で外れる
+		void PinSceneAssets(const std::string& scenePath);
+		void UnpinSceneAssets(const std::string& scenePath);
+
 		// 変更があるかどうか
 		bool IsDirty() const { return m_isDirty; }
 		void SetDirty(bool dirty) { m_isDirty = dirty; }
@@ -69,6 +80,21 @@ namespace Arche
 	private:
 		// 内部処理
 		void PerformLoad(const std::string& path);
+		void PerformLoad(const std::string& path, const SceneDocument& document);
+
+		struct SceneAssets
+		{
+			std::vector<std::string> models, textures, sounds;
+		};
+		static SceneAssets CollectSceneAssets(const std::string& scenePath);
+		static SceneAssets ToSceneAssets(const SceneManifest& manifest);
+		static void PinAssets(const SceneAssets& assets, bool pin);
+
+		// 非同期ロード: シーンJSONの読み込みとアセットの先読みを始める
+		void BeginAsyncLoad(const std::string& path);
+		void RequestAssets(const SceneManifest& manifest);
+		// 読み込み中のシーンJSONが揃っていれば true
+		bool PollSceneDocument();
 
 	private:
 		static SceneManager* s_instance;
@@ -86,6 +112,16 @@ namespace Arche
 		// 非同期ロード管理
 		bool m_isAsyncLoading = false;
 		std::shared_ptr<AsyncOperation> m_currentAsyncOp;
+		// 非同期ロードで読んだアセット（シーンが参照を持つまでの間、追い出されないようにする）
+		SceneAssets m_loadingAssets;
+		bool m_assetsRequested = false;
+		// ワーカーで読んでいるシーン（揃ったら m_loadedDocument に移し、構築にそのまま使う）
+		std::future<SceneDocument> m_documentTask;
+		SceneDocument m_loadedDocument;
+		bool m_documentReady = false;
+
+		// PinSceneAssets で留めたアセット（Unpin 時にファイルが変わっていても同じものを外せるよう保持）
+		std::unordered_map<std::string, std::vector<SceneAssets>> m_pinnedScenes;
 	};
 
 }	// namespace Arche
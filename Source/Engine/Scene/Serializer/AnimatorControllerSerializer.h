@@ -15,6 +15,7 @@
 // ===== インクルード =====
 #include "Engine/pch.h"
 #include "Engine/Scene/Animation/AnimatorController.h"
+#include "Engine/Resource/VirtualFileSystem.h"
 
 namespace Arche
 {
@@ -90,12 +91,11 @@ namespace Arche
 
 		static std::shared_ptr<AnimatorController> Deserialize(const std::string& filepath)
 		{
-			std::ifstream fin(filepath);
-			if (!fin.is_open()) return nullptr;
+			std::string text;
+			if (!VirtualFileSystem::Instance().ReadText(filepath, text)) return nullptr;
 
-			nlohmann::json root;
-			fin >> root;
-			fin.close();
+			nlohmann::json root = nlohmann::json::parse(text, nullptr, false);
+			if (root.is_discarded()) return nullptr;
 
 			auto controller = std::make_shared<AnimatorController>();
 
@@ -163,6 +163,9 @@ namespace Arche
 				}
 			}
 
+			// 実行用データへ変換
+			controller->Compile();
+
 			return controller;
 		}
 	};
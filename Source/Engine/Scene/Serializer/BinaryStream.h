@@ -0,0 +1,245 @@
+﻿/*****************************************************************//**
+ * @file	BinaryStream.h
+ * @brief	リフレクション情報 (REFLECT_VAR) を使ったバイナリの読み書き
+ *
+ * @details	SerializeVisitor / DeserializeVisitor の JSON 版と同じ型を扱う。
+ *			文字列は本体に書かず、BinaryStringTable の番号だけを書く。
+ *			読み込みは範囲チェック付きで、はみ出したら IsFailed() が true になる。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___BINARY_STREAM_H___
+#define ___BINARY_STREAM_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Scene/Core/ECS/ECS.h"
+#include "Engine/Core/Base/StringId.h"
+#include "Engine/Core/Base/Reflection.h"
+#include <string_view>
+
+namespace Arche
+{
+	// フィールドの型（スキーマの照合に使う。リフレクションのフィールド表と同じ値）
+	using BinaryFieldType = Reflection::FieldType;
+
+	struct BinaryField
+	{
+		std::string name;
+		BinaryFieldType type;
+
+		bool operator==(const BinaryField& other) const { return type == other.type && name == other.name; }
+	};
+
+	// 書き出し側の文字列表（同じ文字列は1つにまとめる）
+	class BinaryStringTable
+	{
+	public:
+		uint32_t Add(const std::string& str)
+		{
+			auto it = m_index.find(str);
+			if (it != m_index.end()) return it->second;
+
+			uint32_t index = (uint32_t)m_strings.size();
+			m_strings.push_back(str);
+			m_index.emplace(str, index);
+			return index;
+		}
+
+		const std::vector<std::string>& GetStrings() const { return m_strings; }
+
+	private:
+		std::vector<std::string> m_strings;
+		std::unordered_map<std::string, uint32_t> m_index;
+	};
+
+	class BinaryWriter
+	{
+	public:
+		explicit BinaryWriter(BinaryStringTable& strings) : m_strings(strings) {}
+
+		void WriteBytes(const void* data, size_t size)
+		{
+			const uint8_t* bytes = static_cast<const uint8_t*>(data);
+			m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+		}
+
+		template<typename T>
+		void WritePod(const T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			WriteBytes(&value, sizeof(T));
+		}
+
+		void WriteString(const std::string& str) { WritePod(m_strings.Add(str)); }
+
+		template<typename T>
+		void WriteValue(const T& value)
+		{
+			if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) WritePod(value);
+			else if constexpr (std::is_same_v<T, std::string>) WriteString(value);
+			else if constexpr (std::is_same_v<T, const char*>) WriteString(value ? value : "");
+			else if constexpr (std::is_same_v<T, StringId>)
+			{
+				// Release の StringId は文字列を持たないのでハッシュも書く
+				WritePod(value.GetHash());
+				WriteString(value.c_str());
+			}
+			else if constexpr (std::is_same_v<T, DirectX::XMFLOAT2> || std::is_same_v<T, DirectX::XMFLOAT3> || std::is_same_v<T, DirectX::XMFLOAT4>) WritePod(value);
+			else if constexpr (std::is_same_v<T, std::vector<std::string>>)
+			{
+				WritePod((uint32_t)value.size());
+				for (const auto& str : value) WriteString(str);
+			}
+			else if constexpr (std::is_same_v<T, std::vector<Entity>>)
+			{
+				WritePod((uint32_t)value.size());
+				if (!value.empty()) WriteBytes(value.data(), value.size() * sizeof(Entity));
+			}
+			else static_assert(sizeof(T) == 0, "REFLECT_VAR type is not supported by the binary format");
+		}
+
+		std::vector<uint8_t>& GetBuffer() { return m_buffer; }
+
+	private:
+		BinaryStringTable& m_strings;
+		std::vector<uint8_t> m_buffer;
+	};
+
+	class BinaryReader
+	{
+	public:
+		BinaryReader(const uint8_t* data, size_t size, const std::vector<std::string_view>* strings = nullptr)
+			: m_current(data), m_end(data + size), m_strings(strings) {}
+
+		bool ReadBytes(void* out, size_t size)
+		{
+			if (m_failed || size > (size_t)(m_end - m_current))
+			{
+				m_failed = true;
+				return false;
+			}
+			memcpy(out, m_current, size);
+			m_current += size;
+			return true;
+		}
+
+		// 読まずに進める（読んだ位置を返す。はみ出したら nullptr）
+		const uint8_t* Skip(size_t size)
+		{
+			if (m_failed || size > (size_t)(m_end - m_current))
+			{
+				m_failed = true;
+				return nullptr;
+			}
+			const uint8_t* position = m_current;
+			m_current += size;
+			return position;
+		}
+
+		template<typename T>
+		bool ReadPod(T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			return ReadBytes(&value, sizeof(T));
+		}
+
+		bool ReadString(std::string_view& out)
+		{
+			uint32_t index = 0;
+			if (!ReadPod(index)) return false;
+			if (!m_strings || index >= m_strings->size())
+			{
+				m_failed = true;
+				return false;
+			}
+			out = (*m_strings)[index];
+			return true;
+		}
+
+		template<typename T>
+		void ReadValue(T& value)
+		{
+			if constexpr (std::is_same_v<T, bool>)
+			{
+				uint8_t byte = 0;
+				if (ReadPod(byte)) value = byte != 0;
+			}
+			else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) ReadPod(value);
+			else if constexpr (std::is_same_v<T, std::string>)
+			{
+				std::string_view str;
+				if (ReadString(str)) value.assign(str.data(), str.size());
+			}
+			else if constexpr (std::is_same_v<T, const char*>)
+			{
+				// 文字列リテラルを指すメンバーは読み飛ばす（JSON 版と同じく復元しない）
+				std::string_view str;
+				ReadString(str);
+			}
+			else if constexpr (std::is_same_v<T, StringId>)
+			{
+				StringId::ValueType hash = 0;
+				std::string_view str;
+				if (!ReadPod(hash) || !ReadString(str)) return;
+
+				// 文字列から作り直せるなら文字列を使う（Debug ではエディタの表示名になる）
+				StringId fromString{ std::string(str) };
+				value = (!str.empty() && fromString.GetHash() == hash) ? fromString : StringId(hash);
+			}
+			else if constexpr (std::is_same_v<T, DirectX::XMFLOAT2> || std::is_same_v<T, DirectX::XMFLOAT3> || std::is_same_v<T, DirectX::XMFLOAT4>) ReadPod(value);
+			else if constexpr (std::is_same_v<T, std::vector<std::string>>)
+			{
+				uint32_t count = 0;
+				if (!ReadPod(count) || count > GetRemaining() / sizeof(uint32_t)) { m_failed = true; return; }
+				value.clear();
+				value.reserve(count);
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					std::string_view str;
+					if (!ReadString(str)) return;
+					value.emplace_back(str);
+				}
+			}
+			else if constexpr (std::is_same_v<T, std::vector<Entity>>)
+			{
+				uint32_t count = 0;
+				if (!ReadPod(count) || count > GetRemaining() / sizeof(Entity)) { m_failed = true; return; }
+				value.resize(count);
+				if (count > 0) ReadBytes(value.data(), count * sizeof(Entity));
+			}
+			else static_assert(sizeof(T) == 0, "REFLECT_VAR type is not supported by the binary format");
+		}
+
+		bool IsFailed() const { return m_failed; }
+		size_t GetRemaining() const { return (size_t)(m_end - m_current); }
+
+	private:
+		const uint8_t* m_current;
+		const uint8_t* m_end;
+		const std::vector<std::string_view>* m_strings;
+		bool m_failed = false;
+	};
+
+	// シリアライズ用ビジター（バイナリ）
+	// ------------------------------------------------------------
+	struct BinaryWriteVisitor
+	{
+		BinaryWriter& writer;
+		template<typename T>
+		void operator()(const T& val, const char* name) { writer.WriteValue(val); }
+	};
+
+	struct BinaryReadVisitor
+	{
+		BinaryReader& reader;
+		template<typename T>
+		void operator()(T& val, const char* name) { reader.ReadValue(val); }
+	};
+
+}	// namespace Arche
+
+#endif // !___BINARY_STREAM_H___
@@ -17,6 +17,8 @@
 #include "Engine/Scene/Core/ECS/ECS.h"
 #include "Engine/Core/Base/Reflection.h"
 #include "Engine/Core/Base/StringId.h"
+#include "Engine/Scene/Serializer/BinaryStream.h"
+#include "Engine/Scene/Serializer/JsonStream.h"
 
 // エディタ機能（InspectorGui）を利用可能にする
 #ifdef _DEBUG
@@ -124,6 +126,17 @@ namespace Arche
 	ARCHE_API void AddToComponentOrder(Registry& reg, Entity e, const std::string& compName);
 	ARCHE_API void RemoveFromComponentOrder(Registry& reg, Entity e, const std::string& compName);
 
+	// まとめて追加する前の確保（プール・std::vector 共通）
+	// 足りないときだけ、今の容量の2倍以上に広げる。
+	// ぴったりの量だけ確保すると、少しずつ追加する呼び出しが続いたときに毎回作り直しになる
+	template<typename Container>
+	void ReserveAdditional(Container& container, size_t additional)
+	{
+		const size_t required = container.size() + additional;
+		if (required <= container.capacity()) return;
+		container.reserve(std::max(required, container.capacity() * 2));
+	}
+
 	// コンポーネントレジストリ
 	// ------------------------------------------------------------
 	class ARCHE_API ComponentRegistry
@@ -142,8 +155,47 @@ namespace Arche
 			std::function<bool(Registry&, Entity)> has;
 			std::function<void(Registry&, Entity, CommandCallback)> drawInspector;
 			std::function<void(Registry&, Entity, int, std::function<void(int, int)>, std::function<void()>, CommandCallback)> drawInspectorDnD;
+
+			// バイナリシーン（SceneBinary）用
+			// フィールドの並びと型
+			std::function<void(std::vector<BinaryField>&)> describeBinary;
+			// entityIndex[entity] が NO_INDEX でないエンティティのものをプール順に書き、書いた数を返す
+			std::function<uint32_t(Registry&, const std::vector<uint32_t>&, BinaryWriter&)> writeBinary;
+			// count 個をまとめてプールに追加する（entities[ファイル内の番号] → エンティティ、entityCount 個）
+			// プールの確保はしないので、先に reserve を呼んでおく
+			std::function<bool(Registry&, const Entity*, uint32_t, BinaryReader&, uint32_t)> readBinary;
+			// これから additional 個追加するぶんのプールを確保する（ReserveAdditional。足りなければ2倍以上に広げる）
+			std::function<void(Registry&, size_t)> reserve;
+
+			// 型のままの複製（JSON を通さない）。src と dst は同じレジストリでもよい
+			// srcEntity が持っていれば dstEntity にコピーして true
+			std::function<bool(Registry&, Entity, Registry&, Entity)> clone;
+			// srcEntities[i] → dstEntities[i] を count 組まとめて（持っているものだけ）
+			std::function<void(Registry&, const Entity*, Registry&, const Entity*, size_t)> copyBatch;
+			// copyBatch と同じだが src から移す（src は dst と別のレジストリで、この後捨てる前提）
+			std::function<void(Registry&, const Entity*, Registry&, const Entity*, size_t)> moveBatch;
+
+			// トリビアルコピー可能な型のみ（それ以外は空）。値と有効フラグをそのままのバイト列で保存・復元する
+			std::function<bool(Registry&, Entity, std::vector<uint8_t>&)> snapshot;
+			std::function<bool(Registry&, Entity, const uint8_t*, size_t)> restore;
+
+			// ストリーミング読み込み（SceneStreamLoader）用
+			// フィールド名 → メンバーの位置と代入関数（REFLECT_VAR の順）
+			std::vector<JsonStreamField> streamFields;
+			// 持っていなければ追加して、コンポーネントの先頭を返す
+			std::function<void*(Registry&, Entity)> beginStream;
+			std::function<void(Registry&, Entity, bool)> setEnabled;
+
+			// プレファブの差分反映（PrefabPatch）用。マスクは REFLECT_VAR の i 番目 → 1 << i
+			std::span<const Reflection::FieldInfo> fields;
+			// 両方が持っていれば、値の違うフィールドのマスク（どちらかが持っていなければ 0）
+			std::function<uint64_t(Registry&, Entity, Registry&, Entity)> changedFields;
+			// mask のフィールドだけ src → dst に書き込む（両方が持っているときだけ）
+			std::function<void(Registry&, Entity, Registry&, Entity, uint64_t)> copyFields;
 		};
 
+		static constexpr uint32_t NO_INDEX = 0xFFFFFFFF;
+
 		static ComponentRegistry& Instance();
 
 		// コンポーネント登録関数
@@ -215,6 +267,178 @@ namespace Arche
 					return reg.has<T>(e);
 				};
 
+			// バイナリ
+			iface.describeBinary = [](std::vector<BinaryField>& outFields)
+				{
+					static_assert(Reflection::HasOnlyKnownFields<T>(), "REFLECT_VAR type is not supported by the binary format");
+					for (const auto& field : Reflection::GetFields<T>())
+					{
+						outFields.push_back({ field.name, field.type });
+					}
+				};
+
+			iface.writeBinary = [](Registry& reg, const std::vector<uint32_t>& entityIndex, BinaryWriter& writer)
+				{
+					if (!reg.hasPool<T>()) return 0u;
+
+					auto& pool = reg.getPool<T>();
+					auto& data = pool.getData();
+					const auto& entities = pool.getEntities();
+
+					uint32_t count = 0;
+					for (size_t i = 0; i < entities.size(); ++i)
+					{
+						Entity e = entities[i];
+						if (e >= entityIndex.size() || entityIndex[e] == NO_INDEX) continue;
+
+						writer.WritePod(entityIndex[e]);
+						writer.WritePod((uint8_t)pool.IsEnabled(e));
+						Reflection::VisitMembers(data[i], BinaryWriteVisitor{ writer });
+						count++;
+					}
+					return count;
+				};
+
+			iface.readBinary = [](Registry& reg, const Entity* entities, uint32_t entityCount, BinaryReader& reader, uint32_t count)
+				{
+					// 確保は呼び出し側が reserve で済ませておく
+					auto& pool = reg.getPool<T>();
+					for (uint32_t i = 0; i < count; ++i)
+					{
+						uint32_t index = 0;
+						uint8_t enabled = 1;
+						if (!reader.ReadPod(index) || !reader.ReadPod(enabled) || index >= entityCount) return false;
+
+						Entity e = entities[index];
+						T& comp = pool.emplace(e);
+						if (!enabled) pool.SetEnabled(e, false);
+
+						Reflection::VisitMembers(comp, BinaryReadVisitor{ reader });
+						if (reader.IsFailed()) return false;
+					}
+					return true;
+				};
+
+			iface.reserve = [](Registry& reg, size_t additional)
+				{
+					ReserveAdditional(reg.getPool<T>(), additional);
+				};
+
+			// 複製
+			iface.clone = [](Registry& src, Entity srcEntity, Registry& dst, Entity dstEntity)
+				{
+					if (!src.hasPool<T>() || !src.getPool<T>().has(srcEntity)) return false;
+
+					// 同じプールへの追加で参照が無効にならないよう、先にコピーを取る
+					auto& srcPool = src.getPool<T>();
+					T value = srcPool.get(srcEntity);
+					bool enabled = srcPool.IsEnabled(srcEntity);
+
+					auto& dstPool = dst.getPool<T>();
+					dstPool.emplace(dstEntity, std::move(value));
+					if (!enabled) dstPool.SetEnabled(dstEntity, false);
+					return true;
+				};
+
+			iface.copyBatch = [](Registry& src, const Entity* srcEntities, Registry& dst, const Entity* dstEntities, size_t count)
+				{
+					if (!src.hasPool<T>()) return;
+
+					auto& srcPool = src.getPool<T>();
+					auto& dstPool = dst.getPool<T>();
+
+					// 先に確保しておけば、同じプール内のコピーでも途中で再確保されない
+					ReserveAdditional(dstPool, count);
+					for (size_t i = 0; i < count; ++i)
+					{
+						if (!srcPool.has(srcEntities[i])) continue;
+
+						dstPool.emplace(dstEntities[i], srcPool.get(srcEntities[i]));
+						if (!srcPool.IsEnabled(srcEntities[i])) dstPool.SetEnabled(dstEntities[i], false);
+					}
+				};
+
+			iface.moveBatch = [](Registry& src, const Entity* srcEntities, Registry& dst, const Entity* dstEntities, size_t count)
+				{
+					if (!src.hasPool<T>()) return;
+
+					auto& srcPool = src.getPool<T>();
+					auto& dstPool = dst.getPool<T>();
+					ReserveAdditional(dstPool, count);
+					for (size_t i = 0; i < count; ++i)
+					{
+						if (!srcPool.has(srcEntities[i])) continue;
+
+						dstPool.emplace(dstEntities[i], std::move(srcPool.get(srcEntities[i])));
+						if (!srcPool.IsEnabled(srcEntities[i])) dstPool.SetEnabled(dstEntities[i], false);
+					}
+				};
+
+			if constexpr (std::is_trivially_copyable_v<T>)
+			{
+				iface.snapshot = [](Registry& reg, Entity e, std::vector<uint8_t>& out)
+					{
+						if (!reg.hasPool<T>() || !reg.getPool<T>().has(e)) return false;
+
+						auto& pool = reg.getPool<T>();
+						const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&pool.get(e));
+						out.insert(out.end(), bytes, bytes + sizeof(T));
+						out.push_back((uint8_t)pool.IsEnabled(e));
+						return true;
+					};
+
+				iface.restore = [](Registry& reg, Entity e, const uint8_t* data, size_t size)
+					{
+						if (size != sizeof(T) + 1) return false;
+
+						auto& pool = reg.getPool<T>();
+						T& comp = pool.has(e) ? pool.get(e) : pool.emplace(e);
+						memcpy(&comp, data, sizeof(T));
+						pool.SetEnabled(e, data[sizeof(T)] != 0);
+						pool.patch(e);
+						return true;
+					};
+			}
+
+			// ストリーミング読み込み
+			Reflection::Meta<T>::VisitFields(JsonStreamSchemaVisitor{ iface.streamFields });
+
+			iface.beginStream = [](Registry& reg, Entity e) -> void*
+				{
+					auto& pool = reg.getPool<T>();
+					return pool.has(e) ? &pool.get(e) : &pool.emplace(e);
+				};
+
+			iface.setEnabled = [](Registry& reg, Entity e, bool enabled)
+				{
+					reg.setComponentEnabled<T>(e, enabled);
+				};
+
+			// フィールド単位の差分
+			iface.fields = Reflection::GetFields<T>();
+
+			iface.changedFields = [](Registry& a, Entity ea, Registry& b, Entity eb) -> uint64_t
+				{
+					if (!a.hasPool<T>() || !b.hasPool<T>()) return 0;
+
+					auto& poolA = a.getPool<T>();
+					auto& poolB = b.getPool<T>();
+					if (!poolA.has(ea) || !poolB.has(eb)) return 0;
+					return Reflection::GetChangedFields(poolA.get(ea), poolB.get(eb));
+				};
+
+			iface.copyFields = [](Registry& src, Entity srcEntity, Registry& dst, Entity dstEntity, uint64_t mask)
+				{
+					if (mask == 0 || !src.hasPool<T>() || !dst.hasPool<T>()) return;
+
+					auto& srcPool = src.getPool<T>();
+					auto& dstPool = dst.getPool<T>();
+					if (!srcPool.has(srcEntity) || !dstPool.has(dstEntity)) return;
+
+					Reflection::CopyFields(srcPool.get(srcEntity), dstPool.get(dstEntity), mask);
+					dstPool.patch(dstEntity);
+				};
+
 			// DrawInspector (変更なし)
 			iface.drawInspectorDnD = [nameStr, iface](Registry& reg, Entity e, int index, std::function<void(int, int)> onReorder, std::function<void()> onRemove, CommandCallback onCommand)
 				{
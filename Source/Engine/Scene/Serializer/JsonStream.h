@@ -0,0 +1,168 @@
+﻿/*****************************************************************//**
+ * @file	JsonStream.h
+ * @brief	リフレクション情報 (REFLECT_VAR) を使った、トークン単位の JSON 読み込み
+ *
+ * @details	SAX で届いた値を、DOM を作らずにコンポーネントのメンバーへ直接書き込む。
+ *			フィールドごとに「メンバーの位置」と「型に合わせた代入関数」を登録時に作っておき、
+ *			読み込み中は名前で引いて呼ぶだけにする。
+ *			変換は DeserializeVisitor に合わせるが、型が合わない値は例外にせず読み飛ばす。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___JSON_STREAM_H___
+#define ___JSON_STREAM_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Scene/Core/ECS/ECS.h"
+#include "Engine/Core/Base/StringId.h"
+#include "Engine/Core/Base/Reflection.h"
+
+namespace Arche
+{
+	// SAX で届いた1つの値
+	struct JsonStreamValue
+	{
+		enum class Type : uint8_t { Null, Bool, Integer, Unsigned, Float, String };
+
+		Type type = Type::Null;
+		bool boolean = false;
+		int64_t integer = 0;
+		uint64_t unsignedInteger = 0;
+		double number = 0.0;
+		std::string string;
+
+		bool IsNumber() const { return type == Type::Integer || type == Type::Unsigned || type == Type::Float; }
+		// get<T>（T が数値型）で読めるもの。bool も含む
+		bool IsArithmetic() const { return IsNumber() || type == Type::Bool; }
+
+		// 数値として読む
+		template<typename T>
+		T GetNumber() const
+		{
+			switch (type)
+			{
+			case Type::Bool:		return static_cast<T>(boolean);
+			case Type::Integer:		return static_cast<T>(integer);
+			case Type::Unsigned:	return static_cast<T>(unsignedInteger);
+			case Type::Float:		return static_cast<T>(number);
+			default:				return T{};
+			}
+		}
+	};
+
+	// 1フィールドぶんの書き込み先
+	struct JsonStreamField
+	{
+		std::string name;
+		size_t offset = 0;		// コンポーネントの先頭からの位置
+		void (*setValue)(void* target, const JsonStreamValue& value) = nullptr;
+		void (*setArray)(void* target, const JsonStreamValue* items, size_t count) = nullptr;
+	};
+
+	// 値1つを書き込む（DeserializeVisitor と同じ変換。合わない型は何もしない）
+	template<typename T>
+	void SetStreamValue(void* target, const JsonStreamValue& value)
+	{
+		T& field = *static_cast<T*>(target);
+		if constexpr (std::is_same_v<T, bool>)
+		{
+			if (value.type == JsonStreamValue::Type::Bool) field = value.boolean;
+		}
+		else if constexpr (std::is_enum_v<T>)
+		{
+			if (value.IsArithmetic()) field = (T)value.GetNumber<int>();
+		}
+		else if constexpr (std::is_arithmetic_v<T>)
+		{
+			if (value.IsArithmetic()) field = value.GetNumber<T>();
+		}
+		else if constexpr (std::is_same_v<T, std::string>)
+		{
+			if (value.type == JsonStreamValue::Type::String) field = value.string;
+		}
+		else if constexpr (std::is_same_v<T, StringId>)
+		{
+			// 数値ならハッシュ、文字列なら文字列から（bool は使わない）
+			if (value.IsNumber()) field = StringId(value.GetNumber<uint32_t>());
+			else if (value.type == JsonStreamValue::Type::String) field = StringId(value.string.c_str());
+		}
+	}
+
+	// 配列を書き込む（要素がすべて揃ってから呼ぶ）
+	template<typename T>
+	void SetStreamArray(void* target, const JsonStreamValue* items, size_t count)
+	{
+		T& field = *static_cast<T*>(target);
+
+		auto AllNumbers = [&](size_t n)
+			{
+				for (size_t i = 0; i < n; ++i)
+				{
+					if (!items[i].IsArithmetic()) return false;
+				}
+				return true;
+			};
+
+		if constexpr (std::is_same_v<T, DirectX::XMFLOAT2>)
+		{
+			if (count >= 2 && AllNumbers(2)) field = { items[0].GetNumber<float>(), items[1].GetNumber<float>() };
+		}
+		else if constexpr (std::is_same_v<T, DirectX::XMFLOAT3>)
+		{
+			if (count >= 3 && AllNumbers(3)) field = { items[0].GetNumber<float>(), items[1].GetNumber<float>(), items[2].GetNumber<float>() };
+		}
+		else if constexpr (std::is_same_v<T, DirectX::XMFLOAT4>)
+		{
+			if (count >= 4 && AllNumbers(4)) field = { items[0].GetNumber<float>(), items[1].GetNumber<float>(), items[2].GetNumber<float>(), items[3].GetNumber<float>() };
+		}
+		else if constexpr (std::is_same_v<T, std::vector<std::string>>)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (items[i].type != JsonStreamValue::Type::String) return;
+			}
+			field.clear();
+			field.reserve(count);
+			for (size_t i = 0; i < count; ++i) field.push_back(items[i].string);
+		}
+		else if constexpr (std::is_same_v<T, std::vector<Entity>>)
+		{
+			if (!AllNumbers(count)) return;
+			field.resize(count);
+			for (size_t i = 0; i < count; ++i) field[i] = (Entity)items[i].GetNumber<uint32_t>();
+		}
+	}
+
+	// フィールドの位置と代入関数を集める（Reflection::Meta<T>::VisitFields に渡す）
+	struct JsonStreamSchemaVisitor
+	{
+		std::vector<JsonStreamField>& fields;
+
+		template<typename Owner, typename T>
+		void operator()(T Owner::*, const Reflection::FieldInfo& info)
+		{
+			JsonStreamField field;
+			field.name = info.name;
+			field.offset = info.offset;
+
+			if constexpr (std::is_same_v<T, DirectX::XMFLOAT2> || std::is_same_v<T, DirectX::XMFLOAT3> || std::is_same_v<T, DirectX::XMFLOAT4> ||
+				std::is_same_v<T, std::vector<std::string>> || std::is_same_v<T, std::vector<Entity>>)
+			{
+				field.setArray = &SetStreamArray<T>;
+			}
+			// 文字列リテラルを指すメンバーは復元しない（バイナリ版と同じ）
+			else if constexpr (!std::is_same_v<T, const char*>)
+			{
+				field.setValue = &SetStreamValue<T>;
+			}
+			fields.push_back(std::move(field));
+		}
+	};
+
+}	// namespace Arche
+
+#endif // !___JSON_STREAM_H___
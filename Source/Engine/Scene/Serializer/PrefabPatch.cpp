@@ -0,0 +1,278 @@
+﻿/*****************************************************************//**
+ * @file	PrefabPatch.cpp
+ * @brief	プレファブの変更をインスタンスへ差分だけ反映する
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Scene/Serializer/PrefabPatch.h"
+#include "Engine/Scene/Serializer/PrefabTemplate.h"
+#include "Engine/Scene/Serializer/SceneSerializer.h"
+#include "Engine/Scene/Serializer/ComponentRegistry.h"
+#include "Engine/Scene/Components/Components.h"
+#include <bit>
+
+namespace Arche
+{
+	namespace
+	{
+		using Interface = ComponentRegistry::Interface;
+
+		constexpr uint32_t NO_MATCH = 0xFFFFFFFF;
+
+		std::vector<Entity> GetChildren(Registry& reg, Entity e)
+		{
+			if (!reg.has<Relationship>(e)) return {};
+			return reg.get<Relationship>(e).children;
+		}
+
+		// 兄弟の中での識別子（名前のハッシュ + 同じ名前の何番目か）
+		void MakeChildKeys(Registry& reg, const std::vector<Entity>& children, std::vector<uint64_t>& outKeys)
+		{
+			outKeys.clear();
+			std::unordered_map<uint32_t, uint32_t> occurrences;
+			for (Entity child : children)
+			{
+				uint32_t hash = reg.has<Tag>(child) ? reg.get<Tag>(child).name.GetHash() : 0;
+				uint32_t occurrence = occurrences[hash]++;
+				outKeys.push_back(((uint64_t)hash << 32) | occurrence);
+			}
+		}
+
+		// from[i] と同じ識別子を持つ to の番号（無ければ NO_MATCH）
+		std::vector<uint32_t> MatchChildren(Registry& fromReg, const std::vector<Entity>& from, Registry& toReg, const std::vector<Entity>& to)
+		{
+			std::vector<uint64_t> keys;
+			MakeChildKeys(toReg, to, keys);
+
+			std::unordered_map<uint64_t, uint32_t> indexOf;
+			for (size_t i = 0; i < to.size(); ++i) indexOf.emplace(keys[i], (uint32_t)i);
+
+			MakeChildKeys(fromReg, from, keys);
+			std::vector<uint32_t> matched(from.size(), NO_MATCH);
+			for (size_t i = 0; i < from.size(); ++i)
+			{
+				auto it = indexOf.find(keys[i]);
+				if (it != indexOf.end()) matched[i] = it->second;
+			}
+			return matched;
+		}
+
+		class Patcher
+		{
+		public:
+			Patcher(Registry& reg, Registry& baseReg, Registry& freshReg, PrefabPatch::Stats& stats)
+				: m_reg(reg), m_baseReg(baseReg), m_freshReg(freshReg), m_stats(stats)
+			{
+				// 親子関係は Relationship のフィールドではなく、子の突き合わせで直す
+				for (const auto& [name, iface] : ComponentRegistry::Instance().GetInterfaces())
+				{
+					if (name == "Relationship" || !iface.changedFields) continue;
+
+					Component component;
+					component.iface = &iface;
+					component.isPrefabInstance = name == "PrefabInstance";
+					// ルートの置き場所と名前はインスタンスのもの
+					if (name == "Transform") component.rootOwned = ~0ull;
+					if (name == "Tag") component.rootOwned = GetFieldMask(iface, "name");
+					m_components.push_back(component);
+				}
+			}
+
+			void Sync(Entity instance, Entity base, Entity fresh, bool isRoot)
+			{
+				SyncComponents(instance, base, fresh, isRoot);
+				SyncChildren(instance, base, fresh);
+			}
+
+		private:
+			struct Component
+			{
+				const Interface* iface = nullptr;
+				uint64_t rootOwned = 0;
+				bool isPrefabInstance = false;
+			};
+
+			static uint64_t GetFieldMask(const Interface& iface, const char* fieldName)
+			{
+				const uint32_t hash = StringId::Hash(fieldName);
+				for (size_t i = 0; i < iface.fields.size() && i < 64; ++i)
+				{
+					if (iface.fields[i].nameHash == hash) return 1ull << i;
+				}
+				return 0;
+			}
+
+			void SyncComponents(Entity instance, Entity base, Entity fresh, bool isRoot)
+			{
+				for (const auto& component : m_components)
+				{
+					// ルートのプレファブへのリンクは今のまま
+					if (isRoot && component.isPrefabInstance) continue;
+
+					const Interface& iface = *component.iface;
+					bool inFresh = iface.has(m_freshReg, fresh);
+					bool inBase = iface.has(m_baseReg, base);
+					bool inInstance = iface.has(m_reg, instance);
+
+					if (inFresh && inBase)
+					{
+						// インスタンスで外したものは戻さない
+						if (!inInstance) continue;
+
+						uint64_t mask = iface.changedFields(m_baseReg, base, m_freshReg, fresh);
+						if (mask == 0) continue;
+
+						// インスタンスで書き換えたフィールド（上書き）は残す
+						mask &= ~iface.changedFields(m_baseReg, base, m_reg, instance);
+						if (isRoot) mask &= ~component.rootOwned;
+						if (mask == 0) continue;
+
+						iface.copyFields(m_freshReg, fresh, m_reg, instance, mask);
+						m_stats.patchedFields += (uint32_t)std::popcount(mask);
+					}
+					else if (inFresh)
+					{
+						// プレファブで追加された（インスタンスで既に追加していればそちらを残す）
+						if (inInstance) continue;
+
+						iface.clone(m_freshReg, fresh, m_reg, instance);
+						m_stats.addedComponents++;
+					}
+					else if (inBase && inInstance)
+					{
+						// プレファブから外された
+						iface.remove(m_reg, instance);
+						m_stats.removedComponents++;
+					}
+				}
+			}
+
+			void SyncChildren(Entity instance, Entity base, Entity fresh)
+			{
+				std::vector<Entity> freshChildren = GetChildren(m_freshReg, fresh);
+				std::vector<Entity> baseChildren = GetChildren(m_baseReg, base);
+				std::vector<Entity> instanceChildren = GetChildren(m_reg, instance);
+				if (freshChildren.empty() && baseChildren.empty()) return;
+
+				std::vector<uint32_t> freshToBase = MatchChildren(m_freshReg, freshChildren, m_baseReg, baseChildren);
+				std::vector<uint32_t> baseToInstance = MatchChildren(m_baseReg, baseChildren, m_reg, instanceChildren);
+
+				std::vector<uint8_t> kept(baseChildren.size(), 0);
+				for (size_t i = 0; i < freshChildren.size(); ++i)
+				{
+					uint32_t baseIndex = freshToBase[i];
+					if (baseIndex == NO_MATCH)
+					{
+						// プレファブで増えた子
+						AddSubtree(instance, freshChildren[i]);
+						continue;
+					}
+					kept[baseIndex] = 1;
+
+					// インスタンスで削除した子は戻さない
+					uint32_t instanceIndex = baseToInstance[baseIndex];
+					if (instanceIndex == NO_MATCH) continue;
+
+					Sync(instanceChildren[instanceIndex], baseChildren[baseIndex], freshChildren[i], false);
+				}
+
+				// プレファブから消えた子
+				for (size_t i = 0; i < baseChildren.size(); ++i)
+				{
+					if (kept[i] || baseToInstance[i] == NO_MATCH) continue;
+					DestroySubtree(instance, instanceChildren[baseToInstance[i]]);
+				}
+			}
+
+			void AddSubtree(Entity parent, Entity fresh)
+			{
+				std::vector<Entity> sources;
+				std::vector<Entity> copies;
+				SceneSerializer::CollectHierarchy(m_freshReg, fresh, sources);
+				SceneSerializer::CopyEntities(m_freshReg, sources, m_reg, copies);
+				if (copies.empty()) return;
+
+				Entity root = copies[0];
+				if (!m_reg.has<Relationship>(root)) m_reg.emplace<Relationship>(root);
+				m_reg.get<Relationship>(root).parent = parent;
+
+				if (!m_reg.has<Relationship>(parent)) m_reg.emplace<Relationship>(parent);
+				m_reg.get<Relationship>(parent).children.push_back(root);
+
+				m_stats.createdEntities += (uint32_t)copies.size();
+			}
+
+			void DestroySubtree(Entity parent, Entity entity)
+			{
+				std::vector<Entity> entities;
+				SceneSerializer::CollectHierarchy(m_reg, entity, entities);
+				for (Entity e : entities) m_reg.destroy(e);
+
+				if (m_reg.has<Relationship>(parent))
+				{
+					auto& children = m_reg.get<Relationship>(parent).children;
+					children.erase(std::remove(children.begin(), children.end(), entity), children.end());
+				}
+
+				m_stats.destroyedEntities += (uint32_t)entities.size();
+			}
+
+		private:
+			Registry& m_reg;
+			Registry& m_baseReg;
+			Registry& m_freshReg;
+			PrefabPatch::Stats& m_stats;
+			std::vector<Component> m_components;
+		};
+	}
+
+	void PrefabPatch::FindInstances(Registry& reg, const std::string& prefabPath, std::vector<Entity>& outRoots)
+	{
+		const std::string key = PrefabCache::MakeKey(prefabPath);
+
+		// 正規化したパスの文字列で比べる（ハッシュだけだと別のプレファブが衝突したときに巻き込む）
+		// 同じ文字列のパスは1度だけ正規化する（ほとんどのインスタンスは同じ文字列を持つ）
+		std::unordered_map<std::string, bool> matches;
+		reg.view<PrefabInstance>().each([&](Entity e, PrefabInstance& instance)
+			{
+				auto it = matches.find(instance.prefabPath);
+				if (it == matches.end()) it = matches.emplace(instance.prefabPath, PrefabCache::MakeKey(instance.prefabPath) == key).first;
+				if (it->second) outRoots.push_back(e);
+			});
+	}
+
+	PrefabPatch::Stats PrefabPatch::Apply(Registry& reg, const std::vector<Entity>& roots, const PrefabTemplate* base, const PrefabTemplate& fresh)
+	{
+		Stats stats;
+		if (roots.empty()) return stats;
+
+		// 新旧のテンプレートを作業用のレジストリに1つずつ生成し、型のまま比べる
+		Registry freshReg;
+		std::vector<Entity> freshRoots;
+		fresh.Instantiate(freshReg, 1, freshRoots);
+		if (freshRoots.empty()) return stats;
+
+		Registry baseReg;
+		std::vector<Entity> baseRoots;
+		if (base) base->Instantiate(baseReg, 1, baseRoots);
+		const bool hasBase = !baseRoots.empty();
+
+		Patcher patcher(reg, hasBase ? baseReg : reg, freshReg, stats);
+		for (Entity root : roots)
+		{
+			if (!reg.valid(root)) continue;
+
+			patcher.Sync(root, hasBase ? baseRoots[0] : root, freshRoots[0], true);
+			stats.instances++;
+		}
+		return stats;
+	}
+
+}	// namespace Arche
@@ -0,0 +1,54 @@
+﻿/*****************************************************************//**
+ * @file	PrefabPatch.h
+ * @brief	プレファブの変更をインスタンスへ差分だけ反映する
+ *
+ * @details	インスタンスが合わせてある版（基準）と新しい版をそれぞれ作業用のレジストリに生成し、
+ *			コンポーネントごとに「基準 → 新しい版で変わったフィールド」のうち、
+ *			「基準 → インスタンスで変わっていない（上書きされていない）フィールド」だけを書き込む。
+ *			比較と書き込みはリフレクションのフィールド表で型のまま行い、JSON は通さない。
+ *
+ *			子は名前（Tag）と同じ名前の兄弟の中での順番で突き合わせ、変わっていない子は作り直さない。
+ *			プレファブで増えた子だけを追加し、消えた子だけを削除する。
+ *			インスタンスで外したコンポーネント・削除した子・追加したものはそのまま残す。
+ *			ルートの Transform と名前はインスタンスのものとして扱い、上書きしない。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___PREFAB_PATCH_H___
+#define ___PREFAB_PATCH_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Scene/Core/ECS/ECS.h"
+
+namespace Arche
+{
+	class PrefabTemplate;
+
+	class ARCHE_API PrefabPatch
+	{
+	public:
+		struct Stats
+		{
+			uint32_t instances = 0;
+			uint32_t patchedFields = 0;
+			uint32_t addedComponents = 0;
+			uint32_t removedComponents = 0;
+			uint32_t createdEntities = 0;
+			uint32_t destroyedEntities = 0;
+		};
+
+		// prefabPath のインスタンスのルートを集める（正規化したパスのハッシュで比べる。ファイルシステムには問い合わせない）
+		static void FindInstances(Registry& reg, const std::string& prefabPath, std::vector<Entity>& outRoots);
+
+		// roots を base の内容から fresh の内容へ更新する
+		// base が無ければインスタンス自身を基準にする（上書きは無いものとして fresh に揃える）
+		static Stats Apply(Registry& reg, const std::vector<Entity>& roots, const PrefabTemplate* base, const PrefabTemplate& fresh);
+	};
+
+}	// namespace Arche
+
+#endif // !___PREFAB_PATCH_H___
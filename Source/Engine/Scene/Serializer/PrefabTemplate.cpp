@@ -0,0 +1,226 @@
+﻿/*****************************************************************//**
+ * @file	PrefabTemplate.cpp
+ * @brief	パース済みプレファブのテンプレートとキャッシュ
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Scene/Serializer/PrefabTemplate.h"
+#include "Engine/Scene/Serializer/SceneSerializer.h"
+#include "Engine/Scene/Serializer/ComponentRegistry.h"
+#include "Engine/Scene/Serializer/ComponentSerializer.h"
+#include "Engine/Scene/Components/Components.h"
+
+namespace Arche
+{
+	// ====================================================================================
+	// テンプレート
+	// ====================================================================================
+	bool PrefabTemplate::Build(const json& prefabJson, const std::string& prefabPath)
+	{
+		m_nodes.clear();
+		m_sections.clear();
+		m_strings.clear();
+		m_views.clear();
+
+		// 配列（旧形式）なら先頭がルート
+		const json* rootNode = &prefabJson;
+		if (prefabJson.is_array())
+		{
+			if (prefabJson.empty()) return false;
+			rootNode = &prefabJson[0];
+		}
+		if (!rootNode->is_object()) return false;
+
+		// 作業用のレジストリに復元してから、型ごとに詰める
+		Registry scratch;
+		std::vector<uint32_t> entityIndex;
+
+		std::function<void(const json&, uint32_t)> AddNode = [&](const json& node, uint32_t parent)
+			{
+				uint32_t index = (uint32_t)m_nodes.size();
+				Entity e = scratch.create();
+
+				// 子には既定の Tag を付けてから復元する（ReconstructEntityRecursive と同じ）
+				if (parent != NO_PARENT) scratch.emplace<Tag>(e, "Child");
+				ComponentSerializer::DeserializeEntity(scratch, e, node);
+
+				// ルートにはプレファブへのリンクを残す
+				if (parent == NO_PARENT && !scratch.has<PrefabInstance>(e)) scratch.emplace<PrefabInstance>(e, prefabPath);
+
+				// 親子関係はファイル内のIDを指しているので持たず、生成時に構造から作り直す
+				Node entry;
+				entry.parent = parent;
+				entry.hasRelationship = scratch.has<Relationship>(e) || parent != NO_PARENT;
+				if (scratch.has<Relationship>(e)) scratch.remove<Relationship>(e);
+				m_nodes.push_back(std::move(entry));
+
+				if (parent != NO_PARENT)
+				{
+					m_nodes[parent].hasRelationship = true;
+					m_nodes[parent].children.push_back(index);
+				}
+
+				if (e >= entityIndex.size()) entityIndex.resize((size_t)e + 1, ComponentRegistry::NO_INDEX);
+				entityIndex[e] = index;
+
+				if (node.contains("Children") && node["Children"].is_array())
+				{
+					for (const auto& child : node["Children"]) AddNode(child, index);
+				}
+			};
+		AddNode(*rootNode, NO_PARENT);
+
+		BinaryStringTable strings;
+		for (const auto& [name, iface] : ComponentRegistry::Instance().GetInterfaces())
+		{
+			if (!iface.writeBinary) continue;
+
+			BinaryWriter payload(strings);
+			uint32_t recordCount = iface.writeBinary(scratch, entityIndex, payload);
+			if (recordCount == 0) continue;
+
+			Section section;
+			section.name = name;
+			section.payload = std::move(payload.GetBuffer());
+			section.recordCount = recordCount;
+			m_sections.push_back(std::move(section));
+		}
+
+		m_strings = strings.GetStrings();
+		m_views.assign(m_strings.begin(), m_strings.end());
+		return true;
+	}
+
+	void PrefabTemplate::Instantiate(Registry& reg, uint32_t count, std::vector<Entity>& outRoots) const
+	{
+		if (m_nodes.empty() || count == 0) return;
+
+		// 全インスタンスぶんを一度に確保する（インスタンスごとに nodeCount 個ずつ並ぶ）
+		const uint32_t nodeCount = (uint32_t)m_nodes.size();
+		std::vector<Entity> entities;
+		reg.create((size_t)nodeCount * count, entities);
+
+		// 型ごとにまとめてプールへ追加する
+		const auto& interfaces = ComponentRegistry::Instance().GetInterfaces();
+		for (const auto& section : m_sections)
+		{
+			auto it = interfaces.find(section.name);
+			if (it == interfaces.end() || !it->second.readBinary) continue;
+
+			// 全インスタンスぶんを1回で確保する（readBinary は確保しない）
+			it->second.reserve(reg, (size_t)section.recordCount * count);
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				BinaryReader reader(section.payload.data(), section.payload.size(), &m_views);
+				if (!it->second.readBinary(reg, entities.data() + (size_t)i * nodeCount, nodeCount, reader, section.recordCount))
+				{
+					Logger::LogError("Prefab template is corrupted: " + section.name);
+					break;
+				}
+			}
+		}
+
+		// 親子関係（テンプレート内の番号 → 作ったエンティティ）
+		size_t relationshipCount = 0;
+		for (const auto& node : m_nodes)
+		{
+			if (node.hasRelationship) relationshipCount++;
+		}
+		ReserveAdditional(reg.getPool<Relationship>(), relationshipCount * count);
+		ReserveAdditional(outRoots, count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const Entity* instance = entities.data() + (size_t)i * nodeCount;
+			for (uint32_t n = 0; n < nodeCount; ++n)
+			{
+				const Node& node = m_nodes[n];
+				if (!node.hasRelationship) continue;
+
+				auto& rel = reg.emplace<Relationship>(instance[n]);
+				rel.parent = node.parent != NO_PARENT ? instance[node.parent] : NullEntity;
+				rel.children.reserve(node.children.size());
+				for (uint32_t child : node.children) rel.children.push_back(instance[child]);
+			}
+			outRoots.push_back(instance[0]);
+		}
+	}
+
+	// ====================================================================================
+	// キャッシュ
+	// ====================================================================================
+	PrefabCache& PrefabCache::Instance()
+	{
+		static PrefabCache instance;
+		return instance;
+	}
+
+	std::shared_ptr<const PrefabTemplate> PrefabCache::Get(const std::string& prefabPath)
+	{
+		std::string key = MakeKey(prefabPath);
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto it = m_templates.find(key);
+			if (it != m_templates.end()) return it->second;
+		}
+
+		json prefabJson;
+		if (!SceneSerializer::ReadDocument(prefabPath, prefabJson)) return nullptr;
+
+		auto prefab = std::make_shared<PrefabTemplate>();
+		if (!prefab->Build(prefabJson, prefabPath))
+		{
+			Logger::LogError("Invalid prefab: " + prefabPath);
+			return nullptr;
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_templates.emplace(key, std::move(prefab)).first->second;
+	}
+
+	void PrefabCache::Invalidate(const std::string& prefabPath)
+	{
+		std::string key = MakeKey(prefabPath);
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_templates.find(key);
+		if (it == m_templates.end()) return;
+
+		m_previous[key] = std::move(it->second);
+		m_templates.erase(it);
+	}
+
+	void PrefabCache::Clear()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_templates.clear();
+		m_previous.clear();
+	}
+
+	std::shared_ptr<const PrefabTemplate> PrefabCache::TakePrevious(const std::string& prefabPath)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_previous.find(MakeKey(prefabPath));
+		if (it == m_previous.end()) return nullptr;
+
+		auto prefab = std::move(it->second);
+		m_previous.erase(it);
+		return prefab;
+	}
+
+	std::string PrefabCache::MakeKey(const std::string& prefabPath)
+	{
+		// 表記ゆれ（区切り文字・大文字小文字）で別物にならないよう正規化する
+		std::string key = prefabPath;
+		std::replace(key.begin(), key.end(), '\\', '/');
+		key = std::filesystem::path(key).lexically_normal().generic_string();
+		std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+		return key;
+	}
+
+}	// namespace Arche
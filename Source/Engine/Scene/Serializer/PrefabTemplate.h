@@ -0,0 +1,101 @@
+﻿/*****************************************************************//**
+ * @file	PrefabTemplate.h
+ * @brief	パース済みプレファブのテンプレートとキャッシュ
+ *
+ * @details	プレファブのJSONを1度だけ読み、コンポーネント型ごとに1つの詰めたデータ
+ *			（SceneBinary のセクションと同じ形式）として持っておく。
+ *			生成はプールへの型ごとの一括追加と、親子関係の番号 → エンティティの付け替えだけで、
+ *			JSON のパースやコンポーネント型ごとの有無の確認は行わない。
+ *
+ *			PrefabCache はパスごとにテンプレートを持つ。
+ *			プレファブを保存・再読み込みしたとき（SceneSerializer::SavePrefab / ReloadPrefabInstances）と、
+ *			ゲームDLLを差し替える前（コンポーネントの並びが変わりうる）に破棄する。
+ *			保存で破棄したものは1つ前の版として残し、インスタンスへの差分反映（PrefabPatch）の基準に使う。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___PREFAB_TEMPLATE_H___
+#define ___PREFAB_TEMPLATE_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Scene/Core/ECS/ECS.h"
+#include <string_view>
+
+namespace Arche
+{
+	class ARCHE_API PrefabTemplate
+	{
+	public:
+		static constexpr uint32_t NO_PARENT = 0xFFFFFFFF;
+
+		PrefabTemplate() = default;
+		// 文字列の参照（m_views）が m_strings を指すのでコピーしない
+		PrefabTemplate(const PrefabTemplate&) = delete;
+		PrefabTemplate& operator=(const PrefabTemplate&) = delete;
+
+		// プレファブのJSON（ルートエンティティ、旧形式は配列の先頭）から作る
+		bool Build(const json& prefabJson, const std::string& prefabPath);
+
+		// count 個まとめて生成し、それぞれのルートを outRoots に追加する
+		void Instantiate(Registry& reg, uint32_t count, std::vector<Entity>& outRoots) const;
+
+		uint32_t GetNodeCount() const { return (uint32_t)m_nodes.size(); }
+
+	private:
+		// 階層の1ノード（前順に並び、親は必ず先に来る）
+		struct Node
+		{
+			uint32_t parent = NO_PARENT;
+			bool hasRelationship = false;
+			std::vector<uint32_t> children;
+		};
+
+		// コンポーネント型1つぶん
+		struct Section
+		{
+			std::string name;
+			std::vector<uint8_t> payload;
+			uint32_t recordCount = 0;
+		};
+
+	private:
+		std::vector<Node> m_nodes;
+		std::vector<Section> m_sections;
+		std::vector<std::string> m_strings;
+		std::vector<std::string_view> m_views;
+	};
+
+	class ARCHE_API PrefabCache
+	{
+	public:
+		static PrefabCache& Instance();
+
+		// 無ければ読み込んで作る（読めなければ nullptr）
+		std::shared_ptr<const PrefabTemplate> Get(const std::string& prefabPath);
+
+		// 破棄したテンプレートは TakePrevious で取り出せる（次の Invalidate か Clear まで）
+		void Invalidate(const std::string& prefabPath);
+		void Clear();
+
+		// 最後に Invalidate した版（インスタンスが合わせてある内容）を取り出す。無ければ nullptr
+		std::shared_ptr<const PrefabTemplate> TakePrevious(const std::string& prefabPath);
+
+		// 表記ゆれ（区切り文字・大文字小文字）を除いたパス。同じファイルなら同じ文字列
+		static std::string MakeKey(const std::string& prefabPath);
+
+	private:
+		PrefabCache() = default;
+
+	private:
+		std::mutex m_mutex;
+		std::unordered_map<std::string, std::shared_ptr<const PrefabTemplate>> m_templates;
+		std::unordered_map<std::string, std::shared_ptr<const PrefabTemplate>> m_previous;
+	};
+
+}	// namespace Arche
+
+#endif // !___PREFAB_TEMPLATE_H___
@@ -0,0 +1,177 @@
+﻿/*****************************************************************//**
+ * @file	SceneBenchmark.cpp
+ * @brief	シーン読み込みの計測（JSON とバイナリの比較）
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Scene/Serializer/SceneBenchmark.h"
+#include "Engine/Scene/Serializer/SceneBinary.h"
+#include "Engine/Scene/Serializer/SceneEntityLoader.h"
+#include "Engine/Scene/Serializer/SceneStreamLoader.h"
+#include "Engine/Scene/Serializer/SceneSaver.h"
+#include "Engine/Scene/Serializer/ComponentSerializer.h"
+#include "Engine/Scene/Components/Components.h"
+#include <random>
+
+namespace Arche
+{
+	namespace
+	{
+		// 1グループ（親1 + 子）あたりのエンティティ数
+		constexpr uint32_t GROUP_SIZE = 100;
+
+		double Elapsed(std::chrono::high_resolution_clock::time_point from)
+		{
+			return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - from).count();
+		}
+	}
+
+	json SceneBenchmark::GenerateScene(uint32_t entityCount)
+	{
+		std::mt19937 rng(12345);
+		std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+		std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+
+		Registry reg;
+		std::vector<Entity> entities;
+		entities.reserve(entityCount);
+
+		Entity groupRoot = NullEntity;
+		for (uint32_t i = 0; i < entityCount; ++i)
+		{
+			Entity e = reg.create();
+			entities.push_back(e);
+
+			reg.emplace<Tag>(e, "Entity_" + std::to_string(i));
+			reg.emplace<Transform>(e, XMFLOAT3{ position(rng), position(rng), position(rng) }, XMFLOAT3{ 0.0f, angle(rng), 0.0f });
+
+			if (i % GROUP_SIZE == 0)
+			{
+				groupRoot = e;
+				reg.emplace<Relationship>(e);
+			}
+			else
+			{
+				reg.emplace<Relationship>(e, groupRoot);
+				reg.get<Relationship>(groupRoot).children.push_back(e);
+
+				if (i % 4 == 1) reg.emplace<MeshComponent>(e, "Resources/Game/Models/Crate.fbx");
+				if (i % 8 == 1) reg.emplace<Rigidbody>(e);
+				if (i % 16 == 1) reg.emplace<PointLight>(e);
+			}
+		}
+
+		json sceneJson;
+		sceneJson["SceneName"] = "Benchmark";
+		sceneJson["Physics"]["LayerCollision"] = json::array();
+		sceneJson["Systems"] = json::array();
+
+		json entitiesJson = json::array();
+		for (Entity e : entities)
+		{
+			json entityJson;
+			entityJson["ID"] = (uint32_t)e;
+			entityJson["IsActive"] = true;
+			ComponentSerializer::SerializeEntity(reg, e, entityJson);
+			entitiesJson.push_back(std::move(entityJson));
+		}
+		sceneJson["Entities"] = std::move(entitiesJson);
+		return sceneJson;
+	}
+
+	SceneBenchmarkResult SceneBenchmark::Run(uint32_t entityCount)
+	{
+		SceneBenchmarkResult result;
+		result.entityCount = entityCount;
+
+		// エディタが保存するのと同じ形（インデント付き）のテキスト
+		std::string text = GenerateScene(entityCount).dump(4);
+		result.jsonBytes = text.size();
+
+		// --- JSON: パース → 構築（SceneSerializer::LoadScene と同じ処理） ---
+		auto start = std::chrono::high_resolution_clock::now();
+		json sceneJson = json::parse(text, nullptr, false);
+		result.jsonParseSeconds = Elapsed(start);
+		if (sceneJson.is_discarded()) return result;
+
+		// メインスレッドだけ（以前の読み込みと同じ条件）
+		{
+			Registry reg;
+			EntityIdRemap remap;
+			start = std::chrono::high_resolution_clock::now();
+			SceneEntityLoader::Load(reg, sceneJson["Entities"], remap, 1);
+			result.jsonSerialBuildSeconds = Elapsed(start);
+		}
+
+		// コア数ぶんのスレッドで復元
+		{
+			Registry reg;
+			EntityIdRemap remap;
+			start = std::chrono::high_resolution_clock::now();
+			SceneEntityLoader::Load(reg, sceneJson["Entities"], remap);
+			result.jsonBuildSeconds = Elapsed(start);
+
+			if (remap.GetCount() != entityCount) return result;
+		}
+
+		// --- ストリーミング: DOM を作らずに作業用のレジストリへ → 型ごとに移す ---
+		{
+			SceneSnapshot streamed;
+			std::string error;
+			start = std::chrono::high_resolution_clock::now();
+			if (!SceneStreamLoader::Parse(reinterpret_cast<const uint8_t*>(text.data()), text.size(), false, streamed, error))
+			{
+				Logger::LogError("Scene benchmark: " + error);
+				return result;
+			}
+			result.streamParseSeconds = Elapsed(start);
+
+			Registry reg;
+			EntityIdRemap remap;
+			start = std::chrono::high_resolution_clock::now();
+			SceneStreamLoader::Instantiate(reg, streamed, remap);
+			result.streamBuildSeconds = Elapsed(start);
+
+			if (remap.GetCount() != entityCount) return result;
+		}
+
+		// --- バイナリ: 書き出し（クッカー側）→ パース → 型ごとにまとめて構築 ---
+		std::vector<uint8_t> bytes;
+		start = std::chrono::high_resolution_clock::now();
+		if (!SceneBinary::FromJson(sceneJson, bytes)) return result;
+		result.binaryWriteSeconds = Elapsed(start);
+		result.binaryBytes = bytes.size();
+
+		SceneBinary binary;
+		std::string error;
+		start = std::chrono::high_resolution_clock::now();
+		if (!binary.Parse(bytes.data(), bytes.size(), error))
+		{
+			Logger::LogError("Scene benchmark: " + error);
+			return result;
+		}
+		result.binaryParseSeconds = Elapsed(start);
+
+		{
+			Registry reg;
+			EntityIdRemap remap;
+			start = std::chrono::high_resolution_clock::now();
+			if (!binary.Instantiate(reg, remap)) return result;
+			remap.ResolveRelationships(reg);
+			result.binaryBuildSeconds = Elapsed(start);
+
+			if (remap.GetCount() != entityCount) return result;
+		}
+
+		result.succeeded = true;
+		return result;
+	}
+
+}	// namespace Arche
@@ -0,0 +1,57 @@
+﻿/*****************************************************************//**
+ * @file	SceneBenchmark.h
+ * @brief	シーン読み込みの計測（JSON とバイナリの比較）
+ *
+ * @details	Tag / Transform / Relationship などを持つエンティティを大量に生成し、
+ *			JSON（パース + チャンクごとに並列の構築）、JSON のストリーミング読み込み（SAX + 型ごとの移動）、
+ *			バイナリシーン（パース + 型ごとの一括追加）の時間とサイズを測る。デバイスを使わないので ArcheCook --bench-scene から呼べる。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___SCENE_BENCHMARK_H___
+#define ___SCENE_BENCHMARK_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+
+namespace Arche
+{
+	struct SceneBenchmarkResult
+	{
+		uint32_t entityCount = 0;
+		bool succeeded = false;
+
+		uint64_t jsonBytes = 0;
+		double jsonParseSeconds = 0.0;
+		double jsonBuildSeconds = 0.0;
+		double jsonSerialBuildSeconds = 0.0;	// 同じ構築をメインスレッドだけで行った時間
+
+		double streamParseSeconds = 0.0;		// SAX で作業用のレジストリへ復元（DOM を作らない）
+		double streamBuildSeconds = 0.0;
+
+		uint64_t binaryBytes = 0;
+		double binaryWriteSeconds = 0.0;
+		double binaryParseSeconds = 0.0;
+		double binaryBuildSeconds = 0.0;
+
+		double GetJsonSeconds() const { return jsonParseSeconds + jsonBuildSeconds; }
+		double GetStreamSeconds() const { return streamParseSeconds + streamBuildSeconds; }
+		double GetBinarySeconds() const { return binaryParseSeconds + binaryBuildSeconds; }
+		double GetSpeedup() const { return GetBinarySeconds() > 0.0 ? GetJsonSeconds() / GetBinarySeconds() : 0.0; }
+	};
+
+	class ARCHE_API SceneBenchmark
+	{
+	public:
+		// entityCount 個のエンティティを持つシーンJSONを作る（乱数は固定シード）
+		static json GenerateScene(uint32_t entityCount);
+
+		static SceneBenchmarkResult Run(uint32_t entityCount);
+	};
+
+}	// namespace Arche
+
+#endif // !___SCENE_BENCHMARK_H___
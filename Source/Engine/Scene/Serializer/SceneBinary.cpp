@@ -0,0 +1,400 @@
+﻿/*****************************************************************//**
+ * @file	SceneBinary.cpp
+ * @brief	バイナリ形式のシーン (.ascene)
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Scene/Serializer/SceneBinary.h"
+#include "Engine/Scene/Serializer/ComponentRegistry.h"
+#include "Engine/Scene/Serializer/ComponentSerializer.h"
+#include "Engine/Core/Base/Hash.h"
+#include "Engine/Core/Base/Logger.h"
+
+namespace Arche
+{
+	namespace
+	{
+		// 書き出した時の型で1フィールド読み、SerializeVisitor と同じ形の JSON にする
+		json ReadFieldAsJson(BinaryReader& reader, BinaryFieldType type)
+		{
+			switch (type)
+			{
+			case BinaryFieldType::Int8:		{ int8_t v = 0; reader.ReadPod(v); return v; }
+			case BinaryFieldType::Int16:	{ int16_t v = 0; reader.ReadPod(v); return v; }
+			case BinaryFieldType::Int32:	{ int32_t v = 0; reader.ReadPod(v); return v; }
+			case BinaryFieldType::Int64:	{ int64_t v = 0; reader.ReadPod(v); return v; }
+			case BinaryFieldType::UInt8:	{ uint8_t v = 0; reader.ReadPod(v); return v; }
+			case BinaryFieldType::UInt16:	{ uint16_t v = 0; reader.ReadPod(v); return v; }
+			case BinaryFieldType::UInt32:	{ uint32_t v = 0; reader.ReadPod(v); return v; }
+			case BinaryFieldType::UInt64:	{ uint64_t v = 0; reader.ReadPod(v); return v; }
+			case BinaryFieldType::Float:	{ float v = 0; reader.ReadPod(v); return v; }
+			case BinaryFieldType::Double:	{ double v = 0; reader.ReadPod(v); return v; }
+			case BinaryFieldType::Bool:		{ uint8_t v = 0; reader.ReadPod(v); return v != 0; }
+			case BinaryFieldType::String:
+			{
+				std::string_view str;
+				reader.ReadString(str);
+				return std::string(str);
+			}
+			case BinaryFieldType::StringId:
+			{
+				// 文字列が無ければハッシュのまま（DeserializeVisitor はどちらも読める）
+				StringId::ValueType hash = 0;
+				std::string_view str;
+				if (!reader.ReadPod(hash) || !reader.ReadString(str)) return json();
+				return str.empty() ? json(hash) : json(std::string(str));
+			}
+			case BinaryFieldType::Float2:	{ XMFLOAT2 v = {}; reader.ReadPod(v); return { v.x, v.y }; }
+			case BinaryFieldType::Float3:	{ XMFLOAT3 v = {}; reader.ReadPod(v); return { v.x, v.y, v.z }; }
+			case BinaryFieldType::Float4:	{ XMFLOAT4 v = {}; reader.ReadPod(v); return { v.x, v.y, v.z, v.w }; }
+			case BinaryFieldType::StringList:
+			{
+				std::vector<std::string> list;
+				reader.ReadValue(list);
+				return list;
+			}
+			case BinaryFieldType::EntityList:
+			{
+				std::vector<Entity> list;
+				reader.ReadValue(list);
+				return list;
+			}
+			}
+
+			// 知らない型は続きを読めない
+			reader.Skip((size_t)-1);
+			return json();
+		}
+
+		// 型が変わっても JSON を通して読めるもの（整数・浮動小数点どうし）
+		bool IsNumberField(BinaryFieldType type)
+		{
+			return type <= BinaryFieldType::Double;
+		}
+	}
+
+	// ====================================================================================
+	// 書き出し
+	// ====================================================================================
+	bool SceneBinary::Write(Registry& reg, const Contents& contents, std::vector<uint8_t>& outBytes)
+	{
+		const size_t entityCount = contents.entities.size();
+		if (contents.ids.size() != entityCount) return false;
+
+		BinaryStringTable strings;
+
+		// エンティティ → ファイル内の番号
+		std::vector<uint32_t> entityIndex;
+		for (size_t i = 0; i < entityCount; ++i)
+		{
+			Entity e = contents.entities[i];
+			if (e >= entityIndex.size()) entityIndex.resize((size_t)e + 1, ComponentRegistry::NO_INDEX);
+			entityIndex[e] = (uint32_t)i;
+		}
+
+		// コンポーネント型ごとのセクション（持っているエンティティが無い型は書かない）
+		BinaryWriter sections(strings);
+		uint32_t sectionCount = 0;
+		std::vector<BinaryField> fields;
+		for (const auto& [name, iface] : ComponentRegistry::Instance().GetInterfaces())
+		{
+			if (!iface.writeBinary) continue;
+
+			BinaryWriter payload(strings);
+			uint32_t recordCount = iface.writeBinary(reg, entityIndex, payload);
+			if (recordCount == 0) continue;
+
+			fields.clear();
+			iface.describeBinary(fields);
+
+			sections.WriteString(name);
+			sections.WritePod((uint32_t)fields.size());
+			for (const auto& field : fields)
+			{
+				sections.WriteString(field.name);
+				sections.WritePod(field.type);
+			}
+			sections.WritePod(recordCount);
+			sections.WritePod((uint64_t)payload.GetBuffer().size());
+			sections.WriteBytes(payload.GetBuffer().data(), payload.GetBuffer().size());
+			sectionCount++;
+		}
+
+		// セクションより前の部分と組み立て（文字列表はセクションを書き終えてから確定する）
+		SceneBinaryFormat::Container container;
+		container.settings = contents.settings;
+		container.ids = contents.ids;
+		container.active.reserve(entityCount);
+		for (Entity e : contents.entities) container.active.push_back((uint8_t)reg.isActiveSelf(e));
+		for (size_t i = 0; i < contents.extras.size() && i < entityCount; ++i)
+		{
+			if (contents.extras[i].is_object() && !contents.extras[i].empty()) container.extras.emplace_back((uint32_t)i, contents.extras[i]);
+		}
+		container.sectionCount = sectionCount;
+
+		SceneBinaryFormat::Write(container, strings.GetStrings(), sections.GetBuffer().data(), sections.GetBuffer().size(), outBytes);
+		return true;
+	}
+
+	bool SceneBinary::FromJson(const json& sceneJson, std::vector<uint8_t>& outBytes)
+	{
+		// ID・Active・登録されていないキー（クッカーに読み込まれていないゲーム側のコンポーネントなど）は SceneBinaryFormat で分ける
+		const auto& interfaces = ComponentRegistry::Instance().GetInterfaces();
+		Contents contents;
+		std::vector<SceneBinaryFormat::JsonEntity> jsonEntities;
+		if (!SceneBinaryFormat::SplitJson(sceneJson, [&interfaces](const std::string& key) { return interfaces.count(key) != 0; }, contents.settings, jsonEntities)) return false;
+
+		Registry reg;
+		for (auto& jsonEntity : jsonEntities)
+		{
+			Entity entity = reg.create();
+			if (!jsonEntity.active) reg.setActive(entity, false);
+			ComponentSerializer::DeserializeEntity(reg, entity, *jsonEntity.source);
+
+			contents.entities.push_back(entity);
+			contents.ids.push_back(jsonEntity.hasId ? jsonEntity.id : (uint32_t)entity);
+			contents.extras.push_back(std::move(jsonEntity.extra));
+		}
+
+		return Write(reg, contents, outBytes);
+	}
+
+	// ====================================================================================
+	// 読み込み
+	// ====================================================================================
+	bool SceneBinary::Parse(const uint8_t* data, size_t size, std::string& outError, bool migrate)
+	{
+		m_data.assign(data, data + size);
+		m_sections.clear();
+
+		// ヘッダー・文字列表・設定・エンティティ表・未登録コンポーネント
+		SceneBinaryFormat::Container container;
+		size_t sectionsOffset = 0;
+		if (!SceneBinaryFormat::Read(m_data.data(), m_data.size(), container, m_strings, sectionsOffset, outError))
+		{
+			m_settings = json();
+			m_ids.clear();
+			m_active.clear();
+			m_extras.clear();
+			return false;
+		}
+		m_settings = std::move(container.settings);
+		m_ids = std::move(container.ids);
+		m_active = std::move(container.active);
+		m_extras = std::move(container.extras);
+
+		BinaryReader reader(m_data.data() + sectionsOffset, m_data.size() - sectionsOffset, &m_strings);
+
+		// セクション
+		const auto& interfaces = ComponentRegistry::Instance().GetInterfaces();
+		std::vector<BinaryField> current;
+		uint32_t sectionIndex = 0;
+		for (; sectionIndex < container.sectionCount; ++sectionIndex)
+		{
+			std::string_view name;
+			uint32_t fieldCount = 0;
+			if (!reader.ReadString(name) || !reader.ReadPod(fieldCount) || fieldCount > reader.GetRemaining() / (sizeof(uint32_t) + sizeof(BinaryFieldType))) break;
+
+			std::vector<BinaryField> fields(fieldCount);
+			for (auto& field : fields)
+			{
+				std::string_view fieldName;
+				if (!reader.ReadString(fieldName) || !reader.ReadPod(field.type)) break;
+				field.name.assign(fieldName.data(), fieldName.size());
+			}
+
+			uint32_t recordCount = 0;
+			uint64_t payloadSize = 0;
+			const uint8_t* payload = (reader.ReadPod(recordCount) && reader.ReadPod(payloadSize) && payloadSize <= reader.GetRemaining()) ? reader.Skip((size_t)payloadSize) : nullptr;
+			if (!payload) break;
+
+			// 登録されていない型（ゲーム側が読み込まれていないなど）は JSON 版と同じく読まない
+			std::string sectionName(name);
+			auto it = interfaces.find(sectionName);
+			if (it == interfaces.end() || !it->second.describeBinary) continue;
+
+			current.clear();
+			it->second.describeBinary(current);
+			bool changed = current != fields;
+			if (changed && !migrate)
+			{
+				outError = "schema of " + sectionName + " has changed";
+				return false;
+			}
+
+			Section section;
+			section.name = std::move(sectionName);
+			section.payload = payload;
+			section.payloadSize = (size_t)payloadSize;
+			section.recordCount = recordCount;
+			if (changed)
+			{
+				section.migrate = true;
+				section.fields = std::move(fields);
+			}
+			m_sections.push_back(std::move(section));
+		}
+		if (reader.IsFailed() || sectionIndex != container.sectionCount)
+		{
+			outError = "section table is truncated";
+			return false;
+		}
+		return true;
+	}
+
+	bool SceneBinary::CreateEntities(Registry& reg, std::vector<Entity>& outEntities) const
+	{
+		outEntities.clear();
+		reg.create(m_ids.size(), outEntities);
+		for (size_t i = 0; i < m_ids.size(); ++i)
+		{
+			if (!m_active[i]) reg.setActive(outEntities[i], false);
+		}
+
+		// 型ごとにまとめてプールへ追加する
+		const auto& interfaces = ComponentRegistry::Instance().GetInterfaces();
+		for (const auto& section : m_sections)
+		{
+			auto it = interfaces.find(section.name);
+			if (it == interfaces.end() || !it->second.readBinary) continue;
+
+			if (section.migrate)
+			{
+				if (!MigrateSection(reg, outEntities.data(), (uint32_t)outEntities.size(), section))
+				{
+					Logger::LogError("Binary scene section is corrupted: " + section.name);
+					return false;
+				}
+				continue;
+			}
+
+			it->second.reserve(reg, section.recordCount);
+			BinaryReader reader(section.payload, section.payloadSize, &m_strings);
+			if (!it->second.readBinary(reg, outEntities.data(), (uint32_t)outEntities.size(), reader, section.recordCount))
+			{
+				Logger::LogError("Binary scene section is corrupted: " + section.name);
+				return false;
+			}
+		}
+
+		for (const auto& [index, extra] : m_extras)
+		{
+			ComponentSerializer::DeserializeEntity(reg, outEntities[index], extra);
+		}
+		return true;
+	}
+
+	bool SceneBinary::MigrateSection(Registry& reg, const Entity* entities, uint32_t entityCount, const Section& section) const
+	{
+		const auto& iface = ComponentRegistry::Instance().GetInterfaces().at(section.name);
+
+		// 書き出した時のフィールドごとに、今のコードでも同じ名前で読めるか
+		std::vector<BinaryField> current;
+		iface.describeBinary(current);
+
+		std::vector<uint8_t> keep(section.fields.size(), 0);
+		for (size_t i = 0; i < section.fields.size(); ++i)
+		{
+			const BinaryField& field = section.fields[i];
+			for (const auto& now : current)
+			{
+				if (now.name != field.name) continue;
+				keep[i] = now.type == field.type || (IsNumberField(now.type) && IsNumberField(field.type));
+				break;
+			}
+		}
+
+		// レコードごとに JSON を通して、今の型の DeserializeVisitor で読む
+		BinaryReader reader(section.payload, section.payloadSize, &m_strings);
+		for (uint32_t r = 0; r < section.recordCount; ++r)
+		{
+			uint32_t index = 0;
+			uint8_t enabled = 1;
+			if (!reader.ReadPod(index) || !reader.ReadPod(enabled) || index >= entityCount) return false;
+
+			json compNode = json::object();
+			compNode["Enabled"] = enabled != 0;
+			for (size_t i = 0; i < section.fields.size(); ++i)
+			{
+				json value = ReadFieldAsJson(reader, section.fields[i].type);
+				if (keep[i]) compNode[section.fields[i].name] = std::move(value);
+			}
+			if (reader.IsFailed()) return false;
+
+			json entityJson;
+			entityJson[section.name] = std::move(compNode);
+			iface.deserialize(reg, entities[index], entityJson);
+		}
+		return true;
+	}
+
+	bool SceneBinary::Instantiate(Registry& reg, EntityIdRemap& outRemap) const
+	{
+		std::vector<Entity> entities;
+		bool result = CreateEntities(reg, entities);
+
+		outRemap.Build(m_ids.data(), entities.data(), std::min(entities.size(), m_ids.size()));
+		return result;
+	}
+
+	json SceneBinary::ToJson() const
+	{
+		json root = m_settings;
+
+		Registry reg;
+		std::vector<Entity> entities;
+		CreateEntities(reg, entities);
+
+		json entitiesJson = json::array();
+		for (size_t i = 0; i < entities.size(); ++i)
+		{
+			json entityJson;
+			entityJson["ID"] = m_ids[i];
+			entityJson["IsActive"] = m_active[i] != 0;
+			ComponentSerializer::SerializeEntity(reg, entities[i], entityJson);
+			entitiesJson.push_back(std::move(entityJson));
+		}
+
+		// 今も登録されていないキーはそのまま戻す
+		for (const auto& [index, extra] : m_extras)
+		{
+			for (const auto& [key, value] : extra.items())
+			{
+				if (!entitiesJson[index].contains(key)) entitiesJson[index][key] = value;
+			}
+		}
+
+		root["Entities"] = std::move(entitiesJson);
+		return root;
+	}
+
+	uint64_t SceneBinary::GetSchemaHash()
+	{
+		uint64_t hash = Hash::Fnv1a64(&VERSION, sizeof(VERSION));
+
+		std::vector<BinaryField> fields;
+		for (const auto& [name, iface] : ComponentRegistry::Instance().GetInterfaces())
+		{
+			if (!iface.describeBinary) continue;
+
+			fields.clear();
+			iface.describeBinary(fields);
+
+			hash = Hash::Fnv1a64(name, hash);
+			for (const auto& field : fields)
+			{
+				hash = Hash::Fnv1a64(field.name, hash);
+				hash = Hash::Fnv1a64(&field.type, sizeof(field.type), hash);
+			}
+		}
+		return hash;
+	}
+
+}	// namespace Arche
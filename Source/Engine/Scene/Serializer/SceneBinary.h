@@ -0,0 +1,112 @@
+﻿/*****************************************************************//**
+ * @file	SceneBinary.h
+ * @brief	バイナリ形式のシーン (.ascene)
+ *
+ * @details	REFLECT_VAR のリフレクション情報から読み書きする、ランタイム向けのシーン形式。
+ *			JSON は編集・差分用の形式としてそのまま残し、こちらはクッカーが書き出す。
+ *			例: GameScene.json → GameScene.json.ascene
+ *
+ *			構成:
+ *			- ヘッダー（マジック・バージョン・各数）
+ *			- 文字列表（文字列のフィールドは番号だけを持つ）
+ *			- 設定（環境・物理・システム。Entities 以外の JSON を MessagePack で）
+ *			- エンティティ表（保存時のID・Active）
+ *			- 登録されていないコンポーネント（ゲーム側のものなど。エンティティごとの MessagePack）
+ *			- コンポーネント型ごとのセクション（スキーマ + レコード）
+ *
+ *			読み込みはセクションごとにプールへまとめて追加するので、
+ *			エンティティごとに全コンポーネント型の有無を調べる JSON 版より速い。
+ *			スキーマ（フィールドの名前と型の並び）が今のコードと違うセクションがあれば読み込みを失敗させ、
+ *			呼び出し元はソースの JSON を読み直す。
+ *			ホットリロードのようにソースが無い場合は、フィールドの名前で合わせて読み替えられる（Parse の migrate）。
+ *			セクションより前の部分（ヘッダー〜未登録コンポーネント）の読み書きは SceneBinaryFormat にある。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___SCENE_BINARY_H___
+#define ___SCENE_BINARY_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Scene/Core/ECS/ECS.h"
+#include "Engine/Scene/Serializer/SceneEntityLoader.h"
+#include "Engine/Scene/Serializer/BinaryStream.h"
+#include "Engine/Scene/Serializer/SceneBinaryFormat.h"
+#include <string_view>
+
+namespace Arche
+{
+	class ARCHE_API SceneBinary
+	{
+	public:
+		static constexpr uint32_t MAGIC = SceneBinaryFormat::MAGIC;
+		static constexpr uint32_t VERSION = SceneBinaryFormat::VERSION;
+		static constexpr const char* EXTENSION = SceneBinaryFormat::EXTENSION;
+
+		SceneBinary() = default;
+		// 文字列表とセクションは m_data を指すのでコピーしない
+		SceneBinary(const SceneBinary&) = delete;
+		SceneBinary& operator=(const SceneBinary&) = delete;
+
+		// 書き出す内容
+		struct Contents
+		{
+			json settings = json::object();	// Entities 以外（SceneName, Environment, Physics, Systems）
+			std::vector<Entity> entities;	// 書き出すエンティティ（この順に並ぶ）
+			std::vector<uint32_t> ids;		// 保存時のID（JSON の "ID"。Relationship などはこの番号を指す）
+			std::vector<json> extras;		// エンティティごとの未登録コンポーネント（空なら無し）
+		};
+
+		static bool Write(Registry& reg, const Contents& contents, std::vector<uint8_t>& outBytes);
+		// シーンJSONから（クッカー用）
+		static bool FromJson(const json& sceneJson, std::vector<uint8_t>& outBytes);
+
+		// ヘッダー・文字列表・スキーマを検証する（ワーカースレッドから呼べる）
+		// migrate: スキーマが変わったセクションも失敗にせず、同じ名前のフィールドだけを読み替える
+		//          （無くなったフィールドは捨て、増えたフィールドは既定値のまま。型が変わったものは数値どうしだけ読む）
+		bool Parse(const uint8_t* data, size_t size, std::string& outError, bool migrate = false);
+
+		// エンティティを作り、コンポーネントを型ごとにまとめて追加する
+		// outRemap: 保存時のID → 作ったエンティティ（親子関係の付け替えは呼び出し元で ResolveRelationships）
+		bool Instantiate(Registry& reg, EntityIdRemap& outRemap) const;
+
+		// JSON 形式に戻す（アセット収集など、JSON を前提にした処理用）
+		json ToJson() const;
+
+		const json& GetSettings() const { return m_settings; }
+		uint32_t GetEntityCount() const { return (uint32_t)m_ids.size(); }
+
+		// 登録済みコンポーネント全体のスキーマのハッシュ（変わったらクックし直す）
+		static uint64_t GetSchemaHash();
+
+	private:
+		struct Section
+		{
+			std::string name;
+			const uint8_t* payload = nullptr;
+			size_t payloadSize = 0;
+			uint32_t recordCount = 0;
+			bool migrate = false;				// スキーマが変わっていて、フィールドの名前で読み替える
+			std::vector<BinaryField> fields;	// 書き出した時のスキーマ（migrate のときだけ）
+		};
+
+		bool CreateEntities(Registry& reg, std::vector<Entity>& outEntities) const;
+		// スキーマが変わったセクションを、フィールドの名前で合わせて読む
+		bool MigrateSection(Registry& reg, const Entity* entities, uint32_t entityCount, const Section& section) const;
+
+	private:
+		std::vector<uint8_t> m_data;			// ファイルの中身（文字列表とセクションはここを指す）
+		std::vector<std::string_view> m_strings;
+		json m_settings;
+		std::vector<uint32_t> m_ids;
+		std::vector<uint8_t> m_active;
+		std::vector<std::pair<uint32_t, json>> m_extras;
+		std::vector<Section> m_sections;
+	};
+
+}	// namespace Arche
+
+#endif // !___SCENE_BINARY_H___
@@ -0,0 +1,259 @@
+﻿/*****************************************************************//**
+ * @file	SceneBinaryFormat.cpp
+ * @brief	バイナリシーン (.ascene) のコンポーネント以外の部分
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+// pch.h は含めない（Tests/ からもビルドする。vcxproj でもプリコンパイル済みヘッダーを使わない）
+#include "Engine/Scene/Serializer/SceneBinaryFormat.h"
+#include <cstring>
+
+namespace Arche
+{
+	namespace SceneBinaryFormat
+	{
+		namespace
+		{
+			void AppendBytes(std::vector<uint8_t>& out, const void* data, size_t size)
+			{
+				if (size == 0) return;
+				const size_t old = out.size();
+				out.resize(old + size);
+				std::memcpy(out.data() + old, data, size);
+			}
+
+			template<typename T>
+			void AppendPod(std::vector<uint8_t>& out, const T& value)
+			{
+				AppendBytes(out, &value, sizeof(T));
+			}
+
+			// 範囲チェック付きの読み込み（BinaryReader と同じく、はみ出したら以降はすべて失敗）
+			class ByteReader
+			{
+			public:
+				ByteReader(const uint8_t* data, size_t size) : m_begin(data), m_current(data), m_end(data + size) {}
+
+				const uint8_t* Skip(size_t size)
+				{
+					if (m_failed || size > (size_t)(m_end - m_current))
+					{
+						m_failed = true;
+						return nullptr;
+					}
+					const uint8_t* position = m_current;
+					m_current += size;
+					return position;
+				}
+
+				template<typename T>
+				bool ReadPod(T& value)
+				{
+					const uint8_t* bytes = Skip(sizeof(T));
+					if (bytes) std::memcpy(&value, bytes, sizeof(T));
+					return bytes != nullptr;
+				}
+
+				bool IsFailed() const { return m_failed; }
+				size_t GetRemaining() const { return (size_t)(m_end - m_current); }
+				size_t GetOffset() const { return (size_t)(m_current - m_begin); }
+
+			private:
+				const uint8_t* m_begin;
+				const uint8_t* m_current;
+				const uint8_t* m_end;
+				bool m_failed = false;
+			};
+		}
+
+		void Write(const Container& container, const std::vector<std::string>& strings, const uint8_t* sections, size_t sectionsSize, std::vector<uint8_t>& outBytes)
+		{
+			const size_t entityCount = container.ids.size();
+
+			std::vector<uint8_t> settings = nlohmann::json::to_msgpack(container.settings);
+
+			nlohmann::json extras = nlohmann::json::array();
+			for (const auto& [index, extra] : container.extras)
+			{
+				if (index < entityCount && extra.is_object() && !extra.empty()) extras.push_back({ index, extra });
+			}
+			std::vector<uint8_t> extrasBytes;
+			if (!extras.empty()) extrasBytes = nlohmann::json::to_msgpack(extras);
+
+			std::vector<uint8_t> out;
+			Header header = {};
+			header.magic = MAGIC;
+			header.version = VERSION;
+			header.stringCount = (uint32_t)strings.size();
+			header.entityCount = (uint32_t)entityCount;
+			header.sectionCount = container.sectionCount;
+			AppendPod(out, header);
+
+			for (const auto& str : strings)
+			{
+				AppendPod(out, (uint32_t)str.size());
+				AppendBytes(out, str.data(), str.size());
+			}
+
+			AppendPod(out, (uint32_t)settings.size());
+			AppendBytes(out, settings.data(), settings.size());
+
+			AppendBytes(out, container.ids.data(), entityCount * sizeof(uint32_t));
+			for (size_t i = 0; i < entityCount; ++i) AppendPod(out, (uint8_t)(i < container.active.size() ? container.active[i] != 0 : 1));
+
+			AppendPod(out, (uint32_t)extrasBytes.size());
+			AppendBytes(out, extrasBytes.data(), extrasBytes.size());
+
+			AppendBytes(out, sections, sectionsSize);
+
+			outBytes = std::move(out);
+		}
+
+		bool Read(const uint8_t* data, size_t size, Container& outContainer, std::vector<std::string_view>& outStrings, size_t& outSectionsOffset, std::string& outError)
+		{
+			outContainer = Container();
+			outStrings.clear();
+			outSectionsOffset = 0;
+
+			ByteReader reader(data, size);
+
+			Header header = {};
+			if (!reader.ReadPod(header) || header.magic != MAGIC)
+			{
+				outError = "not a binary scene";
+				return false;
+			}
+			if (header.version != VERSION)
+			{
+				outError = "unsupported version " + std::to_string(header.version);
+				return false;
+			}
+
+			// 文字列表
+			if (header.stringCount > reader.GetRemaining() / sizeof(uint32_t))
+			{
+				outError = "string table is truncated";
+				return false;
+			}
+			outStrings.reserve(header.stringCount);
+			for (uint32_t i = 0; i < header.stringCount; ++i)
+			{
+				uint32_t length = 0;
+				if (!reader.ReadPod(length)) break;
+				const uint8_t* str = reader.Skip(length);
+				if (!str) break;
+				outStrings.emplace_back((const char*)str, length);
+			}
+			if (reader.IsFailed())
+			{
+				outError = "string table is truncated";
+				return false;
+			}
+
+			// 設定
+			uint32_t settingsSize = 0;
+			const uint8_t* settings = reader.ReadPod(settingsSize) ? reader.Skip(settingsSize) : nullptr;
+			if (settings) outContainer.settings = nlohmann::json::from_msgpack(settings, settings + settingsSize, true, false);
+			if (!settings || outContainer.settings.is_discarded())
+			{
+				outError = "settings block is invalid";
+				return false;
+			}
+
+			// エンティティ表
+			if (header.entityCount > reader.GetRemaining() / (sizeof(uint32_t) + sizeof(uint8_t)))
+			{
+				outError = "entity table is truncated";
+				return false;
+			}
+			outContainer.ids.resize(header.entityCount);
+			outContainer.active.resize(header.entityCount);
+			if (header.entityCount > 0)
+			{
+				std::memcpy(outContainer.ids.data(), reader.Skip(header.entityCount * sizeof(uint32_t)), header.entityCount * sizeof(uint32_t));
+				std::memcpy(outContainer.active.data(), reader.Skip(header.entityCount), header.entityCount);
+			}
+
+			// 未登録コンポーネント
+			uint32_t extrasSize = 0;
+			const uint8_t* extras = reader.ReadPod(extrasSize) ? reader.Skip(extrasSize) : nullptr;
+			if (!extras)
+			{
+				outError = "entity table is truncated";
+				return false;
+			}
+			if (extrasSize > 0)
+			{
+				nlohmann::json items = nlohmann::json::from_msgpack(extras, extras + extrasSize, true, false);
+				if (!items.is_array())
+				{
+					outError = "extra components are invalid";
+					return false;
+				}
+				for (auto& item : items)
+				{
+					if (!item.is_array() || item.size() != 2 || !item[0].is_number_unsigned() || item[0].get<uint64_t>() >= header.entityCount || !item[1].is_object())
+					{
+						outError = "extra components are invalid";
+						return false;
+					}
+					outContainer.extras.emplace_back(item[0].get<uint32_t>(), std::move(item[1]));
+				}
+			}
+
+			outContainer.sectionCount = header.sectionCount;
+			outSectionsOffset = reader.GetOffset();
+			return true;
+		}
+
+		bool SplitJson(const nlohmann::json& sceneJson, const std::function<bool(const std::string&)>& isComponent,
+			nlohmann::json& outSettings, std::vector<JsonEntity>& outEntities)
+		{
+			outEntities.clear();
+			if (!sceneJson.is_object()) return false;
+
+			outSettings = sceneJson;
+			outSettings.erase("Entities");
+
+			auto entities = sceneJson.find("Entities");
+			if (entities == sceneJson.end() || !entities->is_array()) return true;
+
+			outEntities.reserve(entities->size());
+			for (const auto& entityJson : *entities)
+			{
+				if (!entityJson.is_object()) continue;
+
+				JsonEntity entity;
+				entity.source = &entityJson;
+
+				auto id = entityJson.find("ID");
+				if (id != entityJson.end() && id->is_number_unsigned())
+				{
+					entity.hasId = true;
+					entity.id = id->get<uint32_t>();
+				}
+
+				auto active = entityJson.find("IsActive");
+				if (active != entityJson.end() && active->is_boolean()) entity.active = active->get<bool>();
+
+				// 登録されていないキー（クッカーに読み込まれていないゲーム側のコンポーネントなど）は JSON のまま持つ
+				for (const auto& [key, value] : entityJson.items())
+				{
+					if (key == "ID" || key == "IsActive" || (isComponent && isComponent(key))) continue;
+					entity.extra[key] = value;
+				}
+
+				outEntities.push_back(std::move(entity));
+			}
+			return true;
+		}
+
+	}	// namespace SceneBinaryFormat
+
+}	// namespace Arche
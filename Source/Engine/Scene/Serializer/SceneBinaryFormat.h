@@ -0,0 +1,92 @@
+﻿/*****************************************************************//**
+ * @file	SceneBinaryFormat.h
+ * @brief	バイナリシーン (.ascene) のコンポーネント以外の部分
+ *
+ * @details	SceneBinary のうち、ComponentRegistry を使わない部分をここに置く。
+ *			- ヘッダー・文字列表・設定・エンティティ表・未登録コンポーネントの読み書き
+ *			- シーンJSON をエンティティごとの ID / Active / 未登録コンポーネントと設定に分ける
+ *			コンポーネント型ごとのセクションの中身は SceneBinary が作る・読む（ここでは前後の枠だけを扱う）。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___SCENE_BINARY_FORMAT_H___
+#define ___SCENE_BINARY_FORMAT_H___
+
+// ===== インクルード =====
+// 標準ライブラリと nlohmann/json だけで書く（pch.h を含めず、Tests/ からも使えるように）
+#include <json.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Arche
+{
+	namespace SceneBinaryFormat
+	{
+		static constexpr uint32_t MAGIC = 0x4E435341;	// "ASCN"
+		static constexpr uint32_t VERSION = 1;
+		static constexpr const char* EXTENSION = ".ascene";
+
+		struct Header
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint32_t stringCount;
+			uint32_t entityCount;
+			uint32_t sectionCount;
+			uint32_t reserved;
+		};
+
+		// セクションより前の部分
+		struct Container
+		{
+			nlohmann::json settings = nlohmann::json::object();			// Entities 以外（SceneName, Environment, Physics, Systems）
+			std::vector<uint32_t> ids;									// 保存時のID
+			std::vector<uint8_t> active;								// ids と同じ数
+			std::vector<std::pair<uint32_t, nlohmann::json>> extras;	// エンティティの番号 → 未登録コンポーネント
+			uint32_t sectionCount = 0;
+		};
+
+		/**
+		 * @brief	ファイル全体を組み立てる
+		 * @param	strings		セクションが番号で参照している文字列表
+		 * @param	sections	セクションを並べたバイト列（container.sectionCount 個）
+		 */
+		void Write(const Container& container, const std::vector<std::string>& strings, const uint8_t* sections, size_t sectionsSize, std::vector<uint8_t>& outBytes);
+
+		/**
+		 * @brief	セクションの手前までを検証しながら読む
+		 * @param	outStrings			data を指す（data を捨てるまで有効）
+		 * @param	outSectionsOffset	セクションの先頭位置
+		 */
+		bool Read(const uint8_t* data, size_t size, Container& outContainer, std::vector<std::string_view>& outStrings, size_t& outSectionsOffset, std::string& outError);
+
+		// シーンJSON のエンティティ1つ分（コンポーネントは source から読む）
+		struct JsonEntity
+		{
+			const nlohmann::json* source = nullptr;
+			bool hasId = false;
+			uint32_t id = 0;
+			bool active = true;
+			nlohmann::json extra = nlohmann::json::object();	// 登録されていないキー（ID / IsActive 以外）
+		};
+
+		/**
+		 * @brief	シーンJSON を設定とエンティティに分ける（オブジェクトでないエンティティは飛ばす）
+		 * @param	isComponent	登録済みのコンポーネント名か
+		 */
+		bool SplitJson(const nlohmann::json& sceneJson, const std::function<bool(const std::string&)>& isComponent,
+			nlohmann::json& outSettings, std::vector<JsonEntity>& outEntities);
+
+	}	// namespace SceneBinaryFormat
+
+}	// namespace Arche
+
+#endif // !___SCENE_BINARY_FORMAT_H___
@@ -0,0 +1,200 @@
+﻿/*****************************************************************//**
+ * @file	SceneEntityLoader.cpp
+ * @brief	シーンJSONのエンティティを段階的に構築する
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Scene/Serializer/SceneEntityLoader.h"
+#include "Engine/Scene/Serializer/ComponentRegistry.h"
+#include "Engine/Scene/Serializer/ComponentSerializer.h"
+#include "Engine/Scene/Components/Components.h"
+
+namespace Arche
+{
+	namespace
+	{
+		// これより少ないエンティティは分けずにメインスレッドで復元する
+		constexpr size_t MIN_CHUNK_SIZE = 512;
+		constexpr size_t MAX_WORKERS = 16;
+
+		// 1チャンクぶんの復元結果
+		struct Chunk
+		{
+			size_t begin = 0;
+			size_t count = 0;
+			Registry staging;				// 作業用（ここにだけ書くのでスレッド間で共有しない）
+			std::vector<Entity> entities;	// staging 側のエンティティ（ファイルの順）
+			std::vector<uint32_t> ids;		// 保存時のID
+			std::vector<uint8_t> active;
+		};
+
+		void DecodeChunk(const json& entitiesJson, Chunk& chunk)
+		{
+			chunk.staging.create(chunk.count, chunk.entities);
+			chunk.ids.resize(chunk.count);
+			chunk.active.resize(chunk.count);
+
+			for (size_t i = 0; i < chunk.count; ++i)
+			{
+				const json& entityJson = entitiesJson[chunk.begin + i];
+				chunk.ids[i] = entityJson["ID"].get<uint32_t>();
+				chunk.active[i] = entityJson.contains("IsActive") ? (uint8_t)entityJson["IsActive"].get<bool>() : 1;
+
+				ComponentSerializer::DeserializeEntity(chunk.staging, chunk.entities[i], entityJson);
+			}
+		}
+	}
+
+	// ====================================================================================
+	// ID の付け替え
+	// ====================================================================================
+	void EntityIdRemap::Build(const uint32_t* ids, const Entity* entities, size_t count)
+	{
+		m_dense.clear();
+		m_sorted.clear();
+		m_entities.assign(entities, entities + count);
+
+		uint32_t maxId = 0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (ids[i] != NullEntity) maxId = std::max(maxId, ids[i]);
+		}
+
+		// エディタが保存したシーンのIDはほぼ連番なので、たいていは平らな表になる
+		if ((size_t)maxId < count * DENSE_LIMIT + 1024)
+		{
+			m_dense.assign((size_t)maxId + 1, NullEntity);
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (ids[i] != NullEntity) m_dense[ids[i]] = entities[i];
+			}
+			return;
+		}
+
+		m_sorted.reserve(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (ids[i] != NullEntity) m_sorted.emplace_back(ids[i], entities[i]);
+		}
+		// 同じIDは後のものを残す
+		std::stable_sort(m_sorted.begin(), m_sorted.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+		auto last = std::unique(m_sorted.rbegin(), m_sorted.rend(), [](const auto& a, const auto& b) { return a.first == b.first; });
+		m_sorted.erase(m_sorted.begin(), last.base());
+	}
+
+	Entity EntityIdRemap::Find(uint32_t id) const
+	{
+		if (!m_sorted.empty())
+		{
+			auto it = std::lower_bound(m_sorted.begin(), m_sorted.end(), id, [](const auto& entry, uint32_t value) { return entry.first < value; });
+			return it != m_sorted.end() && it->first == id ? it->second : NullEntity;
+		}
+		return id < m_dense.size() ? m_dense[id] : NullEntity;
+	}
+
+	void EntityIdRemap::ResolveRelationships(Registry& reg) const
+	{
+		if (!reg.hasPool<Relationship>()) return;
+
+		auto& pool = reg.getPool<Relationship>();
+		for (Entity entity : m_entities)
+		{
+			if (!pool.has(entity)) continue;
+			auto& rel = pool.get(entity);
+
+			// 親IDの解決
+			if (rel.parent != NullEntity) rel.parent = Find((uint32_t)rel.parent);
+
+			// 子IDリストの解決（その場で詰める）
+			size_t kept = 0;
+			for (Entity oldChild : rel.children)
+			{
+				Entity child = Find((uint32_t)oldChild);
+				if (child != NullEntity) rel.children[kept++] = child;
+			}
+			rel.children.resize(kept);
+		}
+	}
+
+	// ====================================================================================
+	// 読み込み
+	// ====================================================================================
+	void SceneEntityLoader::Load(Registry& reg, const json& entitiesJson, EntityIdRemap& outRemap, size_t workerCount)
+	{
+		const size_t total = entitiesJson.is_array() ? entitiesJson.size() : 0;
+		if (total == 0)
+		{
+			outRemap.Build(nullptr, nullptr, 0);
+			return;
+		}
+
+		if (workerCount == 0)
+		{
+			workerCount = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, MAX_WORKERS);
+		}
+		const size_t chunkCount = std::clamp<size_t>(total / MIN_CHUNK_SIZE, 1, workerCount);
+
+		// コンポーネントの型IDはここで確定させておく（型IDの採番はスレッドセーフではない）
+		const auto& interfaces = ComponentRegistry::Instance().GetInterfaces();
+		if (chunkCount > 1)
+		{
+			Registry warmup;
+			for (const auto& [name, iface] : interfaces) iface.reserve(warmup, 0);
+		}
+
+		// 1. チャンクごとに復元（先頭のチャンクはメインスレッドで受け持つ）
+		std::vector<Chunk> chunks(chunkCount);
+		for (size_t i = 0; i < chunkCount; ++i)
+		{
+			chunks[i].begin = total * i / chunkCount;
+			chunks[i].count = total * (i + 1) / chunkCount - chunks[i].begin;
+		}
+
+		{
+			std::vector<std::future<void>> futures;
+			futures.reserve(chunkCount - 1);
+			for (size_t i = 1; i < chunkCount; ++i)
+			{
+				futures.push_back(std::async(std::launch::async, [&entitiesJson, &chunk = chunks[i]]() { DecodeChunk(entitiesJson, chunk); }));
+			}
+			DecodeChunk(entitiesJson, chunks[0]);
+
+			// 壊れたエンティティがあれば例外をそのまま呼び出し元へ（シリアルで読んだときと同じ）
+			for (auto& f : futures) f.get();
+		}
+
+		// 2. まとめて作り、型ごとにプールへ移す
+		std::vector<Entity> entities;
+		reg.create(total, entities);
+
+		std::vector<uint32_t> ids(total);
+		for (const auto& chunk : chunks)
+		{
+			std::copy(chunk.ids.begin(), chunk.ids.end(), ids.begin() + chunk.begin);
+			for (size_t i = 0; i < chunk.count; ++i)
+			{
+				if (!chunk.active[i]) reg.setActive(entities[chunk.begin + i], false);
+			}
+		}
+
+		for (const auto& [name, iface] : interfaces)
+		{
+			for (auto& chunk : chunks)
+			{
+				iface.moveBatch(chunk.staging, chunk.entities.data(), reg, entities.data() + chunk.begin, chunk.count);
+			}
+		}
+
+		// 3. 保存時のIDで書かれた親子関係を付け替える
+		outRemap.Build(ids.data(), entities.data(), total);
+		outRemap.ResolveRelationships(reg);
+	}
+
+}	// namespace Arche
@@ -0,0 +1,62 @@
+﻿/*****************************************************************//**
+ * @file	SceneEntityLoader.h
+ * @brief	シーンJSONのエンティティを段階的に構築する
+ *
+ * @details	1. エンティティの並びをチャンクに分け、ワーカースレッドごとに作業用のレジストリへ
+ *			   コンポーネントを復元する（JSON の読み取りが重いのでここを並列にする）。
+ *			2. メインスレッドでエンティティをまとめて作り、コンポーネント型ごとに
+ *			   作業用レジストリから本番のプールへ移す。
+ *			3. 保存時のID → エンティティの付け替えは、ハッシュではなく平らな表で行う。
+ *
+ *			EntityIdRemap はバイナリシーン (SceneBinary::Instantiate) でも使う。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___SCENE_ENTITY_LOADER_H___
+#define ___SCENE_ENTITY_LOADER_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Scene/Core/ECS/ECS.h"
+
+namespace Arche
+{
+	// 保存時のID → 作ったエンティティ
+	class ARCHE_API EntityIdRemap
+	{
+	public:
+		// ids[i] → entities[i]（同じIDが複数あれば後のものが勝つ）
+		void Build(const uint32_t* ids, const Entity* entities, size_t count);
+
+		// 見つからなければ NullEntity
+		Entity Find(uint32_t id) const;
+
+		// 作ったエンティティの Relationship を付け替える（見つからない親・子は外す）
+		void ResolveRelationships(Registry& reg) const;
+
+		size_t GetCount() const { return m_entities.size(); }
+		const std::vector<Entity>& GetEntities() const { return m_entities; }
+
+	private:
+		// IDの最大値がエンティティ数のこの倍を超えたら、平らな表をやめて並べた表を二分探索する
+		static constexpr size_t DENSE_LIMIT = 4;
+
+		std::vector<Entity> m_dense;						// m_dense[保存時のID]
+		std::vector<std::pair<uint32_t, Entity>> m_sorted;	// IDが飛び飛びのとき（IDの昇順）
+		std::vector<Entity> m_entities;						// 作ったエンティティ（ファイルの順）
+	};
+
+	class ARCHE_API SceneEntityLoader
+	{
+	public:
+		// シーンJSONの "Entities" 配列から作る
+		// workerCount: 復元に使うスレッド数（0 ならコア数から決める、1 ならメインスレッドだけ）
+		static void Load(Registry& reg, const json& entitiesJson, EntityIdRemap& outRemap, size_t workerCount = 0);
+	};
+
+}	// namespace Arche
+
+#endif // !___SCENE_ENTITY_LOADER_H___
@@ -0,0 +1,202 @@
+﻿/*****************************************************************//**
+ * @file	SceneManifest.cpp
+ * @brief	シーンが参照するアセットの一覧（依存マニフェスト）
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Scene/Serializer/SceneManifest.h"
+#include "Engine/Scene/Serializer/SceneSerializer.h"
+#include "Engine/Resource/ResourceManager.h"
+#include "Engine/Resource/VirtualFileSystem.h"
+#include "Engine/Core/Base/Hash.h"
+#include "Engine/Core/Base/Logger.h"
+
+namespace Arche
+{
+	namespace
+	{
+		const char* GetTypeName(SceneManifest::AssetType type)
+		{
+			switch (type)
+			{
+			case SceneManifest::AssetType::Model:		return "Model";
+			case SceneManifest::AssetType::Texture:		return "Texture";
+			case SceneManifest::AssetType::Sound:		return "Sound";
+			case SceneManifest::AssetType::Controller:	return "Controller";
+			default:									return "";
+			}
+		}
+
+		bool ParseType(const std::string& name, SceneManifest::AssetType& out)
+		{
+			for (auto type : { SceneManifest::AssetType::Model, SceneManifest::AssetType::Texture, SceneManifest::AssetType::Sound, SceneManifest::AssetType::Controller })
+			{
+				if (name == GetTypeName(type)) { out = type; return true; }
+			}
+			return false;
+		}
+
+		// マニフェストを鮮度の確認なしで読む
+		bool ReadManifest(const std::string& manifestPath, SceneManifest& out)
+		{
+			std::string text;
+			if (!VirtualFileSystem::Instance().ReadText(manifestPath, text)) return false;
+
+			json root = json::parse(text, nullptr, false);
+			if (root.is_discarded() || root.value("Version", 0u) != SceneManifest::VERSION) return false;
+			if (!root.contains("Assets") || !root["Assets"].is_array()) return false;
+
+			out.assets.clear();
+			for (const auto& item : root["Assets"])
+			{
+				SceneManifest::Asset asset;
+				if (!ParseType(item.value("Type", ""), asset.type)) continue;
+				asset.key = item.value("Key", "");
+				asset.size = item.value("Size", (uint64_t)0);
+				asset.hash = item.value("Hash", (uint64_t)0);
+				if (!asset.key.empty()) out.assets.push_back(std::move(asset));
+			}
+			return true;
+		}
+
+		std::string ResolveAssetPath(const SceneManifest::Asset& asset)
+		{
+			auto& rm = ResourceManager::Instance();
+			switch (asset.type)
+			{
+			case SceneManifest::AssetType::Model:	return rm.ResolvePath(ResourceCategory::Model, asset.key);
+			case SceneManifest::AssetType::Texture:	return rm.ResolvePath(ResourceCategory::Texture, asset.key);
+			case SceneManifest::AssetType::Sound:	return rm.ResolvePath(ResourceCategory::Sound, asset.key);
+			default:								return asset.key;
+			}
+		}
+	}
+
+	void SceneManifest::Add(AssetType type, const std::string& key)
+	{
+		if (key.empty()) return;
+		for (const auto& asset : assets) if (asset.type == type && asset.key == key) return;
+
+		Asset asset;
+		asset.type = type;
+		asset.key = key;
+		assets.push_back(std::move(asset));
+	}
+
+	SceneManifest SceneManifest::Collect(const json& sceneJson)
+	{
+		std::vector<std::string> models, textures, sounds, controllers;
+		SceneSerializer::CollectAssets(sceneJson, models, textures, sounds, controllers);
+
+		SceneManifest manifest;
+		for (const auto& key : models)		manifest.Add(AssetType::Model, key);
+		for (const auto& key : textures)	manifest.Add(AssetType::Texture, key);
+		for (const auto& key : sounds)		manifest.Add(AssetType::Sound, key);
+		for (const auto& key : controllers)	manifest.Add(AssetType::Controller, key);
+		return manifest;
+	}
+
+	SceneManifest SceneManifest::Build(const json& sceneJson, const std::string& scenePath)
+	{
+		SceneManifest manifest = Collect(sceneJson);
+
+		// 前回のハッシュ（マニフェストより後に更新されたファイルは計算し直す）
+		std::string manifestPath = GetManifestPath(scenePath);
+		SceneManifest previous;
+		std::error_code ec;
+		auto previousTime = std::filesystem::last_write_time(manifestPath, ec);
+		if (ec || !ReadManifest(manifestPath, previous)) previous.assets.clear();
+
+		auto& vfs = VirtualFileSystem::Instance();
+		for (auto& asset : manifest.assets)
+		{
+			std::string path = ResolveAssetPath(asset);
+			if (path.empty()) continue;
+
+			asset.size = vfs.GetFileSize(path);
+
+			auto it = std::find_if(previous.assets.begin(), previous.assets.end(), [&](const Asset& a) {
+				return a.type == asset.type && a.key == asset.key;
+				});
+			if (it != previous.assets.end() && it->size == asset.size && it->hash != 0)
+			{
+				std::error_code timeEc;
+				auto assetTime = std::filesystem::last_write_time(path, timeEc);
+				if (!timeEc && assetTime <= previousTime)
+				{
+					asset.hash = it->hash;
+					continue;
+				}
+			}
+
+			FileView file;
+			if (vfs.Open(path, file)) asset.hash = Hash::Fnv1a64(file.GetData(), file.GetSize());
+		}
+		return manifest;
+	}
+
+	bool SceneManifest::Save(const std::string& scenePath) const
+	{
+		json root;
+		root["Version"] = VERSION;
+		root["Assets"] = json::array();
+		for (const auto& asset : assets)
+		{
+			json item;
+			item["Type"] = GetTypeName(asset.type);
+			item["Key"] = asset.key;
+			item["Size"] = asset.size;
+			item["Hash"] = asset.hash;
+			root["Assets"].push_back(std::move(item));
+		}
+
+		std::string path = GetManifestPath(scenePath);
+		std::ofstream fout(path);
+		if (!fout.is_open())
+		{
+			Logger::LogError("Failed to save scene manifest: " + path);
+			return false;
+		}
+		fout << root.dump();
+		return true;
+	}
+
+	bool SceneManifest::Load(const std::string& scenePath, SceneManifest& out)
+	{
+		std::string manifestPath = GetManifestPath(scenePath);
+
+		// パックに入っているものはビルド時にシーンと一緒に入れたものなのでそのまま使う
+		if (!VirtualFileSystem::Instance().IsArchived(manifestPath))
+		{
+			std::error_code ec;
+			auto manifestTime = std::filesystem::last_write_time(manifestPath, ec);
+			if (ec) return false;
+
+			std::error_code sceneEc;
+			auto sceneTime = std::filesystem::last_write_time(scenePath, sceneEc);
+			if (!sceneEc && sceneTime > manifestTime) return false;
+		}
+
+		return ReadManifest(manifestPath, out);
+	}
+
+	void SceneManifest::GetKeys(AssetType type, std::vector<std::string>& outKeys) const
+	{
+		for (const auto& asset : assets) if (asset.type == type) outKeys.push_back(asset.key);
+	}
+
+	uint64_t SceneManifest::GetTotalSize() const
+	{
+		uint64_t total = 0;
+		for (const auto& asset : assets) total += asset.size;
+		return total;
+	}
+
+}	// namespace Arche
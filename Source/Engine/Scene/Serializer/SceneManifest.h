@@ -0,0 +1,70 @@
+﻿/*****************************************************************//**
+ * @file	SceneManifest.h
+ * @brief	シーンが参照するアセットの一覧（依存マニフェスト）
+ *
+ * @details	SaveScene がシーンの隣に書き出す（例: GameScene.json → GameScene.json.deps）。
+ *			アセットのキー・種類・サイズ・内容ハッシュだけを持つ小さなファイルで、
+ *			LoadSceneAsync はシーン本体やアニメーターコントローラーを開かずに先読みを始められる。
+ *			シーンより古い（外部で編集された等）マニフェストは使わず、シーン本体から集め直す。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___SCENE_MANIFEST_H___
+#define ___SCENE_MANIFEST_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+
+namespace Arche
+{
+	class ARCHE_API SceneManifest
+	{
+	public:
+		static constexpr uint32_t VERSION = 1;
+		static constexpr const char* EXTENSION = ".deps";
+
+		enum class AssetType
+		{
+			Model,
+			Texture,
+			Sound,
+			Controller,
+		};
+
+		struct Asset
+		{
+			AssetType type = AssetType::Model;
+			std::string key;		// シーンに書かれているキー
+			uint64_t size = 0;		// 解決後のファイルサイズ（見つからなければ 0）
+			uint64_t hash = 0;		// 内容のハッシュ（見つからなければ 0）
+		};
+
+		std::vector<Asset> assets;
+
+		static std::string GetManifestPath(const std::string& scenePath) { return scenePath + EXTENSION; }
+
+		// 読み込み済みのシーンJSONから集める（キーのみ。重複は除く）
+		static SceneManifest Collect(const json& sceneJson);
+
+		// Collect + 各アセットのサイズとハッシュ（保存時用）
+		// 前回のマニフェストがあれば、それ以降に更新されていないファイルのハッシュは使い回す
+		static SceneManifest Build(const json& sceneJson, const std::string& scenePath);
+
+		bool Save(const std::string& scenePath) const;
+
+		// シーンと同じか新しいマニフェストがあれば読む
+		static bool Load(const std::string& scenePath, SceneManifest& out);
+
+		void GetKeys(AssetType type, std::vector<std::string>& outKeys) const;
+		uint64_t GetTotalSize() const;
+
+	private:
+		void Add(AssetType type, const std::string& key);
+	};
+
+}	// namespace Arche
+
+#endif // !___SCENE_MANIFEST_H___
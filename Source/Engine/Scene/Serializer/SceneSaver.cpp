@@ -0,0 +1,263 @@
+﻿/*****************************************************************//**
+ * @file	SceneSaver.cpp
+ * @brief	シーンの保存（スナップショットを取ってワーカーで書き出す）
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Scene/Serializer/SceneSaver.h"
+#include "Engine/Scene/Serializer/ComponentRegistry.h"
+#include "Engine/Scene/Serializer/ComponentSerializer.h"
+#include "Engine/Scene/Serializer/SceneManifest.h"
+#include "Engine/Scene/Core/SceneManager.h"
+#include "Engine/Scene/Components/Components.h"
+
+namespace Arche
+{
+	struct SceneSaver::Result
+	{
+		SceneManifest manifest;
+		std::string error;
+	};
+
+	// ====================================================================================
+	// スナップショット
+	// ====================================================================================
+	json SceneSnapshot::CaptureSettings(World& world)
+	{
+		json sceneJson;
+		sceneJson["SceneName"] = "Untitled Scene";
+
+		const auto& env = SceneManager::Instance().GetContext().environment;
+
+		json envJson;
+		envJson["SkyboxTexture"] = env.skyboxTexturePath;
+
+		envJson["SkyColorTop"] = { env.skyColorTop.x, env.skyColorTop.y, env.skyColorTop.z, env.skyColorTop.w };
+		envJson["SkyColorHorizon"] = { env.skyColorHorizon.x, env.skyColorHorizon.y, env.skyColorHorizon.z, env.skyColorHorizon.w };
+		envJson["SkyColorBottom"] = { env.skyColorBottom.x, env.skyColorBottom.y, env.skyColorBottom.z, env.skyColorBottom.w };
+
+		envJson["AmbientColor"] = { env.ambientColor.x, env.ambientColor.y, env.ambientColor.z };
+		envJson["AmbientIntensity"] = env.ambientIntensity;
+
+		sceneJson["Environment"] = envJson;
+
+		// 1. レイヤー衝突設定
+		sceneJson["Physics"]["LayerCollision"] = json::array();
+		for (int i = 0; i < 32; ++i)
+		{
+			Layer layer = (Layer)(1 << i);
+			Layer mask = PhysicsConfig::GetMask(layer);
+			if ((int)mask != 0 && (int)mask != -1)
+			{
+				json layerJson;
+				layerJson["Layer"] = (int)layer;
+				layerJson["Mask"] = (int)mask;
+				sceneJson["Physics"]["LayerCollision"].push_back(layerJson);
+			}
+		}
+
+		// 2. システム構成
+		sceneJson["Systems"] = json::array();
+		for (const auto& sys : world.getSystems())
+		{
+			json sysJson;
+			sysJson["Name"] = sys->m_systemName;
+			sysJson["Group"] = (int)sys->m_group;
+			sceneJson["Systems"].push_back(sysJson);
+		}
+
+		return sceneJson;
+	}
+
+	std::unique_ptr<SceneSnapshot> SceneSnapshot::Capture(World& world)
+	{
+		auto snapshot = std::make_unique<SceneSnapshot>();
+		snapshot->settings = CaptureSettings(world);
+
+		// Tagを持たない（内部的な）エンティティは保存しない
+		auto& registry = world.getRegistry();
+		std::vector<Entity> sources;
+		registry.each([&](auto entityID)
+			{
+				Entity entity = entityID;
+				if (!registry.has<Tag>(entity)) return;
+
+				sources.push_back(entity);
+				snapshot->ids.push_back((uint32_t)entity);
+				snapshot->active.push_back((uint8_t)registry.isActiveSelf(entity));
+			});
+
+		// 型のまま複製する（親子関係のIDは付け替えず、元のIDのまま書き出す）
+		// 全型のプールをここで作っておくと、書き出し中のワーカーで型IDが採番されない
+		auto& interfaces = ComponentRegistry::Instance().GetInterfaces();
+		snapshot->registry.create(sources.size(), snapshot->entities);
+		for (const auto& [name, iface] : interfaces)
+		{
+			iface.reserve(snapshot->registry, 0);
+			iface.copyBatch(registry, sources.data(), snapshot->registry, snapshot->entities.data(), sources.size());
+		}
+
+		return snapshot;
+	}
+
+	json SceneSnapshot::ToJson()
+	{
+		json sceneJson = settings;
+
+		json entitiesJson = json::array();
+		for (size_t i = 0; i < entities.size(); ++i)
+		{
+			json entityJson;
+			entityJson["ID"] = ids[i];
+			entityJson["IsActive"] = active[i] != 0;
+
+			ComponentSerializer::SerializeEntity(registry, entities[i], entityJson);
+			entitiesJson.push_back(std::move(entityJson));
+		}
+		sceneJson["Entities"] = std::move(entitiesJson);
+		return sceneJson;
+	}
+
+	// ====================================================================================
+	// 保存
+	// ====================================================================================
+	SceneSaver& SceneSaver::Instance()
+	{
+		static SceneSaver instance;
+		return instance;
+	}
+
+	SceneSaver::~SceneSaver()
+	{
+		// 終了時は書き終わるのを待つだけ（ログはもう出せないことがある）
+		for (auto& pending : m_pending)
+		{
+			if (pending.future.valid()) pending.future.wait();
+		}
+	}
+
+	void SceneSaver::SaveAsync(World& world, const std::string& filepath, Callback onComplete, SaveKind kind)
+	{
+		std::shared_ptr<SceneSnapshot> snapshot = SceneSnapshot::Capture(world);
+
+		Pending pending;
+		pending.filepath = filepath;
+		pending.kind = kind;
+		pending.result = std::make_shared<Result>();
+		pending.onComplete = std::move(onComplete);
+
+		if (m_worker.GetWorkerCount() == 0) m_worker.Start(1);
+		pending.future = m_worker.Submit([snapshot, filepath, kind, result = pending.result]() mutable
+			{
+				bool succeeded = Write(*snapshot, filepath, kind, *result);
+				// ゲーム側コンポーネントの破棄もここで済ませる（DLL差し替え前の Flush で待てるように）
+				snapshot.reset();
+				return succeeded;
+			});
+		m_pending.push_back(std::move(pending));
+	}
+
+	bool SceneSaver::Save(World& world, const std::string& filepath)
+	{
+		// 先に投げてある保存が後から上書きしないように
+		Flush();
+
+		auto snapshot = SceneSnapshot::Capture(world);
+		Result result;
+		bool succeeded = Write(*snapshot, filepath, SaveKind::User, result);
+		if (succeeded) Finish(filepath, SaveKind::User, result);
+		else Logger::LogError("Failed to save scene: " + filepath + (result.error.empty() ? "" : " (" + result.error + ")"));
+		return succeeded;
+	}
+
+	void SceneSaver::Update()
+	{
+		for (size_t i = 0; i < m_pending.size();)
+		{
+			Pending& pending = m_pending[i];
+			if (pending.future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			{
+				++i;
+				continue;
+			}
+
+			bool succeeded = false;
+			try { succeeded = pending.future.get(); }
+			catch (const std::exception& e) { pending.result->error = e.what(); }
+
+			if (succeeded) Finish(pending.filepath, pending.kind, *pending.result);
+			else Logger::LogError("Failed to save scene: " + pending.filepath + (pending.result->error.empty() ? "" : " (" + pending.result->error + ")"));
+
+			Callback onComplete = std::move(pending.onComplete);
+			m_pending.erase(m_pending.begin() + i);
+			if (onComplete) onComplete(succeeded);
+		}
+	}
+
+	void SceneSaver::Flush()
+	{
+		for (auto& pending : m_pending)
+		{
+			if (pending.future.valid()) pending.future.wait();
+		}
+		Update();
+	}
+
+	bool SceneSaver::Write(SceneSnapshot& snapshot, const std::string& filepath, SaveKind kind, Result& outResult)
+	{
+		json sceneJson = snapshot.ToJson();
+		std::string text = sceneJson.dump(4);
+
+		std::error_code ec;
+		std::filesystem::path path(filepath);
+		if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), ec);
+
+		// 一時ファイルに書いてから置き換える（書き込み中に落ちても前のシーンが残る）
+		std::string tempPath = filepath + ".tmp";
+		{
+			std::ofstream fout(tempPath);
+			if (!fout.is_open())
+			{
+				outResult.error = "cannot open " + tempPath;
+				return false;
+			}
+			fout << text;
+			if (!fout)
+			{
+				outResult.error = "write error";
+				return false;
+			}
+		}
+
+		std::filesystem::rename(tempPath, filepath, ec);
+		if (ec)
+		{
+			std::filesystem::remove(tempPath, ec);
+			outResult.error = "cannot replace the scene file";
+			return false;
+		}
+
+		// アセットのハッシュ計算が重いので、マニフェストの中身もここで作る（書き込みは Finish）
+		// 内部用の保存は読み込み時の先読みに使わないので作らない
+		if (kind == SaveKind::User) outResult.manifest = SceneManifest::Build(sceneJson, filepath);
+		return true;
+	}
+
+	void SceneSaver::Finish(const std::string& filepath, SaveKind kind, Result& result)
+	{
+		if (kind == SaveKind::Internal) return;
+
+		// 非同期ロードの先読みに使う依存マニフェスト（シーンより後に書くので新しいものとして扱われる）
+		result.manifest.Save(filepath);
+
+		Logger::Log("Scene Saved: " + filepath);
+	}
+
+}	// namespace Arche
@@ -0,0 +1,104 @@
+﻿/*****************************************************************//**
+ * @file	SceneSaver.h
+ * @brief	シーンの保存（スナップショットを取ってワーカーで書き出す）
+ *
+ * @details	メインスレッドで行うのは、保存するエンティティのコンポーネントを
+ *			型のまま別のレジストリへ複製する（ComponentRegistry の copyBatch）ところまで。
+ *			JSON への変換・テキスト化・書き込み・依存マニフェストのハッシュ計算はワーカーで行い、
+ *			その間も編集を続けられる。
+ *
+ *			書き込みは一時ファイルに書いてから置き換えるので、途中で落ちても前の内容が残る。
+ *			保存は投げた順に1本のワーカーで処理する（同じファイルへの保存が前後しない）。
+ *			ログ出力と完了通知は Update（メインスレッド）で行う。
+ *			オートセーブや Play 前の一時保存（SaveKind::Internal）は依存マニフェストを作らず、保存のログも出さない。
+ *
+ *			書き出しにはゲームDLLのコンポーネントのコードを使うので、
+ *			DLLを差し替える前とアプリの終了前には Flush で書き終わるのを待つこと。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___SCENE_SAVER_H___
+#define ___SCENE_SAVER_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Scene/Core/ECS/ECS.h"
+#include "Engine/Resource/AssetLoader.h"
+
+namespace Arche
+{
+	// 保存する内容の複製（取ったあとは元のワールドと無関係に読める）
+	struct ARCHE_API SceneSnapshot
+	{
+		json settings;					// Entities 以外（SceneName, Environment, Physics, Systems）
+		Registry registry;				// コンポーネントの複製
+		std::vector<Entity> entities;	// registry 内のエンティティ（保存する順）
+		std::vector<uint32_t> ids;		// 元のID（Relationship などはこの番号を指したまま）
+		std::vector<uint8_t> active;
+
+		// メインスレッドで呼ぶ
+		static std::unique_ptr<SceneSnapshot> Capture(World& world);
+		// 環境・物理・システムの設定（Entities 以外）
+		static json CaptureSettings(World& world);
+
+		// どのスレッドからでも呼べる（同じスナップショットを同時に使わないこと）
+		json ToJson();
+	};
+
+	class ARCHE_API SceneSaver
+	{
+	public:
+		using Callback = std::function<void(bool succeeded)>;
+
+		enum class SaveKind
+		{
+			User,		// ユーザーの保存（依存マニフェストを書き、ログを出す）
+			Internal,	// オートセーブ・Play 前の一時保存（シーンファイルだけを書く。失敗したときだけログを出す）
+		};
+
+		static SceneSaver& Instance();
+
+		// 今の状態を取り、書き出しはワーカーで行う（onComplete は Update の中で呼ばれる）
+		void SaveAsync(World& world, const std::string& filepath, Callback onComplete = nullptr, SaveKind kind = SaveKind::User);
+
+		// 書き終わるまで待つ保存（直後に同じファイルを読む場合など）
+		bool Save(World& world, const std::string& filepath);
+
+		// 書き終わった保存の後始末（メインスレッドで毎フレーム）
+		void Update();
+
+		// 投げてある保存がすべて終わるまで待つ
+		void Flush();
+
+		bool IsSaving() const { return !m_pending.empty(); }
+
+	private:
+		SceneSaver() = default;
+		~SceneSaver();
+
+		struct Result;
+
+		// ワーカーで行う部分（テキスト化・書き込み・マニフェストの計算）
+		static bool Write(SceneSnapshot& snapshot, const std::string& filepath, SaveKind kind, Result& outResult);
+		static void Finish(const std::string& filepath, SaveKind kind, Result& result);
+
+		struct Pending
+		{
+			std::string filepath;
+			SaveKind kind = SaveKind::User;
+			std::shared_ptr<Result> result;
+			std::future<bool> future;
+			Callback onComplete;
+		};
+
+	private:
+		AssetLoader m_worker;
+		std::vector<Pending> m_pending;
+	};
+
+}	// namespace Arche
+
+#endif // !___SCENE_SAVER_H___
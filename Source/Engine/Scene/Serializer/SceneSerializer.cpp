@@ -5,197 +5,282 @@
 #include "Engine/Scene/Serializer/ComponentSerializer.h"
 #include "Engine/Scene/Serializer/SystemRegistry.h"
 #include "Engine/Scene/Serializer/ComponentRegistry.h"
+#include "Engine/Scene/Serializer/SceneSaver.h"
+#include "Engine/Scene/Serializer/SceneBinary.h"
+#include "Engine/Scene/Serializer/SceneEntityLoader.h"
+#include "Engine/Scene/Serializer/SceneStreamLoader.h"
+#include "Engine/Scene/Serializer/PrefabTemplate.h"
+#include "Engine/Scene/Serializer/PrefabPatch.h"
 #include "Engine/Scene/Components/Components.h"
+#include "Engine/Resource/VirtualFileSystem.h"
 
 namespace Arche
 {
-	void SceneSerializer::SaveScene(World& world, const std::string& filepath)
+	namespace
 	{
-		json sceneJson;
-		sceneJson["SceneName"] = "Untitled Scene";
+		// クック済みファイルを使えるか（パックに入っているものはビルド時に最新にしてあるのでそのまま使う）
+		bool IsCookedUsable(const std::string& cookedPath, const std::string& sourcePath)
+		{
+			if (VirtualFileSystem::Instance().IsArchived(cookedPath)) return true;
+
+			std::error_code ec;
+			auto cookedTime = std::filesystem::last_write_time(cookedPath, ec);
+			if (ec) return false;
 
-		const auto& env = SceneManager::Instance().GetContext().environment;
+			std::error_code sourceEc;
+			auto sourceTime = std::filesystem::last_write_time(sourcePath, sourceEc);
+			return sourceEc || cookedTime >= sourceTime;
+		}
 
-		json envJson;
-		envJson["SkyboxTexture"] = env.skyboxTexturePath;
+		// 環境・物理・システムの設定を反映する（JSON・バイナリ共通）
+		void ApplySceneSettings(World& world, const json& sceneJson)
+		{
+			if (sceneJson.contains("Environment"))
+			{
+				auto& envJson = sceneJson["Environment"];
+				auto& ctx = SceneManager::Instance().GetContext(); // 書き換え可能な参照を取得
 
-		envJson["SkyColorTop"] = { env.skyColorTop.x, env.skyColorTop.y, env.skyColorTop.z, env.skyColorTop.w };
-		envJson["SkyColorHorizon"] = { env.skyColorHorizon.x, env.skyColorHorizon.y, env.skyColorHorizon.z, env.skyColorHorizon.w };
-		envJson["SkyColorBottom"] = { env.skyColorBottom.x, env.skyColorBottom.y, env.skyColorBottom.z, env.skyColorBottom.w };
+				if (envJson.contains("SkyboxTexture"))
+					ctx.environment.skyboxTexturePath = envJson["SkyboxTexture"].get<std::string>();
 
-		envJson["AmbientColor"] = { env.ambientColor.x, env.ambientColor.y, env.ambientColor.z };
-		envJson["AmbientIntensity"] = env.ambientIntensity;
+				// 色の読み込み (JSON配列 -> XMFLOAT4)
+				auto LoadColor4 = [&](const char* key, XMFLOAT4& outVal) {
+					if (envJson.contains(key)) {
+						auto v = envJson[key];
+						outVal = { v[0], v[1], v[2], v[3] };
+					}
+					};
+				LoadColor4("SkyColorTop", ctx.environment.skyColorTop);
+				LoadColor4("SkyColorHorizon", ctx.environment.skyColorHorizon);
+				LoadColor4("SkyColorBottom", ctx.environment.skyColorBottom);
 
-		sceneJson["Environment"] = envJson;
+				if (envJson.contains("AmbientColor")) {
+					auto v = envJson["AmbientColor"];
+					ctx.environment.ambientColor = { v[0], v[1], v[2] };
+				}
+				if (envJson.contains("AmbientIntensity")) {
+					ctx.environment.ambientIntensity = envJson["AmbientIntensity"].get<float>();
+				}
+			}
 
-		// 1. レイヤー衝突設定
-		sceneJson["Physics"]["LayerCollision"] = json::array();
-		for (int i = 0; i < 32; ++i)
-		{
-			Layer layer = (Layer)(1 << i);
-			Layer mask = PhysicsConfig::GetMask(layer);
-			if ((int)mask != 0 && (int)mask != -1)
+			// Physics
+			if (sceneJson.contains("Physics") && sceneJson["Physics"].contains("LayerCollision"))
+			{
+				for (auto& layerJson : sceneJson["Physics"]["LayerCollision"])
+				{
+					Layer layer = (Layer)layerJson["Layer"].get<int>();
+					Layer mask = (Layer)layerJson["Mask"].get<int>();
+					PhysicsConfig::Configure(layer).setMask(mask);
+				}
+			}
+
+			// Systems
+			if (sceneJson.contains("Systems"))
 			{
-				json layerJson;
-				layerJson["Layer"] = (int)layer;
-				layerJson["Mask"] = (int)mask;
-				sceneJson["Physics"]["LayerCollision"].push_back(layerJson);
+				for (auto& sysJson : sceneJson["Systems"])
+				{
+					std::string name = sysJson["Name"].get<std::string>();
+					SystemGroup group = SystemGroup::PlayOnly;
+					if (sysJson.contains("Group")) group = (SystemGroup)sysJson["Group"].get<int>();
+					SystemRegistry::Instance().CreateSystem(world, name, group);
+				}
 			}
 		}
 
-		// 2. システム構成
-		sceneJson["Systems"] = json::array();
-		for (const auto& sys : world.getSystems())
+		void ResetSceneState(World& world)
 		{
-			json sysJson;
-			sysJson["Name"] = sys->m_systemName;
-			sysJson["Group"] = (int)sys->m_group;
-			sceneJson["Systems"].push_back(sysJson);
+			world.clearSystems();
+			world.clearEntities();
+			CollisionSystem::Reset();
+			PhysicsConfig::Reset();
 		}
+	}
 
-		// 3. エンティティ
-		sceneJson["Entities"] = json::array();
-		auto& registry = world.getRegistry();
+	void SceneSerializer::SaveScene(World& world, const std::string& filepath)
+	{
+		// 書き終わるまで待つ（エディタの通常の保存は SceneSaver::SaveAsync）
+		SceneSaver::Instance().Save(world, filepath);
+	}
 
-		registry.each([&](auto entityID)
-			{
-				Entity entity = entityID;
-				// Tagを持たない（内部的な）エンティティは保存しない
-				if (!registry.has<Tag>(entity)) return;
+	bool SceneSerializer::OpenDocument(const std::string& filepath, FileView& outFile, DocumentFormat& outFormat)
+	{
+		auto& vfs = VirtualFileSystem::Instance();
+
+		// ソースより新しいクック済みファイルがあればそちらを使う（テキストのパースを省く）
+		std::string binaryPath = filepath + SceneBinary::EXTENSION;
+		if (IsCookedUsable(binaryPath, filepath) && vfs.Open(binaryPath, outFile))
+		{
+			outFormat = DocumentFormat::Binary;
+			return true;
+		}
 
-				json entityJson;
-				entityJson["ID"] = (uint32_t)entity;
+		std::string cookedPath = filepath + COOKED_EXTENSION;
+		if (IsCookedUsable(cookedPath, filepath) && vfs.Open(cookedPath, outFile))
+		{
+			outFormat = DocumentFormat::MessagePack;
+			return true;
+		}
 
-				entityJson["IsActive"] = registry.isActiveSelf(entity);
+		outFormat = DocumentFormat::Json;
+		return vfs.Open(filepath, outFile);
+	}
 
-				ComponentSerializer::SerializeEntity(registry, entity, entityJson);
-				sceneJson["Entities"].push_back(entityJson);
-			});
+	bool SceneSerializer::ParseScene(const std::string& filepath, const FileView& file, DocumentFormat format, SceneDocument& outDocument)
+	{
+		outDocument = SceneDocument{};
 
-		std::ofstream fout(filepath);
-		if (fout.is_open()) {
-			fout << sceneJson.dump(4);
-			fout.close();
-			Logger::Log("Scene Saved: " + filepath);
+		if (format == DocumentFormat::Binary)
+		{
+			auto binary = std::make_shared<SceneBinary>();
+			std::string error;
+			if (binary->Parse(file.GetData(), (size_t)file.GetSize(), error))
+			{
+				outDocument.binary = std::move(binary);
+				outDocument.valid = true;
+				return true;
+			}
+
+			// 壊れている・スキーマが古い場合はソースを読み直す
+			Logger::LogWarning("Binary scene is not usable (" + error + "), loading source instead: " + filepath + SceneBinary::EXTENSION);
+			FileView source;
+			if (!VirtualFileSystem::Instance().Open(filepath, source)) return false;
+			return ParseScene(filepath, source, DocumentFormat::Json, outDocument);
+		}
+
+		// DOM を作らず、トークンを読みながら作業用のレジストリへ復元する
+		auto streamed = std::make_shared<SceneSnapshot>();
+		std::string error;
+		if (SceneStreamLoader::Parse(file.GetData(), (size_t)file.GetSize(), format == DocumentFormat::MessagePack, *streamed, error))
+		{
+			outDocument.streamed = std::move(streamed);
+			outDocument.valid = true;
+			return true;
 		}
-		else {
-			Logger::LogError("Failed to save scene: " + filepath);
+
+		if (format == DocumentFormat::MessagePack)
+		{
+			// 壊れていればソースを読み直す
+			Logger::LogWarning("Cooked document is invalid, loading source instead: " + filepath + COOKED_EXTENSION);
+			FileView source;
+			if (!VirtualFileSystem::Instance().Open(filepath, source)) return false;
+			return ParseScene(filepath, source, DocumentFormat::Json, outDocument);
 		}
+
+		Logger::LogError("JSON Parse Error: " + error);
+		return false;
 	}
 
-	void SceneSerializer::LoadScene(World& world, const std::string& filepath)
+	bool SceneSerializer::ParseDocument(const std::string& filepath, const FileView& file, DocumentFormat format, json& outJson)
 	{
-		std::ifstream fin(filepath);
-		if (!fin.is_open()) {
-			Logger::LogError("Failed to load scene: " + filepath);
-			return;
+		if (format == DocumentFormat::Binary)
+		{
+			// JSON を前提にした呼び出し元（エディタなど）向けに変換する
+			SceneBinary binary;
+			std::string error;
+			if (binary.Parse(file.GetData(), (size_t)file.GetSize(), error))
+			{
+				outJson = binary.ToJson();
+				return true;
+			}
+
+			Logger::LogWarning("Binary scene is not usable (" + error + "), loading source instead: " + filepath + SceneBinary::EXTENSION);
+			FileView source;
+			if (!VirtualFileSystem::Instance().Open(filepath, source)) return false;
+			return ParseDocument(filepath, source, DocumentFormat::Json, outJson);
 		}
 
-		world.clearSystems();
-		world.clearEntities();
-		CollisionSystem::Reset();
-		PhysicsConfig::Reset();
+		if (format == DocumentFormat::MessagePack)
+		{
+			outJson = json::from_msgpack(file.GetData(), file.GetData() + file.GetSize(), true, false);
+			if (!outJson.is_discarded()) return true;
+
+			// 壊れていればソースを読み直す
+			Logger::LogWarning("Cooked document is invalid, loading source instead: " + filepath + COOKED_EXTENSION);
+			FileView source;
+			if (!VirtualFileSystem::Instance().Open(filepath, source)) return false;
+			return ParseDocument(filepath, source, DocumentFormat::Json, outJson);
+		}
 
-		json sceneJson;
-		try { fin >> sceneJson; }
+		try { outJson = json::parse(file.GetData(), file.GetData() + file.GetSize()); }
 		catch (json::parse_error& e) {
 			Logger::LogError(std::string("JSON Parse Error: ") + e.what());
+			return false;
+		}
+		return true;
+	}
+
+	bool SceneSerializer::ReadDocument(const std::string& filepath, json& outJson)
+	{
+		FileView file;
+		DocumentFormat format = DocumentFormat::Json;
+		if (!OpenDocument(filepath, file, format)) return false;
+		return ParseDocument(filepath, file, format, outJson);
+	}
+
+	void SceneSerializer::LoadScene(World& world, const std::string& filepath)
+	{
+		FileView file;
+		DocumentFormat format = DocumentFormat::Json;
+		SceneDocument document;
+		if (!OpenDocument(filepath, file, format) || !ParseScene(filepath, file, format, document)) {
+			Logger::LogError("Failed to load scene: " + filepath);
 			return;
 		}
 
-		if (sceneJson.contains("Environment"))
+		LoadScene(world, document, filepath);
+	}
+
+	void SceneSerializer::LoadScene(World& world, const SceneDocument& document, const std::string& filepath)
+	{
+		if (document.streamed)
 		{
-			auto& envJson = sceneJson["Environment"];
-			auto& ctx = SceneManager::Instance().GetContext(); // 書き換え可能な参照を取得
+			ResetSceneState(world);
+			ApplySceneSettings(world, document.streamed->settings);
 
-			if (envJson.contains("SkyboxTexture"))
-				ctx.environment.skyboxTexturePath = envJson["SkyboxTexture"].get<std::string>();
+			auto& registry = world.getRegistry();
+			registry.clear();
+			EntityIdRemap remap;
+			SceneStreamLoader::Instantiate(registry, *document.streamed, remap);
 
-			// 色の読み込み (JSON配列 -> XMFLOAT4)
-			auto LoadColor4 = [&](const char* key, XMFLOAT4& outVal) {
-				if (envJson.contains(key)) {
-					auto v = envJson[key];
-					outVal = { v[0], v[1], v[2], v[3] };
-				}
-				};
-			LoadColor4("SkyColorTop", ctx.environment.skyColorTop);
-			LoadColor4("SkyColorHorizon", ctx.environment.skyColorHorizon);
-			LoadColor4("SkyColorBottom", ctx.environment.skyColorBottom);
-
-			if (envJson.contains("AmbientColor")) {
-				auto v = envJson["AmbientColor"];
-				ctx.environment.ambientColor = { v[0], v[1], v[2] };
-			}
-			if (envJson.contains("AmbientIntensity")) {
-				ctx.environment.ambientIntensity = envJson["AmbientIntensity"].get<float>();
-			}
+			Logger::Log("Scene Loaded: " + filepath);
+			return;
 		}
 
-		// Physics
-		if (sceneJson.contains("Physics") && sceneJson["Physics"].contains("LayerCollision"))
+		if (!document.binary)
 		{
-			for (auto& layerJson : sceneJson["Physics"]["LayerCollision"])
-			{
-				Layer layer = (Layer)layerJson["Layer"].get<int>();
-				Layer mask = (Layer)layerJson["Mask"].get<int>();
-				PhysicsConfig::Configure(layer).setMask(mask);
-			}
+			LoadScene(world, document.root, filepath);
+			return;
 		}
 
-		// Systems
-		if (sceneJson.contains("Systems"))
-		{
-			for (auto& sysJson : sceneJson["Systems"])
-			{
-				std::string name = sysJson["Name"].get<std::string>();
-				SystemGroup group = SystemGroup::PlayOnly;
-				if (sysJson.contains("Group")) group = (SystemGroup)sysJson["Group"].get<int>();
-				SystemRegistry::Instance().CreateSystem(world, name, group);
-			}
-		}
+		ResetSceneState(world);
+		ApplySceneSettings(world, document.binary->GetSettings());
 
-		// Entities
 		auto& registry = world.getRegistry();
 		registry.clear();
-		std::unordered_map<uint32_t, Entity> idMap;
-
-		if (sceneJson.contains("Entities")) {
-			for (auto& entityJson : sceneJson["Entities"]) {
-				Entity newEntity = registry.create();
-				uint32_t oldID = entityJson["ID"].get<uint32_t>();
-				idMap[oldID] = newEntity;
+		EntityIdRemap remap;
+		if (!document.binary->Instantiate(registry, remap))
+		{
+			Logger::LogError("Failed to instantiate binary scene: " + filepath);
+		}
 
-				if (entityJson.contains("IsActive"))
-				{
-					registry.setActive(newEntity, entityJson["IsActive"].get<bool>());
-				}
+		remap.ResolveRelationships(registry);
 
-				ComponentSerializer::DeserializeEntity(registry, newEntity, entityJson);
-			}
-		}
+		Logger::Log("Scene Loaded: " + filepath);
+	}
 
-		// Relationship Fix
-		for (auto const& [oldID, entity] : idMap)
-		{
-			if (registry.has<Relationship>(entity))
-			{
-				auto& rel = registry.get<Relationship>(entity);
+	void SceneSerializer::LoadScene(World& world, const json& sceneJson, const std::string& filepath)
+	{
+		ResetSceneState(world);
+		ApplySceneSettings(world, sceneJson);
 
-				// 親IDの解決
-				if (rel.parent != NullEntity) {
-					uint32_t oldParentID = (uint32_t)rel.parent;
-					if (idMap.count(oldParentID)) rel.parent = idMap[oldParentID];
-					else rel.parent = NullEntity;
-				}
+		// Entities
+		auto& registry = world.getRegistry();
+		registry.clear();
 
-				// 子IDリストの解決
-				std::vector<Entity> newChildren;
-				for (auto oldChildID : rel.children) {
-					uint32_t oldID = (uint32_t)oldChildID;
-					if (idMap.count(oldID)) newChildren.push_back(idMap[oldID]);
-				}
-				rel.children = newChildren;
-			}
+		// 復元はチャンクごとに並列、プールへの追加と親子関係の付け替えはまとめて行う
+		if (sceneJson.contains("Entities")) {
+			EntityIdRemap remap;
+			SceneEntityLoader::Load(registry, sceneJson["Entities"], remap);
 		}
 
 		Logger::Log("Scene Loaded: " + filepath);
@@ -208,49 +293,58 @@ namespace Arche
 		// プレファブ情報を持っていなければ何もしない
 		if (!reg.has<PrefabInstance>(entity)) return;
 
+		// ファイルの今の内容に戻すので、テンプレートは作り直す
 		std::string path = reg.get<PrefabInstance>(entity).prefabPath;
-		if (!std::filesystem::exists(path))
+		PrefabCache::Instance().Invalidate(path);
+		auto prefab = PrefabCache::Instance().Get(path);
+		if (!prefab)
 		{
 			Logger::LogError("Prefab file not found: " + path);
 			return;
 		}
 
-		// ファイル読み込み
-		std::ifstream fin(path);
-		if (!fin.is_open()) return;
-		json prefabJson;
-		fin >> prefabJson;
-		if (!prefabJson.is_array() || prefabJson.empty()) return;
-
 		// --- 復元処理 ---
 
-		// 1. 親子関係とPrefab情報のバックアップ
+		// 1. 親子関係のバックアップ
 		Entity parent = NullEntity;
 		if (reg.has<Relationship>(entity)) parent = reg.get<Relationship>(entity).parent;
 
-		// 2. コンポーネントを一度すべて削除（クリーンな状態にする）
-		// ComponentRegistryを使って全削除
+		// 2. 今の子孫とコンポーネントをすべて削除（クリーンな状態にする）
+		if (reg.has<Relationship>(entity))
+		{
+			auto children = reg.get<Relationship>(entity).children;
+			for (auto child : children) DestroyEntityRecursive(world, child);
+		}
 		for (const auto& [name, iface] : ComponentRegistry::Instance().GetInterfaces())
 		{
 			iface.remove(reg, entity);
 		}
 
-		// 3. プレファブからデータをロード
-		ComponentSerializer::DeserializeEntity(reg, entity, prefabJson[0]);
+		// 3. プレファブから新しく生成し、ルートの中身を entity に移す（子は entity に付け替える）
+		std::vector<Entity> roots;
+		prefab->Instantiate(reg, 1, roots);
+		if (roots.empty()) return;
+		Entity fresh = roots[0];
+
+		for (const auto& [name, iface] : ComponentRegistry::Instance().GetInterfaces())
+		{
+			iface.clone(reg, fresh, reg, entity);
+		}
+		reg.destroy(fresh);
 
-		// 4. バックアップ情報の復元
-		// 親子関係
+		// 4. 親子関係の復元
 		if (reg.has<Relationship>(entity))
 		{
-			reg.get<Relationship>(entity).parent = parent;
+			auto& rel = reg.get<Relationship>(entity);
+			rel.parent = parent;
+			for (auto child : rel.children) reg.get<Relationship>(child).parent = entity;
 		}
 		else if (parent != NullEntity)
 		{
-			auto& rel = reg.emplace<Relationship>(entity);
-			rel.parent = parent;
+			reg.emplace<Relationship>(entity, parent);
 		}
 
-		// PrefabInstance (Deserializeで入っているはずだが念のためパスを保証)
+		// PrefabInstance (テンプレートに入っているが念のためパスを保証)
 		if (!reg.has<PrefabInstance>(entity))
 		{
 			reg.emplace<PrefabInstance>(entity, path);
@@ -260,23 +354,6 @@ namespace Arche
 			reg.get<PrefabInstance>(entity).prefabPath = path;
 		}
 
-		// 5. 子階層の再構築 (プレファブ構造に強制一致させる)
-		// まず今の子を全削除
-		std::function<void(Entity)> deleteChildren = [&](Entity e) {
-			if (reg.has<Relationship>(e)) {
-				auto children = reg.get<Relationship>(e).children;
-				for (auto c : children) {
-					deleteChildren(c);
-					reg.destroy(c);
-				}
-				reg.get<Relationship>(e).children.clear();
-			}
-			};
-		deleteChildren(entity);
-
-		// JSONから子を再生成
-		ReconstructPrefabChildren(world, entity, prefabJson);
-
 		Logger::Log("Reverted to Prefab: " + path);
 	}
 
@@ -328,6 +405,60 @@ namespace Arche
 		world.getRegistry().destroy(entity);
 	}
 
+	// ====================================================================================
+	// ヘルパー: 子孫の収集と、JSON を通さない複製
+	// ====================================================================================
+	void SceneSerializer::CollectHierarchy(Registry& reg, Entity root, std::vector<Entity>& outEntities)
+	{
+		if (!reg.valid(root)) return;
+
+		outEntities.push_back(root);
+		if (reg.has<Relationship>(root))
+		{
+			for (auto child : reg.get<Relationship>(root).children)
+			{
+				CollectHierarchy(reg, child, outEntities);
+			}
+		}
+	}
+
+	void SceneSerializer::CopyEntities(Registry& src, const std::vector<Entity>& sources, Registry& dst, std::vector<Entity>& outCopies)
+	{
+		outCopies.clear();
+		if (sources.empty()) return;
+
+		// まとめて作成し、型ごとにコピーする
+		dst.create(sources.size(), outCopies);
+		for (const auto& [name, iface] : ComponentRegistry::Instance().GetInterfaces())
+		{
+			iface.copyBatch(src, sources.data(), dst, outCopies.data(), sources.size());
+		}
+		for (size_t i = 0; i < sources.size(); ++i)
+		{
+			if (!src.isActiveSelf(sources[i])) dst.setActive(outCopies[i], false);
+		}
+
+		// 複製元 → 複製先（エンティティIDで引く表）
+		std::vector<uint32_t> indexOf;
+		for (size_t i = 0; i < sources.size(); ++i)
+		{
+			if (sources[i] >= indexOf.size()) indexOf.resize((size_t)sources[i] + 1, ComponentRegistry::NO_INDEX);
+			indexOf[sources[i]] = (uint32_t)i;
+		}
+		auto Remap = [&](Entity e) {
+			return (e < indexOf.size() && indexOf[e] != ComponentRegistry::NO_INDEX) ? outCopies[indexOf[e]] : e;
+			};
+
+		for (auto copy : outCopies)
+		{
+			if (!dst.has<Relationship>(copy)) continue;
+
+			auto& rel = dst.get<Relationship>(copy);
+			if (rel.parent != NullEntity) rel.parent = Remap(rel.parent);
+			for (auto& child : rel.children) child = Remap(child);
+		}
+	}
+
 	// ====================================================================================
 	// ヘルパー: 再帰的にエンティティと子要素をJSONにシリアライズ
 	// ====================================================================================
@@ -404,6 +535,8 @@ namespace Arche
 
 		std::ofstream o(filepath);
 		o << std::setw(4) << prefabJson << std::endl;
+
+		PrefabCache::Instance().Invalidate(filepath);
 	}
 
 	// ====================================================================================
@@ -411,79 +544,17 @@ namespace Arche
 	// ====================================================================================
 	Entity SceneSerializer::LoadPrefab(World& world, const std::string& filepath)
 	{
-		std::ifstream i(filepath);
-		if (!i.is_open()) return NullEntity;
-
-		json prefabJson;
-		try { i >> prefabJson; }
-		catch (...) { return NullEntity; }
-		i.close();
-
-		if (prefabJson.is_null()) return NullEntity;
-
-		// ★修正: 配列かオブジェクトかを判定し、ルートノードを特定する
-		const json* rootNode = &prefabJson;
-		if (prefabJson.is_array())
-		{
-			if (prefabJson.empty()) return NullEntity;
-			rootNode = &prefabJson[0];
-		}
-
-		// ルートエンティティ作成
-		Entity root = world.create_entity().id();
-
-		// コンポーネント復元
-		DeserializeEntityFromJson(world.getRegistry(), root, *rootNode);
-
-		// PrefabInstance コンポーネントを付与してリンク情報を残す
-		if (!world.getRegistry().has<PrefabInstance>(root))
-		{
-			world.getRegistry().emplace<PrefabInstance>(root, filepath);
-		}
-
-		// 子要素の再構築
-		if (rootNode->contains("Children"))
-		{
-			for (const auto& childNode : (*rootNode)["Children"])
-			{
-				ReconstructEntityRecursive(world, root, childNode);
-			}
-		}
-
-		return root;
+		std::vector<Entity> roots = InstantiatePrefab(world, filepath, 1);
+		return roots.empty() ? NullEntity : roots[0];
 	}
 
-	// ====================================================================================
-	// パス比較用ヘルパー
-	// ====================================================================================
-	static bool IsSamePath(const std::string& pathA, const std::string& pathB)
+	std::vector<Entity> SceneSerializer::InstantiatePrefab(World& world, const std::string& filepath, uint32_t count)
 	{
-		namespace fs = std::filesystem;
-		try
-		{
-			// 1. ファイルが存在する場合、OSレベルで同一ファイルかチェック (最も確実)
-			if (fs::exists(pathA) && fs::exists(pathB))
-			{
-				return fs::equivalent(pathA, pathB);
-			}
-
-			// 2. 文字列として正規化して比較 (存在しない場合やパス形式違い対策)
-			fs::path a = fs::u8path(pathA).lexically_normal();
-			fs::path b = fs::u8path(pathB).lexically_normal();
-
-			// 小文字に統一して比較 (Windows対策)
-			std::string strA = a.string();
-			std::string strB = b.string();
-			std::transform(strA.begin(), strA.end(), strA.begin(), ::tolower);
-			std::transform(strB.begin(), strB.end(), strB.begin(), ::tolower);
-
-			return strA == strB;
-		}
-		catch (...)
-		{
-			// エラー時は単純な文字列比較へフォールバック
-			return pathA == pathB;
-		}
+		// パースは初回だけ。2回目以降はテンプレートからの型ごとのコピーのみ
+		std::vector<Entity> roots;
+		auto prefab = PrefabCache::Instance().Get(filepath);
+		if (prefab) prefab->Instantiate(world.getRegistry(), count, roots);
+		return roots;
 	}
 
 	// ====================================================================================
@@ -491,117 +562,27 @@ namespace Arche
 	// ====================================================================================
 	void SceneSerializer::ReloadPrefabInstances(World& world, const std::string& filepath)
 	{
-		std::ifstream i(filepath);
-		if (!i.is_open()) return;
-
-		json prefabJson;
-		try { i >> prefabJson; }
-		catch (...) { return; }
-		i.close();
-
-		if (prefabJson.is_null()) return;
-
-		// 配列かオブジェクトかを判定
-		const json* rootNode = &prefabJson;
-		if (prefabJson.is_array())
+		// インスタンスが合わせてある版（保存前に使っていたテンプレート）と、ファイルの今の内容
+		PrefabCache& cache = PrefabCache::Instance();
+		cache.Invalidate(filepath);
+		auto base = cache.TakePrevious(filepath);
+		auto fresh = cache.Get(filepath);
+		if (!fresh)
 		{
-			if (prefabJson.empty()) return;
-			rootNode = &prefabJson[0];
+			Logger::LogError("Prefab file not found: " + filepath);
+			return;
 		}
 
 		auto& reg = world.getRegistry();
 		std::vector<Entity> targets;
+		PrefabPatch::FindInstances(reg, filepath, targets);
 
-		// 対象を収集
-		reg.view<PrefabInstance>().each([&](Entity e, PrefabInstance& pref) {
-			if (IsSamePath(pref.prefabPath, filepath)) {
-				targets.push_back(e);
-			}
-			});
-
-		for (auto entity : targets)
-		{
-			// --- 1. 現状の維持したいデータをバックアップ ---
-			Transform backupTransform;
-			if (reg.has<Transform>(entity)) backupTransform = reg.get<Transform>(entity);
-
-			std::string backupName = "Entity";
-			if (reg.has<Tag>(entity)) backupName = reg.get<Tag>(entity).name.c_str();
+		// 変わったフィールドだけを書き込む（インスタンスで上書きしたフィールドと、変わっていない子はそのまま）
+		PrefabPatch::Stats stats = PrefabPatch::Apply(reg, targets, base.get(), *fresh);
 
-			Entity parent = NullEntity;
-			if (reg.has<Relationship>(entity)) parent = reg.get<Relationship>(entity).parent;
-
-			// --- 2. 古い子要素をすべて削除 ---
-			if (reg.has<Relationship>(entity))
-			{
-				std::function<void(Entity)> destroyRecursive = [&](Entity e) {
-					if (reg.has<Relationship>(e)) {
-						auto children = reg.get<Relationship>(e).children;
-						for (auto child : children) destroyRecursive(child);
-					}
-					world.getRegistry().destroy(e);
-					};
-
-				auto children = reg.get<Relationship>(entity).children; // コピー
-				for (auto child : children)
-				{
-					destroyRecursive(child);
-				}
-				reg.get<Relationship>(entity).children.clear();
-			}
-
-			// --- 3. 自身のコンポーネントをクリア ---
-			for (auto& [name, iface] : ComponentRegistry::Instance().GetInterfaces())
-			{
-				iface.remove(reg, entity);
-			}
-
-			// --- 4. プレファブから復元 ---
-			DeserializeEntityFromJson(reg, entity, *rootNode);
-
-			// --- 5. バックアップデータを書き戻す (オーバーライド) ---
-			// Transform
-			if (reg.has<Transform>(entity)) {
-				reg.get<Transform>(entity) = backupTransform;
-			}
-			else {
-				reg.emplace<Transform>(entity, backupTransform);
-			}
-
-			// Tag
-			if (reg.has<Tag>(entity)) {
-				reg.get<Tag>(entity).name = backupName;
-			}
-			else {
-				reg.emplace<Tag>(entity, backupName);
-			}
-
-			// PrefabInstance
-			if (reg.has<PrefabInstance>(entity)) {
-				reg.get<PrefabInstance>(entity).prefabPath = filepath;
-			}
-			else {
-				reg.emplace<PrefabInstance>(entity, filepath);
-			}
-
-			// 親子関係
-			if (parent != NullEntity)
-			{
-				if (!reg.has<Relationship>(entity)) reg.emplace<Relationship>(entity);
-				reg.get<Relationship>(entity).parent = parent;
-			}
-
-			// --- 6. 子要素の再構築 ---
-			if (rootNode->contains("Children"))
-			{
-				for (const auto& childNode : (*rootNode)["Children"])
-				{
-					ReconstructEntityRecursive(world, entity, childNode);
-				}
-			}
-		}
-
-		Logger::Log("Reloaded prefab instances: " + filepath);
+		Logger::Log("Reloaded prefab instances: " + filepath +
+			" (" + std::to_string(stats.instances) + " instances, " + std::to_string(stats.patchedFields) + " fields, +" +
+			std::to_string(stats.createdEntities) + " / -" + std::to_string(stats.destroyedEntities) + " entities)");
 	}
 
 	void SceneSerializer::SerializeEntityToJson(Registry& registry, Entity entity, json& outJson) {
@@ -681,22 +662,20 @@ namespace Arche
 		}
 	}
 
-	void SceneSerializer::CollectAssets(const std::string& filepath, std::vector<std::string>& outModels, std::vector<std::string>& outTextures, std::vector<std::string>& outSounds)
+	void SceneSerializer::CollectAssets(const std::string& filepath, std::vector<std::string>& outModels, std::vector<std::string>& outTextures, std::vector<std::string>& outSounds, std::vector<std::string>& outControllers)
 	{
-		std::ifstream stream(filepath);
-		if (!stream.is_open()) return;
-
 		json root;
-		try {
-			stream >> root;
-		}
-		catch (...) { return; }
-		stream.close();
+		if (!ReadDocument(filepath, root)) return;
 
-		if (!root.contains("Entities")) return;
+		CollectAssets(root, outModels, outTextures, outSounds, outControllers);
+	}
 
-		for (auto& entity : root["Entities"])
+	void SceneSerializer::CollectAssets(const json& root, std::vector<std::string>& outModels, std::vector<std::string>& outTextures, std::vector<std::string>& outSounds, std::vector<std::string>& outControllers)
+	{
+		std::function<void(const json&)> CollectEntity = [&](const json& entity)
 		{
+			if (!entity.is_object()) return;
+
 			// MeshComponent -> Model
 			if (entity.contains("MeshComponent")) {
 				std::string path = entity["MeshComponent"].value("modelKey", "");
@@ -731,29 +710,48 @@ namespace Arche
 			if (entity.contains("Animator"))
 			{
 				std::string ctrlPath = entity["Animator"].value("controllerPath", "");
-				if (!ctrlPath.empty() && std::filesystem::exists(ctrlPath))
+				std::string ctrlText;
+				if (!ctrlPath.empty() && VirtualFileSystem::Instance().ReadText(ctrlPath, ctrlText))
 				{
+					outControllers.push_back(ctrlPath);
+
 					// コントローラーJSONを開く
-					std::ifstream ctrlStream(ctrlPath);
-					if (ctrlStream.is_open())
-					{
-						json ctrlJson;
-						try {
-							ctrlStream >> ctrlJson;
-							if (ctrlJson.contains("States"))
+					json ctrlJson;
+					try {
+						ctrlJson = json::parse(ctrlText);
+						if (ctrlJson.contains("States"))
+						{
+							for (const auto& state : ctrlJson["States"])
 							{
-								for (const auto& state : ctrlJson["States"])
-								{
-									std::string motion = state.value("MotionName", "");
-									// モーションファイルをモデルとしてプリロードリストに追加
-									if (!motion.empty()) outModels.push_back(motion);
-								}
+								std::string motion = state.value("MotionName", "");
+								// モーションファイルをモデルとしてプリロードリストに追加
+								if (!motion.empty()) outModels.push_back(motion);
 							}
 						}
-						catch (...) {}
 					}
+					catch (...) {}
 				}
 			}
+
+			// プレファブの子階層
+			if (entity.contains("Children") && entity["Children"].is_array())
+			{
+				for (const auto& child : entity["Children"]) CollectEntity(child);
+			}
+		};
+
+		// シーン: { "Entities": [...] } / プレファブ: ルートエンティティ（旧形式は配列）
+		if (root.is_object() && root.contains("Entities"))
+		{
+			for (const auto& entity : root["Entities"]) CollectEntity(entity);
+		}
+		else if (root.is_array())
+		{
+			for (const auto& entity : root) CollectEntity(entity);
+		}
+		else
+		{
+			CollectEntity(root);
 		}
 
 		// 重複削除
@@ -764,6 +762,7 @@ namespace Arche
 		Unique(outModels);
 		Unique(outTextures);
 		Unique(outSounds);
+		Unique(outControllers);
 	}
 	
 	Entity SceneSerializer::DuplicateEntity(World& world, Entity entity)
@@ -771,21 +770,13 @@ namespace Arche
 		Registry& reg = world.getRegistry();
 		if (!reg.valid(entity)) return NullEntity;
 
-		// 1. JSONにシリアライズ (子孫含む)
-		json entityJson;
-		SerializeEntityRecursive(reg, entity, entityJson);
-
-		// 2. 親を取得
-		Entity parent = NullEntity;
-		if (reg.has<Relationship>(entity))
-		{
-			parent = reg.get<Relationship>(entity).parent;
-		}
+		// 1. 子孫を含めて集め、型ごとにまとめて複製する
+		std::vector<Entity> sources;
+		CollectHierarchy(reg, entity, sources);
 
-		// 3. 復元 (複製)
-		// ルートエンティティを作成
-		Entity newEntity = world.create_entity().id();
-		DeserializeEntityFromJson(reg, newEntity, entityJson);
+		std::vector<Entity> copies;
+		CopyEntities(reg, sources, reg, copies);
+		Entity newEntity = copies[0];
 
 		// 名前を変更 (Unity風に "Name (Copy)" とする)
 		if (reg.has<Tag>(newEntity))
@@ -795,27 +786,11 @@ namespace Arche
 			reg.get<Tag>(newEntity).name = name;
 		}
 
-		// 親子付け
-		if (parent != NullEntity)
-		{
-			// 自分のRelationship
-			if (!reg.has<Relationship>(newEntity)) reg.emplace<Relationship>(newEntity);
-			reg.get<Relationship>(newEntity).parent = parent;
-
-			// 親のRelationship
-			if (reg.has<Relationship>(parent))
-			{
-				reg.get<Relationship>(parent).children.push_back(newEntity);
-			}
-		}
-
-		// 子要素の再構築 (再帰処理)
-		if (entityJson.contains("Children"))
+		// 2. 親子付け（複製のルートは元と同じ親を指しているので、親の子リストに加える）
+		Entity parent = reg.has<Relationship>(newEntity) ? reg.get<Relationship>(newEntity).parent : NullEntity;
+		if (parent != NullEntity && reg.has<Relationship>(parent))
 		{
-			for (const auto& childNode : entityJson["Children"])
-			{
-				ReconstructEntityRecursive(world, newEntity, childNode);
-			}
+			reg.get<Relationship>(parent).children.push_back(newEntity);
 		}
 
 		Logger::Log("Duplicated Entity: " + std::to_string(entity) + " -> " + std::to_string(newEntity));
@@ -26,20 +26,58 @@
 
 namespace Arche
 {
+	class FileView;
+	class SceneBinary;
+	struct SceneSnapshot;
+
+	// 読み込んだシーン
+	// JSON / MessagePack なら streamed（SceneStreamLoader で作業用のレジストリまで復元済み）、
+	// バイナリシーンなら binary。root は呼び出し元が JSON を渡す場合（LoadScene(json) と同じ扱い）
+	struct SceneDocument
+	{
+		json root;
+		std::shared_ptr<SceneBinary> binary;
+		std::shared_ptr<SceneSnapshot> streamed;
+		bool valid = false;
+	};
 
 	class ARCHE_API SceneSerializer
 	{
 	public:
+		// クッカーが書き出すプレファブ（MessagePack）の拡張子。例: Enemy.json → Enemy.json.msgpack
+		// シーンは SceneBinary::EXTENSION (.ascene) で書き出される
+		static constexpr const char* COOKED_EXTENSION = ".msgpack";
+
+		enum class DocumentFormat
+		{
+			Json,			// ソース
+			MessagePack,	// クック済み（COOKED_EXTENSION）
+			Binary,			// クック済みのバイナリシーン（SceneBinary::EXTENSION）
+		};
+
+		// シーン / プレファブのJSONを読む（ソースより新しいクック済みファイルがあればそちらを使う）
+		static bool ReadDocument(const std::string& filepath, json& outJson);
+		// ReadDocument を「開く」と「パース」に分けたもの（開くのは呼び出し元のスレッド、パースはワーカーで行う用）
+		static bool OpenDocument(const std::string& filepath, FileView& outFile, DocumentFormat& outFormat);
+		static bool ParseDocument(const std::string& filepath, const FileView& file, DocumentFormat format, json& outJson);
+		// シーン用。JSON に変換せず、バイナリシーンはそのまま、JSON / MessagePack は SAX で直接復元して持つ
+		static bool ParseScene(const std::string& filepath, const FileView& file, DocumentFormat format, SceneDocument& outDocument);
+
 		static void SaveScene(World& world, const std::string& filepath);
 		static void LoadScene(World& world, const std::string& filepath);
+		// 読み込み済みのシーンから構築する（filepath はログ用）
+		static void LoadScene(World& world, const json& sceneJson, const std::string& filepath);
+		static void LoadScene(World& world, const SceneDocument& document, const std::string& filepath);
 		static void RevertPrefab(World& world, Entity entity);
 		static void CreateEmptyScene(const std::string& filepath);
 
 		// プレファブ保存・読み込み
 		static void SavePrefab(Registry& reg, Entity root, const std::string& filepath);
 		static Entity LoadPrefab(World& world, const std::string& filepath);
+		// 同じプレファブを count 個まとめて生成し、ルートを返す（テンプレートは PrefabCache にある）
+		static std::vector<Entity> InstantiatePrefab(World& world, const std::string& filepath, uint32_t count);
 
-		// プレファブの変更をシーン上のインスタンスに適用する
+		// プレファブの変更をシーン上のインスタンスに適用する（変わったフィールドだけ。PrefabPatch）
 		static void ReloadPrefabInstances(World& world, const std::string& filepath);
 
 		// ヘルパー再帰処理用
@@ -49,6 +87,12 @@ namespace Arche
 		// エンティティとその子孫を全て削除する
 		static void DestroyEntityRecursive(World& world, Entity entity);
 
+		// エンティティとその子孫を親 → 子の順に集める
+		static void CollectHierarchy(Registry& reg, Entity root, std::vector<Entity>& outEntities);
+		// sources をまとめて dst に複製する（ComponentRegistry::copyBatch。JSON を通さない）
+		// 親子関係は sources 内を指していれば複製先に付け替え、外を指していればそのまま残す
+		static void CopyEntities(Registry& src, const std::vector<Entity>& sources, Registry& dst, std::vector<Entity>& outCopies);
+
 		static void ReconstructPrefabChildren(World& world, Entity root, const json& prefabJson);
 		// 個別保存用（必要なら実装、使わなければ削除可）
 		static void SerializeEntityToJson(Registry& registry, Entity entity, json& outJson);
@@ -59,7 +103,14 @@ namespace Arche
 		static void CollectAssets(const std::string& filepath, 
 			std::vector<std::string>& outModels, 
 			std::vector<std::string>& outTextures, 
-			std::vector<std::string>& outSounds);
+			std::vector<std::string>& outSounds,
+			std::vector<std::string>& outControllers);
+		// 読み込み済みのシーン / プレファブJSONから収集する
+		static void CollectAssets(const json& root,
+			std::vector<std::string>& outModels,
+			std::vector<std::string>& outTextures,
+			std::vector<std::string>& outSounds,
+			std::vector<std::string>& outControllers);
 
 		static Entity DuplicateEntity(World& world, Entity entity);
 	};
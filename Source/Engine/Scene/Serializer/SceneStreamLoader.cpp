@@ -0,0 +1,388 @@
+﻿/*****************************************************************//**
+ * @file	SceneStreamLoader.cpp
+ * @brief	シーンの JSON / MessagePack を DOM を作らずに読み込む
+ *
+ * @details
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Scene/Serializer/SceneStreamLoader.h"
+#include "Engine/Scene/Serializer/SceneEntityLoader.h"
+#include "Engine/Scene/Serializer/SceneSaver.h"
+#include "Engine/Scene/Serializer/ComponentRegistry.h"
+
+namespace Arche
+{
+	namespace
+	{
+		// SAX のイベントを受けて、シーンの形（{ 設定..., "Entities": [ { "ID", "IsActive", コンポーネント... } ] }）を辿る
+		class SceneSaxHandler : public nlohmann::json_sax<json>
+		{
+		public:
+			explicit SceneSaxHandler(SceneSnapshot& scene)
+				: m_scene(scene), m_interfaces(ComponentRegistry::Instance().GetInterfaces()) {}
+
+			bool null() override { return OnValue(JsonStreamValue::Type::Null); }
+			bool boolean(bool val) override { m_value.boolean = val; return OnValue(JsonStreamValue::Type::Bool); }
+			bool number_integer(number_integer_t val) override { m_value.integer = val; return OnValue(JsonStreamValue::Type::Integer); }
+			bool number_unsigned(number_unsigned_t val) override { m_value.unsignedInteger = val; return OnValue(JsonStreamValue::Type::Unsigned); }
+			bool number_float(number_float_t val, const string_t&) override { m_value.number = val; return OnValue(JsonStreamValue::Type::Float); }
+			bool string(string_t& val) override { m_value.string = std::move(val); return OnValue(JsonStreamValue::Type::String); }
+			// シーンには出てこない（MessagePack の bin 型）ので null として扱う
+			bool binary(binary_t&) override { return OnValue(JsonStreamValue::Type::Null); }
+
+			bool key(string_t& val) override
+			{
+				switch (m_mode)
+				{
+				case Mode::Root:		m_rootKey = std::move(val); break;
+				case Mode::Setting:		m_settingKey = std::move(val); break;
+				case Mode::Component:
+					m_key = std::move(val);
+					m_field = FindField(m_key);
+					break;
+				default:				m_key = std::move(val); break;
+				}
+				return true;
+			}
+
+			bool start_object(std::size_t) override
+			{
+				switch (m_mode)
+				{
+				case Mode::Start:
+					m_mode = Mode::Root;
+					break;
+				case Mode::Root:
+					if (m_rootKey == "Entities") Skip(Mode::Root);
+					else BeginSetting(json::object());
+					break;
+				case Mode::Setting:
+					m_building.push_back(PutSetting(json::object()));
+					break;
+				case Mode::Entities:
+					BeginEntity();
+					break;
+				case Mode::Entity:
+					if (BeginComponent()) m_mode = Mode::Component;
+					else Skip(Mode::Entity);
+					break;
+				case Mode::Component:
+					// 配列のフィールドにオブジェクトが来たら値の並びとして読む（DOM を走査したときと同じ）
+					if (m_field && m_field->setArray) BeginFieldArray();
+					else Skip(Mode::Component);
+					break;
+				case Mode::FieldArray:
+					m_itemsValid = false;
+					Skip(Mode::FieldArray);
+					break;
+				case Mode::Skip:
+					m_skipDepth++;
+					break;
+				default:
+					Skip(m_mode);
+					break;
+				}
+				return true;
+			}
+
+			bool end_object() override
+			{
+				switch (m_mode)
+				{
+				case Mode::Root:		m_mode = Mode::Done; break;
+				case Mode::Setting:		EndSetting(); break;
+				case Mode::Entity:		m_mode = Mode::Entities; break;
+				case Mode::Component:	m_mode = Mode::Entity; break;
+				case Mode::FieldArray:	EndFieldArray(); break;
+				case Mode::Skip:		EndSkip(); break;
+				default:				break;
+				}
+				return true;
+			}
+
+			bool start_array(std::size_t) override
+			{
+				switch (m_mode)
+				{
+				case Mode::Start:
+					// 配列（プレファブの旧形式）はシーンとしては空
+					Skip(Mode::Done);
+					break;
+				case Mode::Root:
+					if (m_rootKey == "Entities") m_mode = Mode::Entities;
+					else BeginSetting(json::array());
+					break;
+				case Mode::Setting:
+					m_building.push_back(PutSetting(json::array()));
+					break;
+				case Mode::Entity:
+					BeginComponent();
+					Skip(Mode::Entity);
+					break;
+				case Mode::Component:
+					if (m_field && m_field->setArray) BeginFieldArray();
+					else Skip(Mode::Component);
+					break;
+				case Mode::FieldArray:
+					m_itemsValid = false;
+					Skip(Mode::FieldArray);
+					break;
+				case Mode::Skip:
+					m_skipDepth++;
+					break;
+				default:
+					Skip(m_mode);
+					break;
+				}
+				return true;
+			}
+
+			bool end_array() override
+			{
+				switch (m_mode)
+				{
+				case Mode::Setting:		EndSetting(); break;
+				case Mode::Entities:	m_mode = Mode::Root; break;
+				case Mode::FieldArray:	EndFieldArray(); break;
+				case Mode::Skip:		EndSkip(); break;
+				default:				break;
+				}
+				return true;
+			}
+
+			bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override
+			{
+				m_error = ex.what();
+				return false;
+			}
+
+			void SetError(const std::string& error) { m_error = error; }
+			const std::string& GetError() const { return m_error; }
+
+		private:
+			enum class Mode
+			{
+				Start,		// ルートの前
+				Root,		// ルートのオブジェクト直下
+				Setting,	// Entities 以外の値（DOM に組み立てる）
+				Entities,	// Entities 配列の中
+				Entity,		// エンティティのオブジェクト直下
+				Component,	// コンポーネントのオブジェクト直下
+				FieldArray,	// 配列のフィールド（要素を溜めて、閉じたときに書き込む）
+				Skip,		// 使わない値を読み飛ばす
+				Done,
+			};
+
+			bool OnValue(JsonStreamValue::Type type)
+			{
+				m_value.type = type;
+				switch (m_mode)
+				{
+				case Mode::Start:
+					// ルートがオブジェクトでなければ空のシーン
+					m_mode = Mode::Done;
+					break;
+				case Mode::Root:
+					if (m_rootKey != "Entities") m_scene.settings[m_rootKey] = ToJson(m_value);
+					break;
+				case Mode::Setting:
+					PutSetting(ToJson(m_value));
+					break;
+				case Mode::Entity:
+					if (m_key == "ID") { if (m_value.IsArithmetic()) m_scene.ids.back() = m_value.GetNumber<uint32_t>(); }
+					else if (m_key == "IsActive") { if (type == JsonStreamValue::Type::Bool) m_scene.active.back() = (uint8_t)m_value.boolean; }
+					else BeginComponent();
+					break;
+				case Mode::Component:
+					if (m_key == "Enabled" && type == JsonStreamValue::Type::Bool) m_iface->setEnabled(m_scene.registry, m_entity, m_value.boolean);
+					if (!m_field) break;
+					if (m_field->setValue) m_field->setValue(m_component + m_field->offset, m_value);
+					// 配列のフィールドに単独の値が来たら1要素（null なら空）として読む（DOM を走査したときと同じ）
+					// どちらも無いフィールド（const char* など復元しないもの）は読み飛ばす
+					else if (m_field->setArray) m_field->setArray(m_component + m_field->offset, &m_value, type == JsonStreamValue::Type::Null ? 0 : 1);
+					break;
+				case Mode::FieldArray:
+					m_items.push_back(std::move(m_value));
+					break;
+				default:
+					break;
+				}
+				return true;
+			}
+
+			// --- エンティティ・コンポーネント ---
+			void BeginEntity()
+			{
+				m_entity = m_scene.registry.create();
+				m_scene.entities.push_back(m_entity);
+				m_scene.ids.push_back(NullEntity);
+				m_scene.active.push_back(1);
+				m_mode = Mode::Entity;
+			}
+
+			// 登録済みのコンポーネント名なら追加して true
+			// 値がオブジェクトでなくても既定値で付ける（DeserializeVisitor と同じ）
+			bool BeginComponent()
+			{
+				auto it = m_interfaces.find(m_key);
+				if (it == m_interfaces.end() || !it->second.beginStream) return false;
+
+				m_iface = &it->second;
+				m_component = static_cast<uint8_t*>(m_iface->beginStream(m_scene.registry, m_entity));
+				m_field = nullptr;
+				return true;
+			}
+
+			void BeginFieldArray()
+			{
+				m_items.clear();
+				m_itemsValid = true;
+				m_mode = Mode::FieldArray;
+			}
+
+			void EndFieldArray()
+			{
+				if (m_itemsValid) m_field->setArray(m_component + m_field->offset, m_items.data(), m_items.size());
+				m_mode = Mode::Component;
+			}
+
+			const JsonStreamField* FindField(const std::string& name) const
+			{
+				for (const auto& field : m_iface->streamFields)
+				{
+					if (field.name == name) return &field;
+				}
+				return nullptr;
+			}
+
+			// --- 設定（Entities 以外は小さいので DOM にする） ---
+			void BeginSetting(json&& container)
+			{
+				json& slot = m_scene.settings[m_rootKey];
+				slot = std::move(container);
+				m_building.push_back(&slot);
+				m_mode = Mode::Setting;
+			}
+
+			json* PutSetting(json&& value)
+			{
+				json& parent = *m_building.back();
+				if (parent.is_object())
+				{
+					json& slot = parent[m_settingKey];
+					slot = std::move(value);
+					return &slot;
+				}
+				parent.push_back(std::move(value));
+				return &parent.back();
+			}
+
+			void EndSetting()
+			{
+				m_building.pop_back();
+				if (m_building.empty()) m_mode = Mode::Root;
+			}
+
+			static json ToJson(JsonStreamValue& value)
+			{
+				switch (value.type)
+				{
+				case JsonStreamValue::Type::Bool:		return value.boolean;
+				case JsonStreamValue::Type::Integer:	return value.integer;
+				case JsonStreamValue::Type::Unsigned:	return value.unsignedInteger;
+				case JsonStreamValue::Type::Float:		return value.number;
+				case JsonStreamValue::Type::String:		return std::move(value.string);
+				default:								return nullptr;
+				}
+			}
+
+			// --- 読み飛ばし ---
+			void Skip(Mode returnTo)
+			{
+				m_skipReturn = returnTo;
+				m_skipDepth = 1;
+				m_mode = Mode::Skip;
+			}
+
+			void EndSkip()
+			{
+				if (--m_skipDepth == 0) m_mode = m_skipReturn;
+			}
+
+		private:
+			SceneSnapshot& m_scene;
+			const std::map<std::string, ComponentRegistry::Interface>& m_interfaces;
+			std::string m_error;
+
+			Mode m_mode = Mode::Start;
+			Mode m_skipReturn = Mode::Done;
+			size_t m_skipDepth = 0;
+
+			JsonStreamValue m_value;
+			std::string m_rootKey;
+			std::string m_key;
+
+			std::string m_settingKey;
+			std::vector<json*> m_building;	// 組み立て中の設定（外側から順）
+
+			Entity m_entity = NullEntity;
+			const ComponentRegistry::Interface* m_iface = nullptr;
+			uint8_t* m_component = nullptr;
+			const JsonStreamField* m_field = nullptr;
+
+			std::vector<JsonStreamValue> m_items;
+			bool m_itemsValid = true;
+		};
+	}
+
+	void SceneStreamLoader::Prepare()
+	{
+		Registry warmup;
+		for (const auto& [name, iface] : ComponentRegistry::Instance().GetInterfaces()) iface.reserve(warmup, 0);
+	}
+
+	bool SceneStreamLoader::Parse(const uint8_t* data, size_t size, bool isMessagePack, SceneSnapshot& outScene, std::string& outError)
+	{
+		SceneSaxHandler handler(outScene);
+		bool succeeded = false;
+		try
+		{
+			succeeded = json::sax_parse(data, data + size, &handler, isMessagePack ? json::input_format_t::msgpack : json::input_format_t::json);
+		}
+		catch (const std::exception& e)
+		{
+			handler.SetError(e.what());
+		}
+
+		if (!succeeded) outError = handler.GetError();
+		return succeeded;
+	}
+
+	void SceneStreamLoader::Instantiate(Registry& reg, SceneSnapshot& scene, EntityIdRemap& outRemap)
+	{
+		const size_t total = scene.entities.size();
+
+		// まとめて作り、型ごとにプールへ移す（SceneEntityLoader と同じ）
+		std::vector<Entity> entities;
+		reg.create(total, entities);
+		for (size_t i = 0; i < total; ++i)
+		{
+			if (!scene.active[i]) reg.setActive(entities[i], false);
+		}
+
+		for (const auto& [name, iface] : ComponentRegistry::Instance().GetInterfaces())
+		{
+			iface.moveBatch(scene.registry, scene.entities.data(), reg, entities.data(), total);
+		}
+
+		outRemap.Build(scene.ids.data(), entities.data(), total);
+		outRemap.ResolveRelationships(reg);
+	}
+
+}	// namespace Arche
@@ -0,0 +1,47 @@
+﻿/*****************************************************************//**
+ * @file	SceneStreamLoader.h
+ * @brief	シーンの JSON / MessagePack を DOM を作らずに読み込む
+ *
+ * @details	nlohmann の SAX でトークンを受け取り、コンポーネントのオブジェクトが始まった時点で
+ *			作業用のレジストリへ追加して、以降のフィールドをその場で書き込む
+ *			（ComponentRegistry::Interface の streamFields）。シーン全体の DOM を持たないので、
+ *			大きいシーンでもピークのメモリはほぼコンポーネントのぶんだけになる。
+ *
+ *			Parse はワーカーで、Instantiate はメインスレッドで行う（SceneManager の非同期ロード）。
+ *			エディタ向けの ReadDocument・プレファブ（PrefabCache）は今までどおり DOM を使う。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___SCENE_STREAM_LOADER_H___
+#define ___SCENE_STREAM_LOADER_H___
+
+// ===== インクルード =====
+#include "Engine/pch.h"
+#include "Engine/Scene/Core/ECS/ECS.h"
+
+namespace Arche
+{
+	struct SceneSnapshot;
+	class EntityIdRemap;
+
+	class ARCHE_API SceneStreamLoader
+	{
+	public:
+		// ワーカーで Parse する前にメインスレッドで呼ぶ（型IDの採番はスレッドセーフではない）
+		static void Prepare();
+
+		// シーンを読み、outScene の作業用レジストリへ復元する（Entities 以外は outScene.settings へ）
+		// どのスレッドからでも呼べる。失敗したら outError に理由を入れて false
+		static bool Parse(const uint8_t* data, size_t size, bool isMessagePack, SceneSnapshot& outScene, std::string& outError);
+
+		// 復元したものを型ごとに reg へ移し、保存時のIDで書かれた親子関係を付け替える
+		// scene のコンポーネントは移したあとなので、この後は使わないこと
+		static void Instantiate(Registry& reg, SceneSnapshot& scene, EntityIdRemap& outRemap);
+	};
+
+}	// namespace Arche
+
+#endif // !___SCENE_STREAM_LOADER_H___
@@ -17,7 +17,8 @@
 #include "Engine/Scene/Components/Components.h"
 #include "Engine/Core/Time/Time.h"
 #include "Engine/Scene/Animation/AnimatorController.h"
-#include "Engine/Scene/Serializer/AnimatorControllerSerializer.h"
+#include "Engine/Scene/Animation/AnimationLod.h"
+#include "Engine/Resource/ResourceManager.h"
 
 namespace Arche
 {
@@ -35,6 +36,14 @@ namespace Arche
 			float dt = Time::DeltaTime();
 			auto view = registry.view<MeshComponent, Animator>();
 
+			// LOD判定用のカメラ位置
+			XMFLOAT3 cameraPos = {};
+			bool hasCamera = FindCameraPosition(registry, cameraPos);
+
+			auto& stats = AnimationLodStats::Instance();
+			stats.Reset();
+			++m_frameIndex;
+
 			for (auto entity : view)
 			{
 				auto& mesh = view.get<MeshComponent>(entity);
@@ -42,111 +51,123 @@ namespace Arche
 
 				if (!mesh.pModel) continue;
 
-				// 1. ロード
+				// 1. ロード（同じパスのコントローラーは ResourceManager で共有）
 				if (!animator.controller && !animator.controllerPath.empty()) {
-					animator.controller = AnimatorControllerSerializer::Deserialize(animator.controllerPath);
+					animator.controller = ResourceManager::Instance().GetAnimatorController(animator.controllerPath);
 				}
 				if (!animator.controller) continue;
 
-				auto& controller = animator.controller;
+				// コントローラーが差し替わった・リロードされた場合は再バインド
+				const AnimatorProgram& program = animator.controller->program;
+				if (animator.boundProgram != &program || animator.boundRevision != program.GetRevision())
+				{
+					animator.Bind(program);
+				}
+
+				// 2. 初期ステート（保存されたステート名があればそこから再開）
+				if (animator.currentStateIndex == AnimatorProgram::INVALID_INDEX)
+				{
+					animator.currentStateIndex = program.FindState(animator.currentState);
+					if (animator.currentStateIndex == AnimatorProgram::INVALID_INDEX)
+					{
+						int entry = program.GetEntryState();
+						if (entry != AnimatorProgram::INVALID_INDEX) ChangeState(animator, mesh, entry, 0.0f); // 初期は即時遷移
+						continue;
+					}
+				}
+
+				// 3. 遷移判定（コンパイル済みの条件命令を実行）
+				int transition = program.EvaluateTransitions(animator.currentStateIndex, animator.params.data(), GetNormalizedTime(mesh));
+				if (transition != AnimatorProgram::INVALID_INDEX)
+				{
+					const auto& trans = program.GetTransition(transition);
+					ChangeState(animator, mesh, trans.targetState, trans.duration);
+				}
+
+				animator.stateTime += dt;
 
-				// 2. 初期ステート
-				const AnimatorState* currentState = controller->FindState(animator.currentState);
-				if (!currentState) {
-					// (前回と同じ初期化処理)
-					const AnimatorState* entry = nullptr;
-					if (controller->entryState.GetHash() != 0) entry = controller->FindState(controller->entryState);
-					else if (!controller->states.empty()) entry = &controller->states[0];
+				// 4. LOD判定（間引くフレームは姿勢とパレットを保持し、経過時間だけ溜める）
+				animator.lodLevel = (hasCamera && animator.useLod) ? SelectLod(registry, entity, animator, cameraPos) : AnimationLodLevel::Full;
+				stats.levelCounts[(int)animator.lodLevel]++;
 
-					if (entry) ChangeState(animator, mesh, *entry, 0.0f); // 初期は即時遷移
+				animator.lodPendingTime += dt;
+				int interval = AnimationLod::GetInterval(animator.lodLevel, animator.lodMidInterval, animator.lodFarInterval);
+				if (!AnimationLod::ShouldUpdate(m_frameIndex, entity, interval) && animator.palette.IsValidFor(mesh.pModel.get()))
+				{
+					stats.held++;
 					continue;
 				}
+				stats.evaluated++;
 
-				// 3. 遷移判定
-				for (const auto& transition : currentState->transitions)
+				// 5. 更新
+				const std::vector<uint8_t>* nodeMask = nullptr;
+				if (animator.lodLevel == AnimationLodLevel::UpperBody)
 				{
-					if (CheckConditions(animator, mesh, transition))
+					// モデルかボーン名が変わったら作り直す
+					uint32_t boneHash = StringId::Hash(animator.lodUpperBodyBone.c_str());
+					if (animator.lodMaskSource != mesh.pModel.get() || animator.lodMaskBoneHash != boneHash)
 					{
-						const AnimatorState* nextState = controller->FindState(transition.targetState);
-						if (nextState)
-						{
-							ConsumeTriggers(animator, transition);
-							// ★修正: Durationを渡して遷移
-							ChangeState(animator, mesh, *nextState, transition.duration);
-							break;
-						}
+						mesh.pModel->BuildSubtreeMask(animator.lodUpperBodyBone, animator.lodUpperBodyMask);
+						animator.lodMaskSource = mesh.pModel.get();
+						animator.lodMaskBoneHash = boneHash;
 					}
+					if (!animator.lodUpperBodyMask.empty()) nodeMask = &animator.lodUpperBodyMask;
 				}
 
-				// 4. 更新
-				if (animator.isPlaying) mesh.pModel->Step(dt);
-				animator.stateTime += dt;
+				if (animator.isPlaying) mesh.pModel->Step(animator.lodPendingTime, nodeMask);
+				animator.lodPendingTime = 0.0f;
+
+				// 6. スキニングパレット計算（描画側はメッシュ毎に再計算しない）
+				animator.palette.Update(*mesh.pModel);
 			}
 		}
 
 	private:
-		// duration引数を追加
-		void ChangeState(Animator& animator, MeshComponent& mesh, const AnimatorState& nextState, float duration)
+		uint64_t m_frameIndex = 0;
+
+		// 描画と同じメインカメラ（Camera::FindMain）の位置
+		bool FindCameraPosition(Registry& registry, XMFLOAT3& outPos)
 		{
-			animator.currentState = nextState.name;
-			animator.stateTime = 0.0f;
+			Entity camera = Camera::FindMain(registry);
+			if (camera == NullEntity) return false;
 
-			if (!nextState.motionName.empty())
-			{
-				// Model側のPlayにDurationを渡す
-				mesh.pModel->Play(nextState.motionName, nextState.loop, nextState.speed, duration);
-			}
+			const auto& world = registry.get<Transform>(camera).worldMatrix;
+			outPos = { world._41, world._42, world._43 };
+			return true;
 		}
 
-		bool CheckConditions(Animator& animator, MeshComponent& mesh, const AnimatorTransition& transition)
+		AnimationLodLevel SelectLod(Registry& registry, Entity entity, const Animator& animator, const XMFLOAT3& cameraPos)
 		{
-			// ExitTimeチェック
-			if (transition.hasExitTime)
-			{
-				// Modelから正確な時間と長さを取得
-				float length = mesh.pModel->GetCurrentAnimationLength();
-				float time = mesh.pModel->GetCurrentAnimationTime();
-
-				// 長さが0なら即遷移 (安全策)
-				if (length <= 0.001f) return true;
-
-				// 正規化時間
-				float normalizedTime = time / length;
-
-				// 指定時間に達していないなら遷移しない
-				if (normalizedTime < transition.exitTime) return false;
-			}
-
-			// ExitTime以外に条件がなければ、ExitTimeを満たした時点でOK
-			if (transition.conditions.empty()) return true;
-
-			// 条件チェック
-			for (const auto& cond : transition.conditions)
-			{
-				if (!EvaluateCondition(animator, cond)) return false;
-			}
-			return true;
+			if (!registry.has<Transform>(entity)) return AnimationLodLevel::Full;
+
+			const auto& world = registry.get<Transform>(entity).worldMatrix;
+			float dx = world._41 - cameraPos.x;
+			float dy = world._42 - cameraPos.y;
+			float dz = world._43 - cameraPos.z;
+			return AnimationLod::Select(dx * dx + dy * dy + dz * dz,
+				animator.lodHalfDistance, animator.lodLowDistance, animator.lodUpperBodyDistance);
 		}
 
-		bool EvaluateCondition(Animator& animator, const AnimatorCondition& cond)
+		void ChangeState(Animator& animator, MeshComponent& mesh, int stateIndex, float duration)
 		{
-			switch (cond.mode)
+			const AnimatorState& nextState = animator.controller->states[stateIndex];
+			animator.currentState = nextState.name;
+			animator.currentStateIndex = stateIndex;
+			animator.stateTime = 0.0f;
+
+			if (!nextState.motionName.empty())
 			{
-			case AnimatorConditionMode::If:		 return animator.GetBool(cond.parameter) == true;
-			case AnimatorConditionMode::IfNot:	 return animator.GetBool(cond.parameter) == false;
-			case AnimatorConditionMode::Greater: return animator.GetFloat(cond.parameter) > cond.threshold;
-			case AnimatorConditionMode::Less:	 return animator.GetFloat(cond.parameter) < cond.threshold;
-			case AnimatorConditionMode::Equals:	 return animator.GetInt(cond.parameter) == (int)cond.threshold;
-			case AnimatorConditionMode::NotEqual:return animator.GetInt(cond.parameter) != (int)cond.threshold;
-			default: if (animator.triggers.count(cond.parameter)) return animator.triggers[cond.parameter]; return false;
+				// Model側のPlayにDurationを渡す
+				mesh.pModel->Play(nextState.motionName, nextState.loop, nextState.speed, duration);
 			}
 		}
 
-		void ConsumeTriggers(Animator& animator, const AnimatorTransition& transition)
+		// 現在モーションの正規化時間（長さが0なら即遷移できるよう十分大きい値を返す）
+		float GetNormalizedTime(MeshComponent& mesh)
 		{
-			for (const auto& cond : transition.conditions) {
-				if (animator.triggers.count(cond.parameter)) animator.triggers[cond.parameter] = false;
-			}
+			float length = mesh.pModel->GetCurrentAnimationLength();
+			if (length <= 0.001f) return FLT_MAX;
+			return mesh.pModel->GetCurrentAnimationTime() / length;
 		}
 	};
 }
@@ -43,17 +43,19 @@ namespace Arche
 			XMMATRIX viewMatrix = XMMatrixIdentity();
 			XMMATRIX projMatrix = XMMatrixIdentity();
 			bool cameraFound = false;
-			registry.view<Camera, Transform>().each([&](Entity e, Camera& cam, Transform& trans)
-				{
-					if (cameraFound) return;
-					XMVECTOR eye = XMLoadFloat3(&trans.position);
-					XMMATRIX rotM = XMMatrixRotationRollPitchYaw(trans.rotation.x, trans.rotation.y, 0.0f);
-					XMVECTOR look = XMVector3TransformCoord(XMVectorSet(0, 0, 1, 0), rotM);
-					XMVECTOR up = XMVector3TransformCoord(XMVectorSet(0, 1, 0, 0), rotM);
-					viewMatrix = XMMatrixLookToLH(eye, look, up);
-					projMatrix = XMMatrixPerspectiveFovLH(cam.fov, cam.aspect, cam.nearZ, cam.farZ);
-					cameraFound = true;
-				});
+			Entity cameraEntity = Camera::FindMain(registry);
+			if (cameraEntity != NullEntity)
+			{
+				auto& cam = registry.get<Camera>(cameraEntity);
+				auto& trans = registry.get<Transform>(cameraEntity);
+				XMVECTOR eye = XMLoadFloat3(&trans.position);
+				XMMATRIX rotM = XMMatrixRotationRollPitchYaw(trans.rotation.x, trans.rotation.y, 0.0f);
+				XMVECTOR look = XMVector3TransformCoord(XMVectorSet(0, 0, 1, 0), rotM);
+				XMVECTOR up = XMVector3TransformCoord(XMVectorSet(0, 1, 0, 0), rotM);
+				viewMatrix = XMMatrixLookToLH(eye, look, up);
+				projMatrix = XMMatrixPerspectiveFovLH(cam.fov, cam.aspect, cam.nearZ, cam.farZ);
+				cameraFound = true;
+			}
 			if (!cameraFound) return;
 
 			// 描画開始
@@ -64,26 +64,28 @@ namespace Arche
 		}
 		else
 		{
-			registry.view<Camera, Transform>().each([&](Entity e, Camera& cam, Transform& trans)
-				{
-					if (cameraFound) return;
-
-					savedRotation = trans.rotation;
-
-					eye = XMLoadFloat3(&trans.position);
-					// 回転行列を作成 (Pitch: X軸回転, Yaw: Y軸回転)
-					// Transform.rotation.x を Pitch(上下)、y を Yaw(左右) として使います
-					XMMATRIX rotationMatrix = XMMatrixRotationRollPitchYaw(trans.rotation.x, trans.rotation.y, 0.0f);
-					// 前方ベクトル (0, 0, 1) を回転させる
-					XMVECTOR lookDir = XMVector3TransformCoord(XMVectorSet(0, 0, 1, 0), rotationMatrix);
-					// 上方向ベクトル (0, 1, 0) を回転させる
-					XMVECTOR upDir = XMVector3TransformCoord(XMVectorSet(0, 1, 0, 0), rotationMatrix);
-
-					// LookToLH: 位置、向き、上でビュー行列を作る
-					viewMatrix = XMMatrixLookToLH(eye, lookDir, upDir);
-					projMatrix = XMMatrixPerspectiveFovLH(cam.fov, cam.aspect, cam.nearZ, cam.farZ);
-					cameraFound = true;
-				});
+			Entity cameraEntity = Camera::FindMain(registry);
+			if (cameraEntity != NullEntity)
+			{
+				auto& cam = registry.get<Camera>(cameraEntity);
+				auto& trans = registry.get<Transform>(cameraEntity);
+
+				savedRotation = trans.rotation;
+
+				eye = XMLoadFloat3(&trans.position);
+				// 回転行列を作成 (Pitch: X軸回転, Yaw: Y軸回転)
+				// Transform.rotation.x を Pitch(上下)、y を Yaw(左右) として使います
+				XMMATRIX rotationMatrix = XMMatrixRotationRollPitchYaw(trans.rotation.x, trans.rotation.y, 0.0f);
+				// 前方ベクトル (0, 0, 1) を回転させる
+				XMVECTOR lookDir = XMVector3TransformCoord(XMVectorSet(0, 0, 1, 0), rotationMatrix);
+				// 上方向ベクトル (0, 1, 0) を回転させる
+				XMVECTOR upDir = XMVector3TransformCoord(XMVectorSet(0, 1, 0, 0), rotationMatrix);
+
+				// LookToLH: 位置、向き、上でビュー行列を作る
+				viewMatrix = XMMatrixLookToLH(eye, lookDir, upDir);
+				projMatrix = XMMatrixPerspectiveFovLH(cam.fov, cam.aspect, cam.nearZ, cam.farZ);
+				cameraFound = true;
+			}
 		}
 
 		// スカイボックスのテクスチャロード管理
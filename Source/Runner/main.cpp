@@ -256,6 +256,8 @@ int main()
 		if (g_app)
 		{
 			isReloading = g_app->IsReloadRequested();
+			// 今のシーンをエンジン側のメモリに取っておく（新しいDLLの Run() で復元される）
+			if (isReloading) g_app->SaveState();
 			delete g_app;
 			g_app = nullptr;
 		}
@@ -0,0 +1,38 @@
+﻿/*****************************************************************//**
+ * @file	AnimatorBenchmarkTest.cpp
+ * @brief	AnimatorBenchmark（遷移評価の変更前と AnimatorProgram の比較）のテスト
+ *
+ * @details	- 変更前の評価（文字列のmap + 名前での検索）と AnimatorProgram で、成立した遷移の数が一致すること
+ *			- 1000体 × 600フレームの時間を出力する（ArcheCook --bench-animator と同じ計測。合否には使わない）
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "TestCommon.h"
+#include "Engine/Scene/Animation/AnimatorBenchmark.h"
+
+using namespace Arche;
+
+int main()
+{
+	// 少数でも多数でも一致すること
+	for (uint32_t count : { 1u, 17u })
+	{
+		AnimatorBenchmarkResult small = AnimatorBenchmark::Run(count, 300);
+		ARCHE_CHECK(small.succeeded);
+		ARCHE_CHECK(small.transitionCount > 0);
+	}
+
+	AnimatorBenchmarkResult result = AnimatorBenchmark::Run(1000, 600);
+	ARCHE_CHECK(result.succeeded);
+	ARCHE_CHECK(result.transitionCount > 0);
+
+	std::printf("Animator: %u animators x %u frames, %llu transitions\n", result.animatorCount, result.frameCount, (unsigned long long)result.transitionCount);
+	std::printf("  legacy  %.3f ms/frame\n", result.GetLegacyFrameMs());
+	std::printf("  program %.3f ms/frame (x%.1f)\n", result.GetProgramFrameMs(), result.GetSpeedup());
+
+	return ARCHE_TEST_RESULT();
+}
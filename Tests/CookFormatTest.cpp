@@ -0,0 +1,219 @@
+﻿/*****************************************************************//**
+ * @file	CookFormatTest.cpp
+ * @brief	クッカーの形式だけの部分（CookDatabase / CookGraph / SceneBinaryFormat）のテスト
+ *
+ * @details	- CookDatabase		: 保存して読み直すと同じ記録になること・バージョン違い/壊れたファイルは空になること・Prune
+ *			- CookGraph			: キーが同じ入力で変わらず、内容・依存先・バージョン・種類ごとの値で変わること
+ *								  クック対象外の依存先のハッシュはパスごとに1回だけ取ること
+ *			- SplitJson			: シーンJSON を設定・ID・Active・未登録コンポーネントに分けること
+ *			- Write / Read		: 書いて読み直すと同じ内容になり、途中で切れたデータはどの長さでも読まないこと
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "TestCommon.h"
+#include "Engine/Resource/CookDatabase.h"
+#include "Engine/Resource/CookGraph.h"
+#include "Engine/Scene/Serializer/SceneBinaryFormat.h"
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+using namespace Arche;
+
+namespace
+{
+	std::filesystem::path MakeTempDirectory()
+	{
+		std::filesystem::path dir = std::filesystem::temp_directory_path() / "ArcheCookFormatTest";
+		std::error_code ec;
+		std::filesystem::remove_all(dir, ec);
+		std::filesystem::create_directories(dir, ec);
+		return dir;
+	}
+
+	void TestDatabase(const std::filesystem::path& dir)
+	{
+		// 親ディレクトリが無くても作って書く
+		const std::string path = (dir / "Cache" / "CookDatabase.json").string();
+		CookDatabaseEntries entries = { { "Resources/Scenes/a.json", 1 }, { "Resources/Models/b.fbx", 0xFFFFFFFFFFFFFFFFull } };
+		ARCHE_CHECK(CookDatabase::Save(path, 3, entries));
+		ARCHE_CHECK(!std::filesystem::exists(path + ".tmp"));
+		ARCHE_CHECK(CookDatabase::Load(path, 3) == entries);
+
+		// バージョン違い・無いファイル・壊れたファイルは空
+		ARCHE_CHECK(CookDatabase::Load(path, 4).empty());
+		ARCHE_CHECK(CookDatabase::Load((dir / "missing.json").string(), 3).empty());
+		{
+			std::ofstream ofs(path, std::ios::trunc);
+			ofs << "{ \"Version\": 3, \"Entries\": ";
+		}
+		ARCHE_CHECK(CookDatabase::Load(path, 3).empty());
+
+		// 数値でない記録だけを捨てる
+		{
+			std::ofstream ofs(path, std::ios::trunc);
+			ofs << R"({ "Version": 3, "Entries": { "a": 5, "b": "x", "c": -1 } })";
+		}
+		CookDatabaseEntries loaded = CookDatabase::Load(path, 3);
+		ARCHE_CHECK(loaded.size() == 1 && loaded["a"] == 5);
+
+		CookDatabase::Prune(entries, { "Resources/Scenes/a.json", "Resources/Scenes/new.json" });
+		ARCHE_CHECK(entries.size() == 1 && entries.count("Resources/Scenes/a.json") == 1);
+	}
+
+	// nodes[0] が nodes[1]（クック対象）と external（クック対象外）に依存する
+	struct GraphFixture
+	{
+		CookNode scene, model, broken;
+		uint64_t externalHash = 42;
+		int externalReads = 0;
+
+		GraphFixture()
+		{
+			scene.path = "Resources/Scenes/a.json";
+			scene.contentHash = 100;
+			scene.dependencies = { "Resources/Models/b.fbx", "Resources/Controllers/c.json", "Resources/Models/b.fbx" };
+			scene.hashed = true;
+			CookGraph::SortDependencies(scene);
+
+			model.path = "Resources/Models/b.fbx";
+			model.contentHash = 200;
+			model.hashed = true;
+
+			broken.path = "Resources/Scenes/broken.json";
+		}
+
+		void Compute(uint32_t version)
+		{
+			CookNode* nodes[] = { &scene, &model, &broken };
+			CookGraph::ComputeKeys(nodes, 3, version, [this](const std::string& path) {
+				++externalReads;
+				return path == "Resources/Controllers/c.json" ? externalHash : 0;
+				});
+		}
+	};
+
+	void TestGraph()
+	{
+		GraphFixture base;
+		ARCHE_CHECK(base.scene.dependencies.size() == 2);
+		base.Compute(3);
+		ARCHE_CHECK(base.externalReads == 1);
+		ARCHE_CHECK(base.broken.cookKey == 0);
+		ARCHE_CHECK(base.scene.cookKey != base.model.cookKey);
+
+		{
+			GraphFixture same;
+			same.Compute(3);
+			ARCHE_CHECK(same.scene.cookKey == base.scene.cookKey && same.model.cookKey == base.model.cookKey);
+		}
+		auto changed = [&base](auto&& mutate, uint32_t version = 3) {
+			GraphFixture f;
+			mutate(f);
+			f.Compute(version);
+			return f.scene.cookKey != base.scene.cookKey;
+			};
+		ARCHE_CHECK(changed([](GraphFixture& f) { f.scene.contentHash++; }));
+		ARCHE_CHECK(changed([](GraphFixture& f) { f.model.contentHash++; }));
+		ARCHE_CHECK(changed([](GraphFixture& f) { f.externalHash++; }));
+		ARCHE_CHECK(changed([](GraphFixture& f) { f.scene.salt = 7; }));
+		ARCHE_CHECK(changed([](GraphFixture&) {}, 4));
+
+		// 記録との照合
+		CookDatabaseEntries entries = { { base.scene.path, base.scene.cookKey }, { base.model.path, base.model.cookKey + 1 }, { base.broken.path, 0 } };
+		ARCHE_CHECK(CookGraph::IsUpToDate(entries, base.scene));
+		ARCHE_CHECK(!CookGraph::IsUpToDate(entries, base.model));
+		ARCHE_CHECK(!CookGraph::IsUpToDate(entries, base.broken));
+	}
+
+	void TestSplitJson()
+	{
+		nlohmann::json scene = nlohmann::json::parse(R"({
+			"SceneName": "Test",
+			"Physics": { "Gravity": -9.8 },
+			"Entities": [
+				{ "ID": 10, "IsActive": false, "Transform": { "Position": [1, 2, 3] }, "GameOnly": { "Value": 1 } },
+				5,
+				{ "Tag": { "Name": "NoId" } }
+			]
+		})");
+
+		nlohmann::json settings;
+		std::vector<SceneBinaryFormat::JsonEntity> entities;
+		auto isComponent = [](const std::string& key) { return key == "Transform" || key == "Tag"; };
+		ARCHE_CHECK(SceneBinaryFormat::SplitJson(scene, isComponent, settings, entities));
+
+		ARCHE_CHECK(!settings.contains("Entities") && settings["SceneName"] == "Test" && settings.contains("Physics"));
+		ARCHE_CHECK(entities.size() == 2);
+		if (entities.size() == 2)
+		{
+			ARCHE_CHECK(entities[0].hasId && entities[0].id == 10 && !entities[0].active);
+			ARCHE_CHECK(entities[0].extra == nlohmann::json({ { "GameOnly", { { "Value", 1 } } } }));
+			ARCHE_CHECK(entities[0].source == &scene["Entities"][0]);
+			ARCHE_CHECK(!entities[1].hasId && entities[1].active && entities[1].extra.empty());
+		}
+
+		ARCHE_CHECK(!SceneBinaryFormat::SplitJson(nlohmann::json::array(), isComponent, settings, entities));
+		ARCHE_CHECK(SceneBinaryFormat::SplitJson(nlohmann::json({ { "SceneName", "Empty" } }), isComponent, settings, entities) && entities.empty());
+	}
+
+	void TestContainer()
+	{
+		SceneBinaryFormat::Container container;
+		container.settings = { { "SceneName", "Test" }, { "Environment", { { "Sky", "Day" } } } };
+		container.ids = { 3, 1, 4 };
+		container.active = { 1, 0, 1 };
+		container.extras = { { 2, { { "GameOnly", 5 } } } };
+		container.sectionCount = 2;
+		const std::vector<std::string> strings = { "Transform", "", "Position" };
+		const std::vector<uint8_t> sections = { 9, 8, 7, 6, 5 };
+
+		std::vector<uint8_t> bytes;
+		SceneBinaryFormat::Write(container, strings, sections.data(), sections.size(), bytes);
+
+		SceneBinaryFormat::Container read;
+		std::vector<std::string_view> readStrings;
+		size_t offset = 0;
+		std::string error;
+		ARCHE_CHECK(SceneBinaryFormat::Read(bytes.data(), bytes.size(), read, readStrings, offset, error));
+		ARCHE_CHECK(read.settings == container.settings);
+		ARCHE_CHECK(read.ids == container.ids && read.active == container.active);
+		ARCHE_CHECK(read.extras == container.extras);
+		ARCHE_CHECK(read.sectionCount == 2);
+		ARCHE_CHECK(readStrings.size() == strings.size() && readStrings[0] == "Transform" && readStrings[1].empty() && readStrings[2] == "Position");
+		ARCHE_CHECK(offset + sections.size() == bytes.size() && std::equal(sections.begin(), sections.end(), bytes.begin() + offset));
+
+		// セクションより前で切れたものはどの長さでも読まない（範囲外を読めば ASan で落ちる）
+		for (size_t length = 0; length < offset; ++length)
+		{
+			std::vector<uint8_t> prefix(bytes.begin(), bytes.begin() + length);
+			ARCHE_CHECK(!SceneBinaryFormat::Read(prefix.data(), prefix.size(), read, readStrings, offset, error));
+		}
+
+		std::vector<uint8_t> badVersion = bytes;
+		badVersion[4] = 2;
+		ARCHE_CHECK(!SceneBinaryFormat::Read(badVersion.data(), badVersion.size(), read, readStrings, offset, error) && error == "unsupported version 2");
+
+		// 範囲外の番号を持つ未登録コンポーネントは書かない
+		container.extras = { { 3, { { "GameOnly", 5 } } } };
+		SceneBinaryFormat::Write(container, strings, nullptr, 0, bytes);
+		ARCHE_CHECK(SceneBinaryFormat::Read(bytes.data(), bytes.size(), read, readStrings, offset, error) && read.extras.empty());
+	}
+}
+
+int main()
+{
+	std::filesystem::path dir = MakeTempDirectory();
+	TestDatabase(dir);
+	TestGraph();
+	TestSplitJson();
+	TestContainer();
+
+	std::error_code ec;
+	std::filesystem::remove_all(dir, ec);
+	return ARCHE_TEST_RESULT();
+}
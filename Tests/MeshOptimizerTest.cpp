@@ -0,0 +1,351 @@
+﻿/*****************************************************************//**
+ * @file	MeshOptimizerTest.cpp
+ * @brief	MeshOptimizer（溶接・並べ替え・量子化）のテスト
+ *
+ * @details	- WeldVertices		: 同じ頂点だけがまとまり、形状（三角形ごとの頂点の中身）が変わらないこと
+ *			- OptimizeVertexCache	: 三角形の並べ替えが置換になっていること（増減・欠け・重複が無い）
+ *			- OptimizeVertexFetch	: 参照順に詰め直され、未使用頂点が消えること
+ *			- Pack				: 量子化誤差が各形式の許容範囲に収まること、インデックス幅の切り替え
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "TestCommon.h"
+#include "Engine/Renderer/Data/MeshOptimizer.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+using namespace Arche;
+
+namespace
+{
+	MeshVertex MakeVertex(float x, float y, float z)
+	{
+		MeshVertex v{};
+		v.pos = { x, y, z };
+		v.normal = { 0.0f, 1.0f, 0.0f };
+		v.uv = { x, z };
+		v.color = { 1.0f, 1.0f, 1.0f, 1.0f };
+		return v;
+	}
+
+	// 格子状の平面（三角形リストを頂点の共有なしで展開したもの = Assimp の JoinIdenticalVertices 無しと同じ）
+	void MakeUnweldedGrid(int cells, std::vector<MeshVertex>& outVertices, std::vector<uint32_t>& outIndices)
+	{
+		outVertices.clear();
+		outIndices.clear();
+		for (int z = 0; z < cells; ++z)
+		{
+			for (int x = 0; x < cells; ++x)
+			{
+				const float x0 = (float)x, x1 = (float)(x + 1), z0 = (float)z, z1 = (float)(z + 1);
+				const MeshVertex quad[6] = {
+					MakeVertex(x0, 0, z0), MakeVertex(x0, 0, z1), MakeVertex(x1, 0, z1),
+					MakeVertex(x0, 0, z0), MakeVertex(x1, 0, z1), MakeVertex(x1, 0, z0),
+				};
+				for (const auto& v : quad)
+				{
+					outIndices.push_back((uint32_t)outVertices.size());
+					outVertices.push_back(v);
+				}
+			}
+		}
+	}
+
+	using Triangle = std::array<uint32_t, 3>;
+
+	// 頂点の中身で三角形を表す（インデックスの振り直しに左右されない比較用）
+	std::vector<std::array<MeshFloat3, 3>> ResolveTriangles(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices)
+	{
+		std::vector<std::array<MeshFloat3, 3>> out;
+		for (size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			out.push_back({ vertices[indices[i]].pos, vertices[indices[i + 1]].pos, vertices[indices[i + 2]].pos });
+		}
+		return out;
+	}
+
+	bool SamePositions(const std::array<MeshFloat3, 3>& a, const std::array<MeshFloat3, 3>& b)
+	{
+		return std::memcmp(a.data(), b.data(), sizeof(a)) == 0;
+	}
+
+	// 三角形を回転させて最小のインデックスを先頭にする（OptimizeVertexCache は巻き順を保ったまま並べ替える）
+	Triangle Canonical(Triangle t)
+	{
+		auto minIt = std::min_element(t.begin(), t.end());
+		std::rotate(t.begin(), minIt, t.end());
+		return t;
+	}
+
+	std::vector<Triangle> SortedTriangles(const std::vector<uint32_t>& indices)
+	{
+		std::vector<Triangle> out;
+		for (size_t i = 0; i + 2 < indices.size(); i += 3) out.push_back(Canonical({ indices[i], indices[i + 1], indices[i + 2] }));
+		std::sort(out.begin(), out.end());
+		return out;
+	}
+
+	float HalfToFloat(uint16_t h)
+	{
+		const int exponent = (h >> 10) & 0x1F;
+		const int mantissa = h & 0x3FF;
+		const float sign = (h & 0x8000) ? -1.0f : 1.0f;
+		if (exponent == 0) return sign * std::ldexp((float)mantissa, -24);
+		if (exponent == 31) return mantissa ? NAN : sign * INFINITY;
+		return sign * std::ldexp((float)(mantissa | 0x400), exponent - 25);
+	}
+
+	float Snorm8ToFloat(uint32_t packed, int lane) { return (float)(int8_t)((packed >> (lane * 8)) & 0xFF) / 127.0f; }
+	uint32_t Byte(uint32_t packed, int lane) { return (packed >> (lane * 8)) & 0xFF; }
+
+	void TestWeld()
+	{
+		constexpr int CELLS = 16;
+		std::vector<MeshVertex> vertices;
+		std::vector<uint32_t> indices;
+		MakeUnweldedGrid(CELLS, vertices, indices);
+		const auto before = ResolveTriangles(vertices, indices);
+		ARCHE_CHECK(vertices.size() == (size_t)CELLS * CELLS * 6);
+
+		const size_t removed = MeshOptimizer::WeldVertices(vertices, indices);
+
+		// 格子の交点だけが残る
+		ARCHE_CHECK(vertices.size() == (size_t)(CELLS + 1) * (CELLS + 1));
+		ARCHE_CHECK(removed == (size_t)CELLS * CELLS * 6 - vertices.size());
+		ARCHE_CHECK(indices.size() == (size_t)CELLS * CELLS * 6);
+		for (uint32_t index : indices) ARCHE_CHECK(index < vertices.size());
+
+		// 残った頂点は全て異なる
+		for (size_t i = 0; i < vertices.size(); ++i)
+		{
+			for (size_t j = i + 1; j < vertices.size(); ++j) ARCHE_CHECK(std::memcmp(&vertices[i], &vertices[j], sizeof(MeshVertex)) != 0);
+		}
+
+		// 三角形の中身は変わらない
+		const auto after = ResolveTriangles(vertices, indices);
+		ARCHE_CHECK(after.size() == before.size());
+		for (size_t i = 0; i < before.size() && i < after.size(); ++i) ARCHE_CHECK(SamePositions(before[i], after[i]));
+
+		// 位置が同じでも他の属性（UV の継ぎ目など）が違えばまとめない
+		std::vector<MeshVertex> seam = { MakeVertex(0, 0, 0), MakeVertex(0, 0, 0), MakeVertex(1, 0, 0), MakeVertex(1, 0, 0) };
+		seam[1].uv = { 0.5f, 0.5f };
+		std::vector<uint32_t> seamIndices = { 0, 2, 3, 1, 2, 3 };
+		ARCHE_CHECK(MeshOptimizer::WeldVertices(seam, seamIndices) == 1);
+		ARCHE_CHECK(seam.size() == 3);
+		ARCHE_CHECK(seamIndices[0] != seamIndices[3]);
+		ARCHE_CHECK(seamIndices[1] == seamIndices[2] && seamIndices[4] == seamIndices[5]);
+
+		// 空のメッシュ
+		std::vector<MeshVertex> empty;
+		std::vector<uint32_t> emptyIndices;
+		ARCHE_CHECK(MeshOptimizer::WeldVertices(empty, emptyIndices) == 0);
+	}
+
+	void TestReorderIsPermutation()
+	{
+		// ランダムな順番の三角形（頂点を共有したもの）
+		std::vector<MeshVertex> vertices;
+		std::vector<uint32_t> indices;
+		MakeUnweldedGrid(24, vertices, indices);
+		MeshOptimizer::WeldVertices(vertices, indices);
+
+		std::mt19937 rng(12345);
+		std::vector<Triangle> triangles;
+		for (size_t i = 0; i < indices.size(); i += 3) triangles.push_back({ indices[i], indices[i + 1], indices[i + 2] });
+		std::shuffle(triangles.begin(), triangles.end(), rng);
+		indices.clear();
+		for (const auto& t : triangles) indices.insert(indices.end(), t.begin(), t.end());
+
+		const auto expected = SortedTriangles(indices);
+		const size_t vertexCount = vertices.size();
+
+		MeshOptimizer::OptimizeVertexCache(indices, vertexCount);
+		ARCHE_CHECK(indices.size() == expected.size() * 3);
+		ARCHE_CHECK(SortedTriangles(indices) == expected);
+
+		// 並べ替え後の頂点の中身で比べる（OptimizeVertexFetch は頂点を詰め直すだけ）
+		auto beforeFetch = ResolveTriangles(vertices, indices);
+		MeshOptimizer::OptimizeVertexFetch(vertices, indices);
+		ARCHE_CHECK(vertices.size() == vertexCount);
+		auto afterFetch = ResolveTriangles(vertices, indices);
+		ARCHE_CHECK(beforeFetch.size() == afterFetch.size());
+		for (size_t i = 0; i < beforeFetch.size() && i < afterFetch.size(); ++i) ARCHE_CHECK(SamePositions(beforeFetch[i], afterFetch[i]));
+
+		// 頂点は初めて参照される順に並ぶ
+		uint32_t next = 0;
+		for (uint32_t index : indices)
+		{
+			ARCHE_CHECK(index <= next);
+			if (index == next) ++next;
+		}
+		ARCHE_CHECK(next == vertices.size());
+
+		// 参照されない頂点は消える
+		std::vector<MeshVertex> unused = { MakeVertex(0, 0, 0), MakeVertex(9, 9, 9), MakeVertex(1, 0, 0), MakeVertex(0, 0, 1) };
+		std::vector<uint32_t> unusedIndices = { 0, 2, 3 };
+		MeshOptimizer::OptimizeVertexFetch(unused, unusedIndices);
+		ARCHE_CHECK(unused.size() == 3);
+		ARCHE_CHECK(unusedIndices == std::vector<uint32_t>({ 0, 1, 2 }));
+
+		// 1 三角形・縮退した三角形でも壊れない
+		std::vector<uint32_t> degenerate = { 0, 0, 1, 1, 2, 0 };
+		const auto degenerateExpected = SortedTriangles(degenerate);
+		MeshOptimizer::OptimizeVertexCache(degenerate, 3);
+		ARCHE_CHECK(SortedTriangles(degenerate) == degenerateExpected);
+	}
+
+	void TestQuantize()
+	{
+		std::mt19937 rng(777);
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> uvRange(-8.0f, 8.0f);
+		std::uniform_real_distribution<float> positive(0.0f, 1.0f);
+
+		constexpr int COUNT = 4096;
+		std::vector<MeshVertex> vertices(COUNT);
+		for (auto& v : vertices)
+		{
+			v.pos = { unit(rng) * 100.0f, unit(rng) * 100.0f, unit(rng) * 100.0f };
+			float n[3] = { unit(rng), unit(rng), unit(rng) };
+			float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+			if (length < 1e-3f) { n[0] = 0; n[1] = 1; n[2] = 0; length = 1; }
+			v.normal = { n[0] / length, n[1] / length, n[2] / length };
+			v.uv = { uvRange(rng), uvRange(rng) };
+			v.color = { positive(rng), positive(rng), positive(rng), positive(rng) };
+			v.weight = { positive(rng), positive(rng), positive(rng), positive(rng) };
+			for (int k = 0; k < 4; ++k) v.index[k] = (uint32_t)(rng() % 200);
+		}
+		std::vector<uint32_t> indices;
+		for (uint32_t i = 0; i + 2 < COUNT; i += 3) indices.insert(indices.end(), { i, i + 1, i + 2 });
+
+		PackedMesh packed;
+		MeshOptimizer::Pack(vertices, indices, true, packed);
+		ARCHE_CHECK(packed.vertices.size() == vertices.size());
+		ARCHE_CHECK(packed.skin.size() == vertices.size());
+
+		for (size_t i = 0; i < vertices.size(); ++i)
+		{
+			const MeshVertex& src = vertices[i];
+			const StaticMeshVertex& dst = packed.vertices[i];
+			const SkinMeshVertex& skin = packed.skin[i];
+
+			// 位置はそのまま
+			ARCHE_CHECK(std::memcmp(&dst.pos, &src.pos, sizeof(src.pos)) == 0);
+
+			// SNORM8: 誤差は半ステップ（0.5 / 127）以内、w は 0
+			ARCHE_CHECK(std::fabs(Snorm8ToFloat(dst.normal, 0) - src.normal.x) <= 0.5f / 127.0f + 1e-6f);
+			ARCHE_CHECK(std::fabs(Snorm8ToFloat(dst.normal, 1) - src.normal.y) <= 0.5f / 127.0f + 1e-6f);
+			ARCHE_CHECK(std::fabs(Snorm8ToFloat(dst.normal, 2) - src.normal.z) <= 0.5f / 127.0f + 1e-6f);
+			ARCHE_CHECK(Byte(dst.normal, 3) == 0);
+
+			// FLOAT16: 相対誤差は 2^-11 以内（|uv| < 8 なので正規化数の範囲）
+			const float u = HalfToFloat((uint16_t)(dst.uv & 0xFFFF));
+			const float v = HalfToFloat((uint16_t)(dst.uv >> 16));
+			ARCHE_CHECK(std::fabs(u - src.uv.x) <= std::fabs(src.uv.x) * (1.0f / 2048.0f) + 1e-7f);
+			ARCHE_CHECK(std::fabs(v - src.uv.y) <= std::fabs(src.uv.y) * (1.0f / 2048.0f) + 1e-7f);
+
+			// UNORM8: 誤差は半ステップ（0.5 / 255）以内
+			const float color[4] = { src.color.x, src.color.y, src.color.z, src.color.w };
+			for (int k = 0; k < 4; ++k) ARCHE_CHECK(std::fabs((float)Byte(dst.color, k) / 255.0f - color[k]) <= 0.5f / 255.0f + 1e-6f);
+
+			// ウェイトは合計がちょうど 255。丸め誤差の寄せ先以外は半ステップ、寄せ先も 2 ステップ以内
+			const float weight[4] = { src.weight.x, src.weight.y, src.weight.z, src.weight.w };
+			const float total = weight[0] + weight[1] + weight[2] + weight[3];
+			uint32_t sum = 0;
+			for (int k = 0; k < 4; ++k)
+			{
+				sum += Byte(skin.weight, k);
+				ARCHE_CHECK(std::fabs((float)Byte(skin.weight, k) / 255.0f - weight[k] / total) <= 2.0f / 255.0f + 1e-6f);
+			}
+			ARCHE_CHECK(sum == 255);
+
+			// ボーン番号はそのまま
+			for (int k = 0; k < 4; ++k) ARCHE_CHECK(Byte(skin.index, k) == src.index[k]);
+		}
+
+		// 頂点が 65535 以下なら 16bit、超えたら 32bit
+		ARCHE_CHECK(packed.GetIndexSize() == 2);
+		ARCHE_CHECK(packed.indices16.size() == indices.size() && packed.indices32.empty());
+		for (size_t i = 0; i < indices.size(); ++i) ARCHE_CHECK(packed.indices16[i] == indices[i]);
+
+		std::vector<MeshVertex> large(0x10000, MakeVertex(0, 0, 0));
+		std::vector<uint32_t> largeIndices = { 0, 1, 0xFFFF };
+		PackedMesh packedLarge;
+		MeshOptimizer::Pack(large, largeIndices, false, packedLarge);
+		ARCHE_CHECK(packedLarge.GetIndexSize() == 4);
+		ARCHE_CHECK(packedLarge.indices32 == largeIndices && packedLarge.indices16.empty());
+		ARCHE_CHECK(packedLarge.skin.empty());
+		ARCHE_CHECK(packedLarge.GetView().GetByteSize() == packedLarge.GetByteSize());
+
+		// half の端の値（範囲外は無限大、0.5ulp ちょうどは偶数へ丸め）
+		std::vector<MeshVertex> edge(1, MakeVertex(0, 0, 0));
+		const std::pair<float, uint16_t> halfCases[] = {
+			{ 0.0f, 0x0000 }, { -0.0f, 0x8000 }, { 1.0f, 0x3C00 }, { -2.0f, 0xC000 },
+			{ 65504.0f, 0x7BFF }, { 65520.0f, 0x7C00 }, { 1.0e6f, 0x7C00 },
+			{ 1.0f + 1.0f / 2048.0f, 0x3C00 }, { 1.0f + 3.0f / 2048.0f, 0x3C02 },
+			{ std::ldexp(1.0f, -24), 0x0001 }, { std::ldexp(1.0f, -25), 0x0000 }, { std::ldexp(1.0f, -14), 0x0400 },
+		};
+		for (const auto& [value, expected] : halfCases)
+		{
+			edge[0].uv = { value, 0.0f };
+			MeshOptimizer::Pack(edge, {}, false, packedLarge);
+			ARCHE_CHECK((packedLarge.vertices[0].uv & 0xFFFF) == expected);
+		}
+
+		// ウェイトが全て 0 の頂点は 0（シェーダー側で (1,0,0,0) 扱い）
+		edge[0].weight = { 0, 0, 0, 0 };
+		MeshOptimizer::Pack(edge, {}, true, packedLarge);
+		ARCHE_CHECK(packedLarge.skin[0].weight == 0);
+	}
+
+	void TestProcess()
+	{
+		// 全工程を通しても三角形の集合（頂点の中身で見て）は変わらない
+		std::vector<MeshVertex> vertices;
+		std::vector<uint32_t> indices;
+		MakeUnweldedGrid(12, vertices, indices);
+
+		auto expected = ResolveTriangles(vertices, indices);
+		PackedMesh packed;
+		MeshOptimizer::Process(vertices, indices, false, packed);
+		ARCHE_CHECK(packed.GetVertexCount() == 13 * 13);
+		ARCHE_CHECK(packed.GetIndexCount() == indices.size());
+
+		std::vector<std::array<MeshFloat3, 3>> actual;
+		for (size_t i = 0; i + 2 < packed.indices16.size(); i += 3)
+		{
+			actual.push_back({ packed.vertices[packed.indices16[i]].pos, packed.vertices[packed.indices16[i + 1]].pos, packed.vertices[packed.indices16[i + 2]].pos });
+		}
+
+		auto key = [](const std::array<MeshFloat3, 3>& t)
+			{
+				// 回転を揃えてから辞書順で比べる
+				std::array<std::array<float, 3>, 3> p;
+				for (int k = 0; k < 3; ++k) p[k] = { t[k].x, t[k].y, t[k].z };
+				std::rotate(p.begin(), std::min_element(p.begin(), p.end()), p.end());
+				return p;
+			};
+		std::vector<std::array<std::array<float, 3>, 3>> a, b;
+		for (const auto& t : expected) a.push_back(key(t));
+		for (const auto& t : actual) b.push_back(key(t));
+		std::sort(a.begin(), a.end());
+		std::sort(b.begin(), b.end());
+		ARCHE_CHECK(a == b);
+	}
+}
+
+int main()
+{
+	TestWeld();
+	TestReorderIsPermutation();
+	TestQuantize();
+	TestProcess();
+	return ARCHE_TEST_RESULT();
+}
@@ -0,0 +1,191 @@
+﻿/*****************************************************************//**
+ * @file	ResourceCacheStressTest.cpp
+ * @brief	ResourceManager が複数スレッドから触る部分（キャッシュと要求キュー）の負荷テスト
+ *
+ * @details	ResourceManager 本体は D3D11 のデバイスを要るので、スレッドをまたいで共有される
+ *			ResourceCache と LoadRequestQueue を直接、多数のスレッドから同時に叩く。
+ *			-DARCHE_TEST_SANITIZER=thread でビルドすると ThreadSanitizer で競合を確かめられる。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "TestCommon.h"
+#include "Engine/Resource/ResourceCache.h"
+#include "Engine/Resource/LoadRequestQueue.h"
+#include <random>
+#include <thread>
+
+using namespace Arche;
+
+namespace
+{
+	constexpr int THREAD_COUNT = 8;
+	constexpr int KEY_COUNT = 64;
+	constexpr int ITERATIONS = 20000;
+
+	std::string MakeKey(int i) { return "Resources/Game/Textures/Tex_" + std::to_string(i) + ".png"; }
+
+	// 同じキーを全スレッドが同時に登録しても、全員が同じ1つを受け取る
+	void TestConcurrentInsert()
+	{
+		ResourceCache<int> cache;
+		std::vector<std::vector<int*>> seen(THREAD_COUNT, std::vector<int*>(KEY_COUNT));
+		std::atomic<int> ready{ 0 };
+
+		std::vector<std::thread> threads;
+		for (int t = 0; t < THREAD_COUNT; ++t)
+		{
+			threads.emplace_back([&, t]()
+				{
+					ready++;
+					while (ready.load() < THREAD_COUNT) std::this_thread::yield();
+					for (int k = 0; k < KEY_COUNT; ++k)
+					{
+						std::shared_ptr<int> value = cache.Find(MakeKey(k));
+						if (!value) value = cache.Insert(MakeKey(k), std::make_shared<int>(t), { 100, 0 });
+						seen[t][k] = value.get();
+					}
+				});
+		}
+		for (auto& thread : threads) thread.join();
+
+		for (int k = 0; k < KEY_COUNT; ++k)
+		{
+			for (int t = 1; t < THREAD_COUNT; ++t) ARCHE_CHECK(seen[t][k] == seen[0][k]);
+			ARCHE_CHECK(cache.Find(MakeKey(k)).get() == seen[0][k]);
+		}
+		ARCHE_CHECK(cache.GetUsage().count == (size_t)KEY_COUNT);
+	}
+
+	// 取得・ハンドル・リロード・追い出しを同時に行う（メインスレッド役が毎フレーム追い出す）
+	void TestMixedAccess()
+	{
+		ResourceCache<int> cache;
+		std::atomic<bool> running{ true };
+
+		std::vector<std::thread> threads;
+		for (int t = 0; t < THREAD_COUNT; ++t)
+		{
+			threads.emplace_back([&, t]()
+				{
+					std::mt19937 rng(1234 + t);
+					std::uniform_int_distribution<int> keyDist(0, KEY_COUNT - 1);
+					std::uniform_int_distribution<int> opDist(0, 9);
+					std::vector<ResourceHandle<int>> held;
+
+					for (int i = 0; i < ITERATIONS; ++i)
+					{
+						const std::string key = MakeKey(keyDist(rng));
+						switch (opDist(rng))
+						{
+						case 0: case 1: case 2:
+						{
+							std::shared_ptr<int> value;
+							if (cache.TryGet(key, value) && value) ARCHE_CHECK(*value >= 0);
+							break;
+						}
+						case 3: case 4:
+							cache.Insert(key, std::make_shared<int>(i), { 1024, 4096 });
+							break;
+						case 5: case 6:
+						{
+							ResourceHandle<int> handle = cache.Acquire(key);
+							if (handle)
+							{
+								ARCHE_CHECK(handle.GetRefCount() >= 1);
+								held.push_back(std::move(handle));
+							}
+							if (held.size() > 8) held.erase(held.begin());
+							break;
+						}
+						case 7:
+							cache.Assign(key, std::make_shared<int>(i), { 1024, 4096 });
+							break;
+						case 8:
+						{
+							// 他のスレッドが同時に登録・追い出すので、2回読んだ結果は比べない（1回読んだ値だけを確かめる）
+							(void)cache.Contains(key);
+							std::shared_ptr<int> value;
+							if (cache.TryGet(key, value)) ARCHE_CHECK(value && *value >= 0 && *value < ITERATIONS);
+							else ARCHE_CHECK(!value);
+							break;
+						}
+						default:
+							if (i % 64 == 0) cache.GetEntryInfos();
+							break;
+						}
+					}
+				});
+		}
+
+		uint64_t frame = 0;
+		std::thread mainThread([&]()
+			{
+				while (running.load())
+				{
+					cache.SetFrame(++frame);
+					cache.EvictLru(16 * 1024, [](const std::string& key) { return key == MakeKey(0); });
+					cache.Snapshot();
+					std::this_thread::yield();
+				}
+			});
+
+		for (auto& thread : threads) thread.join();
+		running = false;
+		mainThread.join();
+
+		// 全ハンドルが解放された後は、参照カウントが残っていない
+		for (const auto& info : cache.GetEntryInfos()) ARCHE_CHECK(info.handleCount == 0);
+	}
+
+	// ワーカーから積まれた要求が、持ち主のスレッドに漏れなく1度ずつ届く
+	void TestRequestQueue()
+	{
+		struct Request { int thread; int index; };
+		LoadRequestQueue<Request> queue;
+
+		// 初期化前はどのスレッドも持ち主ではない
+		ARCHE_CHECK(!queue.IsOwnerThread());
+		queue.BindOwnerThread();
+		ARCHE_CHECK(queue.IsOwnerThread());
+
+		std::atomic<int> finished{ 0 };
+		std::vector<std::thread> workers;
+		for (int t = 0; t < THREAD_COUNT; ++t)
+		{
+			workers.emplace_back([&, t]()
+				{
+					ARCHE_CHECK(!queue.IsOwnerThread());
+					for (int i = 0; i < ITERATIONS; ++i) queue.Push({ t, i });
+					finished++;
+				});
+		}
+
+		std::vector<std::vector<int>> received(THREAD_COUNT);
+		std::vector<Request> requests;
+		while (finished.load() < THREAD_COUNT || queue.HasPending())
+		{
+			if (!queue.Drain(requests)) { std::this_thread::yield(); continue; }
+			for (const auto& req : requests) received[req.thread].push_back(req.index);
+		}
+		for (auto& worker : workers) worker.join();
+
+		// スレッドごとには積んだ順に届く
+		for (int t = 0; t < THREAD_COUNT; ++t)
+		{
+			ARCHE_CHECK(received[t].size() == (size_t)ITERATIONS);
+			for (size_t i = 0; i < received[t].size(); ++i) ARCHE_CHECK(received[t][i] == (int)i);
+		}
+	}
+}
+
+int main()
+{
+	TestConcurrentInsert();
+	TestMixedAccess();
+	TestRequestQueue();
+	return ARCHE_TEST_RESULT();
+}
@@ -0,0 +1,157 @@
+﻿/*****************************************************************//**
+ * @file	SceneBinaryFuzzTest.cpp
+ * @brief	SceneBinaryFormat::Read に壊れたデータを読ませるテスト
+ *
+ * @details	- 往復		: ランダムな設定・エンティティ表・未登録コンポーネントを書いて読み直すと同じになること
+ *			- 破損		: ビット反転・バイトの上書き・長さの書き換え・切り詰めをしたデータで、範囲外を読まず
+ *						  （ASan / UBSan でビルドして確かめる）、読めたときは中身の辻褄が合っていること
+ *			シード固定なので、失敗したら同じ入力で再現できる。
+ *			コンポーネントのセクション（SceneBinary::Parse の後半）は pch.h が要るのでここでは扱わない。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "TestCommon.h"
+#include "Engine/Scene/Serializer/SceneBinaryFormat.h"
+#include <cstring>
+#include <iterator>
+#include <random>
+
+using namespace Arche;
+
+namespace
+{
+	constexpr int SCENE_COUNT = 50;
+	constexpr int MUTATIONS_PER_SCENE = 400;
+
+	nlohmann::json RandomValue(std::mt19937& rng, int depth)
+	{
+		switch (rng() % (depth > 2 ? 4 : 6))
+		{
+		case 0: return (int64_t)(rng() % 2000) - 1000;
+		case 1: return std::uniform_real_distribution<double>(-1e3, 1e3)(rng);
+		case 2: return (rng() & 1) != 0;
+		case 3: return std::string(rng() % 12, (char)('a' + rng() % 26));
+		case 4:
+		{
+			nlohmann::json array = nlohmann::json::array();
+			for (uint32_t i = rng() % 4; i > 0; --i) array.push_back(RandomValue(rng, depth + 1));
+			return array;
+		}
+		default:
+		{
+			nlohmann::json object = nlohmann::json::object();
+			static const char* const KEYS[] = { "Position", "Rotation", "Scale", "Name", "Mass", "Layer", "Enabled", "Color" };
+			for (uint32_t i = rng() % 4; i > 0; --i) object[KEYS[rng() % std::size(KEYS)]] = RandomValue(rng, depth + 1);
+			return object;
+		}
+		}
+	}
+
+	SceneBinaryFormat::Container RandomContainer(std::mt19937& rng, std::vector<std::string>& outStrings)
+	{
+		SceneBinaryFormat::Container container;
+		container.settings = { { "SceneName", std::string(1 + rng() % 12, 'S') }, { "Physics", RandomValue(rng, 1) } };
+
+		const uint32_t entityCount = rng() % 64;
+		for (uint32_t i = 0; i < entityCount; ++i)
+		{
+			container.ids.push_back(rng());
+			container.active.push_back((uint8_t)(rng() % 2));
+			if (rng() % 4 == 0) container.extras.emplace_back(i, nlohmann::json({ { "GameOnly", RandomValue(rng, 1) } }));
+		}
+		container.sectionCount = rng() % 4;
+
+		outStrings.clear();
+		for (uint32_t i = rng() % 16; i > 0; --i) outStrings.push_back(std::string(rng() % 20, (char)('A' + rng() % 26)));
+		return container;
+	}
+
+	void Mutate(std::mt19937& rng, std::vector<uint8_t>& bytes)
+	{
+		if (bytes.empty()) return;
+		switch (rng() % 4)
+		{
+		case 0:	// ビット反転
+			for (uint32_t i = 1 + rng() % 4; i > 0; --i) bytes[rng() % bytes.size()] ^= (uint8_t)(1u << (rng() % 8));
+			break;
+		case 1:	// バイトの上書き
+			for (uint32_t i = 1 + rng() % 8; i > 0; --i) bytes[rng() % bytes.size()] = (uint8_t)rng();
+			break;
+		case 2:	// 長さ・個数らしい4バイトを大きな値にする（ヘッダーの magic / version は残す）
+			if (bytes.size() >= 12)
+			{
+				const uint32_t value = (rng() & 1) ? 0xFFFFFFFFu : (uint32_t)rng();
+				std::memcpy(bytes.data() + 8 + rng() % (bytes.size() - 11), &value, sizeof(value));
+			}
+			break;
+		default:	// 切り詰め
+			bytes.resize(rng() % bytes.size());
+			break;
+		}
+	}
+
+	void CheckConsistent(const SceneBinaryFormat::Container& container, const std::vector<std::string_view>& strings, size_t offset, const std::vector<uint8_t>& bytes)
+	{
+		ARCHE_CHECK(container.ids.size() == container.active.size());
+		ARCHE_CHECK(offset <= bytes.size());
+		for (const auto& [index, extra] : container.extras) ARCHE_CHECK(index < container.ids.size() && extra.is_object());
+		for (const auto& str : strings)
+		{
+			ARCHE_CHECK(str.empty() || ((const uint8_t*)str.data() >= bytes.data() && (const uint8_t*)str.data() + str.size() <= bytes.data() + offset));
+		}
+	}
+}
+
+int main()
+{
+	std::mt19937 rng(48);
+	size_t accepted = 0, rejected = 0;
+
+	for (int scene = 0; scene < SCENE_COUNT; ++scene)
+	{
+		std::vector<std::string> strings;
+		SceneBinaryFormat::Container container = RandomContainer(rng, strings);
+		std::vector<uint8_t> sections(rng() % 32, 0xAB);
+
+		std::vector<uint8_t> bytes;
+		SceneBinaryFormat::Write(container, strings, sections.data(), sections.size(), bytes);
+
+		SceneBinaryFormat::Container read;
+		std::vector<std::string_view> readStrings;
+		size_t offset = 0;
+		std::string error;
+		ARCHE_CHECK(SceneBinaryFormat::Read(bytes.data(), bytes.size(), read, readStrings, offset, error));
+		ARCHE_CHECK(read.settings == container.settings && read.ids == container.ids && read.active == container.active);
+		ARCHE_CHECK(read.extras == container.extras && read.sectionCount == container.sectionCount);
+		ARCHE_CHECK(readStrings.size() == strings.size() && offset + sections.size() == bytes.size());
+		for (size_t i = 0; i < readStrings.size() && i < strings.size(); ++i) ARCHE_CHECK(readStrings[i] == strings[i]);
+
+		for (int i = 0; i < MUTATIONS_PER_SCENE; ++i)
+		{
+			// 範囲外の読み込みを ASan が見つけられるよう、壊したデータはちょうどの大きさの別バッファに置く
+			std::vector<uint8_t> mutated = bytes;
+			Mutate(rng, mutated);
+			mutated.shrink_to_fit();
+
+			if (SceneBinaryFormat::Read(mutated.data(), mutated.size(), read, readStrings, offset, error))
+			{
+				++accepted;
+				CheckConsistent(read, readStrings, offset, mutated);
+			}
+			else
+			{
+				++rejected;
+				ARCHE_CHECK(!error.empty());
+			}
+		}
+	}
+
+	// 読めてしまうもの（設定の中の値だけが変わったなど）もあるが、拒否の経路も通っていること
+	std::printf("mutations: %zu accepted, %zu rejected\n", accepted, rejected);
+	ARCHE_CHECK(rejected > 0);
+	return ARCHE_TEST_RESULT();
+}
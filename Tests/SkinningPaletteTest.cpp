@@ -0,0 +1,141 @@
+﻿/*****************************************************************//**
+ * @file	SkinningPaletteTest.cpp
+ * @brief	SkinningKernel（スキニング行列パレットの計算）のテスト
+ *
+ * @details	- ComputePalette	: 旧実装（XMMatrixMultiply(invOffset, node) を転置）と同じ結果になること
+ *			- 計測				: 1000インスタンス分のパレット計算にかかる時間を出力する（合否には使わない）
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "TestCommon.h"
+#include "Engine/Renderer/Data/SkinningKernel.h"
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Arche;
+
+namespace
+{
+	SkinMatrix RandomMatrix(std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+		SkinMatrix m;
+		for (auto& row : m.m)
+			for (float& v : row) v = dist(rng);
+		return m;
+	}
+
+	// 旧実装の参照値：transpose(invOffset * node)（行ベクトル規約。倍精度で素直に計算する）
+	SkinMatrix Reference(const SkinMatrix& invOffset, const SkinMatrix& node)
+	{
+		SkinMatrix out;
+		for (int i = 0; i < 4; ++i)
+		{
+			for (int j = 0; j < 4; ++j)
+			{
+				double sum = 0.0;
+				for (int k = 0; k < 4; ++k) sum += (double)invOffset.m[i][k] * (double)node.m[k][j];
+				out.m[j][i] = (float)sum;
+			}
+		}
+		return out;
+	}
+
+	bool NearlyEqual(const SkinMatrix& a, const SkinMatrix& b)
+	{
+		for (int i = 0; i < 4; ++i)
+			for (int j = 0; j < 4; ++j)
+				if (std::fabs(a.m[i][j] - b.m[i][j]) > 1e-4f) return false;
+		return true;
+	}
+
+	void TestMatchesReference()
+	{
+		std::mt19937 rng(27);
+		const size_t NODE_COUNT = 48;
+		std::vector<SkinMatrix> nodes(NODE_COUNT);
+		for (auto& n : nodes) n = RandomMatrix(rng);
+
+		// 端数を含むボーン数と、同じノードを複数のボーンが指す場合
+		for (size_t boneCount : { 1u, 3u, 7u, 64u, 200u })
+		{
+			std::vector<SkinBone> bones(boneCount);
+			std::uniform_int_distribution<int> pick(0, (int)NODE_COUNT - 1);
+			for (auto& b : bones) { b.index = pick(rng); b.invOffset = RandomMatrix(rng); }
+
+			std::vector<SkinMatrix> out(boneCount);
+			SkinningKernel::ComputePalette(bones.data(), bones.size(), nodes.data(), out.data());
+
+			for (size_t b = 0; b < boneCount; ++b)
+			{
+				ARCHE_CHECK(NearlyEqual(out[b], Reference(bones[b].invOffset, nodes[bones[b].index])));
+			}
+		}
+	}
+
+	void TestIdentity()
+	{
+		SkinMatrix identity{};
+		for (int i = 0; i < 4; ++i) identity.m[i][i] = 1.0f;
+
+		// 平行移動 (1,2,3) のノード × 単位 invOffset → 転置で平行移動が4列目に来る
+		SkinMatrix node = identity;
+		node.m[3][0] = 1.0f; node.m[3][1] = 2.0f; node.m[3][2] = 3.0f;
+		SkinBone bone{ 0, identity };
+
+		SkinMatrix out;
+		SkinningKernel::ComputePalette(&bone, 1, &node, &out);
+		ARCHE_CHECK(out.m[0][3] == 1.0f && out.m[1][3] == 2.0f && out.m[2][3] == 3.0f);
+		ARCHE_CHECK(out.m[3][0] == 0.0f && out.m[3][1] == 0.0f && out.m[3][2] == 0.0f && out.m[3][3] == 1.0f);
+	}
+
+	// 1000インスタンス × 64ボーンのパレット計算（AnimationSystem が毎フレーム行う量）
+	void MeasureInstances()
+	{
+		const size_t INSTANCES = 1000;
+		const size_t BONES = 64;
+		const size_t NODES = 80;
+		const int FRAMES = 20;
+
+		std::mt19937 rng(1000);
+		std::vector<SkinMatrix> nodes(INSTANCES * NODES);
+		for (auto& n : nodes) n = RandomMatrix(rng);
+		std::vector<SkinBone> bones(BONES);
+		std::uniform_int_distribution<int> pick(0, (int)NODES - 1);
+		for (auto& b : bones) { b.index = pick(rng); b.invOffset = RandomMatrix(rng); }
+		std::vector<SkinMatrix> palettes(INSTANCES * BONES);
+
+		const auto start = std::chrono::steady_clock::now();
+		for (int f = 0; f < FRAMES; ++f)
+		{
+			for (size_t i = 0; i < INSTANCES; ++i)
+			{
+				SkinningKernel::ComputePalette(bones.data(), BONES, nodes.data() + i * NODES, palettes.data() + i * BONES);
+			}
+		}
+		const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / FRAMES;
+
+		// 最後のインスタンスだけ参照値と照合（計測ループが最適化で消えていないことの確認も兼ねる）
+		const size_t last = INSTANCES - 1;
+		for (size_t b = 0; b < BONES; ++b)
+		{
+			ARCHE_CHECK(NearlyEqual(palettes[last * BONES + b], Reference(bones[b].invOffset, nodes[last * NODES + bones[b].index])));
+		}
+
+		std::printf("ComputePalette: %zu instances x %zu bones = %.3f ms/frame\n", INSTANCES, BONES, ms);
+	}
+}
+
+int main()
+{
+	TestMatchesReference();
+	TestIdentity();
+	MeasureInstances();
+	return ARCHE_TEST_RESULT();
+}
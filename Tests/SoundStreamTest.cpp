@@ -0,0 +1,359 @@
+﻿/*****************************************************************//**
+ * @file	SoundStreamTest.cpp
+ * @brief	SoundStream（BGM のストリーミング再生）を音声デバイス無しで動かすテスト
+ *
+ * @details	メモリ上・一時ファイル上に作った WAV を MemoryStreamReader / FileStreamReader で読み、
+ *			NullAudioSink に流して以下を確かめる。
+ *			- ループ無し: 最後まで欠けも重複も無く渡り、終わりの印が付く（ブロック境界の前後のサイズ）
+ *			- ループ有り: 末尾から先頭へ途切れずつながり、終わらない
+ *			- 1回の読み込みはブロックサイズ以下、再生先に積まれるのは BUFFER_COUNT 個まで
+ *			- 壊れたファイルは開けない、途中で読めなくなっても止まらない、再生中に Close できる
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+// ===== インクルード =====
+#include "TestCommon.h"
+#include "Engine/Audio/SoundStream.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+using namespace Arche;
+
+namespace
+{
+	constexpr uint32_t BLOCK_SIZE = SoundStream::BLOCK_SIZE;
+	constexpr uint32_t BUFFER_COUNT = SoundStream::BUFFER_COUNT;
+
+	// insert だと GCC 12 の -O2 で -Warray-bounds / -Wstringop-overflow の誤検知が出るので、広げてからコピーする
+	void AppendBytes(std::vector<uint8_t>& out, const void* data, size_t size)
+	{
+		if (size == 0) return;
+		const size_t old = out.size();
+		out.resize(old + size);
+		std::memcpy(out.data() + old, data, size);
+	}
+
+	template<typename T>
+	void Append(std::vector<uint8_t>& out, const T& value)
+	{
+		AppendBytes(out, &value, sizeof(T));
+	}
+
+	void AppendChunk(std::vector<uint8_t>& out, const char* id, const std::vector<uint8_t>& body, uint32_t declaredSize)
+	{
+		AppendBytes(out, id, 4);
+		Append(out, declaredSize);
+		AppendBytes(out, body.data(), body.size());
+		if (body.size() & 1) out.push_back(0);
+	}
+
+	std::vector<uint8_t> MakeSamples(uint32_t size)
+	{
+		std::vector<uint8_t> samples(size);
+		for (uint32_t i = 0; i < size; ++i) samples[i] = (uint8_t)((i * 31 + i / 251) & 0xFF);
+		return samples;
+	}
+
+	// PCM の WAV（fmt の前後に関係ないチャンクを挟む）
+	std::vector<uint8_t> MakeWave(const std::vector<uint8_t>& samples, uint16_t channels = 2, uint16_t bitsPerSample = 16, bool declareLongerData = false)
+	{
+		std::vector<uint8_t> format;
+		const uint32_t sampleRate = 44100;
+		const uint16_t blockAlign = (uint16_t)(channels * bitsPerSample / 8);
+		Append(format, (uint16_t)1);			// WAVE_FORMAT_PCM
+		Append(format, channels);
+		Append(format, sampleRate);
+		Append(format, sampleRate * blockAlign);
+		Append(format, blockAlign);
+		Append(format, bitsPerSample);
+
+		std::vector<uint8_t> body;
+		AppendBytes(body, "WAVE", 4);
+		AppendChunk(body, "JUNK", std::vector<uint8_t>(3, 0xAA), 3);	// 奇数サイズ（パディングが入る）
+		AppendChunk(body, "fmt ", format, (uint32_t)format.size());
+		AppendChunk(body, "LIST", std::vector<uint8_t>(10, 0xBB), 10);
+		AppendChunk(body, "data", samples, (uint32_t)samples.size() + (declareLongerData ? 16u : 0u));
+
+		std::vector<uint8_t> wave;
+		AppendBytes(wave, "RIFF", 4);
+		Append(wave, (uint32_t)body.size());
+		AppendBytes(wave, body.data(), body.size());
+		return wave;
+	}
+
+	// 渡された中身を記録し、積まれた数の上限を確かめる再生先
+	class RecordingSink : public NullAudioSink
+	{
+	public:
+		bool SubmitBuffer(const uint8_t* data, uint32_t size, bool endOfStream) override
+		{
+			ARCHE_CHECK(GetQueuedBufferCount() < BUFFER_COUNT);
+			ARCHE_CHECK(size > 0 && size <= BLOCK_SIZE);
+			ARCHE_CHECK(!IsEndSubmitted());
+			sizes.push_back(size);
+			received.insert(received.end(), data, data + size);
+			return NullAudioSink::SubmitBuffer(data, size, endOfStream);
+		}
+
+		std::vector<uint8_t> received;
+		std::vector<uint32_t> sizes;
+	};
+
+	// 1回に読む量を記録し、指定した位置より先は読めなくする
+	class ProbeReader : public StreamReader
+	{
+	public:
+		ProbeReader(std::vector<uint8_t> data, uint64_t failAfter = UINT64_MAX) : m_inner(std::move(data)), m_failAfter(failAfter) {}
+
+		uint64_t GetSize() const override { return m_inner.GetSize(); }
+		bool Read(uint64_t offset, void* dst, size_t size) override
+		{
+			m_maxRead->store(std::max<size_t>(m_maxRead->load(), size));
+			if (offset + size > m_failAfter) return false;
+			return m_inner.Read(offset, dst, size);
+		}
+
+		// reader はストリームに渡すので、結果は外に置く
+		std::shared_ptr<std::atomic<size_t>> m_maxRead = std::make_shared<std::atomic<size_t>>(0);
+
+	private:
+		MemoryStreamReader m_inner;
+		uint64_t m_failAfter;
+	};
+
+	// 毎回1つずつ再生し終わったことにして、最後まで（または limit バイト渡るまで）回す
+	bool Play(SoundStream& stream, RecordingSink& sink, size_t limit = SIZE_MAX)
+	{
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+		while (!stream.IsFinished() && sink.received.size() < limit)
+		{
+			if (std::chrono::steady_clock::now() > deadline) return false;
+			stream.Pump(sink);
+			sink.Consume(1);
+			std::this_thread::yield();
+		}
+		return true;
+	}
+
+	void TestPlayToEnd()
+	{
+		const uint32_t sizes[] = { 4, BLOCK_SIZE - 4, BLOCK_SIZE, BLOCK_SIZE + 4, BLOCK_SIZE * BUFFER_COUNT * 3 + 12 };
+		for (uint32_t size : sizes)
+		{
+			const std::vector<uint8_t> samples = MakeSamples(size);
+			auto reader = std::make_unique<ProbeReader>(MakeWave(samples));
+			auto maxRead = reader->m_maxRead;
+
+			SoundStream stream;
+			ARCHE_CHECK(stream.Open("memory.wav", std::move(reader), false));
+			ARCHE_CHECK(stream.GetFormat().size() == 16);
+			ARCHE_CHECK(std::fabs(stream.GetDuration() - (float)size / (44100.0f * 4.0f)) < 1e-4f);
+			ARCHE_CHECK(stream.GetMemoryUsage() == (uint64_t)BUFFER_COUNT * BLOCK_SIZE);
+
+			RecordingSink sink;
+			ARCHE_CHECK(Play(stream, sink));
+			ARCHE_CHECK(stream.IsFinished());
+			ARCHE_CHECK(sink.IsEndSubmitted());
+			ARCHE_CHECK(sink.GetSubmittedBytes() == size);
+			ARCHE_CHECK(sink.received == samples);
+			ARCHE_CHECK(sink.sizes.size() == (size + BLOCK_SIZE - 1) / BLOCK_SIZE);
+			stream.Close();
+
+			// ファイル全体ではなく、ブロック単位で読んでいる
+			ARCHE_CHECK(maxRead->load() <= BLOCK_SIZE);
+		}
+	}
+
+	void TestLoop()
+	{
+		// ブロックサイズで割り切れない長さ（つなぎ目がブロックの途中に来る）
+		const uint32_t size = BLOCK_SIZE + BLOCK_SIZE / 2 + 8;
+		const std::vector<uint8_t> samples = MakeSamples(size);
+
+		SoundStream stream;
+		ARCHE_CHECK(stream.Open("loop.wav", std::make_unique<MemoryStreamReader>(MakeWave(samples)), true));
+
+		RecordingSink sink;
+		ARCHE_CHECK(Play(stream, sink, (size_t)size * 5));
+		ARCHE_CHECK(!stream.IsFinished());
+		ARCHE_CHECK(!sink.IsEndSubmitted());
+		ARCHE_CHECK(sink.received.size() >= (size_t)size * 5);
+
+		bool seamless = true;
+		for (size_t i = 0; i < sink.received.size(); ++i) seamless &= sink.received[i] == samples[i % size];
+		ARCHE_CHECK(seamless);
+
+		// 途中のブロックは全て満杯（つなぎ目で短いブロックを挟まない）
+		for (size_t i = 0; i + 1 < sink.sizes.size(); ++i) ARCHE_CHECK(sink.sizes[i] == BLOCK_SIZE);
+
+		stream.Close();
+		ARCHE_CHECK(!stream.IsOpen());
+	}
+
+	void TestBlockAlign()
+	{
+		// 24bit ステレオ（1サンプル6バイト）はブロックの途中でサンプルが切れないよう 6 の倍数にする
+		const uint32_t size = 6 * 40000;
+		const std::vector<uint8_t> samples = MakeSamples(size);
+
+		SoundStream stream;
+		ARCHE_CHECK(stream.Open("24bit.wav", std::make_unique<MemoryStreamReader>(MakeWave(samples, 2, 24)), false));
+
+		RecordingSink sink;
+		ARCHE_CHECK(Play(stream, sink));
+		ARCHE_CHECK(sink.received == samples);
+		for (uint32_t blockSize : sink.sizes) ARCHE_CHECK(blockSize % 6 == 0);
+	}
+
+	void TestBackPressure()
+	{
+		// 再生先が消費しない間は、BUFFER_COUNT 個を超えて読み進めない
+		const std::vector<uint8_t> samples = MakeSamples(BLOCK_SIZE * 16);
+
+		SoundStream stream;
+		ARCHE_CHECK(stream.Open("slow.wav", std::make_unique<MemoryStreamReader>(MakeWave(samples)), false));
+
+		RecordingSink sink;
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (sink.GetQueuedBufferCount() < BUFFER_COUNT && std::chrono::steady_clock::now() < deadline)
+		{
+			stream.Pump(sink);
+			std::this_thread::yield();
+		}
+		ARCHE_CHECK(sink.GetQueuedBufferCount() == BUFFER_COUNT);
+
+		for (int i = 0; i < 1000; ++i) stream.Pump(sink);
+		ARCHE_CHECK(sink.GetQueuedBufferCount() == BUFFER_COUNT);
+		ARCHE_CHECK(sink.GetSubmittedBytes() == (uint64_t)BUFFER_COUNT * BLOCK_SIZE);
+
+		// 消費すれば最後まで進む
+		ARCHE_CHECK(Play(stream, sink));
+		ARCHE_CHECK(sink.received == samples);
+	}
+
+	void TestInvalid()
+	{
+		SoundStream stream;
+		ARCHE_CHECK(!stream.Open("null.wav", nullptr, false));
+
+		std::vector<uint8_t> notWave = MakeWave(MakeSamples(64));
+		std::memcpy(notWave.data(), "RIFX", 4);
+		ARCHE_CHECK(!stream.Open("bad.wav", std::make_unique<MemoryStreamReader>(notWave), false));
+
+		// data チャンクのサイズがファイルより長い
+		ARCHE_CHECK(!stream.Open("truncated.wav", std::make_unique<MemoryStreamReader>(MakeWave(MakeSamples(64), 2, 16, true)), false));
+
+		// data が空
+		ARCHE_CHECK(!stream.Open("empty.wav", std::make_unique<MemoryStreamReader>(MakeWave({})), false));
+
+		// ヘッダーだけで途切れている
+		std::vector<uint8_t> header = MakeWave(MakeSamples(64));
+		header.resize(20);
+		ARCHE_CHECK(!stream.Open("short.wav", std::make_unique<MemoryStreamReader>(header), false));
+		ARCHE_CHECK(!stream.IsOpen());
+	}
+
+	void TestReadFailure()
+	{
+		// 途中で読めなくなったら、読めた所までで終わる（ループでも止まる）
+		const std::vector<uint8_t> samples = MakeSamples(BLOCK_SIZE * 3);
+		std::vector<uint8_t> wave = MakeWave(samples);
+		const uint64_t dataOffset = wave.size() - samples.size();
+		const uint64_t failAfter = dataOffset + BLOCK_SIZE;	// 2ブロック目で失敗
+
+		for (bool loop : { false, true })
+		{
+			SoundStream stream;
+			ARCHE_CHECK(stream.Open("broken.wav", std::make_unique<ProbeReader>(wave, failAfter), loop));
+
+			RecordingSink sink;
+			ARCHE_CHECK(Play(stream, sink));
+			ARCHE_CHECK(stream.IsFinished());
+			ARCHE_CHECK(sink.received.size() == BLOCK_SIZE);
+			ARCHE_CHECK(std::equal(sink.received.begin(), sink.received.end(), samples.begin()));
+		}
+	}
+
+	void TestCloseWhilePlaying()
+	{
+		const std::vector<uint8_t> samples = MakeSamples(BLOCK_SIZE * 8);
+		for (int i = 0; i < 50; ++i)
+		{
+			SoundStream stream;
+			ARCHE_CHECK(stream.Open("close.wav", std::make_unique<MemoryStreamReader>(MakeWave(samples)), true));
+
+			NullAudioSink sink;
+			for (int pump = 0; pump < i; ++pump)
+			{
+				stream.Pump(sink);
+				sink.Consume(1);
+			}
+			stream.Close();
+			ARCHE_CHECK(!stream.IsOpen());
+		}
+	}
+
+	void TestFileReader()
+	{
+		const std::vector<uint8_t> samples = MakeSamples(BLOCK_SIZE * 2 + 100);
+		const std::vector<uint8_t> wave = MakeWave(samples);
+
+		// パックの中のエントリと同じく、前後に他のデータがあるファイルの一部として開く
+		const std::vector<uint8_t> prefix(4096, 0xCD);
+		const std::vector<uint8_t> suffix(777, 0xEF);
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / "ArcheSoundStreamTest.pak";
+		{
+			std::ofstream out(path, std::ios::binary | std::ios::trunc);
+			out.write((const char*)prefix.data(), prefix.size());
+			out.write((const char*)wave.data(), wave.size());
+			out.write((const char*)suffix.data(), suffix.size());
+		}
+
+		FileStreamReader whole;
+		ARCHE_CHECK(whole.Open(path));
+		ARCHE_CHECK(whole.GetSize() == prefix.size() + wave.size() + suffix.size());
+
+		auto reader = std::make_unique<FileStreamReader>();
+		ARCHE_CHECK(reader->Open(path, prefix.size(), wave.size()));
+		ARCHE_CHECK(reader->GetSize() == wave.size());
+
+		// 範囲外は読めない
+		uint8_t byte = 0;
+		ARCHE_CHECK(!reader->Read(wave.size(), &byte, 1));
+		ARCHE_CHECK(reader->Read(wave.size() - 1, &byte, 1));
+
+		SoundStream stream;
+		ARCHE_CHECK(stream.Open(path.string(), std::move(reader), false));
+		RecordingSink sink;
+		ARCHE_CHECK(Play(stream, sink));
+		ARCHE_CHECK(sink.received == samples);
+		stream.Close();
+
+		FileStreamReader missing;
+		ARCHE_CHECK(!missing.Open(path.parent_path() / "ArcheSoundStreamTest_missing.wav"));
+
+		std::error_code ec;
+		std::filesystem::remove(path, ec);
+	}
+}
+
+int main()
+{
+	TestPlayToEnd();
+	TestLoop();
+	TestBlockAlign();
+	TestBackPressure();
+	TestInvalid();
+	TestReadFailure();
+	TestCloseWhilePlaying();
+	TestFileReader();
+	return ARCHE_TEST_RESULT();
+}
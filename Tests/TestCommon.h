@@ -0,0 +1,35 @@
+﻿/*****************************************************************//**
+ * @file	TestCommon.h
+ * @brief	テスト用の最小限のチェックマクロ
+ *
+ * @details	失敗した条件と場所を出力して数え、main の最後に ARCHE_TEST_RESULT() で終了コードにする。
+ *
+ * ------------------------------------------------------------
+ * @author	Iwai Shogo
+ * ------------------------------------------------------------
+ *********************************************************************/
+
+#ifndef ___TEST_COMMON_H___
+#define ___TEST_COMMON_H___
+
+// ===== インクルード =====
+#include <atomic>
+#include <cstdio>
+
+namespace ArcheTest
+{
+	inline std::atomic<int> g_failures{ 0 };
+}
+
+#define ARCHE_CHECK(cond) \
+	do { \
+		if (!(cond)) { \
+			std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+			ArcheTest::g_failures++; \
+		} \
+	} while (0)
+
+#define ARCHE_TEST_RESULT() \
+	(ArcheTest::g_failures == 0 ? (std::printf("OK\n"), 0) : (std::fprintf(stderr, "%d check(s) failed\n", ArcheTest::g_failures.load()), 1))
+
+#endif // !___TEST_COMMON_H___